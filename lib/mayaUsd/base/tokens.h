@@ -62,11 +62,30 @@ PXR_NAMESPACE_OPEN_SCOPE
     ((SerializedUsdEditsLocation, "mayaUsd_SerializedUsdEditsLocation")) \
     /* optionVar to force a prompt on every save                    */ \
     ((SerializedUsdEditsLocationPrompt, "mayaUsd_SerializedUsdEditsLocationPrompt")) \
+    /* optionVar to compress the Usd edits exported to the Maya file */ \
+    ((SerializedUsdEditsCompressed, "mayaUsd_SerializedUsdEditsCompressed")) \
     /* optionVar to control if comfirmation dialog will be show when overriding file */ \
     ((ConfirmExistingFileSave, "mayaUsd_ConfirmExistingFileSave"))     \
     /* optionVar to turn on or off async texture loading            */ \
     /* Notice that only newly opened USD stage would be affected.   */ \
     ((DisableAsyncTextureLoading, "mayaUsd_DisableAsyncTextureLoading")) \
+    /* optionVar for the maximum number of threads decoding textures */ \
+    /* in the background when async texture loading is enabled.      */ \
+    ((AsyncTextureLoadingThreads, "mayaUsd_AsyncTextureLoadingThreads")) \
+    /* optionVar for the viewport texture memory budget, in megabytes. */ \
+    /* Zero or unset means no budget.                                  */ \
+    ((TextureMemoryBudget, "mayaUsd_TextureMemoryBudget")) \
+    /* optionVar for the largest dimension of the viewport textures.   */ \
+    /* Zero or unset means full resolution.                            */ \
+    ((TextureMaxResolution, "mayaUsd_TextureMaxResolution")) \
+    /* optionVar for the directory caching the reduced textures.       */ \
+    ((TextureCacheDirectory, "mayaUsd_TextureCacheDirectory")) \
+    /* optionVar for the directory caching the OGS fragments generated */ \
+    /* for MaterialX materials across sessions.                         */ \
+    ((MaterialXCacheDirectory, "mayaUsd_MaterialXCacheDirectory")) \
+    /* optionVar to generate the OGS fragments of MaterialX materials  */ \
+    /* on worker threads, drawing with the fallback shader meanwhile.  */ \
+    ((AsyncMaterialXGeneration, "mayaUsd_AsyncMaterialXGeneration")) \
     /* option var to remember if the stage in the layer editor is pinned. */ \
     ((PinLayerEditorStage, "mayaUsd_PinLayerEditorStage")) \
     /* option var to remember if use display color when texture mode off */ \
@@ -44,6 +44,10 @@ MSyntax MayaUSDExportCommand::createSyntax()
     // UsdMayaJobExportArgs::GetGuideDictionary.
     syntax.addFlag(
         kWriteDefaults, UsdMayaJobExportArgsTokens->writeDefaults.GetText(), MSyntax::kBoolean);
+    syntax.addFlag(
+        kParallelFrameWriteFlag,
+        UsdMayaJobExportArgsTokens->parallelFrameWrite.GetText(),
+        MSyntax::kBoolean);
     syntax.addFlag(
         kMergeTransformAndShapeFlag,
         UsdMayaJobExportArgsTokens->mergeTransformAndShape.GetText(),
@@ -231,6 +235,10 @@ MSyntax MayaUSDExportCommand::createSyntax()
     // These are additional flags under our control.
     syntax.addFlag(
         kMetersPerUnit, UsdMayaJobExportArgsTokens->metersPerUnit.GetText(), MSyntax::kDouble);
+    syntax.addFlag(
+        kTimeSampleChunkSize,
+        UsdMayaJobExportArgsTokens->timeSampleChunkSize.GetText(),
+        MSyntax::kDouble);
     syntax.addFlag(kFrameRangeFlag, kFrameRangeFlagLong, MSyntax::kDouble, MSyntax::kDouble);
     syntax.addFlag(kFrameStrideFlag, kFrameStrideFlagLong, MSyntax::kDouble);
     syntax.addFlag(kFrameSampleFlag, kFrameSampleFlagLong, MSyntax::kDouble);
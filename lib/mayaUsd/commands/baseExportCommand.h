@@ -53,6 +53,7 @@ public:
     static constexpr auto kIgnoreWarningsFlag = "ign";
     static constexpr auto kExportInstancesFlag = "ein";
     static constexpr auto kWriteDefaults = "wd";
+    static constexpr auto kParallelFrameWriteFlag = "pfw";
     static constexpr auto kMergeTransformAndShapeFlag = "mt";
     static constexpr auto kStripNamespacesFlag = "sn";
     static constexpr auto kExportRefsAsInstanceableFlag = "eri";
@@ -93,6 +94,7 @@ public:
     static constexpr auto kWorldspaceFlag = "wsp";
     static constexpr auto kCustomLayerData = "cld";
     static constexpr auto kMetersPerUnit = "mpu";
+    static constexpr auto kTimeSampleChunkSize = "tsc";
     static constexpr auto kExcludeExportTypesFlag = "eet";
 
     // Short and Long forms of flags defined by this command itself:
@@ -16,8 +16,108 @@
 
 #include "flexibleSparseValueWriter.h"
 
+#include <pxr/base/gf/half.h>
+#include <pxr/base/gf/math.h>
+#include <pxr/base/gf/matrix2d.h>
+#include <pxr/base/gf/matrix3d.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/vec2d.h>
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec2h.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec3h.h>
+#include <pxr/base/gf/vec4d.h>
+#include <pxr/base/gf/vec4f.h>
+#include <pxr/base/gf/vec4h.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/vt/array.h>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+// Floating-point samples are compared with GfIsClose(), like the USD sparse writer
+// does, so that the typed, the VtValue and the staged paths skip the same samples.
+template <typename T> bool _IsClose(const T& a, const T& b, double tolerance)
+{
+    return GfIsClose(a, b, tolerance);
+}
+
+bool _IsClose(const GfHalf a, const GfHalf b, double tolerance)
+{
+    return GfIsClose(static_cast<float>(a), static_cast<float>(b), tolerance);
+}
+
+// Arrays are compared element by element.
+template <typename T> bool _IsClose(const VtArray<T>& a, const VtArray<T>& b, double tolerance)
+{
+    // Arrays sharing the same buffer are trivially identical.
+    if (a.IsIdentical(b))
+        return true;
+    if (a.size() != b.size())
+        return false;
+    const T* const dataA = a.cdata();
+    const T* const dataB = b.cdata();
+    for (size_t i = 0, n = a.size(); i < n; ++i) {
+        if (!_IsClose(dataA[i], dataB[i], tolerance))
+            return false;
+    }
+    return true;
+}
+
+// Integers are always compared exactly.
+bool _IsClose(const VtIntArray& a, const VtIntArray& b, double)
+{
+    return a.IsIdentical(b) || a == b;
+}
+
+// Returns true if both values hold a T, and sets isSame to the result of their comparison.
+template <typename T>
+bool _CompareHolding(const VtValue& a, const VtValue& b, double tolerance, bool& isSame)
+{
+    if (!a.IsHolding<T>())
+        return false;
+    isSame = b.IsHolding<T>() && _IsClose(a.UncheckedGet<T>(), b.UncheckedGet<T>(), tolerance);
+    return true;
+}
+
+template <typename T>
+bool _CompareHoldingOrArray(const VtValue& a, const VtValue& b, double tolerance, bool& isSame)
+{
+    return _CompareHolding<T>(a, b, tolerance, isSame)
+        || _CompareHolding<VtArray<T>>(a, b, tolerance, isSame);
+}
+
+// Every floating-point type staged by the exporters, scalar or array, is compared with
+// the tolerance, like UsdUtilsSparseValueWriter compares the samples of the serial export.
+// The other types are compared exactly.
+bool _IsSameValue(const VtValue& a, const VtValue& b, double tolerance)
+{
+    bool isSame = false;
+    if (_CompareHoldingOrArray<GfVec3f>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<float>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<double>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfMatrix4d>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec3d>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec2f>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec4f>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec2d>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec4d>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfHalf>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec2h>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec3h>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfVec4h>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfMatrix2d>(a, b, tolerance, isSame)
+        || _CompareHoldingOrArray<GfMatrix3d>(a, b, tolerance, isSame)
+        || _CompareHolding<VtIntArray>(a, b, tolerance, isSame)) {
+        return isSame;
+    }
+    return a == b;
+}
+
+} // namespace
+
 FlexibleSparseValueWriter::FlexibleSparseValueWriter(bool writeDefaults)
     : _writeDefaults(writeDefaults)
 {
@@ -32,6 +132,9 @@ bool FlexibleSparseValueWriter::SetAttribute(
     // then write the value directly on the attribute, skipping the sparse writer.
     if (_writeDefaults && time.IsDefault()) {
         return attr.Set(value, time);
+    } else if (_staging && !time.IsDefault()) {
+        VtValue copy(value);
+        return _StageSample(attr, &copy, time);
     } else {
         return _sparseWriter.SetAttribute(attr, value, time);
     }
@@ -46,9 +149,193 @@ bool FlexibleSparseValueWriter::SetAttribute(
     // then write the value directly on the attribute, skipping the sparse writer.
     if (_writeDefaults && time.IsDefault()) {
         return attr.Set(*value, time);
+    } else if (_staging && !time.IsDefault()) {
+        return _StageSample(attr, value, time);
     } else {
         return _sparseWriter.SetAttribute(attr, value, time);
     }
 }
 
+bool FlexibleSparseValueWriter::SetAttribute(
+    const UsdAttribute& attr,
+    VtVec3fArray&       value,
+    const UsdTimeCode   time)
+{
+    return _SetTypedAttribute(attr, value, time);
+}
+
+bool FlexibleSparseValueWriter::SetAttribute(
+    const UsdAttribute& attr,
+    VtFloatArray&       value,
+    const UsdTimeCode   time)
+{
+    return _SetTypedAttribute(attr, value, time);
+}
+
+bool FlexibleSparseValueWriter::SetAttribute(
+    const UsdAttribute& attr,
+    VtIntArray&         value,
+    const UsdTimeCode   time)
+{
+    return _SetTypedAttribute(attr, value, time);
+}
+
+bool FlexibleSparseValueWriter::SetAttribute(
+    const UsdAttribute& attr,
+    GfMatrix4d&         value,
+    const UsdTimeCode   time)
+{
+    return _SetTypedAttribute(attr, value, time);
+}
+
+template <typename T>
+bool FlexibleSparseValueWriter::_SetTypedAttribute(
+    const UsdAttribute& attr,
+    T&                  value,
+    const UsdTimeCode   time)
+{
+    // Default values and staged samples go through the VtValue code path.
+    if (time.IsDefault() || _staging) {
+        VtValue val = VtValue::Take(value);
+        return SetAttribute(attr, &val, time);
+    }
+
+    if (!attr)
+        return false;
+
+    // Like the USD sparse writer, the first sample is compared against the
+    // authored default value or the fallback value of the attribute.
+    auto        inserted = _attrStates.emplace(attr, _AttrState());
+    _AttrState& state = inserted.first->second;
+    if (inserted.second) {
+        attr.Get(&state.prevValue, UsdTimeCode::Default());
+    }
+
+    if (time < state.prevTime) {
+        TF_CODING_ERROR(
+            "Time-sample at %f of attribute <%s> is before the previous one at %f.",
+            time.GetValue(),
+            attr.GetPath().GetText(),
+            state.prevTime.GetValue());
+        return false;
+    }
+
+    if (state.prevValue.IsHolding<T>()
+        && _IsClose(value, state.prevValue.UncheckedGet<T>(), _tolerance)) {
+        state.didWritePrevValue = false;
+        ++_numSkippedSamples;
+    } else {
+        // The previous sample was skipped because it was close to its predecessor:
+        // it must be written now to keep the interpolation correct.
+        if (!state.didWritePrevValue) {
+            attr.Set(state.prevValue.UncheckedGet<T>(), state.prevTime);
+            ++_numWrittenSamples;
+        }
+        if (!attr.Set(value, time))
+            return false;
+        state.didWritePrevValue = true;
+        ++_numWrittenSamples;
+    }
+
+    // Swapping reuses the storage of the previous sample, so no VtValue is allocated.
+    state.prevValue.Swap(value);
+    state.prevTime = time;
+    value = T();
+    return true;
+}
+
+void FlexibleSparseValueWriter::Clear()
+{
+    _sparseWriter.Clear();
+    _stagedSamples.clear();
+    _stagedAttrs.clear();
+    _takenSamples.clear();
+    _processedSamples.clear();
+    _attrStates.clear();
+}
+
+bool FlexibleSparseValueWriter::_StageSample(
+    const UsdAttribute& attr,
+    VtValue*            value,
+    const UsdTimeCode   time)
+{
+    if (!attr)
+        return false;
+
+    _stagedSamples.emplace_back();
+    _Sample& sample = _stagedSamples.back();
+    sample.attr = attr;
+    sample.value.Swap(*value);
+    sample.time = time;
+
+    // The first sample of an attribute is compared against its authored default
+    // or fallback value, which must be read now, on the main thread.
+    if (_stagedAttrs.insert(attr).second) {
+        sample.isFirst = true;
+        attr.Get(&sample.initialValue, UsdTimeCode::Default());
+    }
+
+    return true;
+}
+
+void FlexibleSparseValueWriter::TakeStagedSamples()
+{
+    _takenSamples.swap(_stagedSamples);
+    _stagedSamples.clear();
+}
+
+void FlexibleSparseValueWriter::ProcessTakenSamples()
+{
+    for (_Sample& sample : _takenSamples) {
+        _AttrState& state = _attrStates[sample.attr];
+        if (sample.isFirst) {
+            state.prevValue.Swap(sample.initialValue);
+            state.prevTime = UsdTimeCode::Default();
+            state.didWritePrevValue = true;
+        }
+
+        if (sample.time < state.prevTime) {
+            // Samples must come in non-decreasing time order, like for the USD sparse writer.
+            continue;
+        }
+
+        // Same comparison as the typed overloads of SetAttribute() and, for every
+        // floating-point type, as the USD sparse writer of the serial export.
+        if (_IsSameValue(sample.value, state.prevValue, _tolerance)) {
+            state.didWritePrevValue = false;
+            ++_numSkippedSamples;
+        } else {
+            // The previous sample was skipped because it was close to its predecessor:
+            // it must be written now to keep the interpolation correct.
+            if (!state.didWritePrevValue) {
+                _Sample prevSample;
+                prevSample.attr = sample.attr;
+                prevSample.value = state.prevValue;
+                prevSample.time = state.prevTime;
+                _processedSamples.push_back(std::move(prevSample));
+                ++_numWrittenSamples;
+            }
+            _Sample newSample;
+            newSample.attr = sample.attr;
+            newSample.value = sample.value;
+            newSample.time = sample.time;
+            _processedSamples.push_back(std::move(newSample));
+            state.didWritePrevValue = true;
+            ++_numWrittenSamples;
+        }
+
+        state.prevValue.Swap(sample.value);
+        state.prevTime = sample.time;
+    }
+    _takenSamples.clear();
+}
+
+void FlexibleSparseValueWriter::AuthorProcessedSamples()
+{
+    for (const _Sample& sample : _processedSamples) {
+        sample.attr.Set(sample.value, sample.time);
+    }
+    _processedSamples.clear();
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -18,12 +18,19 @@
 
 #include <mayaUsd/base/api.h>
 
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/tf/hash.h>
+#include <pxr/base/vt/types.h>
 #include <pxr/base/vt/value.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdUtils/sparseValueWriter.h>
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 /// Flexible spare value writer.
@@ -32,12 +39,21 @@ PXR_NAMESPACE_OPEN_SCOPE
 /// This is necessary in some cases, for example to author a layer that will override
 /// a value back to its default. Another example is during edit-as-Maya / merge-to-USD
 /// where we need to author default values in case the original value was not the default.
+///
+/// The writer can also stage its time samples instead of authoring them right away. This
+/// is used by the write job to export frames in parallel: the Maya data of a frame is
+/// pulled on the main thread into the staging buffer, the comparison against the previous
+/// samples runs on a worker thread and only the samples that must be kept are authored,
+/// again on the main thread.
 class MAYAUSD_CORE_PUBLIC FlexibleSparseValueWriter
 {
 public:
     /// Constructor taking a flag to decide if default values at default time should be written.
     FlexibleSparseValueWriter(bool writeDefaults = true);
 
+    /// The tolerance of UsdUtilsSparseValueWriter, used by default for floating-point samples.
+    static constexpr double DefaultTolerance = 1e-6;
+
     FlexibleSparseValueWriter(const FlexibleSparseValueWriter&) = delete;
     FlexibleSparseValueWriter& operator=(const FlexibleSparseValueWriter&) = delete;
 
@@ -61,6 +77,34 @@ public:
         VtValue*            value,
         const UsdTimeCode   time = UsdTimeCode::Default());
 
+    /// \overload
+    /// Typed fast path for the values that change on most frames of an animated
+    /// export. Time samples are compared with the previous sample of the attribute
+    /// without boxing them in a VtValue, so redundant samples are skipped without
+    /// any allocation. Swaps out the given \p value, leaving it empty.
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        VtVec3fArray&       value,
+        const UsdTimeCode   time = UsdTimeCode::Default());
+
+    /// \overload
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        VtFloatArray&       value,
+        const UsdTimeCode   time = UsdTimeCode::Default());
+
+    /// \overload
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        VtIntArray&         value,
+        const UsdTimeCode   time = UsdTimeCode::Default());
+
+    /// \overload
+    bool SetAttribute(
+        const UsdAttribute& attr,
+        GfMatrix4d&         value,
+        const UsdTimeCode   time = UsdTimeCode::Default());
+
     /// \overload
     template <typename T>
     bool SetAttribute(
@@ -74,11 +118,89 @@ public:
 
     /// Clears the internal map, thereby releasing all the memory used by
     /// the sparse value-writers.
-    void Clear() { _sparseWriter.Clear(); }
+    void Clear();
+
+    /// Sets the tolerance under which a floating-point time sample is considered
+    /// identical to the previous sample of its attribute, and skipped. Only used
+    /// by the typed overloads of SetAttribute() and by the staging of time samples:
+    /// the other values go through UsdUtilsSparseValueWriter, which always uses 1e-6.
+    /// Integer arrays are always compared exactly.
+    void SetTolerance(double tolerance) { _tolerance = tolerance; }
+
+    /// Returns the tolerance used to skip redundant floating-point time samples.
+    double GetTolerance() const { return _tolerance; }
+
+    /// Enables or disables the staging of time samples. When staging, the time samples
+    /// given to SetAttribute() are kept in memory until TakeStagedSamples(),
+    /// ProcessTakenSamples() and AuthorProcessedSamples() are called, in that order.
+    /// Values at the default time are always authored immediately.
+    void SetStaging(bool staging) { _staging = staging; }
+
+    /// Returns true if time samples are staged instead of being authored immediately.
+    bool IsStaging() const { return _staging; }
+
+    /// Moves the samples staged so far out of the staging buffer so that they can be
+    /// processed while new samples are being staged. Must be called from the main thread.
+    void TakeStagedSamples();
+
+    /// Compares the taken samples with the previous samples of their attribute and keeps
+    /// those that need to be authored. Does not access the USD stage, so it can run on a
+    /// worker thread while SetAttribute() stages the samples of the next frame.
+    void ProcessTakenSamples();
+
+    /// Authors the samples kept by ProcessTakenSamples(). Must be called from the main thread.
+    void AuthorProcessedSamples();
+
+    /// Returns the number of time samples authored by the typed overloads of
+    /// SetAttribute() and by the staging of time samples.
+    size_t GetNumWrittenSamples() const { return _numWrittenSamples; }
+
+    /// Returns the number of redundant time samples skipped by the typed overloads
+    /// of SetAttribute() and by the staging of time samples.
+    size_t GetNumSkippedSamples() const { return _numSkippedSamples; }
 
 private:
+    bool _StageSample(const UsdAttribute& attr, VtValue* value, const UsdTimeCode time);
+
+    template <typename T>
+    bool _SetTypedAttribute(const UsdAttribute& attr, T& value, const UsdTimeCode time);
+
+    /// A time sample waiting to be compared or authored. The initial value is only
+    /// filled for the first sample of an attribute, since the attribute default value
+    /// or fallback value can only be read from the main thread.
+    struct _Sample
+    {
+        UsdAttribute attr;
+        VtValue      value;
+        UsdTimeCode  time;
+        VtValue      initialValue;
+        bool         isFirst = false;
+    };
+
+    /// The sparse authoring state of an attribute, mirroring UsdUtilsSparseAttrValueWriter.
+    struct _AttrState
+    {
+        VtValue     prevValue;
+        UsdTimeCode prevTime = UsdTimeCode::Default();
+        bool        didWritePrevValue = true;
+    };
+
     UsdUtilsSparseValueWriter _sparseWriter;
     bool                      _writeDefaults;
+    bool                      _staging = false;
+    double                    _tolerance = DefaultTolerance;
+    size_t                    _numWrittenSamples = 0;
+    size_t                    _numSkippedSamples = 0;
+
+    // Only accessed from the main thread.
+    std::vector<_Sample>                     _stagedSamples;
+    std::unordered_set<UsdAttribute, TfHash> _stagedAttrs;
+
+    // Handed over between the main thread and the worker thread. The attribute
+    // states are also used by the typed overloads of SetAttribute() when not staging.
+    std::vector<_Sample>                                 _takenSamples;
+    std::vector<_Sample>                                 _processedSamples;
+    std::unordered_map<UsdAttribute, _AttrState, TfHash> _attrStates;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
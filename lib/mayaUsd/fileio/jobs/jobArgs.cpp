@@ -132,6 +132,19 @@ double _ExtractMetersPerUnit(const VtDictionary& userArgs)
     return value;
 }
 
+unsigned int _ExtractTimeSampleChunkSize(const VtDictionary& userArgs)
+{
+    const double value
+        = extractDouble(userArgs, UsdMayaJobExportArgsTokens->timeSampleChunkSize, 0.0);
+
+    // Zero or negative values disable the flushing of the time samples.
+    if (value < 1.0) {
+        return 0;
+    }
+
+    return static_cast<unsigned int>(value);
+}
+
 std::map<std::string, std::string> _UVSetRemaps(const VtDictionary& userArgs, const TfToken& key)
 {
     const std::vector<std::vector<VtValue>> uvRemaps
@@ -635,6 +648,8 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
     , stripNamespaces(extractBoolean(userArgs, UsdMayaJobExportArgsTokens->stripNamespaces))
     , worldspace(extractBoolean(userArgs, UsdMayaJobExportArgsTokens->worldspace))
     , writeDefaults(extractBoolean(userArgs, UsdMayaJobExportArgsTokens->writeDefaults))
+    , parallelFrameWrite(
+          extractBoolean(userArgs, UsdMayaJobExportArgsTokens->parallelFrameWrite))
     , parentScope(extractAbsolutePath(userArgs, UsdMayaJobExportArgsTokens->parentScope))
     , renderLayerMode(extractToken(
           userArgs,
@@ -670,6 +685,7 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
     , allChaserArgs(_ChaserArgs(userArgs, UsdMayaJobExportArgsTokens->chaserArgs))
     , customLayerData(_CustomLayerData(userArgs, UsdMayaJobExportArgsTokens->customLayerData))
     , metersPerUnit(_ExtractMetersPerUnit(userArgs))
+    , timeSampleChunkSize(_ExtractTimeSampleChunkSize(userArgs))
     , remapUVSetsTo(_UVSetRemaps(userArgs, UsdMayaJobExportArgsTokens->remapUVSetsTo))
     , melPerFrameCallback(extractString(userArgs, UsdMayaJobExportArgsTokens->melPerFrameCallback))
     , melPostCallback(extractString(userArgs, UsdMayaJobExportArgsTokens->melPostCallback))
@@ -703,6 +719,7 @@ std::ostream& operator<<(std::ostream& out, const UsdMayaJobExportArgs& exportAr
         << "exportDisplayColor: " << TfStringify(exportArgs.exportDisplayColor) << std::endl
         << "exportDistanceUnit: " << TfStringify(exportArgs.exportDistanceUnit) << std::endl
         << "metersPerUnit: " << TfStringify(exportArgs.metersPerUnit) << std::endl
+        << "timeSampleChunkSize: " << TfStringify(exportArgs.timeSampleChunkSize) << std::endl
         << "exportInstances: " << TfStringify(exportArgs.exportInstances) << std::endl
         << "exportMaterialCollections: " << TfStringify(exportArgs.exportMaterialCollections)
         << std::endl
@@ -734,6 +751,7 @@ std::ostream& operator<<(std::ostream& out, const UsdMayaJobExportArgs& exportAr
         << "normalizeNurbs: " << TfStringify(exportArgs.normalizeNurbs) << std::endl
         << "preserveUVSetNames: " << TfStringify(exportArgs.preserveUVSetNames) << std::endl
         << "writeDefaults: " << TfStringify(exportArgs.writeDefaults) << std::endl
+        << "parallelFrameWrite: " << TfStringify(exportArgs.parallelFrameWrite) << std::endl
         << "parentScope: " << exportArgs.parentScope << std::endl
         << "renderLayerMode: " << exportArgs.renderLayerMode << std::endl
         << "rootKind: " << exportArgs.rootKind << std::endl
@@ -996,6 +1014,7 @@ const VtDictionary& UsdMayaJobExportArgs::GetDefaultDictionary()
         d[UsdMayaJobExportArgsTokens->normalizeNurbs] = false;
         d[UsdMayaJobExportArgsTokens->preserveUVSetNames] = false;
         d[UsdMayaJobExportArgsTokens->writeDefaults] = false;
+        d[UsdMayaJobExportArgsTokens->parallelFrameWrite] = false;
         d[UsdMayaJobExportArgsTokens->parentScope] = std::string();
         d[UsdMayaJobExportArgsTokens->pythonPerFrameCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->pythonPostCallback] = std::string();
@@ -1016,6 +1035,7 @@ const VtDictionary& UsdMayaJobExportArgs::GetDefaultDictionary()
             = UsdMayaJobExportArgsTokens->derived.GetString();
         d[UsdMayaJobExportArgsTokens->customLayerData] = std::vector<VtValue>();
         d[UsdMayaJobExportArgsTokens->metersPerUnit] = 0.0;
+        d[UsdMayaJobExportArgsTokens->timeSampleChunkSize] = 0.0;
         d[UsdMayaJobExportArgsTokens->excludeExportTypes] = std::vector<VtValue>();
 
         // plugInfo.json site defaults.
@@ -1057,6 +1077,7 @@ const VtDictionary& UsdMayaJobExportArgs::GetGuideDictionary()
         d[UsdMayaJobExportArgsTokens->remapUVSetsTo] = _stringPairVector;
         d[UsdMayaJobExportArgsTokens->customLayerData] = _stringTripletVector;
         d[UsdMayaJobExportArgsTokens->metersPerUnit] = _double;
+        d[UsdMayaJobExportArgsTokens->timeSampleChunkSize] = _double;
         d[UsdMayaJobExportArgsTokens->compatibility] = _string;
         d[UsdMayaJobExportArgsTokens->defaultCameras] = _boolean;
         d[UsdMayaJobExportArgsTokens->defaultMeshScheme] = _string;
@@ -1092,6 +1113,7 @@ const VtDictionary& UsdMayaJobExportArgs::GetGuideDictionary()
         d[UsdMayaJobExportArgsTokens->normalizeNurbs] = _boolean;
         d[UsdMayaJobExportArgsTokens->preserveUVSetNames] = _boolean;
         d[UsdMayaJobExportArgsTokens->writeDefaults] = _boolean;
+        d[UsdMayaJobExportArgsTokens->parallelFrameWrite] = _boolean;
         d[UsdMayaJobExportArgsTokens->parentScope] = _string;
         d[UsdMayaJobExportArgsTokens->pythonPerFrameCallback] = _string;
         d[UsdMayaJobExportArgsTokens->pythonPostCallback] = _string;
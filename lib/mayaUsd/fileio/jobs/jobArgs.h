@@ -110,8 +110,10 @@ TF_DECLARE_PUBLIC_TOKENS(
     (geomSidedness)   \
     (worldspace) \
     (writeDefaults) \
+    (parallelFrameWrite) \
     (customLayerData) \
     (metersPerUnit) \
+    (timeSampleChunkSize) \
     /* Types of objects to export */ \
     (excludeExportTypes) \
     /* Special "none" token */ \
@@ -234,6 +236,9 @@ struct UsdMayaJobExportArgs
     const bool worldspace;
     // Write default values at default time.
     const bool writeDefaults;
+    // Compare the time samples of a frame on worker threads while
+    // Maya evaluates the next frame.
+    const bool parallelFrameWrite;
 
     /// This is the path of the USD prim under which *all* prims will be
     /// authored.
@@ -257,6 +262,10 @@ struct UsdMayaJobExportArgs
     const VtDictionary                      customLayerData;
     const double                            metersPerUnit;
 
+    // Number of frames after which the time samples are flushed to a value
+    // clip layer on disk. Zero keeps all the time samples in the exported layer.
+    const unsigned int timeSampleChunkSize;
+
     const std::map<std::string, std::string> remapUVSetsTo;
 
     const std::string melPerFrameCallback;
@@ -19,6 +19,7 @@
 #include <mayaUsd/fileio/primReaderRegistry.h>
 #include <mayaUsd/fileio/translators/translatorMaterial.h>
 #include <mayaUsd/fileio/translators/translatorXformable.h>
+#include <mayaUsd/fileio/utils/primDataPrefetch.h>
 #include <mayaUsd/fileio/utils/readUtil.h>
 #include <mayaUsd/nodes/stageNode.h>
 #include <mayaUsd/undo/OpUndoItemMuting.h>
@@ -620,7 +621,8 @@ void UsdMaya_ReadJob::_ImportPrototype(
 
 bool UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
 {
-    const bool buildInstances = mArgs.importInstances;
+    const bool   buildInstances = mArgs.importInstances;
+    const size_t prefetchBatchSize = UsdMayaPrimDataPrefetch::GetDefaultBatchSize();
 
     MayaUsd::ProgressBarScope progressBar(0);
 
@@ -637,12 +639,29 @@ bool UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootP
             : UsdPrimRange::PreAndPostVisit(
                 rootPrim, UsdTraverseInstanceProxies(UsdPrimAllPrimsPredicate));
 
-        const int                     loopSize = std::distance(range.begin(), range.end());
+        // Collect the prims in a single traversal, both to size the progress
+        // bar and to read their data on worker threads ahead of the prim
+        // readers, which create the Maya nodes on the main thread.
+        UsdMayaPrimDataPrefetch prefetch(mArgs.timeInterval, prefetchBatchSize);
+        std::vector<UsdPrim>    prims;
+        int                     loopSize = 0;
+        for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
+            if (prefetchBatchSize > 0 && !primIt.IsPostVisit()) {
+                prims.push_back(*primIt);
+            }
+            ++loopSize;
+        }
+        prefetch.Start(std::move(prims));
+
         MayaUsd::ProgressBarLoopScope instanceLoop(loopSize);
         for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
             const UsdPrim&           prim = *primIt;
             UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
             readCtx.SetTimeSampleMultiplier(mTimeSampleMultiplier);
+            if (!primIt.IsPostVisit()) {
+                prefetch.Advance(prim);
+                readCtx.SetPrimDataPrefetch(&prefetch);
+            }
 
             if (buildInstances && prim.IsInstance()) {
                 _DoImportInstanceIt(primIt, usdRootPrim, readCtx, primReaderMap);
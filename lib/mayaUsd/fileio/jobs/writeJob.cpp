@@ -41,6 +41,7 @@
 
 #include <limits>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 // Needed for directly removing a UsdVariant via Sdf
 //   Remove when UsdVariantSet::RemoveVariant() is exposed
@@ -54,11 +55,14 @@
 #include <mayaUsd/fileio/shading/shadingModeExporterContext.h>
 #include <mayaUsd/fileio/transformWriter.h>
 #include <mayaUsd/fileio/translators/translatorMaterial.h>
+#include <mayaUsd/ufe/Utils.h>
 #include <mayaUsd/utils/progressBarScope.h>
 #include <mayaUsd/utils/util.h>
 
+#include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/sdf/variantSetSpec.h>
 #include <pxr/usd/sdf/variantSpec.h>
+#include <pxr/usd/usd/clipsAPI.h>
 #include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/primRange.h>
@@ -68,9 +72,342 @@
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdUtils/dependencies.h>
 #include <pxr/usd/usdUtils/pipeline.h>
+#include <pxr/usd/usdUtils/stitch.h>
+
+#include <ufe/trie.imp.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+// The first component of the UFE path of every Maya DAG path.
+const std::string kWorldComponent = "world";
+} // namespace
+
+/// Two-phase frame export: the prim writers pull the Maya data of a frame into
+/// the staging buffer of their sparse value-writer on the main thread, then the
+/// comparison with the previous samples runs on the TBB worker pool while the
+/// main thread moves on to the next frame. The samples that must be kept are
+/// authored on the main thread, since USD layers cannot be edited concurrently.
+class UsdMaya_WriteJob::_FramePipeline
+{
+public:
+    _FramePipeline(const std::vector<UsdMayaPrimWriterSharedPtr>& primWriters)
+    {
+        for (const UsdMayaPrimWriterSharedPtr& primWriter : primWriters) {
+            if (primWriter->GetUsdPrim()) {
+                FlexibleSparseValueWriter& valueWriter = primWriter->GetSparseValueWriter();
+                valueWriter.SetStaging(true);
+                _valueWriters.push_back(&valueWriter);
+            }
+        }
+    }
+
+    ~_FramePipeline()
+    {
+        // Never leave a task running on writers that are about to be destroyed.
+        _tasks.wait();
+    }
+
+    /// Takes the samples staged for the current frame and starts comparing them.
+    void Start()
+    {
+        for (FlexibleSparseValueWriter* valueWriter : _valueWriters) {
+            valueWriter->TakeStagedSamples();
+        }
+
+        _tasks.run([this]() {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, _valueWriters.size()),
+                [this](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i) {
+                        _valueWriters[i]->ProcessTakenSamples();
+                    }
+                });
+        });
+        _pending = true;
+    }
+
+    /// Waits for the comparison started by Start() and authors the kept samples.
+    void Finish()
+    {
+        if (!_pending) {
+            return;
+        }
+
+        _tasks.wait();
+        for (FlexibleSparseValueWriter* valueWriter : _valueWriters) {
+            valueWriter->AuthorProcessedSamples();
+        }
+        _pending = false;
+    }
+
+private:
+    std::vector<FlexibleSparseValueWriter*> _valueWriters;
+    tbb::task_group                         _tasks;
+    bool                                    _pending = false;
+};
+
+/// Bounds the memory used by long animated exports: the time samples of each
+/// window of frames are authored in the session layer of the stage, then moved
+/// to a value clip layer saved on disk. The root layer only keeps the default
+/// values and the value clip metadata, authored once all the frames are written.
+class UsdMaya_WriteJob::_ValueClipWriter
+{
+public:
+    _ValueClipWriter(const UsdStageRefPtr& stage, const std::string& fileName, size_t chunkSize)
+        : _stage(stage)
+        , _baseName(TfStringGetBeforeSuffix(fileName))
+        , _chunkSize(chunkSize)
+    {
+        // The session layer is stronger than the default values of the root layer,
+        // so the samples of the current window are visible to chasers and callbacks.
+        _stage->SetEditTarget(UsdEditTarget(_stage->GetSessionLayer()));
+        _manifest = SdfLayer::CreateAnonymous();
+    }
+
+    ~_ValueClipWriter() { _stage->SetEditTarget(UsdEditTarget(_stage->GetRootLayer())); }
+
+    /// Records that the samples of \p time were written. Returns \c true when
+    /// the current window is complete and must be flushed.
+    bool AddFrame(double time)
+    {
+        if (_numFrames == 0) {
+            _clipStartTimes.push_back(time);
+        }
+        _lastTime = time;
+        return ++_numFrames >= _chunkSize;
+    }
+
+    /// Moves the time samples of the current window to a new value clip layer.
+    /// The last window is flushed by Finish() instead, once the post export
+    /// steps and the chasers had a chance to edit its samples.
+    bool Flush() { return _Flush(false); }
+
+    /// Flushes the last window, then authors the value clip metadata on the
+    /// root prims and saves the clip manifest. Must be called after the post
+    /// export steps and the chasers ran.
+    bool Finish()
+    {
+        if (!_Flush(true)) {
+            return false;
+        }
+
+        const SdfLayerHandle rootLayer = _stage->GetRootLayer();
+        _stage->SetEditTarget(UsdEditTarget(rootLayer));
+
+        // Move the remaining opinions of the session layer, such as attributes
+        // created while writing the frames or the single samples that were not
+        // moved to the clips, to the exported layer.
+        const SdfLayerHandle sessionLayer = _stage->GetSessionLayer();
+        UsdUtilsStitchLayers(rootLayer, sessionLayer);
+        sessionLayer->Clear();
+
+        if (_clipFileNames.empty()) {
+            return true;
+        }
+
+        const std::string manifestFileName = TfStringPrintf(
+            "%s.manifest.%s",
+            _baseName.c_str(),
+            UsdMayaTranslatorTokens->UsdFileExtensionASCII.GetText());
+        SdfLayerRefPtr manifestLayer = SdfLayer::CreateNew(manifestFileName);
+        if (!manifestLayer) {
+            TF_RUNTIME_ERROR("Failed to create clip manifest '%s'", manifestFileName.c_str());
+            return false;
+        }
+        manifestLayer->TransferContent(_manifest);
+        if (!manifestLayer->Save()) {
+            TF_RUNTIME_ERROR("Failed to save clip manifest '%s'", manifestFileName.c_str());
+            return false;
+        }
+
+        // The clip asset paths are relative to the exported layer, which sits
+        // next to them.
+        VtArray<SdfAssetPath> assetPaths;
+        VtVec2dArray          active;
+        for (size_t i = 0; i < _clipFileNames.size(); ++i) {
+            assetPaths.push_back(SdfAssetPath("./" + TfGetBaseName(_clipFileNames[i])));
+            active.push_back(GfVec2d(_clipStartTimes[i], static_cast<double>(i)));
+        }
+        VtVec2dArray times { GfVec2d(_clipStartTimes.front(), _clipStartTimes.front()) };
+        if (_lastTime > _clipStartTimes.front()) {
+            times.push_back(GfVec2d(_lastTime, _lastTime));
+        }
+        const SdfAssetPath manifestAssetPath("./" + TfGetBaseName(manifestFileName));
+
+        // The root prims may have been deactivated by the modeling variants.
+        for (const UsdPrim& rootPrim : _stage->GetPseudoRoot().GetAllChildren()) {
+            if (!_manifest->GetPrimAtPath(rootPrim.GetPath())) {
+                continue;
+            }
+
+            UsdClipsAPI clipsAPI(rootPrim);
+            clipsAPI.SetClipPrimPath(rootPrim.GetPath().GetString());
+            clipsAPI.SetClipAssetPaths(assetPaths);
+            clipsAPI.SetClipActive(active);
+            clipsAPI.SetClipTimes(times);
+            clipsAPI.SetClipManifestAssetPath(manifestAssetPath);
+        }
+
+        return true;
+    }
+
+private:
+    bool _Flush(bool isLast)
+    {
+        if (_numFrames == 0) {
+            // When the export was interrupted right after a flush, the samples kept
+            // in the session layer are already in the clips.
+            if (isLast) {
+                _EraseKeptSamples();
+            }
+            return true;
+        }
+        _numFrames = 0;
+
+        const std::string clipFileName = TfStringPrintf(
+            "%s.clip%04zu.%s",
+            _baseName.c_str(),
+            _clipFileNames.size() + 1,
+            UsdMayaTranslatorTokens->UsdFileExtensionCrate.GetText());
+        SdfLayerRefPtr clipLayer = SdfLayer::CreateNew(clipFileName);
+        if (!clipLayer) {
+            TF_RUNTIME_ERROR("Failed to create value clip layer '%s'", clipFileName.c_str());
+            return false;
+        }
+
+        // Take the samples out of the session layer, leaving the attribute specs
+        // behind so that they are still found when authoring the next frames.
+        const SdfLayerHandle sessionLayer = _stage->GetSessionLayer();
+        std::vector<SdfPath> attrPaths;
+        sessionLayer->Traverse(SdfPath::AbsoluteRootPath(), [&attrPaths](const SdfPath& path) {
+            if (path.IsPrimPropertyPath()) {
+                attrPaths.push_back(path);
+            }
+        });
+
+        const double startTime = _clipStartTimes.back();
+
+        std::unordered_map<SdfPath, SdfTimeSampleMap, SdfPath::Hash> clipSamples;
+        for (const SdfPath& attrPath : attrPaths) {
+            const SdfAttributeSpecHandle attrSpec = sessionLayer->GetAttributeAtPath(attrPath);
+            if (!attrSpec || !attrSpec->HasInfo(SdfFieldKeys->TimeSamples)) {
+                continue;
+            }
+
+            SdfTimeSampleMap samples = attrSpec->GetTimeSampleMap();
+            if (samples.empty()) {
+                continue;
+            }
+
+            // A single sample stays in the session layer until the attribute gets a
+            // second one, so that the post export steps still see the whole animation
+            // of the attribute, e.g. to make it static with staticSingleSample.
+            const bool inClips = static_cast<bool>(_manifest->GetAttributeAtPath(attrPath));
+            if (!inClips
+                && (samples.size() < 2 || !_AddToManifest(attrSpec, samples.begin()->second))) {
+                continue;
+            }
+
+            if (isLast) {
+                attrSpec->ClearInfo(SdfFieldKeys->TimeSamples);
+            } else {
+                // Keep the last two samples: they hold the value at the start of the next
+                // window and the attribute is still seen as animated by the post export steps.
+                const auto keptBegin
+                    = samples.size() > 2 ? std::prev(samples.end(), 2) : samples.begin();
+                attrSpec->SetInfo(
+                    SdfFieldKeys->TimeSamples,
+                    VtValue(SdfTimeSampleMap(keptBegin, samples.end())));
+            }
+
+            // Without samples in this window, the clip only needs the held value when
+            // it differs from the manifest default, used for the attributes it lacks.
+            if (samples.rbegin()->first < startTime
+                && samples.rbegin()->second
+                    == _manifest->GetField(attrPath, SdfFieldKeys->Default)) {
+                continue;
+            }
+            clipSamples[attrPath] = std::move(samples);
+        }
+
+        for (auto& attrSamples : clipSamples) {
+            const SdfPath&         attrPath = attrSamples.first;
+            SdfAttributeSpecHandle manifestSpec = _manifest->GetAttributeAtPath(attrPath);
+            if (!SdfJustCreatePrimAttributeInLayer(
+                    clipLayer,
+                    attrPath,
+                    manifestSpec->GetTypeName(),
+                    manifestSpec->GetVariability(),
+                    manifestSpec->IsCustom())) {
+                continue;
+            }
+            clipLayer->SetField(
+                attrPath, SdfFieldKeys->TimeSamples, VtValue::Take(attrSamples.second));
+        }
+
+        if (!clipLayer->Save()) {
+            TF_RUNTIME_ERROR("Failed to save value clip layer '%s'", clipFileName.c_str());
+            return false;
+        }
+        _clipFileNames.push_back(clipFileName);
+
+        return true;
+    }
+
+    /// Erases the time samples of the attributes moved to the clips from the
+    /// session layer.
+    void _EraseKeptSamples()
+    {
+        const SdfLayerHandle sessionLayer = _stage->GetSessionLayer();
+        std::vector<SdfPath> attrPaths;
+        sessionLayer->Traverse(SdfPath::AbsoluteRootPath(), [this, &attrPaths](const SdfPath& path) {
+            if (path.IsPrimPropertyPath() && _manifest->GetAttributeAtPath(path)) {
+                attrPaths.push_back(path);
+            }
+        });
+        for (const SdfPath& attrPath : attrPaths) {
+            sessionLayer->EraseField(attrPath, SdfFieldKeys->TimeSamples);
+        }
+    }
+
+    /// Declares the attribute of \p attrSpec in the clip manifest. Its default
+    /// value is \p firstSample, the value held before the first time sample of
+    /// the attribute, which is used by the clips that do not hold the attribute.
+    bool _AddToManifest(const SdfAttributeSpecHandle& attrSpec, const VtValue& firstSample)
+    {
+        const SdfPath& attrPath = attrSpec->GetPath();
+        if (_manifest->GetAttributeAtPath(attrPath)) {
+            return true;
+        }
+
+        if (!SdfJustCreatePrimAttributeInLayer(
+                _manifest,
+                attrPath,
+                attrSpec->GetTypeName(),
+                attrSpec->GetVariability(),
+                attrSpec->IsCustom())) {
+            return false;
+        }
+
+        _manifest->SetField(attrPath, SdfFieldKeys->Default, firstSample);
+        return true;
+    }
+
+    UsdStageRefPtr           _stage;
+    const std::string        _baseName;
+    const size_t             _chunkSize;
+    size_t                   _numFrames = 0;
+    double                   _lastTime = 0.0;
+    SdfLayerRefPtr           _manifest;
+    std::vector<std::string> _clipFileNames;
+    std::vector<double>      _clipStartTimes;
+};
+
 UsdMaya_WriteJob::UsdMaya_WriteJob(const UsdMayaJobExportArgs& iArgs)
     : mJobCtx(iArgs)
     , _modelKindProcessor(new UsdMaya_ModelKindProcessor(iArgs))
@@ -165,28 +502,14 @@ bool UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
 
 bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
 {
-    MayaUsd::ProgressBarScope progressBar(8);
-
-    // Check for DAG nodes that are a child of an already specified DAG node to export
-    // if that's the case, report the issue and skip the export
-    UsdMayaUtil::MDagPathSet::const_iterator m, n;
-    UsdMayaUtil::MDagPathSet::const_iterator endPath = mJobCtx.mArgs.dagPaths.end();
-    for (m = mJobCtx.mArgs.dagPaths.begin(); m != endPath;) {
-        MDagPath path1 = *m;
-        m++;
-        for (n = m; n != endPath; n++) {
-            MDagPath path2 = *n;
-            if (UsdMayaUtil::isAncestorDescendentRelationship(path1, path2)) {
-                TF_RUNTIME_ERROR(
-                    "%s and %s are ancestors or descendants of each other. "
-                    "Please specify export DAG paths that don't overlap. "
-                    "Exiting.",
-                    path1.fullPathName().asChar(),
-                    path2.fullPathName().asChar());
-                return false;
-            }
-        } // for n
-    }     // for m
+    MayaUsd::ProgressBarScope progressBar(7);
+
+    // Index the DAG paths to export in a trie. This detects DAG paths that are a child
+    // of an already specified DAG path, in which case the issue is reported and the export
+    // is skipped. It also restricts the DAG traversal below to the exported subtrees.
+    if (!_BuildSelectionTrie()) {
+        return false;
+    }
     progressBar.advance();
 
     // Make sure the file name is a valid one with a proper USD extension.
@@ -293,122 +616,17 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
     }
     progressBar.advance();
 
-    // Pre-process the argument dagPath path names into two sets. One set
-    // contains just the arg dagPaths, and the other contains all parents of
-    // arg dagPaths all the way up to the world root. Partial path names are
-    // enough because Maya guarantees them to still be unique, and they require
-    // less work to hash and compare than full path names.
-    TfHashSet<std::string, TfHash>           argDagPaths;
-    TfHashSet<std::string, TfHash>           argDagPathParents;
-    UsdMayaUtil::MDagPathSet::const_iterator end = mJobCtx.mArgs.dagPaths.end();
-    for (UsdMayaUtil::MDagPathSet::const_iterator it = mJobCtx.mArgs.dagPaths.begin(); it != end;
-         ++it) {
-        MDagPath curDagPath = *it;
-        MStatus  status;
-        bool     curDagPathIsValid = curDagPath.isValid(&status);
-        if (status != MS::kSuccess || !curDagPathIsValid) {
-            continue;
-        }
-
-        std::string curDagPathStr(curDagPath.partialPathName(&status).asChar());
-        if (status != MS::kSuccess) {
-            continue;
-        }
-
-        argDagPaths.insert(curDagPathStr);
-
-        status = curDagPath.pop();
-        if (status != MS::kSuccess) {
-            continue;
-        }
-        curDagPathIsValid = curDagPath.isValid(&status);
-
-        while (status == MS::kSuccess && curDagPathIsValid) {
-            curDagPathStr = curDagPath.partialPathName(&status).asChar();
-            if (status != MS::kSuccess) {
-                break;
-            }
-
-            if (argDagPathParents.find(curDagPathStr) != argDagPathParents.end()) {
-                // We've already traversed up from this path.
-                break;
-            }
-            argDagPathParents.insert(curDagPathStr);
-
-            status = curDagPath.pop();
-            if (status != MS::kSuccess) {
-                break;
-            }
-            curDagPathIsValid = curDagPath.isValid(&status);
-        }
-    }
-    progressBar.advance();
-
-    // We are entering a loop here, so count the number of dag objects
-    // so we can have a better progress bar status.
-    // Note: Maya does the same thing during its write.
-    uint32_t numberDagObjects { 0 };
+    // Now do a depth-first traversal of the Maya DAG from the world root, only
+    // visiting the arg dagPaths, their ancestors and their descendants.
     {
-        for (MItDag itDag(MItDag::kDepthFirst, MFn::kInvalid); !itDag.isDone(); itDag.next()) {
-            ++numberDagObjects;
-        }
-    }
-
-    // Now do a depth-first traversal of the Maya DAG from the world root.
-    // We keep a reference to arg dagPaths as we encounter them.
-    MayaUsd::ProgressBarLoopScope dagObjLoop(numberDagObjects);
-    MDagPath                      curLeafDagPath;
-    for (MItDag itDag(MItDag::kDepthFirst, MFn::kInvalid); !itDag.isDone(); itDag.next()) {
-        MDagPath curDagPath;
-        itDag.getPath(curDagPath);
-        std::string curDagPathStr(curDagPath.partialPathName().asChar());
-
-        if (argDagPathParents.find(curDagPathStr) != argDagPathParents.end()) {
-            // This dagPath is a parent of one of the arg dagPaths. It should
-            // be included in the export, but not necessarily all of its
-            // children should be, so we continue to traverse down.
-        } else if (argDagPaths.find(curDagPathStr) != argDagPaths.end()) {
-            // This dagPath IS one of the arg dagPaths. It AND all of its
-            // children should be included in the export.
-            curLeafDagPath = curDagPath;
-        } else if (!MFnDagNode(curDagPath).hasParent(curLeafDagPath.node())) {
-            // This dagPath is not a child of one of the arg dagPaths, so prune
-            // it and everything below it from the traversal.
-            itDag.prune();
-            continue;
-        }
-
-        if (!mJobCtx._NeedToTraverse(curDagPath) && curDagPath.length() > 0) {
-            // This dagPath and all of its children should be pruned.
-            itDag.prune();
-        } else {
-            const MFnDagNode           dagNodeFn(curDagPath);
-            UsdMayaPrimWriterSharedPtr primWriter = mJobCtx.CreatePrimWriter(dagNodeFn);
-
-            if (primWriter) {
-                mJobCtx.mMayaPrimWriterList.push_back(primWriter);
-
-                // Write out data (non-animated/default values).
-                if (const auto& usdPrim = primWriter->GetUsdPrim()) {
-                    if (!_CheckNameClashes(usdPrim.GetPath(), primWriter->GetDagPath())) {
-                        return false;
-                    }
-
-                    primWriter->Write(UsdTimeCode::Default());
-
-                    const UsdMayaUtil::MDagPathMap<SdfPath>& mapping
-                        = primWriter->GetDagToUsdPathMapping();
-                    mDagPathToUsdPathMap.insert(mapping.begin(), mapping.end());
-
-                    _modelKindProcessor->OnWritePrim(usdPrim, primWriter);
-                }
-
-                if (primWriter->ShouldPruneChildren()) {
-                    itDag.prune();
-                }
-            }
+        MayaUsd::ProgressBarLoopScope dagObjLoop(mJobCtx.mArgs.dagPaths.size());
+        MDagPath                      worldDagPath;
+        MDagPath::getAPathTo(MItDag().root(), worldDagPath);
+        const _SelectionTrieNodePtr worldNode
+            = (*_selectionTrie.root())[Ufe::PathComponent(kWorldComponent)];
+        if (!_TraverseSelectionAncestor(worldDagPath, worldNode, dagObjLoop)) {
+            return false;
         }
-        dagObjLoop.loopAdvance();
     }
 
     if (!mJobCtx.mArgs.rootMapFunction.IsNull()) {
@@ -461,6 +679,164 @@ bool UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         chasersLoop.loopAdvance();
     }
 
+    if (mJobCtx.mArgs.parallelFrameWrite && !mJobCtx.mArgs.timeSamples.empty()) {
+        _framePipeline.reset(new _FramePipeline(mJobCtx.mMayaPrimWriterList));
+    }
+
+    if (mJobCtx.mArgs.timeSampleChunkSize > 0 && !mJobCtx.mArgs.timeSamples.empty()) {
+        if (append || !_packageName.empty()) {
+            TF_WARN(
+                "Time samples are not flushed to value clips when appending to a layer or "
+                "packaging a usdz file.");
+        } else {
+            _valueClipWriter.reset(new _ValueClipWriter(
+                mJobCtx.mStage, _fileName, mJobCtx.mArgs.timeSampleChunkSize));
+        }
+    }
+
+    return true;
+}
+
+bool UsdMaya_WriteJob::_BuildSelectionTrie()
+{
+    _selectionTrie.clear();
+
+    // The DAG paths are sorted by path count, then by full path name. A full path name
+    // sorts before the names it prefixes and a descendant never has fewer path segments
+    // than its ancestor, so ancestors are always added to the trie before their
+    // descendants and a single ancestor lookup detects any overlap.
+    for (const MDagPath& dagPath : mJobCtx.mArgs.dagPaths) {
+        MStatus status;
+        if (!dagPath.isValid(&status) || status != MS::kSuccess) {
+            continue;
+        }
+
+        const Ufe::Path ufePath = MayaUsd::ufe::dagPathToUfe(dagPath);
+        if (_selectionTrie.containsAncestor(ufePath) || _selectionTrie.contains(ufePath)) {
+            // Only look for the offending ancestor in the error case.
+            MDagPath ancestor = dagPath;
+            while (ancestor.length() > 0 && ancestor.pop() == MS::kSuccess) {
+                if (_selectionTrie.contains(MayaUsd::ufe::dagPathToUfe(ancestor))) {
+                    break;
+                }
+            }
+            TF_RUNTIME_ERROR(
+                "%s and %s are ancestors or descendants of each other. "
+                "Please specify export DAG paths that don't overlap. "
+                "Exiting.",
+                ancestor.fullPathName().asChar(),
+                dagPath.fullPathName().asChar());
+            return false;
+        }
+
+        _selectionTrie.add(ufePath, dagPath);
+    }
+
+    return true;
+}
+
+bool UsdMaya_WriteJob::_TraverseSelectionAncestor(
+    const MDagPath&                dagPath,
+    const _SelectionTrieNodePtr&   node,
+    MayaUsd::ProgressBarLoopScope& progressLoop)
+{
+    if (!node) {
+        return true;
+    }
+
+    if (node->hasData()) {
+        // This dagPath IS one of the arg dagPaths. It AND all of its
+        // children should be included in the export.
+        if (!_TraverseSelectedSubtree(dagPath)) {
+            return false;
+        }
+        progressLoop.loopAdvance();
+        return true;
+    }
+
+    // This dagPath is a parent of one of the arg dagPaths. It should be
+    // included in the export, but only the children leading to arg dagPaths
+    // are traversed. Children are visited in DAG order to keep the export order.
+    bool prune = false;
+    if (!_WriteDagPath(dagPath, &prune)) {
+        return false;
+    }
+    if (prune) {
+        return true;
+    }
+
+    const MFnDagNode   dagNodeFn(dagPath);
+    const unsigned int childCount = dagNodeFn.childCount();
+    for (unsigned int i = 0; i < childCount; ++i) {
+        const MObject               child = dagNodeFn.child(i);
+        const _SelectionTrieNodePtr childNode
+            = (*node)[Ufe::PathComponent(MFnDependencyNode(child).name().asChar())];
+        if (!childNode) {
+            // This child is not an ancestor of one of the arg dagPaths: prune it.
+            continue;
+        }
+
+        MDagPath childDagPath = dagPath;
+        childDagPath.push(child);
+        if (!_TraverseSelectionAncestor(childDagPath, childNode, progressLoop)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool UsdMaya_WriteJob::_TraverseSelectedSubtree(const MDagPath& rootDagPath)
+{
+    MItDag itDag(MItDag::kDepthFirst, MFn::kInvalid);
+    itDag.reset(rootDagPath, MItDag::kDepthFirst, MFn::kInvalid);
+    for (; !itDag.isDone(); itDag.next()) {
+        MDagPath curDagPath;
+        itDag.getPath(curDagPath);
+
+        bool prune = false;
+        if (!_WriteDagPath(curDagPath, &prune)) {
+            return false;
+        }
+        if (prune) {
+            itDag.prune();
+        }
+    }
+
+    return true;
+}
+
+bool UsdMaya_WriteJob::_WriteDagPath(const MDagPath& curDagPath, bool* prune)
+{
+    if (!mJobCtx._NeedToTraverse(curDagPath) && curDagPath.length() > 0) {
+        // This dagPath and all of its children should be pruned.
+        *prune = true;
+        return true;
+    }
+
+    const MFnDagNode           dagNodeFn(curDagPath);
+    UsdMayaPrimWriterSharedPtr primWriter = mJobCtx.CreatePrimWriter(dagNodeFn);
+    if (!primWriter) {
+        return true;
+    }
+
+    mJobCtx.mMayaPrimWriterList.push_back(primWriter);
+
+    // Write out data (non-animated/default values).
+    if (const auto& usdPrim = primWriter->GetUsdPrim()) {
+        if (!_CheckNameClashes(usdPrim.GetPath(), primWriter->GetDagPath())) {
+            return false;
+        }
+
+        primWriter->Write(UsdTimeCode::Default());
+
+        const UsdMayaUtil::MDagPathMap<SdfPath>& mapping = primWriter->GetDagToUsdPathMapping();
+        mDagPathToUsdPathMap.insert(mapping.begin(), mapping.end());
+
+        _modelKindProcessor->OnWritePrim(usdPrim, primWriter);
+    }
+
+    *prune = primWriter->ShouldPruneChildren();
     return true;
 }
 
@@ -475,6 +851,19 @@ bool UsdMaya_WriteJob::_WriteFrame(double iFrame)
         }
     }
 
+    if (_framePipeline) {
+        // The previous frame was compared while Maya evaluated this one: author
+        // its samples before starting to compare this frame.
+        _framePipeline->Finish();
+        _framePipeline->Start();
+
+        // Chasers and per-frame callbacks may read this frame back from the stage.
+        if (!mChasers.empty() || !mJobCtx.mArgs.melPerFrameCallback.empty()
+            || !mJobCtx.mArgs.pythonPerFrameCallback.empty()) {
+            _framePipeline->Finish();
+        }
+    }
+
     for (UsdMayaExportChaserRefPtr& chaser : mChasers) {
         if (!chaser->ExportFrame(iFrame)) {
             return false;
@@ -483,6 +872,19 @@ bool UsdMaya_WriteJob::_WriteFrame(double iFrame)
 
     _PerFrameCallback(iFrame);
 
+    // The last window is only flushed once the post export steps ran.
+    if (_valueClipWriter && _valueClipWriter->AddFrame(iFrame)
+        && iFrame != mJobCtx.mArgs.timeSamples.back()) {
+        // The frame window is complete: author its pending samples before moving
+        // them to a value clip layer on disk.
+        if (_framePipeline) {
+            _framePipeline->Finish();
+        }
+        if (!_valueClipWriter->Flush()) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -490,6 +892,24 @@ bool UsdMaya_WriteJob::_FinishWriting()
 {
     MayaUsd::ProgressBarScope progressBar(6);
 
+    // Author the samples of the last exported frame.
+    if (_framePipeline) {
+        _framePipeline->Finish();
+        _framePipeline.reset();
+    }
+
+    if (mJobCtx.mArgs.verbose && !mJobCtx.mArgs.timeSamples.empty()) {
+        size_t numWrittenSamples = 0;
+        size_t numSkippedSamples = 0;
+        for (const UsdMayaPrimWriterSharedPtr& primWriter : mJobCtx.mMayaPrimWriterList) {
+            const FlexibleSparseValueWriter& valueWriter = primWriter->GetSparseValueWriter();
+            numWrittenSamples += valueWriter.GetNumWrittenSamples();
+            numSkippedSamples += valueWriter.GetNumSkippedSamples();
+        }
+        TF_STATUS(
+            "Sparse time samples: %zu written, %zu skipped", numWrittenSamples, numSkippedSamples);
+    }
+
     UsdPrimSiblingRange usdRootPrims = mJobCtx.mStage->GetPseudoRoot().GetChildren();
 
     // Write Variants (to first root prim path)
@@ -580,6 +1000,17 @@ bool UsdMaya_WriteJob::_FinishWriting()
         chasersLoop.loopAdvance();
     }
 
+    // Flush the samples of the last frame window and reference all the value clips.
+    // This comes after the post export steps and the chasers since they may edit the
+    // samples of the last window, or make single samples static.
+    if (_valueClipWriter) {
+        const bool clipsWritten = _valueClipWriter->Finish();
+        _valueClipWriter.reset();
+        if (!clipsWritten) {
+            return false;
+        }
+    }
+
     _PostCallback();
     progressBar.advance();
 
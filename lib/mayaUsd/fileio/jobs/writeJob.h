@@ -19,6 +19,7 @@
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/fileio/chaser/exportChaser.h>
 #include <mayaUsd/fileio/writeJobContext.h>
+#include <mayaUsd/utils/progressBarScope.h>
 #include <mayaUsd/utils/util.h>
 
 #include <pxr/base/tf/hashmap.h>
@@ -26,6 +27,9 @@
 
 #include <maya/MObjectHandle.h>
 
+#include <ufe/trie.h>
+
+#include <memory>
 #include <string>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -81,6 +85,27 @@ private:
 
     bool _CheckNameClashes(const SdfPath& path, const MDagPath& dagPath);
 
+    /// Builds the trie of the DAG paths to export. Returns \c false if two
+    /// of these DAG paths are ancestors or descendants of each other.
+    bool _BuildSelectionTrie();
+
+    using _SelectionTrie = Ufe::Trie<MDagPath>;
+    using _SelectionTrieNodePtr = Ufe::TrieNode<MDagPath>::Ptr;
+
+    /// Writes \p dagPath, an ancestor of the DAG paths to export or one of
+    /// them, then only traverses the children leading to the DAG paths to export.
+    bool _TraverseSelectionAncestor(
+        const MDagPath&                dagPath,
+        const _SelectionTrieNodePtr&   node,
+        MayaUsd::ProgressBarLoopScope& progressLoop);
+
+    /// Writes \p rootDagPath, one of the DAG paths to export, and all of its descendants.
+    bool _TraverseSelectedSubtree(const MDagPath& rootDagPath);
+
+    /// Creates the prim writer of \p curDagPath and writes its default-time values.
+    /// Sets \p prune if the children of \p curDagPath must not be traversed.
+    bool _WriteDagPath(const MDagPath& curDagPath, bool* prune);
+
     // Name of the created/appended USD file
     std::string _fileName;
 
@@ -100,9 +125,23 @@ private:
 
     UsdMayaExportChaserRefPtrVector mChasers;
 
+    // Trie of the UFE paths of the DAG paths to export, holding their MDagPath.
+    _SelectionTrie _selectionTrie;
+
     UsdMayaWriteJobContext mJobCtx;
 
     std::unique_ptr<UsdMaya_ModelKindProcessor> _modelKindProcessor;
+
+    // Compares the staged time samples of a frame on worker threads while Maya
+    // evaluates the next frame. Only created when exporting with parallelFrameWrite.
+    // Declared last so that it is destroyed before the prim writers it uses.
+    class _FramePipeline;
+    std::unique_ptr<_FramePipeline> _framePipeline;
+
+    // Moves the time samples of each completed frame window to a value clip layer
+    // on disk. Only created when exporting with timeSampleChunkSize.
+    class _ValueClipWriter;
+    std::unique_ptr<_ValueClipWriter> _valueClipWriter;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
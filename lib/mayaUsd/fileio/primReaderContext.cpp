@@ -15,6 +15,8 @@
 //
 #include "primReaderContext.h"
 
+#include <mayaUsd/fileio/utils/primDataPrefetch.h>
+
 #include <pxr/base/tf/diagnostic.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -22,6 +24,7 @@ PXR_NAMESPACE_OPEN_SCOPE
 UsdMayaPrimReaderContext::UsdMayaPrimReaderContext(ObjectRegistry* pathNodeMap)
     : _prune(false)
     , _timeSampleMultiplier(1.0)
+    , _prefetch(nullptr)
     , _pathNodeMap(pathNodeMap)
 {
 }
@@ -95,4 +98,15 @@ void UsdMayaPrimReaderContext::SetTimeSampleMultiplier(double multiplier)
     _timeSampleMultiplier = multiplier;
 };
 
+void UsdMayaPrimReaderContext::SetPrimDataPrefetch(const UsdMayaPrimDataPrefetch* prefetch)
+{
+    _prefetch = prefetch;
+}
+
+const UsdMayaMeshReadData*
+UsdMayaPrimReaderContext::GetPrefetchedMeshData(const SdfPath& path) const
+{
+    return _prefetch ? _prefetch->GetMeshData(path) : nullptr;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -25,6 +25,9 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+class UsdMayaPrimDataPrefetch;
+struct UsdMayaMeshReadData;
+
 /// \class UsdMayaPrimReaderContext
 /// \brief This class provides an interface for reader plugins to communicate
 /// state back to the core usd maya logic as well as retrieve information set by
@@ -94,12 +97,24 @@ public:
     MAYAUSD_CORE_PUBLIC
     void SetTimeSampleMultiplier(double multiplier);
 
+    /// \brief Set the USD data read ahead of the prim readers, if any.
+    MAYAUSD_CORE_PUBLIC
+    void SetPrimDataPrefetch(const UsdMayaPrimDataPrefetch* prefetch);
+
+    /// \brief Return the mesh data read ahead for the prim at \p path, or
+    /// nullptr if it was not read ahead.
+    MAYAUSD_CORE_PUBLIC
+    const UsdMayaMeshReadData* GetPrefetchedMeshData(const SdfPath& path) const;
+
     ~UsdMayaPrimReaderContext() { }
 
 private:
     bool   _prune;
     double _timeSampleMultiplier;
 
+    // Not owned.
+    const UsdMayaPrimDataPrefetch* _prefetch;
+
     // used to keep track of prims that are created.
     // for undo/redo
     ObjectRegistry* _pathNodeMap;
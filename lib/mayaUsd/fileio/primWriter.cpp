@@ -258,6 +258,8 @@ const UsdMayaJobExportArgs& UsdMayaPrimWriter::_GetExportArgs() const
 
 FlexibleSparseValueWriter* UsdMayaPrimWriter::_GetSparseValueWriter() { return &_valueWriter; }
 
+FlexibleSparseValueWriter& UsdMayaPrimWriter::GetSparseValueWriter() { return _valueWriter; }
+
 void UsdMayaPrimWriter::MakeSingleSamplesStatic()
 {
     auto exportArgs = _GetExportArgs();
@@ -186,6 +186,11 @@ public:
     MAYAUSD_CORE_PUBLIC
     void MakeSingleSamplesStatic(UsdAttribute attr);
 
+    /// The attribute value-writer used by this prim writer. The write job uses
+    /// it to stage time samples when frames are exported in parallel.
+    MAYAUSD_CORE_PUBLIC
+    FlexibleSparseValueWriter& GetSparseValueWriter();
+
 protected:
     /// Helper function for determining whether the current node has input
     /// animation curves.
@@ -60,17 +60,23 @@ void UsdMayaTransformWriter::_AnimChannel::setXformOp(
         return;
     }
 
-    VtValue vtValue;
+    // Matrices go through the typed fast path of the sparse value writer.
     if (isMatrix) {
-        vtValue = matrix;
-    } else if (opType == _XformType::Shear) {
+        GfMatrix4d matrixValue(matrix);
+        valueWriter->SetAttribute(op.GetAttr(), matrixValue, usdTime);
+        return;
+    }
+    if (opType == _XformType::Shear) {
         GfMatrix4d shearXForm(1.0);
         shearXForm[1][0] = value[0]; // xyVal
         shearXForm[2][0] = value[1]; // xzVal
         shearXForm[2][1] = value[2]; // yzVal
-        vtValue = shearXForm;
-    } else if (
-        UsdGeomXformOp::GetPrecisionFromValueTypeName(op.GetAttr().GetTypeName())
+        valueWriter->SetAttribute(op.GetAttr(), shearXForm, usdTime);
+        return;
+    }
+
+    VtValue vtValue;
+    if (UsdGeomXformOp::GetPrecisionFromValueTypeName(op.GetAttr().GetTypeName())
         == UsdGeomXformOp::PrecisionDouble) {
         vtValue = VtValue(value);
     } else { // float precision
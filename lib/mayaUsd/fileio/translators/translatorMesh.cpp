@@ -67,11 +67,19 @@ TranslatorMeshRead::TranslatorMeshRead(
     // ==============================================
     // construct a Maya mesh
     // ==============================================
-    VtIntArray faceVertexCounts;
-    VtIntArray faceVertexIndices;
+    // Use the data read ahead by the import job, if any.
+    UsdMayaMeshReadData        readData;
+    const UsdMayaMeshReadData* meshData
+        = context ? context->GetPrefetchedMeshData(prim.GetPath()) : nullptr;
+    if (!meshData || meshData->frameRange != frameRange) {
+        UsdMayaMeshReadUtils::readMeshData(mesh, frameRange, &readData);
+        meshData = &readData;
+    }
+
+    const VtIntArray& faceVertexCounts = meshData->faceVertexCounts;
+    const VtIntArray& faceVertexIndices = meshData->faceVertexIndices;
 
-    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-    if (fvc.ValueMightBeTimeVarying()) {
+    if (meshData->faceVertexCountsVarying) {
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
         TF_RUNTIME_ERROR(
@@ -79,12 +87,9 @@ TranslatorMeshRead::TranslatorMeshRead(
             "faceVertexCounts), which isn't currently supported. "
             "Skipping...",
             prim.GetPath().GetText());
-    } else {
-        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
     }
 
-    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
-    if (fvi.ValueMightBeTimeVarying()) {
+    if (meshData->faceVertexIndicesVarying) {
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
         TF_RUNTIME_ERROR(
@@ -92,8 +97,6 @@ TranslatorMeshRead::TranslatorMeshRead(
             "faceVertexIndices), which isn't currently supported. "
             "Skipping...",
             prim.GetPath().GetText());
-    } else {
-        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
     }
 
     // Sanity Checks. If the vertex arrays are empty, skip this mesh
@@ -106,54 +109,14 @@ TranslatorMeshRead::TranslatorMeshRead(
             prim.GetPath().GetText());
     }
 
-    // If the USD mesh was left-handed, then the faces had their vertices in left-handed order.
-    // Fix them to be in right-handed order, as expected by Maya.
-    if (isPrimitiveLeftHanded(mesh)) {
-        size_t firstIndex = 0;
-        for (int vertexCount : faceVertexCounts) {
-            std::reverse(
-                faceVertexIndices.begin() + firstIndex,
-                faceVertexIndices.begin() + firstIndex + vertexCount);
-            firstIndex += vertexCount;
-        }
-    }
-
     // Gather points and normals
-    // If timeInterval is non-empty, pick the first available sample in the
-    // timeInterval or default.
-    VtVec3fArray        points;
-    VtVec3fArray        normals;
-    TfToken             normalsInterpolation;
-    UsdTimeCode         pointsTimeSample = UsdTimeCode::EarliestTime();
-    UsdTimeCode         normalsTimeSample = UsdTimeCode::EarliestTime();
-    std::vector<double> pointsTimeSamples;
-
-    if (!frameRange.IsEmpty()) {
-        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange, &pointsTimeSamples);
-        if (!pointsTimeSamples.empty()) {
-            m_pointsNumTimeSamples = pointsTimeSamples.size();
-            pointsTimeSample = pointsTimeSamples.front();
-        }
-
-        std::vector<double> normalsTimeSamples;
-        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange, &normalsTimeSamples);
-        if (!normalsTimeSamples.empty()) {
-            normalsTimeSample = normalsTimeSamples.front();
-        }
-    }
-
-    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
-
-    /* If 'normals' and 'primvars:normals' are both specified, the latter has precedence. */
-    UsdGeomPrimvar primvar = UsdGeomPrimvarsAPI(mesh).GetPrimvar(UsdGeomTokens->normals);
-
-    if (primvar.HasValue()) {
-        primvar.ComputeFlattened(&normals, normalsTimeSample);
-        normalsInterpolation = primvar.GetInterpolation();
-    } else {
-        mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
-        normalsInterpolation = mesh.GetNormalsInterpolation();
-    }
+    // If timeInterval is non-empty, the first available sample in the
+    // timeInterval or default was picked.
+    VtVec3fArray               points = meshData->points;
+    VtVec3fArray               normals = meshData->normals;
+    const TfToken&             normalsInterpolation = meshData->normalsInterpolation;
+    const std::vector<double>& pointsTimeSamples = meshData->pointsTimeSamples;
+    m_pointsNumTimeSamples = pointsTimeSamples.size();
 
     if (points.empty()) {
         TF_RUNTIME_ERROR(
@@ -365,16 +328,6 @@ TranslatorMeshRead::TranslatorMeshRead(
     *status = stat;
 }
 
-bool TranslatorMeshRead::isPrimitiveLeftHanded(const UsdGeomGprim& prim)
-{
-    TfToken orientation;
-    if (!prim.GetOrientationAttr().Get(&orientation)) {
-        return false;
-    }
-
-    return orientation == UsdGeomTokens->leftHanded;
-}
-
 MStatus TranslatorMeshRead::setPointBasedDeformerForMayaNode(
     const MObject& mayaObj,
     const MObject& stageNode,
@@ -57,6 +57,8 @@
 #include <maya/MStatus.h>
 #include <maya/MUintArray.h>
 
+#include <algorithm>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 TF_DEFINE_PUBLIC_TOKENS(UsdMayaMeshPrimvarTokens, PXRUSDMAYA_MESH_PRIMVAR_TOKENS);
@@ -720,6 +722,70 @@ void UsdMayaMeshReadUtils::assignInvisibleFaces(const UsdGeomMesh& mesh, const M
     }
 }
 
+void UsdMayaMeshReadUtils::readMeshData(
+    const UsdGeomMesh&   mesh,
+    const GfInterval&    frameRange,
+    UsdMayaMeshReadData* data)
+{
+    data->frameRange = frameRange;
+
+    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
+    data->faceVertexCountsVarying = fvc.ValueMightBeTimeVarying();
+    if (!data->faceVertexCountsVarying) {
+        fvc.Get(&data->faceVertexCounts, UsdTimeCode::EarliestTime());
+    }
+
+    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+    data->faceVertexIndicesVarying = fvi.ValueMightBeTimeVarying();
+    if (!data->faceVertexIndicesVarying) {
+        fvi.Get(&data->faceVertexIndices, UsdTimeCode::EarliestTime());
+    }
+
+    TfToken orientation;
+    if (mesh.GetOrientationAttr().Get(&orientation) && orientation == UsdGeomTokens->leftHanded) {
+        size_t firstIndex = 0;
+        for (int vertexCount : data->faceVertexCounts) {
+            if (firstIndex + vertexCount > data->faceVertexIndices.size()) {
+                break;
+            }
+            std::reverse(
+                data->faceVertexIndices.begin() + firstIndex,
+                data->faceVertexIndices.begin() + firstIndex + vertexCount);
+            firstIndex += vertexCount;
+        }
+    }
+
+    UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
+    UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
+    data->pointsTimeSamples.clear();
+
+    if (!frameRange.IsEmpty()) {
+        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange, &data->pointsTimeSamples);
+        if (!data->pointsTimeSamples.empty()) {
+            pointsTimeSample = data->pointsTimeSamples.front();
+        }
+
+        std::vector<double> normalsTimeSamples;
+        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange, &normalsTimeSamples);
+        if (!normalsTimeSamples.empty()) {
+            normalsTimeSample = normalsTimeSamples.front();
+        }
+    }
+
+    mesh.GetPointsAttr().Get(&data->points, pointsTimeSample);
+
+    /* If 'normals' and 'primvars:normals' are both specified, the latter has precedence. */
+    UsdGeomPrimvar primvar = UsdGeomPrimvarsAPI(mesh).GetPrimvar(UsdGeomTokens->normals);
+
+    if (primvar.HasValue()) {
+        primvar.ComputeFlattened(&data->normals, normalsTimeSample);
+        data->normalsInterpolation = primvar.GetInterpolation();
+    } else {
+        mesh.GetNormalsAttr().Get(&data->normals, normalsTimeSample);
+        data->normalsInterpolation = mesh.GetNormalsInterpolation();
+    }
+}
+
 MStatus UsdMayaMeshReadUtils::assignSubDivTagsToMesh(
     const UsdGeomMesh& mesh,
     MObject&           meshObj,
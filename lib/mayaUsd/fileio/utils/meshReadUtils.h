@@ -20,6 +20,7 @@
 
 #include <mayaUsd/base/api.h>
 
+#include <pxr/base/gf/interval.h>
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/tf/staticTokens.h>
 #include <pxr/base/tf/token.h>
@@ -65,8 +66,36 @@ TF_DECLARE_PUBLIC_TOKENS(
     MAYAUSD_CORE_PUBLIC,
     PXRUSDMAYA_GEOMSUBSET_TOKENS);
 
+/// The USD data needed to create a Maya mesh, read ahead of its creation.
+struct UsdMayaMeshReadData
+{
+    /// The frame range used to select the points and normals time samples.
+    GfInterval frameRange;
+
+    VtIntArray          faceVertexCounts;
+    VtIntArray          faceVertexIndices;
+    VtVec3fArray        points;
+    VtVec3fArray        normals;
+    TfToken             normalsInterpolation;
+    std::vector<double> pointsTimeSamples;
+
+    /// The topology is not read when it is animated.
+    bool faceVertexCountsVarying { false };
+    bool faceVertexIndicesVarying { false };
+};
+
 /// Utilities for dealing with USD and RenderMan for Maya mesh/subdiv tags.
 namespace UsdMayaMeshReadUtils {
+/// Reads the topology, points and normals of \p mesh into \p data. The
+/// first time samples of the points and normals within \p frameRange are
+/// used, if any. The face vertex indices of left-handed meshes are reversed to
+/// be in right-handed order, as expected by Maya.
+///
+/// Only reads from the USD stage, without reporting errors, so that it can be
+/// called from worker threads.
+MAYAUSD_CORE_PUBLIC
+void readMeshData(const UsdGeomMesh& mesh, const GfInterval& frameRange, UsdMayaMeshReadData* data);
+
 /// Gets the internal emit-normals tag on the Maya \p mesh, placing it in
 /// \p value. Returns true if the tag exists on the mesh, and false if not.
 MAYAUSD_CORE_PUBLIC
@@ -0,0 +1,175 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "primDataPrefetch.h"
+
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/trace/trace.h>
+#include <pxr/usd/usdGeom/mesh.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE,
+    1024,
+    "Number of prims whose USD data is read ahead at a time on worker threads "
+    "during imports. Set to 0 to read the data from the prim readers instead.");
+
+UsdMayaPrimDataPrefetch::UsdMayaPrimDataPrefetch(const GfInterval& frameRange, size_t batchSize)
+    : _frameRange(frameRange)
+    , _batchSize(batchSize)
+    , _launchedBatches(0)
+    , _currentIndex(0)
+    , _currentBatch(0)
+    , _hasCurrent(false)
+{
+}
+
+UsdMayaPrimDataPrefetch::~UsdMayaPrimDataPrefetch()
+{
+    // The prims that were not read yet are not needed anymore.
+    for (auto& tasks : _batchTasks) {
+        if (tasks) {
+            tasks->cancel();
+            tasks->wait();
+        }
+    }
+}
+
+/* static */
+size_t UsdMayaPrimDataPrefetch::GetDefaultBatchSize()
+{
+    static const int batchSize = TfGetEnvSetting(MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE);
+    return static_cast<size_t>(std::max(batchSize, 0));
+}
+
+void UsdMayaPrimDataPrefetch::Start(std::vector<UsdPrim>&& prims)
+{
+    if (_batchSize == 0 || !_prims.empty()) {
+        return;
+    }
+
+    _prims = std::move(prims);
+    _meshData.resize(_prims.size());
+    _batchTasks.resize((_prims.size() + _batchSize - 1) / _batchSize);
+    _LaunchBatch(0);
+}
+
+void UsdMayaPrimDataPrefetch::Advance(const UsdPrim& prim)
+{
+    if (_prims.empty()) {
+        return;
+    }
+
+    // The prims are visited in order, but the prim readers may skip the
+    // descendants of a prim.
+    size_t index = _currentIndex;
+    while (index < _prims.size() && _prims[index] != prim) {
+        ++index;
+    }
+    if (index == _prims.size()) {
+        _hasCurrent = false;
+        return;
+    }
+
+    const size_t batch = index / _batchSize;
+    if (batch != _currentBatch || _batchTasks[batch]) {
+        _WaitForBatch(batch);
+        for (size_t previous = _currentBatch; previous < batch; ++previous) {
+            _ReleaseBatch(previous);
+        }
+
+        // Read the next batch while the prim readers consume this one.
+        _LaunchBatch(batch + 1);
+        _currentBatch = batch;
+    }
+
+    _currentIndex = index;
+    _hasCurrent = true;
+}
+
+const UsdMayaMeshReadData* UsdMayaPrimDataPrefetch::GetMeshData(const SdfPath& path) const
+{
+    if (!_hasCurrent || _prims[_currentIndex].GetPath() != path) {
+        return nullptr;
+    }
+
+    return _meshData[_currentIndex].get();
+}
+
+void UsdMayaPrimDataPrefetch::_LaunchBatch(size_t batch)
+{
+    // Batches are launched in order, so all the batches up to this one are
+    // launched as well.
+    while (_launchedBatches <= batch && _launchedBatches < _batchTasks.size()) {
+        const size_t begin = _launchedBatches * _batchSize;
+        const size_t end = std::min(begin + _batchSize, _prims.size());
+
+        auto tasks = std::make_unique<tbb::task_group>();
+        tasks->run([this, begin, end]() {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(begin, end),
+                [this](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i) {
+                        _ReadPrim(i);
+                    }
+                });
+        });
+        _batchTasks[_launchedBatches++] = std::move(tasks);
+    }
+}
+
+void UsdMayaPrimDataPrefetch::_WaitForBatch(size_t batch)
+{
+    TRACE_FUNCTION();
+
+    _LaunchBatch(batch);
+    if (batch < _batchTasks.size() && _batchTasks[batch]) {
+        _batchTasks[batch]->wait();
+        _batchTasks[batch].reset();
+    }
+}
+
+void UsdMayaPrimDataPrefetch::_ReleaseBatch(size_t batch)
+{
+    const size_t begin = batch * _batchSize;
+    const size_t end = std::min(begin + _batchSize, _prims.size());
+
+    // Skipped batches may still be read: they must be done before releasing
+    // their data.
+    _WaitForBatch(batch);
+    for (size_t i = begin; i < end; ++i) {
+        _meshData[i].reset();
+    }
+}
+
+void UsdMayaPrimDataPrefetch::_ReadPrim(size_t index)
+{
+    const UsdPrim& prim = _prims[index];
+    if (!prim.IsA<UsdGeomMesh>()) {
+        return;
+    }
+
+    auto data = std::make_unique<UsdMayaMeshReadData>();
+    UsdMayaMeshReadUtils::readMeshData(UsdGeomMesh(prim), _frameRange, data.get());
+    _meshData[index] = std::move(data);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,107 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PRIM_DATA_PREFETCH_H
+#define PXRUSDMAYA_PRIM_DATA_PREFETCH_H
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/fileio/utils/meshReadUtils.h>
+
+#include <pxr/base/gf/interval.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+
+#include <tbb/task_group.h>
+
+#include <memory>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \class UsdMayaPrimDataPrefetch
+/// \brief Reads the USD data of the prims of an import ahead of the prim
+/// readers.
+///
+/// The prims are split in batches, in traversal order. Each batch is read in
+/// parallel on worker threads while the prim readers of the previous batch
+/// create the Maya nodes on the main thread, so that the prim readers only
+/// consume data that is already decoded. The data of a batch is released once
+/// the prim readers are done with it, to bound the memory used.
+///
+/// Only the topology, points and normals of the meshes are currently read
+/// ahead, which is the bulk of the data of most imports.
+class UsdMayaPrimDataPrefetch
+{
+public:
+    /// Reads the time samples within \p frameRange, \p batchSize prims at a
+    /// time.
+    MAYAUSD_CORE_PUBLIC
+    UsdMayaPrimDataPrefetch(const GfInterval& frameRange, size_t batchSize);
+
+    MAYAUSD_CORE_PUBLIC
+    ~UsdMayaPrimDataPrefetch();
+
+    UsdMayaPrimDataPrefetch(const UsdMayaPrimDataPrefetch&) = delete;
+    UsdMayaPrimDataPrefetch& operator=(const UsdMayaPrimDataPrefetch&) = delete;
+
+    /// Returns the number of prims read ahead at a time, from the
+    /// MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE environment variable. Zero means
+    /// that the data is not read ahead.
+    MAYAUSD_CORE_PUBLIC
+    static size_t GetDefaultBatchSize();
+
+    /// Starts reading the data of \p prims, which must be in the order in
+    /// which they will be read.
+    MAYAUSD_CORE_PUBLIC
+    void Start(std::vector<UsdPrim>&& prims);
+
+    /// Makes the data of \p prim available and keeps reading ahead of it.
+    /// Must be called from the main thread before reading each prim. Prims
+    /// that are not part of the prefetched ones are ignored.
+    MAYAUSD_CORE_PUBLIC
+    void Advance(const UsdPrim& prim);
+
+    /// Returns the mesh data of the current prim if its path is \p path, or
+    /// nullptr if it was not read ahead.
+    MAYAUSD_CORE_PUBLIC
+    const UsdMayaMeshReadData* GetMeshData(const SdfPath& path) const;
+
+private:
+    void _LaunchBatch(size_t batch);
+    void _WaitForBatch(size_t batch);
+    void _ReleaseBatch(size_t batch);
+    void _ReadPrim(size_t index);
+
+    const GfInterval     _frameRange;
+    const size_t         _batchSize;
+    std::vector<UsdPrim> _prims;
+
+    // One entry per prim, null for the prims that are not meshes.
+    std::vector<std::unique_ptr<UsdMayaMeshReadData>> _meshData;
+
+    // One entry per batch, null before the batch is launched and after it is
+    // waited for. Batches are launched in order.
+    std::vector<std::unique_ptr<tbb::task_group>> _batchTasks;
+
+    size_t _launchedBatches;
+    size_t _currentIndex;
+    size_t _currentBatch;
+    bool   _hasCurrent;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
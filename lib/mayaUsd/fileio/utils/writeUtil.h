@@ -324,7 +324,7 @@ struct UsdMayaWriteUtil
         const UsdTimeCode          time = UsdTimeCode::Default(),
         FlexibleSparseValueWriter* valueWriter = nullptr)
     {
-        return valueWriter ? valueWriter->SetAttribute(attr, VtValue::Take(*value), time)
+        return valueWriter ? valueWriter->SetAttribute(attr, *value, time)
                            : attr.Set(*value, time);
     }
 };
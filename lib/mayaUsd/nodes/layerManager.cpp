@@ -27,9 +27,11 @@
 #include <mayaUsd/utils/utilSerialization.h>
 
 #include <pxr/base/arch/env.h>
+#include <pxr/base/tf/fastCompression.h>
 #include <pxr/base/tf/instantiateType.h>
 #include <pxr/base/tf/weakBase.h>
 #include <pxr/usd/ar/resolver.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/sdf/textFileFormat.h>
 #include <pxr/usd/usd/editTarget.h>
 #include <pxr/usd/usd/usdFileFormat.h>
@@ -57,8 +59,14 @@
 #include <ufe/observableSelection.h>
 #include <ufe/selectionNotification.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <set>
 
 namespace {
@@ -205,6 +213,108 @@ bool isCopyingSceneNodes()
 
 constexpr auto kSaveOptionUICmd = "usdFileSaveOptions(true);";
 
+// Compressed layers are stored in the serialized attribute as this header, followed by the size
+// of the exported layer, a new line and the compressed layer encoded in base64. Exported layers
+// start with the "#usda" header, so the two cannot be confused.
+constexpr char kCompressedLayerHeader[] = "#mayaUsdCompressed ";
+
+constexpr char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string encodeBase64(const char* data, size_t size)
+{
+    std::string encoded;
+    encoded.reserve(((size + 2) / 3) * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        const size_t remaining = size - i;
+        unsigned int bits = static_cast<unsigned char>(data[i]) << 16;
+        if (remaining > 1)
+            bits |= static_cast<unsigned char>(data[i + 1]) << 8;
+        if (remaining > 2)
+            bits |= static_cast<unsigned char>(data[i + 2]);
+
+        encoded.push_back(kBase64Chars[(bits >> 18) & 0x3F]);
+        encoded.push_back(kBase64Chars[(bits >> 12) & 0x3F]);
+        encoded.push_back(remaining > 1 ? kBase64Chars[(bits >> 6) & 0x3F] : '=');
+        encoded.push_back(remaining > 2 ? kBase64Chars[bits & 0x3F] : '=');
+    }
+    return encoded;
+}
+
+bool decodeBase64(const char* encoded, size_t size, std::string* data)
+{
+    int values[256];
+    std::fill(values, values + 256, -1);
+    for (int i = 0; i < 64; ++i) {
+        values[static_cast<unsigned char>(kBase64Chars[i])] = i;
+    }
+
+    data->clear();
+    data->reserve((size / 4) * 3);
+    unsigned int bits = 0;
+    int          bitCount = 0;
+    for (size_t i = 0; i < size && encoded[i] != '='; ++i) {
+        const int value = values[static_cast<unsigned char>(encoded[i])];
+        if (value < 0)
+            return false;
+
+        bits = (bits << 6) | value;
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            data->push_back(static_cast<char>((bits >> bitCount) & 0xFF));
+        }
+    }
+    return true;
+}
+
+// Compresses an exported layer to store it in the Maya file. The Maya string attributes cannot
+// hold binary data, so the compressed layer is encoded in base64.
+bool compressLayer(const std::string& exported, std::string* serialized)
+{
+    if (exported.size() > PXR_NS::TfFastCompression::GetMaxInputSize()) {
+        *serialized = exported;
+        return true;
+    }
+
+    std::string compressed;
+    compressed.resize(PXR_NS::TfFastCompression::GetCompressedBufferSize(exported.size()));
+    const size_t compressedSize = PXR_NS::TfFastCompression::CompressToBuffer(
+        exported.data(), &compressed[0], exported.size());
+    if (compressedSize == 0)
+        return false;
+
+    *serialized = kCompressedLayerHeader + std::to_string(exported.size()) + "\n"
+        + encodeBase64(compressed.data(), compressedSize);
+    return true;
+}
+
+bool isCompressedLayer(const std::string& serialized)
+{
+    return serialized.compare(0, sizeof(kCompressedLayerHeader) - 1, kCompressedLayerHeader) == 0;
+}
+
+bool uncompressLayer(const std::string& serialized, std::string* exported)
+{
+    const size_t sizeStart = sizeof(kCompressedLayerHeader) - 1;
+    const size_t dataStart = serialized.find('\n', sizeStart);
+    if (dataStart == std::string::npos)
+        return false;
+
+    const size_t exportedSize = std::strtoull(serialized.c_str() + sizeStart, nullptr, 10);
+    std::string  compressed;
+    if (!decodeBase64(
+            serialized.data() + dataStart + 1, serialized.size() - dataStart - 1, &compressed))
+        return false;
+
+    exported->resize(exportedSize);
+    if (exportedSize == 0)
+        return true;
+
+    return PXR_NS::TfFastCompression::DecompressFromBuffer(
+               compressed.data(), &(*exported)[0], compressed.size(), exportedSize)
+        == exportedSize;
+}
+
 } // namespace
 
 namespace MAYAUSD_NS_DEF {
@@ -246,12 +356,18 @@ public:
 
     SdfLayerHandle findLayer(std::string identifier) const;
 
+    // Returns the content of the layer to store in the Maya file. Compressed layers that did not
+    // change since the previous save are not exported again. Safe to call from multiple threads
+    // for different layers.
+    bool serializeLayer(const SdfLayerHandle& layer, bool compress, std::string* serialized);
+
 private:
     void registerCallbacks();
     void unregisterCallbacks();
 
     void _addLayer(SdfLayerRefPtr layer, const std::string& identifier);
     void onStageSet(const MayaUsdProxyStageSetNotice& notice);
+    void onLayersDidChange(const SdfNotice::LayersDidChange& notice);
 
     bool            saveUsd(bool isExport);
     BatchSaveResult saveUsdToMayaFile();
@@ -266,18 +382,28 @@ private:
     void refreshProxiesToSave();
     void updateLayerManagers();
 
-    std::map<std::string, SdfLayerRefPtr> _idToLayer;
-    TfNotice::Key                         _onStageSetKey;
-    std::set<unsigned int>                _supportedTypes;
-    std::vector<StageSavingInfo>          _proxiesToSave;
-    std::vector<StageSavingInfo>          _internalProxiesToSave;
-    std::string                           _selectedStage;
-    static MCallbackId                    preSaveCallbackId;
-    static MCallbackId                    postSaveCallbackId;
-    static MCallbackId                    preExportCallbackId;
-    static MCallbackId                    postExportCallbackId;
-    static MCallbackId                    postNewCallbackId;
-    static MCallbackId                    preOpenCallbackId;
+    struct SerializedLayer
+    {
+        SdfLayerHandle layer;
+        std::string    serialized;
+    };
+
+    std::map<std::string, SdfLayerRefPtr>  _idToLayer;
+    // Compressed layers stored by the previous saves, until the layers are changed.
+    std::map<std::string, SerializedLayer> _serializedLayers;
+    std::mutex                             _serializedLayersMutex;
+    TfNotice::Key                          _onStageSetKey;
+    TfNotice::Key                          _onLayersDidChangeKey;
+    std::set<unsigned int>                 _supportedTypes;
+    std::vector<StageSavingInfo>           _proxiesToSave;
+    std::vector<StageSavingInfo>           _internalProxiesToSave;
+    std::string                            _selectedStage;
+    static MCallbackId                     preSaveCallbackId;
+    static MCallbackId                     postSaveCallbackId;
+    static MCallbackId                     preExportCallbackId;
+    static MCallbackId                     postExportCallbackId;
+    static MCallbackId                     postNewCallbackId;
+    static MCallbackId                     preOpenCallbackId;
 
     static MayaUsd::BatchSaveDelegate _batchSaveDelegate;
 
@@ -307,6 +433,7 @@ LayerDatabase::LayerDatabase()
 {
     TfWeakPtr<LayerDatabase> me(this);
     _onStageSetKey = TfNotice::Register(me, &LayerDatabase::onStageSet);
+    _onLayersDidChangeKey = TfNotice::Register(me, &LayerDatabase::onLayersDidChange);
 }
 
 LayerDatabase::~LayerDatabase()
@@ -314,6 +441,9 @@ LayerDatabase::~LayerDatabase()
     if (_onStageSetKey.IsValid()) {
         TfNotice::Revoke(_onStageSetKey);
     }
+    if (_onLayersDidChangeKey.IsValid()) {
+        TfNotice::Revoke(_onLayersDidChangeKey);
+    }
 
     unregisterCallbacks();
 }
@@ -379,6 +509,19 @@ void LayerDatabase::onStageSet(const MayaUsdProxyStageSetNotice& notice)
     }
 }
 
+void LayerDatabase::onLayersDidChange(const SdfNotice::LayersDidChange& notice)
+{
+    std::lock_guard<std::mutex> lock(_serializedLayersMutex);
+    if (_serializedLayers.empty())
+        return;
+
+    for (const auto& layer : notice.GetLayers()) {
+        if (layer) {
+            _serializedLayers.erase(layer->GetIdentifier());
+        }
+    }
+}
+
 void LayerDatabase::setBatchSaveDelegate(BatchSaveDelegate delegate)
 {
     _batchSaveDelegate = delegate;
@@ -683,8 +826,7 @@ MStatus addLayerToBuilder(
     MArrayDataBuilder&     builder,
     SdfLayerHandle         layer,
     bool                   isAnon,
-    bool                   stubOnly = false,
-    bool                   exportOnlyIfDirty = false)
+    const std::string&     serialized)
 {
     if (!lm)
         return MS::kFailure;
@@ -703,14 +845,7 @@ MStatus addLayerToBuilder(
     auto fileFormatIdToken = layer->GetFileFormat()->GetFormatId();
     fileFormatIdHandle.setString(UsdMayaUtil::convert(fileFormatIdToken.GetString()));
 
-    std::string temp;
-    if (!stubOnly && ((exportOnlyIfDirty && layer->IsDirty()) || !exportOnlyIfDirty)) {
-        if (!layer->ExportToString(&temp)) {
-            status = MS::kFailure;
-        }
-    }
-
-    serializedHandle.setString(UsdMayaUtil::convert(temp));
+    serializedHandle.setString(UsdMayaUtil::convert(serialized));
 
     return status;
 }
@@ -743,20 +878,36 @@ SaveStageToMayaResult saveStageToMayaFile(
     const MFnDependencyNode depNodeFn(proxyNode);
     MayaUsdProxyShapeBase*  pShape = static_cast<MayaUsdProxyShapeBase*>(depNodeFn.userNode());
 
-    SdfLayerHandleVector allLayers = stage->GetLayerStack(true);
-    for (auto layer : allLayers) {
-        addLayerToBuilder(
-            lm,
-            builder,
-            layer,
-            layer->IsAnonymous(),
-            pShape->isIncomingLayer(layer->GetIdentifier()),
-            true);
+    // Only the dirty layers are exported, the others are recorded as stubs. The layers are
+    // independent, so they are exported in parallel and then added to the builder in order.
+    const SdfLayerHandleVector allLayers = stage->GetLayerStack(true);
+    const size_t               layerCount = allLayers.size();
+    std::vector<char>          exportLayer(layerCount, false);
+    std::vector<std::string>   serialized(layerCount);
+    for (size_t i = 0; i < layerCount; ++i) {
+        const SdfLayerHandle& layer = allLayers[i];
+        exportLayer[i] = layer->IsDirty() && !pShape->isIncomingLayer(layer->GetIdentifier());
         if (layer->IsDirty()) {
             result._stageHasDirtyLayers = true;
         }
     }
 
+    LayerDatabase& layerDatabase = LayerDatabase::instance();
+    const bool     compress = MayaUsd::utils::serializeUsdEditsCompressedOption();
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, layerCount, 1), [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); ++i) {
+                if (exportLayer[i]) {
+                    layerDatabase.serializeLayer(allLayers[i], compress, &serialized[i]);
+                }
+            }
+        });
+
+    for (size_t i = 0; i < layerCount; ++i) {
+        const SdfLayerHandle& layer = allLayers[i];
+        addLayerToBuilder(lm, builder, layer, layer->IsAnonymous(), serialized[i]);
+    }
+
     if (result._stageHasDirtyLayers) {
         setValueForAttr(
             proxyNode,
@@ -943,7 +1094,9 @@ void LayerDatabase::saveUsdLayerToMayaFile(SdfLayerRefPtr layer, bool asAnonymou
     MArrayDataHandle  layersHandle = dataBlock.outputArrayValue(lm->layers, &status);
     MArrayDataBuilder builder(&dataBlock, lm->layers, 1 /*maybe nb stages?*/, &status);
 
-    addLayerToBuilder(lm, builder, layer, asAnonymous);
+    std::string serialized;
+    serializeLayer(layer, MayaUsd::utils::serializeUsdEditsCompressedOption(), &serialized);
+    addLayerToBuilder(lm, builder, layer, asAnonymous, serialized);
 
     layersHandle.set(builder);
 
@@ -1053,6 +1206,20 @@ void LayerDatabase::loadLayersPostRead(void*)
         }
 
         if (layer) {
+            // Compressed layers are imported right away too: composition opens the layers by
+            // their identifiers, not through the layer database, so an empty layer would be
+            // found.
+            if (layerContainsEdits && isCompressedLayer(serializedVal)) {
+                std::string exported;
+                if (!uncompressLayer(serializedVal, &exported)) {
+                    MGlobal::displayError(
+                        MString("Failed to uncompress serialized layer: ")
+                        + identifierVal.c_str());
+                    continue;
+                }
+                serializedVal = std::move(exported);
+            }
+
             if (layerContainsEdits) {
                 if (!layer->ImportFromString(serializedVal)) {
                     MGlobal::displayError(
@@ -1081,6 +1248,49 @@ void LayerDatabase::cleanUpNewScene(void*)
 {
     LayerDatabase::instance().removeAllLayers();
     LayerDatabase::removeManagerNode();
+
+    // The layers stored by the previous saves are kept while saving the same scene.
+    if (!_isSavingMayaFile) {
+        LayerDatabase&              layerDatabase = LayerDatabase::instance();
+        std::lock_guard<std::mutex> lock(layerDatabase._serializedLayersMutex);
+        layerDatabase._serializedLayers.clear();
+    }
+}
+
+bool LayerDatabase::serializeLayer(
+    const SdfLayerHandle& layer,
+    bool                  compress,
+    std::string*          serialized)
+{
+    const std::string identifier = layer->GetIdentifier();
+    if (compress) {
+        std::lock_guard<std::mutex> lock(_serializedLayersMutex);
+        auto                        foundLayer = _serializedLayers.find(identifier);
+        if (foundLayer != _serializedLayers.end() && foundLayer->second.layer == layer) {
+            *serialized = foundLayer->second.serialized;
+            return true;
+        }
+    }
+
+    std::string exported;
+    if (!layer->ExportToString(&exported)) {
+        serialized->clear();
+        return false;
+    }
+
+    if (!compress) {
+        *serialized = std::move(exported);
+        return true;
+    }
+
+    if (!compressLayer(exported, serialized)) {
+        serialized->clear();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_serializedLayersMutex);
+    _serializedLayers[identifier] = { layer, *serialized };
+    return true;
 }
 
 bool LayerDatabase::remapSubLayerPaths(SdfLayerHandle parentLayer)
@@ -19,18 +19,23 @@
 
 #include <pxr/base/gf/math.h>
 #include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/notice.h>
 #include <pxr/base/tf/staticTokens.h>
 #include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/base/tf/weakPtr.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/base/vt/array.h>
 #include <pxr/base/vt/types.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/notice.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/pointBased.h>
 
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MFnData.h>
@@ -43,13 +48,16 @@
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
+#include <maya/MPointArray.h>
 #include <maya/MPxDeformerNode.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 #include <maya/MTime.h>
 #include <maya/MTypeId.h>
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -61,6 +69,114 @@ const MTypeId UsdMayaPointBasedDeformerNode::typeId(0x00126401);
 const MString UsdMayaPointBasedDeformerNode::typeName(
     UsdMayaPointBasedDeformerNodeTokens->MayaTypeName.GetText());
 
+namespace {
+
+// Reads the weights painted on the geometry at \p multiIndex, indexed by
+// point. The points without a painted weight have a weight of 1. Returns false
+// when no weight is painted.
+bool _GetPaintedWeights(MDataBlock& block, unsigned int multiIndex, std::vector<float>* weights)
+{
+    MStatus          status;
+    MArrayDataHandle weightListHandle = block.inputArrayValue(MPxDeformerNode::weightList, &status);
+    if (!status || !weightListHandle.jumpToElement(multiIndex)) {
+        return false;
+    }
+
+    MDataHandle weightListElemHandle = weightListHandle.inputValue(&status);
+    if (!status) {
+        return false;
+    }
+
+    MArrayDataHandle   weightsHandle = weightListElemHandle.child(MPxDeformerNode::weights);
+    const unsigned int numWeights = weightsHandle.elementCount();
+    for (unsigned int i = 0u; i < numWeights; ++i, weightsHandle.next()) {
+        const unsigned int index = weightsHandle.elementIndex();
+        if (index >= weights->size()) {
+            weights->resize(index + 1u, 1.0f);
+        }
+        (*weights)[index] = weightsHandle.inputValue().asFloat();
+    }
+
+    return numWeights > 0u;
+}
+
+// The lerp kernels below only do arithmetic on contiguous arrays, so that the
+// compiler can vectorize them. The Maya points are stored as 4 doubles.
+
+void _LerpPoints(double* points, const GfVec3f* targets, float factor, size_t count)
+{
+    const double t = factor;
+    for (size_t i = 0u; i < count; ++i) {
+        double* point = points + 4u * i;
+        point[0] += t * (targets[i][0] - point[0]);
+        point[1] += t * (targets[i][1] - point[1]);
+        point[2] += t * (targets[i][2] - point[2]);
+    }
+}
+
+void _LerpPoints(double* points, const GfVec3f* targets, const float* factors, size_t count)
+{
+    for (size_t i = 0u; i < count; ++i) {
+        double*      point = points + 4u * i;
+        const double t = factors[i];
+        point[0] += t * (targets[i][0] - point[0]);
+        point[1] += t * (targets[i][1] - point[1]);
+        point[2] += t * (targets[i][2] - point[2]);
+    }
+}
+
+void _CopyPoints(double* points, const GfVec3f* targets, size_t count)
+{
+    for (size_t i = 0u; i < count; ++i) {
+        double* point = points + 4u * i;
+        point[0] = targets[i][0];
+        point[1] = targets[i][1];
+        point[2] = targets[i][2];
+        point[3] = 1.0;
+    }
+}
+
+} // namespace
+
+// Flags the cached points query as stale when the prim changes in the stage,
+// since the query caches the resolved opinions of the attribute.
+class UsdMayaPointBasedDeformerNode::_StageListener : public TfWeakBase
+{
+public:
+    _StageListener(const UsdStageWeakPtr& stage, const SdfPath& primPath)
+        : _primPath(primPath)
+    {
+        TfWeakPtr<_StageListener> me(this);
+        _noticeKey = TfNotice::Register(me, &_StageListener::_OnObjectsChanged, stage);
+    }
+
+    ~_StageListener() { TfNotice::Revoke(_noticeKey); }
+
+    bool IsPrimChanged() const { return _primChanged; }
+
+private:
+    void _OnObjectsChanged(const UsdNotice::ObjectsChanged& notice)
+    {
+        for (const SdfPath& path : notice.GetResyncedPaths()) {
+            if (_primPath.HasPrefix(path) || path.HasPrefix(_primPath)) {
+                _primChanged = true;
+                return;
+            }
+        }
+
+        for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+            if (path.GetPrimPath() == _primPath) {
+                _primChanged = true;
+                return;
+            }
+        }
+    }
+
+    const SdfPath     _primPath;
+    TfNotice::Key     _noticeKey;
+    std::atomic<bool> _primChanged { false };
+};
+
 // Attributes
 MObject UsdMayaPointBasedDeformerNode::inUsdStageAttr;
 MObject UsdMayaPointBasedDeformerNode::primPathAttr;
@@ -133,23 +249,13 @@ MStatus UsdMayaPointBasedDeformerNode::deform(
         return MS::kFailure;
     }
 
-    const UsdStageRefPtr& usdStage = stageData->stage;
-
     // Get the prim path.
     const MDataHandle primPathHandle = block.inputValue(primPathAttr, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    const std::string primPathString = TfStringTrim(primPathHandle.asString().asChar());
-
-    if (primPathString.empty()) {
-        return MS::kFailure;
-    }
-
-    const SdfPath primPath(primPathString);
-
-    const UsdPrim&          usdPrim = usdStage->GetPrimAtPath(primPath);
-    const UsdGeomPointBased usdPointBased(usdPrim);
-    if (!usdPointBased) {
+    const std::shared_ptr<const UsdAttributeQuery> pointsQuery
+        = _GetPointsQuery(stageData->stage, primPathHandle.asString());
+    if (!pointsQuery) {
         return MS::kFailure;
     }
 
@@ -162,28 +268,116 @@ MStatus UsdMayaPointBasedDeformerNode::deform(
     const float envelope = envelopeHandle.asFloat();
 
     VtVec3fArray usdPoints;
-    if (!usdPointBased.GetPointsAttr().Get(&usdPoints, usdTime) || usdPoints.empty()) {
+    if (!pointsQuery->Get(&usdPoints, usdTime) || usdPoints.empty()) {
         return MS::kFailure;
     }
 
+    // Gather the indices of the deformed points, which usually are all the
+    // points of the geometry, in order.
+    std::vector<int> indices;
+    indices.reserve(iter.count());
+    bool inOrder = true;
     for (; !iter.isDone(); iter.next()) {
         const int index = iter.index();
-        if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
-            continue;
+        inOrder = inOrder && index == static_cast<int>(indices.size());
+        indices.push_back(index);
+    }
+    iter.reset();
+
+    const size_t numPoints = indices.size();
+    const bool   allInRange = inOrder && numPoints <= usdPoints.size();
+
+    std::vector<float> weights;
+    const bool         hasWeights = _GetPaintedWeights(block, multiIndex, &weights);
+
+    std::vector<double> points(4u * numPoints);
+    if (allInRange && !hasWeights && envelope == 1.0f) {
+        // The deformed points are exactly the USD points.
+        _CopyPoints(points.data(), usdPoints.cdata(), numPoints);
+    } else {
+        MPointArray mayaPoints;
+        status = iter.allPositions(mayaPoints);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        if (mayaPoints.length() != numPoints) {
+            return MS::kFailure;
         }
+        mayaPoints.get(reinterpret_cast<double(*)[4]>(points.data()));
+
+        if (allInRange && !hasWeights) {
+            _LerpPoints(points.data(), usdPoints.cdata(), envelope, numPoints);
+        } else {
+            // Gather the USD point and the blend factor of each deformed
+            // point. The points without a USD point are left as is.
+            std::vector<GfVec3f> targets(numPoints, GfVec3f(0.0f));
+            std::vector<float>   factors(numPoints, 0.0f);
+            for (size_t i = 0u; i < numPoints; ++i) {
+                const int index = indices[i];
+                if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
+                    continue;
+                }
+
+                targets[i] = usdPoints[static_cast<size_t>(index)];
+                factors[i] = static_cast<size_t>(index) < weights.size()
+                    ? envelope * weights[static_cast<size_t>(index)]
+                    : envelope;
+            }
+            _LerpPoints(points.data(), targets.data(), factors.data(), numPoints);
+        }
+    }
 
-        const MPoint mayaPoint = iter.position();
-        const float  weight = weightValue(block, multiIndex, index);
+    status = iter.setAllPositions(
+        MPointArray(reinterpret_cast<const double(*)[4]>(points.data()), numPoints));
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-        const GfVec3f& usdPoint = usdPoints[static_cast<size_t>(index)];
+    return status;
+}
+
+/* virtual */
+MPxNode::SchedulingType UsdMayaPointBasedDeformerNode::schedulingType() const
+{
+    // The cached points query is guarded by a mutex, and USD reads are
+    // thread-safe.
+    return MPxNode::kParallel;
+}
 
-        const GfVec3f deformedPoint = GfLerp<GfVec3f>(
-            weight * envelope, GfVec3f(mayaPoint[0], mayaPoint[1], mayaPoint[2]), usdPoint);
+std::shared_ptr<const UsdAttributeQuery> UsdMayaPointBasedDeformerNode::_GetPointsQuery(
+    const UsdStageRefPtr& stage,
+    const MString&        primPathString)
+{
+    std::lock_guard<std::mutex> lock(_pointsQueryMutex);
 
-        iter.setPosition(MPoint(deformedPoint[0], deformedPoint[1], deformedPoint[2]));
+    if (get_pointer(_pointsQueryStage) == get_pointer(stage)
+        && _pointsQueryPrimPath == primPathString.asChar()
+        && !(_stageListener && _stageListener->IsPrimChanged())) {
+        return _pointsQuery;
     }
 
-    return status;
+    _pointsQuery.reset();
+    _stageListener.reset();
+    _pointsQueryStage = stage;
+    _pointsQueryPrimPath = primPathString.asChar();
+
+    const std::string trimmedPrimPath = TfStringTrim(_pointsQueryPrimPath);
+    if (trimmedPrimPath.empty()) {
+        return _pointsQuery;
+    }
+
+    const SdfPath primPath(trimmedPrimPath);
+    if (!primPath.IsAbsoluteRootOrPrimPath()) {
+        return _pointsQuery;
+    }
+
+    // Listen before reading the prim, so that no change is missed. The prim
+    // may not exist yet, in which case the query is rebuilt when it is
+    // created.
+    _stageListener = std::make_unique<_StageListener>(stage, primPath);
+
+    const UsdGeomPointBased usdPointBased(stage->GetPrimAtPath(primPath));
+    if (usdPointBased) {
+        _pointsQuery = std::make_shared<const UsdAttributeQuery>(usdPointBased.GetPointsAttr());
+    }
+
+    return _pointsQuery;
 }
 
 UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode()
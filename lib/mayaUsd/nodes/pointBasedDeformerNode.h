@@ -20,6 +20,8 @@
 
 #include <pxr/base/tf/staticTokens.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/stage.h>
 
 #include <maya/MDataBlock.h>
 #include <maya/MItGeometry.h>
@@ -30,6 +32,10 @@
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // clang-format off
@@ -52,6 +58,12 @@ TF_DECLARE_PUBLIC_TOKENS(
 /// the deformer runs, it will read the points attribute of the prim at that
 /// time sample and use the positions to modify the positions of the geometry
 /// being deformed.
+///
+/// The query of the points attribute is cached, and only rebuilt when the
+/// stage or the prim path change, or when the prim is changed in the stage.
+/// All the points are read and written at once, and copied directly when the
+/// envelope is 1 and no weights are painted. The node can be evaluated in
+/// parallel.
 class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
 {
 public:
@@ -80,10 +92,27 @@ public:
     deform(MDataBlock& block, MItGeometry& iter, const MMatrix& mat, unsigned int multiIndex)
         override;
 
+    // MPxNode overrides
+    MAYAUSD_CORE_PUBLIC
+    MPxNode::SchedulingType schedulingType() const override;
+
 private:
     UsdMayaPointBasedDeformerNode();
     ~UsdMayaPointBasedDeformerNode() override;
 
+    class _StageListener;
+
+    // Returns the cached query of the points attribute of the prim, rebuilding
+    // it if needed. Returns null if the prim is not a UsdGeomPointBased prim.
+    std::shared_ptr<const UsdAttributeQuery>
+    _GetPointsQuery(const UsdStageRefPtr& stage, const MString& primPathString);
+
+    std::mutex                               _pointsQueryMutex;
+    std::shared_ptr<const UsdAttributeQuery> _pointsQuery;
+    UsdStageWeakPtr                          _pointsQueryStage;
+    std::string                              _pointsQueryPrimPath;
+    std::unique_ptr<_StageListener>          _stageListener;
+
     UsdMayaPointBasedDeformerNode(const UsdMayaPointBasedDeformerNode&);
     UsdMayaPointBasedDeformerNode& operator=(const UsdMayaPointBasedDeformerNode&);
 };
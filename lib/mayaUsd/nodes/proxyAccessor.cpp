@@ -22,6 +22,7 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/resolverScopedCache.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/schema.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usd/notice.h>
@@ -115,12 +116,25 @@ public:
     //! \brief  Restore will handle changing context pointer in the accessor to the state before
     ~ComputeContext() { _accessor._inCompute = _restoreState; }
 
+    //! \brief  Returns the visibility of the proxy shape, queried once for all the outputs
+    bool isProxyShapeVisible()
+    {
+        if (_proxyShapeVisibility < 0) {
+            Ufe::Path proxyShapeUfePath = MayaUsd::ufe::stagePath(_stage);
+            MDagPath  proxyShapeDagPath = MayaUsd::ufe::ufeToDagPath(proxyShapeUfePath);
+            _proxyShapeVisibility = proxyShapeDagPath.isVisible() ? 1 : 0;
+        }
+        return _proxyShapeVisibility > 0;
+    }
+
     ComputeContext(const ComputeContext&) = delete;
     ComputeContext& operator=(const ComputeContext&) = delete;
 
 private:
     //! Remember context pointer at the creation of this object
     ComputeContext* _restoreState;
+    //! Visibility of the proxy shape, -1 until queried
+    int _proxyShapeVisibility { -1 };
 
 public:
     //! Accessor setting up this context
@@ -289,6 +303,11 @@ void ProxyAccessor::collectAccessorItems(MObject node)
 
     _accessorInputItems.clear();
     _accessorOutputItems.clear();
+    _inputItemsByAttribute.clear();
+    _outputItemsByAttribute.clear();
+    _inputItemsByPath.clear();
+    _outputItemsByPath.clear();
+    _xformInputItemsByPrimPath.clear();
 
     _validAccessorItems = true;
 
@@ -365,27 +384,83 @@ void ProxyAccessor::collectAccessorItems(MObject node)
             continue;
         }
 
-        if (isAccessorInputPlug(item.plug)) {
+        const bool      isInput = isAccessorInputPlug(item.plug);
+        Container&      accessorItems = isInput ? _accessorInputItems : _accessorOutputItems;
+        AttributeIndex& itemsByAttribute
+            = isInput ? _inputItemsByAttribute : _outputItemsByAttribute;
+        PathIndex& itemsByPath = isInput ? _inputItemsByPath : _outputItemsByPath;
+
+        const size_t index = accessorItems.size();
+        itemsByAttribute.emplace(MObjectHandle(item.plug.attribute()), index);
+        if (!item.property.IsEmpty()) {
+            itemsByPath.emplace(item.path.AppendProperty(item.property), index);
+            if (isInput && UsdGeomXformOp::IsXformOp(item.property)) {
+                _xformInputItemsByPrimPath.emplace(item.path, index);
+            }
+        }
+
+        if (isInput) {
             TF_DEBUG(USDMAYA_PROXYACCESSOR).Msg("Added INPUT '%s'\n", item.path.GetText());
-            _accessorInputItems.emplace_back(item);
         } else {
             TF_DEBUG(USDMAYA_PROXYACCESSOR).Msg("Added OUTPUT '%s'\n", item.path.GetText());
-            _accessorOutputItems.emplace_back(item);
         }
+        accessorItems.emplace_back(std::move(item));
     }
 
     return;
 }
 
-const ProxyAccessor::Item* ProxyAccessor::findAccessorItem(const MPlug& plug, bool isInput) const
+ProxyAccessor::Item* ProxyAccessor::findAccessorItem(const MPlug& plug, bool isInput)
+{
+    // Accessor items are registered with their top level plug
+    const MPlug&          itemPlug = plug.isElement() ? plug.array() : plug;
+    const AttributeIndex& itemsByAttribute
+        = isInput ? _inputItemsByAttribute : _outputItemsByAttribute;
+
+    auto it = itemsByAttribute.find(MObjectHandle(itemPlug.attribute()));
+    if (it == itemsByAttribute.end())
+        return nullptr;
+
+    Container& accessorItems = isInput ? _accessorInputItems : _accessorOutputItems;
+    return &accessorItems[it->second];
+}
+
+ProxyAccessor::Item* ProxyAccessor::findAccessorItem(const SdfPath& propertyPath, bool isInput)
+{
+    const PathIndex& itemsByPath = isInput ? _inputItemsByPath : _outputItemsByPath;
+
+    auto it = itemsByPath.find(propertyPath);
+    if (it == itemsByPath.end())
+        return nullptr;
+
+    Container& accessorItems = isInput ? _accessorInputItems : _accessorOutputItems;
+    return &accessorItems[it->second];
+}
+
+void ProxyAccessor::resolveAccessorHandles(Item& item, const UsdStageRefPtr& stage)
 {
-    const Container& accessorItems = isInput ? _accessorInputItems : _accessorOutputItems;
-    for (const auto& item : accessorItems) {
-        if ((plug.isElement() && item.plug == plug.array()) || item.plug == plug)
-            return &item;
+    // Handles resolved for another stage are all stale
+    if (!_handlesStage || _handlesStage != stage) {
+        _handlesStage = stage;
+        invalidateAccessorHandles();
     }
 
-    return nullptr;
+    if (item.handlesSyncId.inSync(_handlesId))
+        return;
+
+    item.handlesSyncId.sync(_handlesId);
+
+    item.prim = stage->GetPrimAtPath(item.path);
+    item.attribute = UsdAttribute();
+    item.query = UsdAttributeQuery();
+
+    if (item.property.IsEmpty() || item.property == combinedVisibilityToken || !item.prim)
+        return;
+
+    item.attribute = item.prim.GetAttribute(item.property);
+    if (item.attribute.IsDefined()) {
+        item.query = UsdAttributeQuery(item.attribute);
+    }
 }
 
 MStatus ProxyAccessor::addDependentsDirty(const MPlug& plug, MPlugArray& plugArray)
@@ -428,7 +503,7 @@ MStatus ProxyAccessor::compute(const MPlug& plug, MDataBlock& dataBlock)
         MProfilingScope profilingScope(
             _accessorProfilerCategory, MProfiler::kColorB_L3, "Nested compute USD accessor");
 
-        const auto* accessorItem = findAccessorItem(plug, false);
+        auto* accessorItem = findAccessorItem(plug, false);
         if (accessorItem) {
             TF_DEBUG(USDMAYA_PROXYACCESSOR)
                 .Msg("Nested compute triggered by '%s'\n", plug.name().asChar());
@@ -438,32 +513,24 @@ MStatus ProxyAccessor::compute(const MPlug& plug, MDataBlock& dataBlock)
             // If it's not a property path, then we will be writing out world matrix data
             if (!accessorItem->path.IsPrimPropertyPath()) {
                 // Read only inputs that can affect requested xform matrix and that haven't been
-                // yet read. We will perform evaluationId check to prevent causing recursive
-                // computation of the same plug, when there is more than one input depending on it.
-                for (auto& inputItem : _accessorInputItems) {
-                    if (UsdGeomXformOp::IsXformOp(inputItem.property)
-                        && accessorItem->path.HasPrefix(inputItem.path)) {
-                        computeInput(inputItem, topState._stage, dataBlock, topState._args);
+                // yet read, i.e. the xform ops of the prim and of its ancestors. We will perform
+                // evaluationId check to prevent causing recursive computation of the same plug,
+                // when there is more than one input depending on it.
+                for (SdfPath path = accessorItem->path; !path.IsEmpty();
+                     path = path.GetParentPath()) {
+                    auto range = _xformInputItemsByPrimPath.equal_range(path);
+                    for (auto it = range.first; it != range.second; ++it) {
+                        computeInput(
+                            _accessorInputItems[it->second],
+                            topState._stage,
+                            dataBlock,
+                            topState._args);
                     }
                 }
-
-                // write to only single output that was requested.
-                computeOutput(
-                    *accessorItem,
-                    topState._proxyInclusiveMatrix,
-                    topState._stage,
-                    dataBlock,
-                    topState._xformCache,
-                    topState._args);
-            } else {
-                computeOutput(
-                    *accessorItem,
-                    topState._proxyInclusiveMatrix,
-                    topState._stage,
-                    dataBlock,
-                    topState._xformCache,
-                    topState._args);
             }
+
+            // write to only single output that was requested.
+            computeOutput(*accessorItem, topState, dataBlock);
         } else {
             TF_DEBUG(USDMAYA_PROXYACCESSOR)
                 .Msg("!!!! Nested compute on a plug ignored '%s'\n", plug.name().asChar());
@@ -490,15 +557,10 @@ MStatus ProxyAccessor::compute(const MPlug& plug, MDataBlock& dataBlock)
     for (auto& item : _accessorInputItems) {
         computeInput(item, evalState._stage, dataBlock, evalState._args);
     }
-    // Write outputs that haven't been yet computed
-    for (const auto& item : _accessorOutputItems) {
-        computeOutput(
-            item,
-            evalState._proxyInclusiveMatrix,
-            evalState._stage,
-            dataBlock,
-            evalState._xformCache,
-            evalState._args);
+    // Write outputs that haven't been yet computed. All of them share the xform cache of the
+    // context, so the transforms of common ancestors are only computed once.
+    for (auto& item : _accessorOutputItems) {
+        computeOutput(item, evalState, dataBlock);
     }
 
     return MS::kSuccess;
@@ -516,20 +578,17 @@ MStatus ProxyAccessor::computeInput(
     if (evaluationId.inSync(_evaluationId))
         return MS::kSuccess;
 
-    // We should cache UsdAttribute in here too and avoid expensive
-    // searches (i.e. getting the prim, getting attribute, checking if defined)
-
     MProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Write input", item.path.GetText());
 
     evaluationId.sync(_evaluationId);
 
-    const UsdPrim& itemPrim = stage->GetPrimAtPath(item.path);
-
     if (item.property.IsEmpty() || !item.converter)
         return MS::kFailure;
 
-    UsdAttribute itemAttribute = itemPrim.GetAttribute(item.property);
+    resolveAccessorHandles(item, stage);
+
+    UsdAttribute& itemAttribute = item.attribute;
 
     if (!itemAttribute.IsDefined()) {
         TF_CODING_ERROR(
@@ -550,28 +609,28 @@ MStatus ProxyAccessor::computeInput(
     VtValue currentValue;
     if (itemAttribute.Get(&currentValue, args._timeCode) && convertedValue != currentValue) {
         itemAttribute.Set(convertedValue, args._timeCode);
+
+        // The value may now come from the edit target layer, which invalidates the value
+        // resolution of an output reading the same attribute.
+        if (Item* outputItem = findAccessorItem(itemAttribute.GetPath(), false)) {
+            outputItem->handlesSyncId.invalidate();
+        }
     }
 
     return MS::kSuccess;
 }
 
-MStatus ProxyAccessor::computeOutput(
-    const Item&          item,
-    const MMatrix&       proxyInclusiveMatrix,
-    const UsdStageRefPtr stage,
-    MDataBlock&          dataBlock,
-    UsdGeomXformCache&   xformCache,
-    const ConverterArgs& args)
+MStatus ProxyAccessor::computeOutput(Item& item, ComputeContext& context, MDataBlock& dataBlock)
 {
     MStatus retValue = MS::kSuccess;
 
-    // We should cache UsdAttribute in here too and avoid expensive
-    // searches (i.e. getting the prim, getting attribute, checking if defined)
-
     MProfilingScope profilingScope(
         _accessorProfilerCategory, MProfiler::kColorB_L1, "Write output", item.path.GetText());
 
-    const UsdPrim& itemPrim = stage->GetPrimAtPath(item.path);
+    resolveAccessorHandles(item, context._stage);
+
+    const UsdPrim&       itemPrim = item.prim;
+    const ConverterArgs& args = context._args;
 
     MDataHandle itemDataHandle = dataBlock.outputValue(item.plug, &retValue);
     if (MFAIL(retValue)) {
@@ -580,11 +639,11 @@ MStatus ProxyAccessor::computeOutput(
 
     // If it's not a property path, then we will be writing out world matrix data
     if (item.property.IsEmpty()) {
-        GfMatrix4d mat = xformCache.GetLocalToWorldTransform(itemPrim);
+        GfMatrix4d mat = context._xformCache.GetLocalToWorldTransform(itemPrim);
         MMatrix    mayaMat;
         TypedConverter<MMatrix, GfMatrix4d>::convert(mat, mayaMat);
 
-        mayaMat *= proxyInclusiveMatrix;
+        mayaMat *= context._proxyInclusiveMatrix;
 
         MFnMatrixData data;
         MObject       dataMatrix = data.create();
@@ -600,9 +659,7 @@ MStatus ProxyAccessor::computeOutput(
         dstArray.setAllClean();
     } else if (item.property == combinedVisibilityToken) {
         // First, verify visibility of the proxy shape
-        Ufe::Path proxyShapeUfePath = MayaUsd::ufe::stagePath(stage);
-        MDagPath  proxyShapeDagPath = MayaUsd::ufe::ufeToDagPath(proxyShapeUfePath);
-        bool      visible = proxyShapeDagPath.isVisible();
+        bool visible = context.isProxyShapeVisible();
 
         // Next, verify visibility of the usd prim
         UsdGeomImageable imageable(itemPrim);
@@ -612,10 +669,7 @@ MStatus ProxyAccessor::computeOutput(
 
         itemDataHandle.set(visible ? 1 : 0);
     } else if (item.converter) {
-        UsdAttribute itemAttribute = itemPrim.GetAttribute(item.property);
-
-        // cache this! expensive call
-        if (!itemAttribute.IsDefined()) {
+        if (!item.attribute.IsDefined()) {
             TF_CODING_ERROR(
                 "Undefined/invalid attribute '%s.%s'",
                 item.path.GetText(),
@@ -625,7 +679,13 @@ MStatus ProxyAccessor::computeOutput(
             return MS::kFailure;
         }
 
-        item.converter->convert(itemAttribute, itemDataHandle, args);
+        // The attribute query caches the value resolution of the attribute
+        VtValue value;
+        if (item.query.Get(&value, args._timeCode) && !value.IsEmpty()) {
+            item.converter->convert(value, itemDataHandle, args);
+        } else {
+            item.converter->convert(item.attribute, itemDataHandle, args);
+        }
     }
 
     // Even if we have no data to write, we set the data in data block as clean
@@ -673,17 +733,32 @@ MStatus ProxyAccessor::stageChanged(const MObject& node, const UsdNotice::Object
 
     bool needsForceCompute = true;
 
-    if (_accessorInputItems.size() > 0) {
-        auto findInputItemFn = [this](const SdfPath& changedPath) -> Item* {
-            for (Item& item : _accessorInputItems) {
-                if (item.path == changedPath
-                    || item.path.AppendProperty(item.property) == changedPath) {
-                    return &item;
+    // Prims and properties may have been added or removed, the cached handles can't be trusted.
+    if (!notice.GetResyncedPaths().empty()) {
+        invalidateAccessorHandles();
+    }
+
+    // The value resolution of an output changes when time samples or a default value are
+    // authored in a layer, this is reported as a change to the attribute info.
+    if (_accessorOutputItems.size() > 0) {
+        for (const auto& changedPath : notice.GetChangedInfoOnlyPaths()) {
+            if (!changedPath.IsPrimPropertyPath())
+                continue;
+
+            Item* changedOutput = findAccessorItem(changedPath, false);
+            if (!changedOutput)
+                continue;
+
+            for (const TfToken& field : notice.GetChangedFields(changedPath)) {
+                if (field == SdfFieldKeys->Default || field == SdfFieldKeys->TimeSamples) {
+                    changedOutput->handlesSyncId.invalidate();
+                    break;
                 }
             }
-            return nullptr;
-        };
+        }
+    }
 
+    if (_accessorInputItems.size() > 0) {
         // UFE currently doesn't write time sampled data.
         ConverterArgs args;
         args._timeCode = UsdTimeCode::Default(); // getTime();
@@ -693,7 +768,7 @@ MStatus ProxyAccessor::stageChanged(const MObject& node, const UsdNotice::Object
 
         for (const auto& changedPath : notice.GetChangedInfoOnlyPaths()) {
             if (changedPath.IsPrimPropertyPath()) {
-                Item* changedInput = findInputItemFn(changedPath);
+                Item* changedInput = findAccessorItem(changedPath, true);
                 if (!changedInput) {
                     TF_DEBUG(USDMAYA_PROXYACCESSOR)
                         .Msg(
@@ -708,13 +783,9 @@ MStatus ProxyAccessor::stageChanged(const MObject& node, const UsdNotice::Object
                 MPlug&           changedPlug = changedInput->plug;
                 const Converter* converter = changedInput->converter;
 
-                SdfPath        changedPrimPath = changedPath.GetAbsoluteRootOrPrimPath();
-                const UsdPrim& changedPrim = stage->GetPrimAtPath(changedPrimPath);
-
-                const TfToken& changedPropertyToken = changedPath.GetNameToken();
-                UsdAttribute   changedAttribute = changedPrim.GetAttribute(changedPropertyToken);
+                resolveAccessorHandles(*changedInput, getUsdStage());
 
-                converter->convert(changedAttribute, changedPlug, args);
+                converter->convert(changedInput->attribute, changedPlug, args);
 
                 // When input plug is set, this value may be a new constant or
                 // just temporary value overriding what comes from animation curve.
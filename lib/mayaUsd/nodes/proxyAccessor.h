@@ -22,7 +22,10 @@
 
 #include <pxr/base/tf/notice.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/attributeQuery.h>
 #include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/timeCode.h>
 
@@ -31,6 +34,7 @@
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 #include <maya/MPxNode.h>
@@ -39,6 +43,7 @@
 #include <memory>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 
 PXR_NAMESPACE_OPEN_SCOPE
 class UsdGeomXformCache;
@@ -182,18 +187,35 @@ public:
 private:
     /*! \brief  Single item in acceleration structure holding.
         To avoid expensive searches during compute, we cache MPlug, SdfPath and converter needed
-       to translate values between data models.
+       to translate values between data models. The USD handles are resolved on first use and
+       resolved again after they have been invalidated by a change to the stage.
      */
     struct Item
     {
-        MPlug            plug;
-        SdfPath          path;
-        TfToken          property;
-        const Converter* converter = nullptr;
-        SyncId           syncId;
+        MPlug             plug;
+        SdfPath           path;
+        TfToken           property;
+        const Converter*  converter = nullptr;
+        SyncId            syncId;
+        UsdPrim           prim;      //!< Prim at path
+        UsdAttribute      attribute; //!< Attribute of property items
+        UsdAttributeQuery query;     //!< Value resolution of output attributes
+        SyncId            handlesSyncId;
     };
     using Container = std::vector<Item>;
 
+    struct ObjectHandleHash
+    {
+        size_t operator()(const MObjectHandle& handle) const { return handle.hashCode(); }
+    };
+
+    //! \brief  Maps accessor attributes to the index of their item
+    using AttributeIndex = std::unordered_map<MObjectHandle, size_t, ObjectHandleHash>;
+    //! \brief  Maps property paths to the index of their item
+    using PathIndex = std::unordered_map<SdfPath, size_t, SdfPath::Hash>;
+    //! \brief  Maps prim paths to the index of the items writing xform ops
+    using PrimPathIndex = std::unordered_multimap<SdfPath, size_t, SdfPath::Hash>;
+
     ProxyAccessor(ProxyStageProvider& provider)
         : _stageProvider(provider)
     {
@@ -216,8 +238,14 @@ private:
     void collectAccessorItems(MObject node);
     //! \brief  Invalidate acceleration structure
     void invalidateAccessorItems() { _validAccessorItems = false; }
+    //! \brief  Invalidate the USD handles cached by all the accessor items
+    void invalidateAccessorHandles() { _handlesId.next(); }
     //! \brief  Find accessor item in the acceleration structure
-    const Item* findAccessorItem(const MPlug& plug, bool isInput) const;
+    Item* findAccessorItem(const MPlug& plug, bool isInput);
+    //! \brief  Find accessor item of a property path in the acceleration structure
+    Item* findAccessorItem(const SdfPath& propertyPath, bool isInput);
+    //! \brief  Resolve the USD handles of the item, unless they are still valid
+    void resolveAccessorHandles(Item& item, const UsdStageRefPtr& stage);
 
     //! \brief  Notification from MPxNode to insert accessor plugs dependencies
     MStatus addDependentsDirty(const MPlug& plug, MPlugArray& plugArray);
@@ -230,13 +258,9 @@ private:
         MDataBlock&          dataBlock,
         const ConverterArgs& args);
     //! \brief  Using acceleration structure, do computation of a given accessor output plug.
-    MStatus computeOutput(
-        const Item&          outputItemToCompute,
-        const MMatrix&       proxyInclusiveMatrix,
-        const UsdStageRefPtr stage,
-        MDataBlock&          dataBlock,
-        UsdGeomXformCache&   xformCache,
-        const ConverterArgs& args);
+    //!         All the outputs computed in the same context share its xform cache.
+    MStatus
+    computeOutput(Item& outputItemToCompute, ComputeContext& context, MDataBlock& dataBlock);
 
     /*! \brief  Notification from MPxNode to synchronize evaluation cache with USD stage
         Each manipulation can mutate the state of USD, but not every manipulation will
@@ -266,6 +290,13 @@ private:
     //! \brief  Acceleration structure holding all output accessor plugs
     Container _accessorOutputItems;
 
+    //! \brief  Indices of the accessor items, to avoid linear searches in the containers
+    AttributeIndex _inputItemsByAttribute;
+    AttributeIndex _outputItemsByAttribute;
+    PathIndex      _inputItemsByPath;
+    PathIndex      _outputItemsByPath;
+    PrimPathIndex  _xformInputItemsByPrimPath;
+
     ComputeContext* _inCompute {
         nullptr
     }; //!< Detect nested compute and provide access to top level context
@@ -274,6 +305,12 @@ private:
     //! dependencies
     Id _evaluationId;
 
+    //! \brief  Current id of the USD handles cached by the accessor items. Changed to
+    //! invalidate all of them.
+    Id _handlesId;
+    //! \brief  Stage for which the USD handles have been resolved
+    UsdStageWeakPtr _handlesStage;
+
     //! \brief  Flag to indicate if acceleration structure is valid or needs to be recreated
     bool _validAccessorItems { false };
 
@@ -1238,6 +1238,8 @@ MStatus MayaUsdProxyShapeBase::computeOutStageData(MDataBlock& dataBlock)
     const bool isNormalContext = dataBlock.context().isNormal();
     if (isNormalContext) {
         TfReset(_boundingBoxCache);
+        _hasStaticBoundingBox = false;
+        _boundsCache.Clear();
 
         // Reset the stage listener until we determine that everything is valid.
         _stageNoticeListener.SetStage(UsdStageWeakPtr());
@@ -1512,12 +1514,34 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     dataBlock.inputValue(outStageDataAttr, &status);
     CHECK_MSTATUS_AND_RETURN(status, MBoundingBox());
 
-    // XXX:
-    // If we could cheaply determine whether a stage only has static geometry,
-    // we could make this value a constant one for that case, avoiding the
-    // memory overhead of a cache entry per frame
+    bool drawRenderPurpose = false;
+    bool drawProxyPurpose = true;
+    bool drawGuidePurpose = false;
+    _GetDrawPurposeToggles(dataBlock, &drawRenderPurpose, &drawProxyPurpose, &drawGuidePurpose);
+
+    TfTokenVector purposes { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
+
+    if (nonConstThis->_boundsCache.SetIncludedPurposes(purposes)) {
+        nonConstThis->_ClearBoundingBoxes();
+    }
+
     UsdTimeCode currTime = GetOutputTime(dataBlock);
 
+    // A stage only made of static geometry has the same bounding box at all the frames, so a
+    // single cache entry is used for it.
+    if (_hasStaticBoundingBox && !currTime.IsDefault()) {
+        return _staticBoundingBox;
+    }
+
     std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup
         = _boundingBoxCache.find(currTime);
 
@@ -1533,22 +1557,10 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
         return MBoundingBox();
     }
 
-    const UsdGeomImageable imageablePrim(prim);
-
-    bool drawRenderPurpose = false;
-    bool drawProxyPurpose = true;
-    bool drawGuidePurpose = false;
-    _GetDrawPurposeToggles(dataBlock, &drawRenderPurpose, &drawProxyPurpose, &drawGuidePurpose);
-
-    const TfToken purpose1 = UsdGeomTokens->default_;
-    const TfToken purpose2 = drawRenderPurpose ? UsdGeomTokens->render : TfToken();
-    const TfToken purpose3 = drawProxyPurpose ? UsdGeomTokens->proxy : TfToken();
-    const TfToken purpose4 = drawGuidePurpose ? UsdGeomTokens->guide : TfToken();
-
+    // Only the time-varying branches of the stage are recomputed when the time changes.
+    bool     isTimeVarying = false;
     GfBBox3d allBox
-        = imageablePrim.ComputeUntransformedBound(currTime, purpose1, purpose2, purpose3, purpose4);
-
-    UsdMayaUtil::AddMayaExtents(allBox, prim, currTime);
+        = nonConstThis->_boundsCache.ComputeUntransformedBound(prim, currTime, &isTimeVarying);
 
     Ufe::BBox3d pulledUfeBBox = ufe::getPulledPrimsBoundingBox(ufePath());
     if (!pulledUfeBBox.empty()) {
@@ -1556,9 +1568,15 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
             GfVec3d(pulledUfeBBox.min.x(), pulledUfeBBox.min.y(), pulledUfeBBox.min.z()),
             GfVec3d(pulledUfeBBox.max.x(), pulledUfeBBox.max.y(), pulledUfeBBox.max.z())));
         allBox = GfBBox3d::Combine(allBox, pulledBox);
+
+        // The pulled Maya nodes may be animated.
+        isTimeVarying = true;
     }
 
-    MBoundingBox& retval = nonConstThis->_boundingBoxCache[currTime];
+    const bool    isStatic = !isTimeVarying && !currTime.IsDefault();
+    MBoundingBox& retval = isStatic ? nonConstThis->_staticBoundingBox
+                                    : nonConstThis->_boundingBoxCache[currTime];
+    nonConstThis->_hasStaticBoundingBox = isStatic;
 
     const GfRange3d boxRange = allBox.ComputeAlignedBox();
 
@@ -1575,7 +1593,26 @@ MBoundingBox MayaUsdProxyShapeBase::boundingBox() const
     return retval;
 }
 
-void MayaUsdProxyShapeBase::clearBoundingBoxCache() { _boundingBoxCache.clear(); }
+void MayaUsdProxyShapeBase::clearBoundingBoxCache()
+{
+    _boundsCache.Clear();
+    _ClearBoundingBoxes();
+}
+
+void MayaUsdProxyShapeBase::invalidateBoundingBoxCache(
+    const UsdStageWeakPtr& stage,
+    const SdfPathVector&   resyncedPaths,
+    const SdfPathVector&   changedOnlyPaths)
+{
+    _boundsCache.Invalidate(stage, resyncedPaths, changedOnlyPaths);
+    _ClearBoundingBoxes();
+}
+
+void MayaUsdProxyShapeBase::_ClearBoundingBoxes()
+{
+    _boundingBoxCache.clear();
+    _hasStaticBoundingBox = false;
+}
 
 bool MayaUsdProxyShapeBase::isStageValid() const
 {
@@ -2076,10 +2113,10 @@ void MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChang
     case UsdMayaStageNoticeListener::ChangeType::kUpdate: ++_UsdStageUpdateCounter; break;
     }
 
-    // This will definitely force a BBox recomputation on "Frame All" or when framing a selected
-    // stage. Computing bounds in USD is expensive, so if it pops up in other frequently used
-    // scenarios we will have to investigate ways to make this cache clearing less expensive.
-    clearBoundingBoxCache();
+    // Only the bounds of the changed prims and of their ancestors are recomputed on the next
+    // bounding box request: the bounds of the rest of the stage stay cached.
+    _boundsCache.Invalidate(notice);
+    _ClearBoundingBoxes();
 
     ProxyAccessor::stageChanged(_usdAccessor, thisMObject(), notice);
     MayaUsdProxyStageObjectsChangedNotice(*this, notice).Send();
@@ -47,6 +47,7 @@ UFE_NS_DEF { class Path; }
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/listeners/stageNoticeListener.h>
 #include <mayaUsd/nodes/proxyAccessor.h>
+#include <mayaUsd/nodes/proxyShapeBoundsCache.h>
 #include <mayaUsd/nodes/proxyStageProvider.h>
 #include <mayaUsd/nodes/usdPrimProvider.h>
 
@@ -256,6 +257,15 @@ public:
     MAYAUSD_CORE_PUBLIC
     void clearBoundingBoxCache();
 
+    /// \brief  Clears the bounding boxes of the shape, but only drops the cached bounds of the
+    ///         given prims of \p stage, of their ancestors and of the descendants of the
+    ///         resynced prims.
+    MAYAUSD_CORE_PUBLIC
+    void invalidateBoundingBoxCache(
+        const UsdStageWeakPtr& stage,
+        const SdfPathVector&   resyncedPaths,
+        const SdfPathVector&   changedOnlyPaths);
+
     // returns the shape's parent transform
     MAYAUSD_CORE_PUBLIC
     MDagPath parentTransform();
@@ -391,6 +401,8 @@ private:
         bool*      drawProxyPurpose,
         bool*      drawGuidePurpose) const;
 
+    void _ClearBoundingBoxes();
+
     void _OnStageContentsChanged(const UsdNotice::StageContentsChanged& notice);
     void _OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
     void _OnLayerMutingChanged(const UsdNotice::LayerMutingChanged& notice);
@@ -401,6 +413,9 @@ private:
     UsdMayaStageNoticeListener _stageNoticeListener;
 
     std::map<UsdTimeCode, MBoundingBox> _boundingBoxCache;
+    MBoundingBox                        _staticBoundingBox;
+    bool                                _hasStaticBoundingBox { false };
+    MayaUsdProxyShapeBoundsCache        _boundsCache;
     size_t                              _excludePrimPathsVersion { 1 };
     size_t                              _UsdStageVersion { 1 };
 
@@ -0,0 +1,333 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "proxyShapeBoundsCache.h"
+
+#include <mayaUsd/utils/util.h>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/range3d.h>
+#include <pxr/base/trace/trace.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/primFlags.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/boundable.h>
+#include <pxr/usd/usdGeom/modelAPI.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+void _CombineBound(GfBBox3d* bound, const GfRange3d& range)
+{
+    if (!range.IsEmpty()) {
+        *bound = GfBBox3d::Combine(*bound, GfBBox3d(range));
+    }
+}
+
+bool _MightBeTimeVarying(const UsdPrim& prim)
+{
+    for (const UsdAttribute& attr : prim.GetAuthoredAttributes()) {
+        if (attr.ValueMightBeTimeVarying()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Prims in prototypes are cached through the paths of their instance proxies, which are not part
+// of the change notices.
+bool _IsInPrototype(const UsdStageWeakPtr& stage, const SdfPath& primPath)
+{
+    const UsdPrim prim = stage ? stage->GetPrimAtPath(primPath) : UsdPrim();
+    return prim && prim.IsInPrototype();
+}
+
+} // namespace
+
+bool MayaUsdProxyShapeBoundsCache::SetIncludedPurposes(const TfTokenVector& purposes)
+{
+    if (purposes == _purposes) {
+        return false;
+    }
+
+    Clear();
+    _purposes = purposes;
+    return true;
+}
+
+GfBBox3d MayaUsdProxyShapeBoundsCache::ComputeUntransformedBound(
+    const UsdPrim& prim,
+    UsdTimeCode    time,
+    bool*          isTimeVarying)
+{
+    TRACE_FUNCTION();
+
+    *isTimeVarying = false;
+    if (!prim) {
+        return GfBBox3d();
+    }
+
+    // The default value of an attribute may differ from its single time sample, so the entries
+    // computed at the default time cannot be shared with the ones computed at numeric times.
+    if (time.IsDefault() != _isDefaultTime) {
+        Clear();
+        _isDefaultTime = time.IsDefault();
+    }
+
+    UsdGeomImageable::PurposeInfo purposeInfo(UsdGeomTokens->default_, false);
+
+    const UsdGeomImageable imageable(prim);
+    if (imageable) {
+        *isTimeVarying = imageable.GetVisibilityAttr().ValueMightBeTimeVarying();
+        if (imageable.ComputeVisibility(time) == UsdGeomTokens->invisible) {
+            return GfBBox3d();
+        }
+
+        purposeInfo = imageable.ComputePurposeInfo();
+        if (purposeInfo.isInheritable && !_IsIncludedPurpose(purposeInfo.purpose)) {
+            return GfBBox3d();
+        }
+    }
+
+    const _Entry entry = _ComputeSubtreeBound(prim, purposeInfo, time);
+    *isTimeVarying = *isTimeVarying || entry.isTimeVarying;
+    return entry.bound;
+}
+
+void MayaUsdProxyShapeBoundsCache::Invalidate(const UsdNotice::ObjectsChanged& notice)
+{
+    _Invalidate(notice.GetStage(), notice.GetResyncedPaths(), notice.GetChangedInfoOnlyPaths());
+}
+
+void MayaUsdProxyShapeBoundsCache::Invalidate(
+    const UsdStageWeakPtr& stage,
+    const SdfPathVector&   resyncedPaths,
+    const SdfPathVector&   changedInfoOnlyPaths)
+{
+    _Invalidate(stage, resyncedPaths, changedInfoOnlyPaths);
+}
+
+template <typename PATHS>
+void MayaUsdProxyShapeBoundsCache::_Invalidate(
+    const UsdStageWeakPtr& stage,
+    const PATHS&           resyncedPaths,
+    const PATHS&           changedInfoOnlyPaths)
+{
+    if (_entries.empty()) {
+        return;
+    }
+
+    for (const SdfPath& path : resyncedPaths) {
+        const SdfPath primPath = path.GetPrimPath();
+        if (_IsInPrototype(stage, primPath)) {
+            Clear();
+            return;
+        }
+        _InvalidatePrim(primPath, path.IsAbsoluteRootOrPrimPath());
+    }
+
+    for (const SdfPath& path : changedInfoOnlyPaths) {
+        const SdfPath primPath = path.GetPrimPath();
+        if (_IsInPrototype(stage, primPath)) {
+            Clear();
+            return;
+        }
+
+        // The purpose is inherited, so changing it affects the bounds of all the descendants.
+        _InvalidatePrim(
+            primPath, path.IsPropertyPath() && path.GetNameToken() == UsdGeomTokens->purpose);
+    }
+}
+
+void MayaUsdProxyShapeBoundsCache::Clear() { _entries.clear(); }
+
+MayaUsdProxyShapeBoundsCache::_Entry MayaUsdProxyShapeBoundsCache::_ComputeSubtreeBound(
+    const UsdPrim&                       prim,
+    const UsdGeomImageable::PurposeInfo& purposeInfo,
+    UsdTimeCode                          time)
+{
+    const auto found = _entries.find(prim.GetPath());
+    if (found != _entries.end()) {
+        return found->second;
+    }
+
+    _Entry entry;
+    if (_ComputeOwnBound(prim, purposeInfo, time, &entry.bound, &entry.isTimeVarying)) {
+        if (!entry.isTimeVarying) {
+            _entries.emplace(prim.GetPath(), entry);
+        }
+        return entry;
+    }
+
+    GfMatrix4d primToWorld(1.0);
+    bool       hasPrimToWorld = false;
+
+    for (const UsdPrim& child :
+         prim.GetFilteredChildren(UsdTraverseInstanceProxies(UsdPrimDefaultPredicate))) {
+        // Like UsdGeomBBoxCache, only imageable prims contribute to the bounds.
+        const UsdGeomImageable imageable(child);
+        if (!imageable) {
+            continue;
+        }
+
+        const UsdAttribute visibilityAttr = imageable.GetVisibilityAttr();
+        if (visibilityAttr.ValueMightBeTimeVarying()) {
+            entry.isTimeVarying = true;
+        }
+        TfToken visibility;
+        if (visibilityAttr.Get(&visibility, time) && visibility == UsdGeomTokens->invisible) {
+            continue;
+        }
+
+        const UsdGeomImageable::PurposeInfo childPurposeInfo
+            = imageable.ComputePurposeInfo(purposeInfo);
+        if (childPurposeInfo.isInheritable && !_IsIncludedPurpose(childPurposeInfo.purpose)) {
+            continue;
+        }
+
+        const _Entry childEntry = _ComputeSubtreeBound(child, childPurposeInfo, time);
+        entry.isTimeVarying = entry.isTimeVarying || childEntry.isTimeVarying;
+        if (childEntry.bound.GetRange().IsEmpty()) {
+            continue;
+        }
+
+        // The cached bound of the child does not include its own transform, so that an animated
+        // transform does not require recomputing the bound of the subtree under it.
+        GfBBox3d               childBound = childEntry.bound;
+        const UsdGeomXformable xformable(child);
+        if (xformable) {
+            GfMatrix4d childXform(1.0);
+            bool       resetsXformStack = false;
+            xformable.GetLocalTransformation(&childXform, &resetsXformStack, time);
+            if (xformable.TransformMightBeTimeVarying()) {
+                entry.isTimeVarying = true;
+            }
+
+            if (resetsXformStack) {
+                // The child is placed in world space: bring it back in the space of this prim,
+                // which depends on the transforms of all its ancestors.
+                entry.isTimeVarying = true;
+                if (!hasPrimToWorld) {
+                    const UsdGeomImageable primImageable(prim);
+                    if (primImageable) {
+                        primToWorld = primImageable.ComputeLocalToWorldTransform(time);
+                    }
+                    hasPrimToWorld = true;
+                }
+                childXform *= primToWorld.GetInverse();
+            }
+
+            childBound.Transform(childXform);
+        }
+
+        entry.bound = GfBBox3d::Combine(entry.bound, childBound);
+    }
+
+    if (!entry.isTimeVarying) {
+        _entries.emplace(prim.GetPath(), entry);
+    }
+
+    return entry;
+}
+
+bool MayaUsdProxyShapeBoundsCache::_ComputeOwnBound(
+    const UsdPrim&                       prim,
+    const UsdGeomImageable::PurposeInfo& purposeInfo,
+    UsdTimeCode                          time,
+    GfBBox3d*                            bound,
+    bool*                                isTimeVarying) const
+{
+    // Returns true when the bound of the prim already covers all its descendants.
+
+    GfRange3d mayaExtent;
+    if (UsdMayaUtil::GetMayaExtent(prim, mayaExtent)) {
+        _CombineBound(bound, mayaExtent);
+    }
+
+    // An authored extentsHint holds the bounds of the whole model, one pair of min and max per
+    // purpose, ordered like UsdGeomImageable::GetOrderedPurposeTokens().
+    if (prim.IsModel()) {
+        const UsdAttribute extentsHintAttr = UsdGeomModelAPI(prim).GetExtentsHintAttr();
+        VtVec3fArray       extentsHint;
+        if (extentsHintAttr && extentsHintAttr.Get(&extentsHint, time)) {
+            *isTimeVarying = *isTimeVarying || extentsHintAttr.ValueMightBeTimeVarying();
+
+            const TfTokenVector& purposes = UsdGeomImageable::GetOrderedPurposeTokens();
+            for (size_t i = 0; i < purposes.size() && 2 * i + 1 < extentsHint.size(); ++i) {
+                if (_IsIncludedPurpose(purposes[i])) {
+                    _CombineBound(bound, GfRange3d(extentsHint[2 * i], extentsHint[2 * i + 1]));
+                }
+            }
+            return true;
+        }
+    }
+
+    if (!_IsIncludedPurpose(purposeInfo.purpose)) {
+        return false;
+    }
+
+    const UsdGeomBoundable boundable(prim);
+    if (!boundable) {
+        return false;
+    }
+
+    VtVec3fArray       extent;
+    const UsdAttribute extentAttr = boundable.GetExtentAttr();
+    if (extentAttr.HasAuthoredValue()) {
+        extentAttr.Get(&extent, time);
+        *isTimeVarying = *isTimeVarying || extentAttr.ValueMightBeTimeVarying();
+    } else {
+        // The computed extent depends on other attributes of the prim, like its points.
+        UsdGeomBoundable::ComputeExtentFromPlugins(boundable, time, &extent);
+        *isTimeVarying = *isTimeVarying || _MightBeTimeVarying(prim);
+    }
+
+    if (extent.size() == 2) {
+        _CombineBound(bound, GfRange3d(extent[0], extent[1]));
+    }
+
+    return false;
+}
+
+bool MayaUsdProxyShapeBoundsCache::_IsIncludedPurpose(const TfToken& purpose) const
+{
+    return std::find(_purposes.begin(), _purposes.end(), purpose) != _purposes.end();
+}
+
+void MayaUsdProxyShapeBoundsCache::_InvalidatePrim(
+    const SdfPath& primPath,
+    bool           invalidateDescendants)
+{
+    // The bound of every ancestor includes the bound of the prim.
+    for (SdfPath path = primPath; !path.IsEmpty(); path = path.GetParentPath()) {
+        _entries.erase(path);
+    }
+
+    if (invalidateDescendants) {
+        // Paths sort with their descendants right after them.
+        auto it = _entries.lower_bound(primPath);
+        while (it != _entries.end() && it->first.HasPrefix(primPath)) {
+            it = _entries.erase(it);
+        }
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,113 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYAUSD_PROXY_SHAPE_BOUNDS_CACHE_H
+#define MAYAUSD_PROXY_SHAPE_BOUNDS_CACHE_H
+
+#include <mayaUsd/base/api.h>
+
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/timeCode.h>
+#include <pxr/usd/usdGeom/imageable.h>
+
+#include <map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \class MayaUsdProxyShapeBoundsCache
+/// \brief Hierarchical cache of the untransformed bounds of the prims of a proxy shape stage.
+///
+/// The bound of each prim subtree is computed in the local space of the prim and remembered
+/// along with whether it can change over time. Subtrees that cannot change are only computed
+/// once, so that evaluating the bound at a new time only revisits the animated branches of the
+/// stage. Authored extent and extentsHint attributes are used when available instead of
+/// computing the extent of the geometry. Maya-specific extents, like the ones of the cameras,
+/// are included as well.
+///
+/// Entries are invalidated incrementally from the ObjectsChanged notices of the stage: only the
+/// changed prims and their ancestors are dropped, along with the descendants of resynced prims.
+class MayaUsdProxyShapeBoundsCache
+{
+public:
+    /// \brief Set the purposes of the prims included in the bounds. The cache is cleared and
+    /// true is returned when they differ from the current ones.
+    MAYAUSD_CORE_PUBLIC
+    bool SetIncludedPurposes(const TfTokenVector& purposes);
+
+    /// \brief Compute the bound of the subtree of \p prim at \p time, without the transform of
+    /// \p prim itself. \p isTimeVarying is set to whether the bound can change over time.
+    MAYAUSD_CORE_PUBLIC
+    GfBBox3d ComputeUntransformedBound(const UsdPrim& prim, UsdTimeCode time, bool* isTimeVarying);
+
+    /// \brief Drop the entries affected by the changes described in \p notice.
+    MAYAUSD_CORE_PUBLIC
+    void Invalidate(const UsdNotice::ObjectsChanged& notice);
+
+    /// \brief Drop the entries affected by the changes of \p resyncedPaths and
+    /// \p changedInfoOnlyPaths in \p stage, for changes accumulated over several notices.
+    MAYAUSD_CORE_PUBLIC
+    void Invalidate(
+        const UsdStageWeakPtr& stage,
+        const SdfPathVector&   resyncedPaths,
+        const SdfPathVector&   changedInfoOnlyPaths);
+
+    /// \brief Drop all entries.
+    MAYAUSD_CORE_PUBLIC
+    void Clear();
+
+private:
+    struct _Entry
+    {
+        GfBBox3d bound;
+        bool     isTimeVarying { false };
+    };
+
+    _Entry _ComputeSubtreeBound(
+        const UsdPrim&                       prim,
+        const UsdGeomImageable::PurposeInfo& purposeInfo,
+        UsdTimeCode                          time);
+
+    bool _ComputeOwnBound(
+        const UsdPrim&                       prim,
+        const UsdGeomImageable::PurposeInfo& purposeInfo,
+        UsdTimeCode                          time,
+        GfBBox3d*                            bound,
+        bool*                                isTimeVarying) const;
+
+    bool _IsIncludedPurpose(const TfToken& purpose) const;
+
+    template <typename PATHS>
+    void _Invalidate(
+        const UsdStageWeakPtr& stage,
+        const PATHS&           resyncedPaths,
+        const PATHS&           changedInfoOnlyPaths);
+
+    void _InvalidatePrim(const SdfPath& primPath, bool invalidateDescendants);
+
+    // Only the entries that do not vary over time are kept. They are sorted by path so that the
+    // entries of a subtree are contiguous.
+    std::map<SdfPath, _Entry> _entries;
+    TfTokenVector             _purposes;
+    bool                      _isDefaultTime { false };
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -40,6 +40,7 @@ TF_WRAP_MODULE
     TF_WRAP(OpUndoItem);
     TF_WRAP(Query);
     TF_WRAP(ReadUtil);
+    TF_WRAP(RenderDelegate);
     TF_WRAP(RoundTripUtil);
     TF_WRAP(StageCache);
     TF_WRAP(Tokens);
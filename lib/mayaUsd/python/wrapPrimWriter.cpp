@@ -583,6 +583,7 @@ void wrapJobExportArgs()
         .def_readonly("normalizeNurbs", &UsdMayaJobExportArgs::normalizeNurbs)
         .def_readonly("preserveUVSetNames", &UsdMayaJobExportArgs::preserveUVSetNames)
         .def_readonly("writeDefaults", &UsdMayaJobExportArgs::writeDefaults)
+        .def_readonly("parallelFrameWrite", &UsdMayaJobExportArgs::parallelFrameWrite)
         .add_property(
             "parentScope",
             make_getter(&UsdMayaJobExportArgs::parentScope, return_value_policy<return_by_value>()))
@@ -608,6 +609,7 @@ void wrapJobExportArgs()
         .add_property(
             "timeSamples",
             make_getter(&UsdMayaJobExportArgs::timeSamples, return_value_policy<return_by_value>()))
+        .def_readonly("timeSampleChunkSize", &UsdMayaJobExportArgs::timeSampleChunkSize)
         .add_property(
             "usdModelRootOverridePath",
             make_getter(
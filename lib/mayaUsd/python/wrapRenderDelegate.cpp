@@ -0,0 +1,31 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
+
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/pxr.h>
+
+#include <boost/python/def.hpp>
+
+using namespace boost::python;
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+void wrapRenderDelegate()
+{
+    def("GetVP2RenderDelegateStatistics", ProxyRenderDelegate::GetStatistics);
+    def("ClearVP2RenderDelegateShaderCache", ProxyRenderDelegate::ClearShaderCache);
+}
@@ -68,6 +68,12 @@ void _trackLayerStates(const SdfLayerHandle& layer)
     UsdUfe::UsdUndoManager::instance().trackLayerStates(layer);
 }
 
+void _setMemoryBudget(size_t budget) { UsdUfe::UsdUndoManager::instance().setMemoryBudget(budget); }
+
+size_t _getMemoryBudget() { return UsdUfe::UsdUndoManager::instance().memoryBudget(); }
+
+size_t _getMemoryUsage() { return UsdUfe::UsdUndoManager::instance().memoryUsage(); }
+
 } // namespace
 
 void wrapUsdUndoManager()
@@ -77,7 +83,13 @@ void wrapUsdUndoManager()
         typedef UsdUfe::UsdUndoManager This;
         class_<This, boost::noncopyable>("UsdUndoManager", no_init)
             .def("trackLayerStates", &_trackLayerStates)
-            .staticmethod("trackLayerStates");
+            .staticmethod("trackLayerStates")
+            .def("setMemoryBudget", &_setMemoryBudget)
+            .staticmethod("setMemoryBudget")
+            .def("getMemoryBudget", &_getMemoryBudget)
+            .staticmethod("getMemoryBudget")
+            .def("getMemoryUsage", &_getMemoryUsage)
+            .staticmethod("getMemoryUsage");
     }
 
     // UsdUndoBlock
@@ -149,7 +149,13 @@ string GlslFragmentSyntax::getVariableName(
 const string GlslFragmentGenerator::MATRIX3_TO_MATRIX4_POSTFIX = "4";
 
 GlslFragmentGenerator::GlslFragmentGenerator()
+    : GlslFragmentGenerator(OgsXmlGenerator::getPrimaryUVSetName())
+{
+}
+
+GlslFragmentGenerator::GlslFragmentGenerator(const string& primaryUVSetName)
     : GlslShaderGenerator()
+    , _primaryUVSetName(primaryUVSetName)
 {
     // Use our custom syntax class
     _syntax = std::make_shared<GlslFragmentSyntax>();
@@ -173,7 +179,7 @@ GlslFragmentGenerator::GlslFragmentGenerator()
         _tokenSubstitutions[HW::T_NUM_ACTIVE_LIGHT_SOURCES] = "g_numActiveLightSources";
     }
 
-    if (!OgsXmlGenerator::getPrimaryUVSetName().empty()) {
+    if (!_primaryUVSetName.empty()) {
         registerImplementation(
             "IM_texcoord_vector2_" + GlslShaderGenerator::TARGET, TexcoordNodeGlslMaya::create);
         registerImplementation(
@@ -190,6 +196,11 @@ ShaderGeneratorPtr GlslFragmentGenerator::create()
     return std::make_shared<GlslFragmentGenerator>();
 }
 
+ShaderGeneratorPtr GlslFragmentGenerator::create(const string& primaryUVSetName)
+{
+    return std::make_shared<GlslFragmentGenerator>(primaryUVSetName);
+}
+
 ShaderPtr GlslFragmentGenerator::createShader(
     const string& name,
     ElementPtr    element,
@@ -62,7 +62,11 @@ class GlslFragmentGenerator : public GlslShaderGenerator
 public:
     GlslFragmentGenerator();
 
+    /// Replaces every texcoord use with the given UV set name, unless it is empty.
+    explicit GlslFragmentGenerator(const string& primaryUVSetName);
+
     static ShaderGeneratorPtr create();
+    static ShaderGeneratorPtr create(const string& primaryUVSetName);
 
     ShaderPtr createShader(const string& name, ElementPtr, GenContext&) const override;
     ShaderPtr generate(const string& name, ElementPtr, GenContext&) const override;
@@ -78,8 +82,14 @@ public:
 
     static const string MATRIX3_TO_MATRIX4_POSTFIX;
 
+    /// UV set name replacing every texcoord use, empty if they generate their usual code.
+    const string& getPrimaryUVSetName() const { return _primaryUVSetName; }
+
 protected:
     static void toVec3(const TypeDesc* type, string& variable);
+
+private:
+    string _primaryUVSetName;
 };
 
 MATERIALX_NAMESPACE_END
@@ -27,6 +27,7 @@
 
 #include <cstring>
 #include <map>
+#include <mutex>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -73,6 +74,9 @@ struct OcioData
     std::string              sourceCode;
 };
 
+// The fragments are registered on the main thread, while the shaders can be generated on worker
+// threads. The entries are never removed, so references to them stay valid once unlocked.
+std::mutex                      knownOCIOMutex;
 std::map<std::string, OcioData> knownOCIOFragments;
 std::vector<std::string>        knownOCIOImplementations;
 DocumentPtr                     knownLibrary;
@@ -93,6 +97,8 @@ const OcioData& getOcioData(const std::string& implName)
     auto nodeName = implName.substr(
         OCIO_IM_PREFIX_LEN - 1, implName.size() - OCIO_IM_PREFIX_LEN - OCIO_COLOR3_LEN + 1);
 
+    std::lock_guard<std::mutex> lock(knownOCIOMutex);
+
     auto it = knownOCIOFragments.find(nodeName);
     if (it == knownOCIOFragments.end()) {
         throw std::runtime_error("Missing OCIO data");
@@ -142,8 +148,11 @@ public:
 
 std::string GlslOcioNodeImpl::registerOCIOFragment(const std::string& fragName)
 {
-    if (knownOCIOFragments.count(fragName)) {
-        return getUntypedNodeDefName(fragName);
+    {
+        std::lock_guard<std::mutex> lock(knownOCIOMutex);
+        if (knownOCIOFragments.count(fragName)) {
+            return getUntypedNodeDefName(fragName);
+        }
     }
 
     MHWRender::MRenderer* theRenderer = MHWRender::MRenderer::theRenderer();
@@ -241,6 +250,7 @@ std::string GlslOcioNodeImpl::registerOCIOFragment(const std::string& fragName)
 
     // We now have all the data we need. Preserve the info and add our new OCIO NodeDef in the
     // library.
+    std::lock_guard<std::mutex> lock(knownOCIOMutex);
     addOCIONodeDef(ocioData, OCIO_COLOR3);
     addOCIONodeDef(ocioData, OCIO_COLOR4);
     knownOCIOFragments.emplace(fragName, std::move(ocioData));
@@ -248,10 +258,15 @@ std::string GlslOcioNodeImpl::registerOCIOFragment(const std::string& fragName)
     return getUntypedNodeDefName(fragName);
 }
 
-DocumentPtr GlslOcioNodeImpl::getOCIOLibrary() { return knownLibrary; }
+DocumentPtr GlslOcioNodeImpl::getOCIOLibrary()
+{
+    std::lock_guard<std::mutex> lock(knownOCIOMutex);
+    return knownLibrary;
+}
 
-const std::vector<std::string>& GlslOcioNodeImpl::getOCIOImplementations()
+std::vector<std::string> GlslOcioNodeImpl::getOCIOImplementations()
 {
+    std::lock_guard<std::mutex> lock(knownOCIOMutex);
     return knownOCIOImplementations;
 }
 
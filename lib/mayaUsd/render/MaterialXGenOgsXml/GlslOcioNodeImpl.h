@@ -43,11 +43,12 @@ public:
     /// Prepare all data structures to handle an internal Maya OCIO fragment:
     static std::string registerOCIOFragment(const std::string& fragName);
 
-    /// Get a library with all known internal Maya OCIO fragment:
+    /// Get a library with all known internal Maya OCIO fragment. It is only extended by
+    /// registerOCIOFragment, so it must only be read on the thread registering the fragments:
     static DocumentPtr getOCIOLibrary();
 
-    /// Returns the full list of internal Maya OCIO fragment we can implement:
-    static const std::vector<std::string>& getOCIOImplementations();
+    /// Returns a copy of the full list of internal Maya OCIO fragment we can implement:
+    static std::vector<std::string> getOCIOImplementations();
 };
 
 MATERIALX_NAMESPACE_END
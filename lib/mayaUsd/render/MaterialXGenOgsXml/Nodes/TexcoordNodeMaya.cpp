@@ -6,16 +6,19 @@
 #include "TexcoordNodeMaya.h"
 
 #include <mayaUsd/render/MaterialXGenOgsXml/CombinedMaterialXVersion.h>
-#include <mayaUsd/render/MaterialXGenOgsXml/OgsXmlGenerator.h>
+#include <mayaUsd/render/MaterialXGenOgsXml/GlslFragmentGenerator.h>
 
 #include <MaterialXGenShader/Shader.h>
 
 MATERIALX_NAMESPACE_BEGIN
 
 namespace {
-std::string geomNameFromIndex(const std::string& index)
+std::string geomNameFromIndex(const std::string& index, const GenContext& context)
 {
-    std::string geomname = OgsXmlGenerator::getPrimaryUVSetName();
+    // The Maya texcoord implementations are only registered by the fragment generator.
+    std::string geomname
+        = static_cast<const GlslFragmentGenerator&>(context.getShaderGenerator())
+              .getPrimaryUVSetName();
 
     // The code below which is trying to handle non-zero indices has little chance of working. Main
     // reason is that our main client (USD) will only handle UV0 by adding an extra primvar in the
@@ -51,8 +54,10 @@ ShaderNodeImplPtr TexcoordNodeGlslMaya::create()
     return std::make_shared<TexcoordNodeGlslMaya>();
 }
 
-void TexcoordNodeGlslMaya::createVariables(const ShaderNode& node, GenContext&, Shader& shader)
-    const
+void TexcoordNodeGlslMaya::createVariables(
+    const ShaderNode& node,
+    GenContext&       context,
+    Shader&           shader) const
 {
     const ShaderInput* indexInput = node.getInput(INDEX);
     if (!indexInput || !indexInput->getValue()) {
@@ -62,7 +67,7 @@ void TexcoordNodeGlslMaya::createVariables(const ShaderNode& node, GenContext&,
     }
     // Use the standard USD convention for texcoord primvar names:
     const string        index = indexInput ? indexInput->getValue()->getValueString() : "0";
-    const string        geomProp = geomNameFromIndex(index);
+    const string        geomProp = geomNameFromIndex(index, context);
     const ShaderOutput* output = node.getOutput();
 
     ShaderStage& vs = shader.getStage(Stage::VERTEX);
@@ -89,7 +94,7 @@ void TexcoordNodeGlslMaya::emitFunctionCall(
     }
     // Use the standard USD convention for texcoord primvar names:
     const string index = indexInput ? indexInput->getValue()->getValueString() : "0";
-    const string geomname = geomNameFromIndex(index);
+    const string geomname = geomNameFromIndex(index, context);
     const string variable = HW::T_IN_GEOMPROP + "_" + geomname;
 
 #if MX_COMBINED_VERSION >= 13807
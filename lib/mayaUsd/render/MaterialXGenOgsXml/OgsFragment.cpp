@@ -168,9 +168,13 @@ private:
 class LocalGlslGeneratorWrapper : public GlslGeneratorWrapperBase
 {
 public:
-    LocalGlslGeneratorWrapper(mx::ElementPtr element, const mx::FileSearchPath& librarySearchPath)
+    LocalGlslGeneratorWrapper(
+        mx::ElementPtr            element,
+        const mx::FileSearchPath& librarySearchPath,
+        const std::string&        primaryUVSetName)
         : GlslGeneratorWrapperBase(element)
         , _librarySearchPath(librarySearchPath)
+        , _primaryUVSetName(primaryUVSetName)
     {
     }
 
@@ -178,7 +182,7 @@ public:
 
     mx::ShaderPtr operator()(const std::string& baseFragmentName)
     {
-        mx::ShaderGeneratorPtr generator = mx::GlslFragmentGenerator::create();
+        mx::ShaderGeneratorPtr generator = mx::GlslFragmentGenerator::create(_primaryUVSetName);
         mx::GenContext         genContext(generator);
         mx::GenOptions&        genOptions = genContext.getOptions();
 
@@ -243,6 +247,7 @@ public:
     }
 
     const mx::FileSearchPath& _librarySearchPath;
+    const std::string         _primaryUVSetName;
 };
 
 // Wraps an externally-provided GLSL fragment generator (such as the one
@@ -371,7 +376,18 @@ std::string generateLightRig(
 } // anonymous namespace
 
 OgsFragment::OgsFragment(mx::ElementPtr element, const mx::FileSearchPath& librarySearchPath)
-    : OgsFragment(element, LocalGlslGeneratorWrapper(element, librarySearchPath))
+    : OgsFragment(
+        element,
+        LocalGlslGeneratorWrapper(
+            element, librarySearchPath, mx::OgsXmlGenerator::getPrimaryUVSetName()))
+{
+}
+
+OgsFragment::OgsFragment(
+    mx::ElementPtr            element,
+    const mx::FileSearchPath& librarySearchPath,
+    const std::string&        primaryUVSetName)
+    : OgsFragment(element, LocalGlslGeneratorWrapper(element, librarySearchPath, primaryUVSetName))
 {
 }
 
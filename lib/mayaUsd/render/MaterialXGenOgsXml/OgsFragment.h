@@ -24,6 +24,14 @@ public:
     /// Creates a local GLSL fragment generator
     OgsFragment(mx::ElementPtr, const mx::FileSearchPath& librarySearchPath);
 
+    /// Creates a local GLSL fragment generator replacing every texcoord use with the given UV set
+    /// name, unless it is empty. Unlike the global UV set name of OgsXmlGenerator, it can be used
+    /// by concurrent generations.
+    OgsFragment(
+        mx::ElementPtr,
+        const mx::FileSearchPath& librarySearchPath,
+        const std::string&        primaryUVSetName);
+
     /// Reuses an externally-provided GLSL fragment generator. Used in the test
     /// harness.
     OgsFragment(mx::ElementPtr, mx::GenContext&);
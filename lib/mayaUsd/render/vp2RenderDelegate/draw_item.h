@@ -57,6 +57,9 @@ public:
         //! Render item index buffer - use when updating data
         std::unique_ptr<MHWRender::MIndexBuffer> _indexBuffer;
         bool                                     _indexBufferValid { false };
+        //! Index buffer shared with the meshes having the same topology, used instead of
+        //! _indexBuffer when set
+        std::shared_ptr<MHWRender::MIndexBuffer> _sharedIndexBuffer;
         //! Bounding box of the render item.
         MBoundingBox _boundingBox;
         //! World matrix of the render item.
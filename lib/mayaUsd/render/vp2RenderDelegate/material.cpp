@@ -27,6 +27,7 @@
 #include <mayaUsd/render/vp2ShaderFragments/shaderFragments.h>
 #include <mayaUsd/utils/hash.h>
 
+#include <pxr/base/arch/hash.h>
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/matrix4f.h>
 #include <pxr/base/gf/vec2f.h>
@@ -35,6 +36,7 @@
 #include <pxr/base/tf/diagnostic.h>
 #include <pxr/base/tf/getenv.h>
 #include <pxr/base/tf/pathUtils.h>
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 
 #ifdef WANT_MATERIALX_BUILD
@@ -70,6 +72,7 @@
 #include <mayaUsd/render/MaterialXGenOgsXml/ShaderGenUtil.h>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/Util.h>
 #include <MaterialXFormat/File.h>
 #include <MaterialXFormat/Util.h>
 #include <MaterialXGenGlsl/GlslShaderGenerator.h>
@@ -84,10 +87,22 @@
 
 #include <ghc/filesystem.hpp>
 #include <tbb/parallel_for.h>
-
+#include <tbb/task_group.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -106,6 +121,54 @@ static bool _IsDisabledAsyncTextureLoading()
     return true;
 }
 
+static size_t _GetAsyncTextureLoadingThreads()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->AsyncTextureLoadingThreads.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        const int numThreads = MGlobal::optionVarIntValue(kOptionVarName);
+        if (numThreads > 0) {
+            return static_cast<size_t>(numThreads);
+        }
+    }
+    // Leave half of the cores to Maya evaluation and to the Hydra sync.
+    return std::max<size_t>(std::thread::hardware_concurrency() / 2, 1);
+}
+
+// Texture memory budget, in bytes. Zero when there is no budget.
+static size_t _GetTextureMemoryBudget()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->TextureMemoryBudget.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        const int budgetInMB = MGlobal::optionVarIntValue(kOptionVarName);
+        if (budgetInMB > 0) {
+            return static_cast<size_t>(budgetInMB) << 20;
+        }
+    }
+    return 0;
+}
+
+// Largest dimension of the textures. Zero when loading textures at full resolution.
+static unsigned int _GetTextureMaxResolution()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->TextureMaxResolution.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        const int maxResolution = MGlobal::optionVarIntValue(kOptionVarName);
+        if (maxResolution > 0) {
+            return static_cast<unsigned int>(maxResolution);
+        }
+    }
+    return 0;
+}
+
+static std::string _GetTextureCacheDirectory()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->TextureCacheDirectory.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        return MGlobal::optionVarStringValue(kOptionVarName).asChar();
+    }
+    return std::string();
+}
+
 // Refresh viewport duration (in milliseconds)
 static const std::size_t kRefreshDuration { 1000 };
 
@@ -168,6 +231,184 @@ private:
     bool                                          _isExiting = false;
 };
 
+//! Keeps track of the memory used by the loaded textures, in least recently used order.
+//! When a memory budget is set, the textures which are no longer used by any material are
+//! kept loaded so they can be reused, until the budget is exceeded and the least recently
+//! used of them are evicted. If the budget is still exceeded, new textures are loaded at a
+//! reduced resolution. Only accessed from the main thread.
+class _TextureResidency
+{
+public:
+    static constexpr unsigned int kMaxResolution = 16384;
+    static constexpr unsigned int kMinResolution = 256;
+
+    static _TextureResidency& GetInstance()
+    {
+        static _TextureResidency sInstance;
+        return sInstance;
+    }
+
+    //! Start tracking a newly loaded texture.
+    void Add(const std::string& path, const HdVP2TextureInfoSharedPtr& info, size_t budget)
+    {
+        _Remove(path);
+        _SetBudget(budget);
+
+        _Entry entry;
+        entry.path = path;
+        entry.info = info;
+        if (budget > 0) {
+            entry.retained = info;
+        }
+        entry.sizeInBytes = _GetTextureSize(*info);
+        _lru.push_front(std::move(entry));
+        _entries[path] = _lru.begin();
+        _residentBytes += _lru.front().sizeInBytes;
+
+        Evict(budget);
+    }
+
+    //! Mark the texture as the most recently used one.
+    void Touch(const std::string& path, size_t budget)
+    {
+        const auto it = _entries.find(path);
+        if (it != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, it->second);
+        }
+
+        Evict(budget);
+    }
+
+    //! Evict the least recently used textures no longer used by any material, starting from
+    //! the tail, until the resident textures fit in the budget. The textures found still in
+    //! use are moved to the front, and only a few of them are visited by each call so that
+    //! tracking a texture does not depend on the number of resident ones.
+    void Evict(size_t budget)
+    {
+        _SetBudget(budget);
+
+        for (size_t numInUse = 0; !_lru.empty() && numInUse < kMaxInUseVisits;) {
+            const auto it = std::prev(_lru.end());
+            if (it->info.expired()) {
+                _Erase(it);
+                continue;
+            }
+            // Textures tracked before the budget was set are retained once they are reached.
+            if (budget > 0 && !it->retained) {
+                it->retained = it->info.lock();
+            }
+            if (!it->retained || it->retained.use_count() > 1) {
+                _lru.splice(_lru.begin(), _lru, it);
+                ++numInUse;
+                continue;
+            }
+            if (_residentBytes <= budget) {
+                break;
+            }
+            TF_DEBUG(HDVP2_DEBUG_MATERIAL)
+                .Msg("Evicting texture '%s' (%zu bytes)\n", it->path.c_str(), it->sizeInBytes);
+            _Erase(it);
+        }
+    }
+
+    //! Returns the largest resolution of a new texture fitting in the remaining budget,
+    //! or zero if there is no budget.
+    unsigned int GetMaxResolution(size_t budget) const
+    {
+        if (budget == 0) {
+            return 0;
+        }
+        const size_t available = (budget > _residentBytes) ? budget - _residentBytes : 0;
+        // Assume 4 bytes per texel, as for 8-bit RGBA textures.
+        unsigned int resolution = kMaxResolution;
+        while (resolution > kMinResolution
+               && static_cast<size_t>(resolution) * resolution * 4 > available) {
+            resolution /= 2;
+        }
+        return resolution;
+    }
+
+    size_t GetResidentBytes() const { return _residentBytes; }
+    size_t GetNumResidentTextures() const { return _lru.size(); }
+    size_t GetNumEvictedTextures() const { return _numEvicted; }
+
+    void Clear()
+    {
+        _lru.clear();
+        _entries.clear();
+        _residentBytes = 0;
+    }
+
+private:
+    _TextureResidency() = default;
+    ~_TextureResidency() = default;
+
+    //! Number of textures in use visited by each eviction.
+    static constexpr size_t kMaxInUseVisits = 4;
+
+    static size_t _GetTextureSize(const HdVP2TextureInfo& info)
+    {
+        if (!info._texture) {
+            return 0;
+        }
+        MHWRender::MTextureDescription desc;
+        info._texture->textureDescription(desc);
+        return static_cast<size_t>(desc.fWidth) * desc.fHeight * info._texture->bytesPerPixel();
+    }
+
+    struct _Entry
+    {
+        std::string               path;
+        HdVP2TextureInfoWeakPtr   info;
+        HdVP2TextureInfoSharedPtr retained; //!< Set when a budget is set
+        size_t                    sizeInBytes { 0 };
+    };
+
+    using _EntryList = std::list<_Entry>;
+
+    //! Release the retained textures when the budget is removed, which is not expected often.
+    void _SetBudget(size_t budget)
+    {
+        if (budget == 0 && _budget > 0) {
+            for (auto it = _lru.begin(); it != _lru.end();) {
+                if (it->retained.use_count() == 1) {
+                    it = _Erase(it);
+                } else {
+                    it->retained.reset();
+                    ++it;
+                }
+            }
+        }
+        _budget = budget;
+    }
+
+    _EntryList::iterator _Erase(_EntryList::iterator it)
+    {
+        if (it->retained) {
+            ++_numEvicted;
+        }
+        _residentBytes -= it->sizeInBytes;
+        _entries.erase(it->path);
+        return _lru.erase(it);
+    }
+
+    void _Remove(const std::string& path)
+    {
+        const auto it = _entries.find(path);
+        if (it != _entries.end()) {
+            _residentBytes -= it->second->sizeInBytes;
+            _lru.erase(it->second);
+            _entries.erase(it);
+        }
+    }
+
+    _EntryList                                            _lru;
+    std::unordered_map<std::string, _EntryList::iterator> _entries;
+    size_t                                                _residentBytes { 0 };
+    size_t                                                _budget { 0 };
+    size_t                                                _numEvicted { 0 };
+};
+
 // clang-format off
 TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
@@ -518,6 +759,36 @@ size_t _GenerateNetwork2TopoHash(const HdMaterialNetwork2& materialNetwork)
     return topoHash;
 }
 
+//! Helper function to serialize the nodes, parameters and relationships of the material network.
+//  It only depends on the content of the network, so it identifies the network exactly, within a
+//  session and across sessions.
+std::string _GenerateNetwork2Fingerprint(const HdMaterialNetwork2& materialNetwork)
+{
+    // The parameter values are prefixed by their length, since strings can hold any character.
+    std::ostringstream result;
+    for (const auto& c : materialNetwork.terminals) {
+        result << "terminal " << c.first << ' ' << c.second.upstreamNode << '.'
+               << c.second.upstreamOutputName << '\n';
+    }
+    for (const auto& nodePair : materialNetwork.nodes) {
+        const auto& node = nodePair.second;
+        result << "node " << nodePair.first << ' ' << node.nodeTypeId << '\n';
+        for (auto const& p : node.parameters) {
+            const std::string value = TfStringify(p.second);
+            result << "param " << p.first << ' ' << p.second.GetTypeName() << ' ' << value.size()
+                   << ' ' << value << '\n';
+        }
+        for (auto const& i : node.inputConnections) {
+            result << "input " << i.first;
+            for (auto const& c : i.second) {
+                result << ' ' << c.upstreamNode << '.' << c.upstreamOutputName;
+            }
+            result << '\n';
+        }
+    }
+    return result.str();
+}
+
 //! Helper function to generate a XML string about nodes, relationships and primvars in the
 //! specified material network.
 std::string _GenerateXMLString(const HdMaterialNetwork2& materialNetwork)
@@ -920,6 +1191,499 @@ void _AddMissingTangents(mx::DocumentPtr& mtlxDoc)
     }
 }
 
+//! OGS fragment generated for a MaterialX network, with what the shader instance needs from the
+//! code generation.
+struct _MtlxFragment
+{
+    std::string   name;                    //!< Name of the fragment
+    std::string   source;                  //!< XML source of the fragment
+    mx::StringMap pathInputMap;            //!< Maps MaterialX element paths to fragment input names
+    bool          requiresNormals = false; //!< Whether the vertex shader reads the normals
+};
+
+std::atomic_size_t gNumMtlxFragmentCacheReads { 0 };
+std::atomic_size_t gNumGeneratedMtlxFragments { 0 };
+std::atomic_size_t gNumMtlxFallbackShaders { 0 };
+
+constexpr char   kMtlxFragmentCacheMagic[] = "MUSDFRAG";
+constexpr int    kMtlxFragmentCacheVersion = 2;
+constexpr size_t kMtlxFragmentCacheMaxStringSize = size_t(1) << 28;
+
+//! Directory caching the generated fragments across sessions, empty when there is no disk cache.
+std::string _GetMtlxFragmentCacheDirectory()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->MaterialXCacheDirectory.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        return MGlobal::optionVarStringValue(kOptionVarName).asChar();
+    }
+    return std::string();
+}
+
+//! Returns everything besides the material network affecting the generated fragments. It is
+//! hashed in the name of the cache files and stored in them, so that a fragment generated by
+//! another version of MaterialX, Maya or MayaUsd, or with other settings, is never reused.
+std::string _GetMtlxFragmentCacheEnvironment()
+{
+    std::ostringstream environment;
+    environment << "MaterialX " << mx::getVersionString() << "; Maya " << MAYA_API_VERSION
+                << "; MayaUsd " << MAYAUSD_MAJOR_VERSION << "." << MAYAUSD_MINOR_VERSION << "."
+                << MAYAUSD_PATCH_LEVEL << "; search path "
+                << _GetMaterialXData()._mtlxSearchPath.asString() << "; uv set "
+                << _GetMaterialXData()._mainUvSetName << "; specular "
+                << MaterialXMaya::OgsFragment::getSpecularEnvKey();
+#ifdef HAS_COLOR_MANAGEMENT_SUPPORT_API
+    if (MayaUsd::ColorManagementPreferences::Active()) {
+        environment << "; rendering space "
+                    << MayaUsd::ColorManagementPreferences::RenderingSpaceName().asChar();
+    }
+#endif
+    return environment.str();
+}
+
+//! Returns the path of the cache file of the network. The file name hashes the content of the
+//! network and the environment, so that it is the same in every session.
+std::string _GetMtlxFragmentCachePath(
+    const std::string& cacheDirectory,
+    const std::string& fingerprint,
+    const std::string& environment)
+{
+    const uint64_t hash = ArchHash64(
+        environment.data(),
+        environment.size(),
+        ArchHash64(fingerprint.data(), fingerprint.size()));
+
+    std::ostringstream fileName;
+    fileName << std::hex << std::setw(16) << std::setfill('0') << hash << ".vp2frag";
+    return (ghc::filesystem::path(cacheDirectory) / fileName.str()).string();
+}
+
+bool _ReadCachedString(std::istream& file, std::string& str)
+{
+    size_t size = 0;
+    if (!(file >> size) || file.get() != '\n' || size > kMtlxFragmentCacheMaxStringSize) {
+        return false;
+    }
+    str.resize(size);
+    return size == 0 || file.read(&str[0], size);
+}
+
+void _WriteCachedString(std::ostream& file, const std::string& str)
+{
+    file << str.size() << '\n';
+    file.write(str.data(), str.size());
+    file << '\n';
+}
+
+//! Reads the fragment cached for the network. The environment and the network fingerprint are
+//! stored in the entry and compared, so that a hash collision never returns another fragment.
+bool _ReadCachedMtlxFragment(
+    const std::string& cachePath,
+    const std::string& environment,
+    const std::string& fingerprint,
+    _MtlxFragment&     fragment)
+{
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    std::string magic;
+    int         version = 0;
+    std::string cachedEnvironment;
+    std::string cachedFingerprint;
+    if (!(file >> magic >> version) || magic != kMtlxFragmentCacheMagic
+        || version != kMtlxFragmentCacheVersion || !_ReadCachedString(file, cachedEnvironment)
+        || cachedEnvironment != environment || !_ReadCachedString(file, cachedFingerprint)
+        || cachedFingerprint != fingerprint) {
+        return false;
+    }
+
+    int    requiresNormals = 0;
+    size_t numInputs = 0;
+    if (!_ReadCachedString(file, fragment.name) || !_ReadCachedString(file, fragment.source)
+        || !(file >> requiresNormals >> numInputs)) {
+        return false;
+    }
+
+    fragment.requiresNormals = requiresNormals != 0;
+    fragment.pathInputMap.clear();
+    for (size_t i = 0; i < numInputs; ++i) {
+        std::string path;
+        std::string input;
+        if (!_ReadCachedString(file, path) || !_ReadCachedString(file, input)) {
+            return false;
+        }
+        fragment.pathInputMap.emplace(std::move(path), std::move(input));
+    }
+
+    return !fragment.name.empty() && !fragment.source.empty();
+}
+
+void _WriteCachedMtlxFragment(
+    const std::string&   cachePath,
+    const std::string&   environment,
+    const std::string&   fingerprint,
+    const _MtlxFragment& fragment)
+{
+    std::error_code             ec;
+    const ghc::filesystem::path cacheFile(cachePath);
+    ghc::filesystem::create_directories(cacheFile.parent_path(), ec);
+
+    // Write to a temporary file first: other Maya sessions may read the cache.
+    std::ostringstream tmpPath;
+    tmpPath << cachePath << "." << std::this_thread::get_id() << ".tmp";
+    {
+        std::ofstream file(tmpPath.str(), std::ios::binary);
+        file << kMtlxFragmentCacheMagic << ' ' << kMtlxFragmentCacheVersion << '\n';
+        _WriteCachedString(file, environment);
+        _WriteCachedString(file, fingerprint);
+        _WriteCachedString(file, fragment.name);
+        _WriteCachedString(file, fragment.source);
+        file << (fragment.requiresNormals ? 1 : 0) << ' ' << fragment.pathInputMap.size() << '\n';
+        for (const auto& namePair : fragment.pathInputMap) {
+            _WriteCachedString(file, namePair.first);
+            _WriteCachedString(file, namePair.second);
+        }
+        if (!file) {
+            file.close();
+            ghc::filesystem::remove(tmpPath.str(), ec);
+            return;
+        }
+    }
+    ghc::filesystem::rename(tmpPath.str(), cacheFile, ec);
+    if (ec) {
+        ghc::filesystem::remove(tmpPath.str(), ec);
+    }
+}
+
+//! Returns the MaterialX library used by the code generation. The OCIO library is extended by
+//! the materials being synced, so the library must be created on the main thread.
+mx::DocumentPtr _GetMtlxCompleteLibrary()
+{
+#ifdef HAS_COLOR_MANAGEMENT_SUPPORT_API
+    mx::DocumentPtr completeLibrary = mx::createDocument();
+    completeLibrary->importLibrary(_GetMaterialXData()._mtlxLibrary);
+    completeLibrary->importLibrary(MaterialXMaya::OgsFragment::getOCIOLibrary());
+    return completeLibrary;
+#else
+    return _GetMaterialXData()._mtlxLibrary;
+#endif
+}
+
+//! Runs the MaterialX code generation of the OGS fragment of the surface network. Returns false
+//! if the network is not a MaterialX network. Can throw if any MaterialX error is raised.
+bool _GenerateMtlxFragment(
+    const SdfPath&            materialId,
+    const HdMaterialNetwork2& fixedNetwork,
+    const SdfPath&            fixedPath,
+    const HdMaterialNode2&    surfTerminal,
+    const mx::DocumentPtr&    completeLibrary,
+    const std::string&        primaryUVSetName,
+    _MtlxFragment&            fragment)
+{
+    // Check if the Terminal is a MaterialX Node
+    SdrRegistry&                sdrRegistry = SdrRegistry::GetInstance();
+    const SdrShaderNodeConstPtr mtlxSdrNode = sdrRegistry.GetShaderNodeByIdentifierAndType(
+        surfTerminal.nodeTypeId, HdVP2Tokens->mtlx);
+    if (!mtlxSdrNode) {
+        return false;
+    }
+
+    const mx::FileSearchPath& crLibrarySearchPath(_GetMaterialXData()._mtlxSearchPath);
+
+    // Create the MaterialX Document from the HdMaterialNetwork
+#if PXR_VERSION > 2111
+    mx::DocumentPtr mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
+        fixedNetwork,
+        surfTerminal, // MaterialX HdNode
+        fixedPath,
+        SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
+        completeLibrary);
+#else
+    std::set<SdfPath> hdTextureNodes;
+    mx::StringMap     mxHdTextureMap; // Mx-Hd texture name counterparts
+    mx::DocumentPtr   mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
+        fixedNetwork,
+        surfTerminal, // MaterialX HdNode
+        SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
+        completeLibrary,
+        &hdTextureNodes,
+        &mxHdTextureMap);
+#endif
+
+    if (!mtlxDoc) {
+        return false;
+    }
+
+    // Touchups required to fix input stream issues:
+    _AddMissingTangents(mtlxDoc);
+
+    if (TfDebug::IsEnabled(HDVP2_DEBUG_MATERIAL)) {
+        std::cout << "generated shader code for " << materialId.GetText() << ":\n";
+        std::cout << "Generated graph\n==============================\n";
+        mx::writeToXmlStream(mtlxDoc, std::cout);
+        std::cout << "\n==============================\n";
+    }
+
+    mx::NodePtr materialNode;
+    for (const mx::NodePtr& material : mtlxDoc->getMaterialNodes()) {
+        if (material->getName() == _mtlxTokens->USD_Mtlx_VP2_Material.GetText()) {
+            materialNode = material;
+        }
+    }
+
+    if (!materialNode) {
+        return false;
+    }
+
+    // Enable changing texcoord to geompropvalue. The UV set name is given to the generator, so
+    // that fragments generated on worker threads do not share it.
+    MaterialXMaya::OgsFragment ogsFragment(materialNode, crLibrarySearchPath, primaryUVSetName);
+
+    fragment.name = ogsFragment.getFragmentName();
+    fragment.source = ogsFragment.getFragmentSource();
+    fragment.pathInputMap = ogsFragment.getPathInputMap();
+    fragment.requiresNormals = false;
+
+    // Explore the fragment for primvars:
+    mx::ShaderPtr            shader = ogsFragment.getShader();
+    const mx::VariableBlock& vertexInputs
+        = shader->getStage(mx::Stage::VERTEX).getInputBlock(mx::HW::VERTEX_INPUTS);
+    for (size_t i = 0; i < vertexInputs.size(); ++i) {
+        const mx::ShaderPort* variable = vertexInputs[i];
+        // Position is always assumed.
+        // Tangent will be generated in the vertex shader using a utility fragment
+        if (variable->getName() == mx::HW::T_IN_NORMAL) {
+            fragment.requiresNormals = true;
+        }
+    }
+
+    ++gNumGeneratedMtlxFragments;
+    return true;
+}
+
+//! Whether the fragments of the MaterialX networks are generated on worker threads.
+bool _IsAsyncMaterialXGeneration()
+{
+    static const MString kOptionVarName(MayaUsdOptionVars->AsyncMaterialXGeneration.GetText());
+    if (MGlobal::optionVarExists(kOptionVarName)) {
+        return MGlobal::optionVarIntValue(kOptionVarName) != 0;
+    }
+    return false;
+}
+
+//! Generates the fragments of the MaterialX networks on worker threads, so that the networks of
+//! all the materials synced together are generated concurrently. Only the registration of the
+//! fragments with VP2 needs the main thread: it is done by the next sync of the materials, which
+//! are marked dirty on idle once their fragment is generated. A network used by several materials
+//! is only generated once. Only accessed from the main thread, except by the jobs.
+class _MtlxFragmentGenerator
+{
+public:
+    using Job = std::function<bool(_MtlxFragment&)>;
+
+    static _MtlxFragmentGenerator& GetInstance()
+    {
+        static _MtlxFragmentGenerator sInstance;
+        return sInstance;
+    }
+
+    //! Queue the generation of the network unless it is already queued, the material is marked
+    //! dirty once it is done. Returns false if the job has been rejected.
+    bool Push(
+        const TfToken&   key,
+        HdVP2Material*   material,
+        HdSceneDelegate* sceneDelegate,
+        Job&&            job)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_isExiting) {
+            return false;
+        }
+
+        auto  inserted = _entries.emplace(key, _Entry());
+        auto& waiters = inserted.first->second.waiters;
+        if (std::none_of(waiters.begin(), waiters.end(), [material](const _Waiter& waiter) {
+                return waiter.material == material;
+            })) {
+            waiters.push_back({ material, sceneDelegate });
+        }
+
+        if (inserted.second) {
+            ++_numPendingJobs;
+            _tasks.run([this, key, job = std::move(job)]() { _Run(key, job); });
+        }
+        return true;
+    }
+
+    //! Returns true if the generation of the network is done, with the generated fragment and the
+    //! generation time. The fragment is empty if the generation failed.
+    bool GetResult(
+        const TfToken& key,
+        HdVP2Material* material,
+        _MtlxFragment& fragment,
+        double&        milliseconds)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto it = _entries.find(key);
+        if (it == _entries.end() || !it->second.done) {
+            return false;
+        }
+
+        fragment = it->second.fragment;
+        milliseconds = it->second.milliseconds;
+
+        // The result is kept until all the materials waiting for it got it.
+        _RemoveWaiter(it->second.waiters, material);
+        if (it->second.waiters.empty()) {
+            _entries.erase(it);
+        }
+        return true;
+    }
+
+    //! Stop notifying the material, which is about to be deleted.
+    void Forget(const HdVP2Material* material)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            _RemoveWaiter(it->second.waiters, material);
+            // Pending entries are removed once generated.
+            it = (it->second.done && it->second.waiters.empty()) ? _entries.erase(it)
+                                                                 : std::next(it);
+        }
+    }
+
+    //! Number of networks queued or being generated.
+    size_t GetNumPendingJobs() const { return _numPendingJobs.load(); }
+
+    void OnMayaExit()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isExiting = true;
+        }
+        // Queued jobs are not started anymore, wait for the running ones.
+        _tasks.cancel();
+        _tasks.wait();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+        _finishedKeys.clear();
+    }
+
+private:
+    _MtlxFragmentGenerator() = default;
+    ~_MtlxFragmentGenerator() { OnMayaExit(); }
+
+    struct _Waiter
+    {
+        HdVP2Material*   material;
+        HdSceneDelegate* sceneDelegate;
+    };
+
+    struct _Entry
+    {
+        std::vector<_Waiter> waiters;
+        _MtlxFragment        fragment;
+        double               milliseconds { 0.0 };
+        bool                 done { false };
+    };
+
+    static void _RemoveWaiter(std::vector<_Waiter>& waiters, const HdVP2Material* material)
+    {
+        waiters.erase(
+            std::remove_if(
+                waiters.begin(),
+                waiters.end(),
+                [material](const _Waiter& waiter) { return waiter.material == material; }),
+            waiters.end());
+    }
+
+    //! Runs on a worker thread.
+    void _Run(const TfToken& key, const Job& job)
+    {
+        const auto    start = std::chrono::steady_clock::now();
+        _MtlxFragment fragment;
+        if (!job(fragment)) {
+            fragment = _MtlxFragment();
+        }
+        const std::chrono::duration<double, std::milli> duration
+            = std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _Finish(key, std::move(fragment), duration.count());
+
+        // Only decremented once the idle task is queued, so that no pending job means that the
+        // waiting materials are marked dirty by the next idle processing.
+        --_numPendingJobs;
+    }
+
+    //! Stores the generated fragment and queues the notification of the waiting materials.
+    //! Called with the mutex locked.
+    void _Finish(const TfToken& key, _MtlxFragment&& fragment, double milliseconds)
+    {
+        const auto it = _entries.find(key);
+        if (it == _entries.end() || _isExiting) {
+            return;
+        }
+        if (it->second.waiters.empty()) {
+            // All the materials waiting for the fragment have been deleted.
+            _entries.erase(it);
+            return;
+        }
+
+        it->second.fragment = std::move(fragment);
+        it->second.milliseconds = milliseconds;
+        it->second.done = true;
+        _finishedKeys.push_back(key);
+
+        // Avoid creating multiple idle tasks if there is already one
+        if (!_hasIdleTask) {
+            auto ret = MGlobal::executeTaskOnIdle(
+                [](void* data) { _MtlxFragmentGenerator::GetInstance()._Notify(); });
+            _hasIdleTask = (ret == MStatus::kSuccess);
+        }
+    }
+
+    //! Runs on idle, on the main thread: marks the materials waiting for the generated fragments
+    //! dirty, so that the next sync registers the fragments and creates the shader instances.
+    void _Notify()
+    {
+        std::vector<_Waiter> waiters;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _hasIdleTask = false;
+            for (const TfToken& key : _finishedKeys) {
+                const auto it = _entries.find(key);
+                if (it != _entries.end()) {
+                    waiters.insert(
+                        waiters.end(), it->second.waiters.begin(), it->second.waiters.end());
+                }
+            }
+            _finishedKeys.clear();
+        }
+
+        for (const _Waiter& waiter : waiters) {
+            waiter.sceneDelegate->GetRenderIndex().GetChangeTracker().MarkSprimDirty(
+                waiter.material->GetId(), HdMaterial::DirtyResource);
+        }
+
+        if (!waiters.empty()) {
+            M3dView::scheduleRefreshAllViews();
+        }
+    }
+
+    std::mutex                                                _mutex;
+    std::unordered_map<TfToken, _Entry, TfToken::HashFunctor> _entries;
+    std::vector<TfToken>                                      _finishedKeys;
+    tbb::task_group                                           _tasks;
+    std::atomic_size_t                                        _numPendingJobs { 0 };
+    bool                                                      _hasIdleTask { false };
+    bool                                                      _isExiting { false };
+};
+
 #endif // WANT_MATERIALX_BUILD
 
 #if PXR_VERSION <= 2211
@@ -1582,40 +2346,30 @@ MHWRender::MTexture* _GenerateFallbackTexture(
     return textureMgr->acquireTexture(path.c_str(), desc, texels.data());
 }
 
-//! Load texture from the specified path
-MHWRender::MTexture* _LoadTexture(
-    const std::string& path,
-    bool               hasFallbackColor,
-    const GfVec4f&     fallbackColor,
-    bool&              isColorSpaceSRGB,
-    MFloatArray&       uvScaleOffset)
+//! Options used when loading the texels of a texture.
+struct _TextureLoadOptions
 {
-    MProfilingScope profilingScope(
-        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "LoadTexture", path.c_str());
-
-    // If it is a UDIM texture we need to modify the path before calling OpenForReading
-    if (HdStIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
-
-    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr
-        = renderer ? renderer->getTextureManager() : nullptr;
-    if (!TF_VERIFY(textureMgr)) {
-        return nullptr;
-    }
+    unsigned int maxResolution = 0; //!< Largest texture dimension, zero for full resolution
+    std::string  cacheDirectory;    //!< Directory caching the reduced textures, if not empty
+};
 
-    MHWRender::MTexture* texture = textureMgr->findTexture(path.c_str());
-    if (texture) {
-        return texture;
-    }
+//! Texels decoded from an image file, in a format supported by VP2.
+struct _DecodedTexture
+{
+    MHWRender::MTextureDescription desc;
+    std::vector<unsigned char>     texels;
+    unsigned int                   mipLevel = 0; //!< Number of times the image has been halved
+    bool                           isColorSpaceSRGB = false;
+    bool                           imageNotFound = false;
+};
 
+//! Read the image at the specified path and convert its texels to a VP2 format.
+bool _ReadTexels(const std::string& path, _DecodedTexture& decoded)
+{
     HioImageSharedPtr image = HioImage::OpenForReading(path);
     if (!TF_VERIFY(image, "Unable to create an image from %s", path.c_str())) {
-        if (!hasFallbackColor) {
-            return nullptr;
-        }
-        // Create a 1x1 texture of the fallback color, if it was specified:
-        return _GenerateFallbackTexture(textureMgr, path, fallbackColor);
+        decoded.imageNotFound = true;
+        return false;
     }
 
     // This image is used for loading pixel data from usdz only and should
@@ -1636,10 +2390,10 @@ MHWRender::MTexture* _LoadTexture(
     spec.data = storage.data();
 
     if (!image->Read(spec)) {
-        return nullptr;
+        return false;
     }
 
-    MHWRender::MTextureDescription desc;
+    MHWRender::MTextureDescription& desc = decoded.desc;
     desc.setToDefault2DTexture();
     desc.fWidth = spec.width;
     desc.fHeight = spec.height;
@@ -1669,7 +2423,7 @@ MHWRender::MTexture* _LoadTexture(
             *texels32++ = pixel;
         }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
+        decoded.texels = std::move(texels);
     } break;
     case HioFormatFloat16: {
         // We want white instead or red when expanding to RGB, so convert to kR16G16B16A16_FLOAT
@@ -1695,7 +2449,7 @@ MHWRender::MTexture* _LoadTexture(
             *texels16++ = alphaBits;
         }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
+        decoded.texels = std::move(texels);
     } break;
     case HioFormatUNorm8: {
         // We want white instead or red when expanding to RGB, so convert to kR8G8B8A8_UNORM
@@ -1718,8 +2472,8 @@ MHWRender::MTexture* _LoadTexture(
             *texels8++ = 0xFF;
         }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        decoded.texels = std::move(texels);
+        decoded.isColorSpaceSRGB = image->IsColorSpaceSRGB();
     } break;
 
     // Dual channel (quite rare, but seen with mono + alpha files)
@@ -1744,7 +2498,7 @@ MHWRender::MTexture* _LoadTexture(
             *texels32++ = *storage32++;
         }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
+        decoded.texels = std::move(texels);
     } break;
     case HioFormatFloat16Vec2: {
         // R16G16 is not supported by VP2. Converted to R16G16B16A16.
@@ -1767,7 +2521,7 @@ MHWRender::MTexture* _LoadTexture(
             *texels16++ = *storage16++;
         }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
+        decoded.texels = std::move(texels);
         break;
     }
     case HioFormatUNorm8Vec2:
@@ -1781,109 +2535,535 @@ MHWRender::MTexture* _LoadTexture(
 
         std::vector<unsigned char> texels(desc.fBytesPerSlice);
 
-        uint8_t* texels8 = (uint8_t*)texels.data();
-        uint8_t* storage8 = (uint8_t*)storage.data();
+        uint8_t* texels8 = (uint8_t*)texels.data();
+        uint8_t* storage8 = (uint8_t*)storage.data();
+
+        for (int p = 0; p < spec.height * spec.width; p++) {
+            const uint8_t pixel = *storage8++;
+            *texels8++ = pixel;
+            *texels8++ = pixel;
+            *texels8++ = pixel;
+            *texels8++ = *storage8++;
+        }
+
+        decoded.texels = std::move(texels);
+        decoded.isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        break;
+    }
+
+    // 3-Channel
+    case HioFormatFloat32Vec3:
+        desc.fFormat = MHWRender::kR32G32B32_FLOAT;
+        decoded.texels = std::move(storage);
+        break;
+    case HioFormatFloat16Vec3: {
+        // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
+        constexpr int bpp_8 = 8;
+
+        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        desc.fBytesPerRow = spec.width * bpp_8;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        GfHalf               opaqueAlpha(1.0f);
+        const unsigned short alphaBits = opaqueAlpha.bits();
+        const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
+        const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
+
+        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
+                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
+                texels[t * bpp_8 + 2] = storage[t * bpp + 2];
+                texels[t * bpp_8 + 3] = storage[t * bpp + 3];
+                texels[t * bpp_8 + 4] = storage[t * bpp + 4];
+                texels[t * bpp_8 + 5] = storage[t * bpp + 5];
+                texels[t * bpp_8 + 6] = lowAlpha;
+                texels[t * bpp_8 + 7] = highAlpha;
+            }
+        }
+
+        decoded.texels = std::move(texels);
+        break;
+    }
+    case HioFormatFloat16Vec4:
+        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
+        decoded.texels = std::move(storage);
+        break;
+    case HioFormatUNorm8Vec3:
+    case HioFormatUNorm8Vec3srgb: {
+        // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
+        constexpr int bpp_4 = 4;
+
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        desc.fBytesPerRow = spec.width * bpp_4;
+        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+
+        for (int y = 0; y < spec.height; y++) {
+            for (int x = 0; x < spec.width; x++) {
+                const int t = spec.width * y + x;
+                texels[t * bpp_4] = storage[t * bpp];
+                texels[t * bpp_4 + 1] = storage[t * bpp + 1];
+                texels[t * bpp_4 + 2] = storage[t * bpp + 2];
+                texels[t * bpp_4 + 3] = 255;
+            }
+        }
+
+        decoded.texels = std::move(texels);
+        decoded.isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        break;
+    }
+
+    // 4-Channel
+    case HioFormatFloat32Vec4:
+        desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
+        decoded.texels = std::move(storage);
+        break;
+    case HioFormatUNorm8Vec4:
+    case HioFormatUNorm8Vec4srgb:
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        decoded.isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        decoded.texels = std::move(storage);
+        break;
+    default:
+        TF_WARN(
+            "VP2 renderer delegate: unsupported pixel format (%d) in texture file %s.",
+            (int)specFormat,
+            path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+inline void _StoreTexel(float value, uint8_t& texel)
+{
+    texel = static_cast<uint8_t>(GfClamp(value + 0.5f, 0.0f, 255.0f));
+}
+inline void _StoreTexel(float value, GfHalf& texel) { texel = GfHalf(value); }
+inline void _StoreTexel(float value, float& texel) { texel = value; }
+
+//! Halve the resolution of the decoded texels with a box filter.
+template <typename T> void _HalveTexels(_DecodedTexture& decoded, unsigned int numChannels)
+{
+    MHWRender::MTextureDescription& desc = decoded.desc;
+
+    const unsigned int width = desc.fWidth;
+    const unsigned int height = desc.fHeight;
+    const unsigned int halfWidth = std::max(width / 2, 1u);
+    const unsigned int halfHeight = std::max(height / 2, 1u);
+
+    std::vector<unsigned char> texels(halfWidth * halfHeight * numChannels * sizeof(T));
+
+    const T* src = reinterpret_cast<const T*>(decoded.texels.data());
+    T*       dst = reinterpret_cast<T*>(texels.data());
+    for (unsigned int y = 0; y < halfHeight; ++y) {
+        const T* row0 = src + std::min(2 * y, height - 1) * width * numChannels;
+        const T* row1 = src + std::min(2 * y + 1, height - 1) * width * numChannels;
+        for (unsigned int x = 0; x < halfWidth; ++x) {
+            const unsigned int x0 = std::min(2 * x, width - 1) * numChannels;
+            const unsigned int x1 = std::min(2 * x + 1, width - 1) * numChannels;
+            for (unsigned int c = 0; c < numChannels; ++c) {
+                const float sum = static_cast<float>(row0[x0 + c])
+                    + static_cast<float>(row0[x1 + c]) + static_cast<float>(row1[x0 + c])
+                    + static_cast<float>(row1[x1 + c]);
+                _StoreTexel(sum * 0.25f, *dst++);
+            }
+        }
+    }
+
+    desc.fWidth = halfWidth;
+    desc.fHeight = halfHeight;
+    desc.fBytesPerRow = halfWidth * numChannels * sizeof(T);
+    desc.fBytesPerSlice = desc.fBytesPerRow * halfHeight;
+    decoded.texels = std::move(texels);
+    ++decoded.mipLevel;
+}
+
+//! Halve the resolution of the decoded texels until they fit in the maximum resolution.
+void _DownsampleTexels(_DecodedTexture& decoded, unsigned int maxResolution)
+{
+    MHWRender::MTextureDescription& desc = decoded.desc;
+    while (maxResolution > 0 && std::max(desc.fWidth, desc.fHeight) > maxResolution) {
+        switch (desc.fFormat) {
+        case MHWRender::kR8G8B8A8_UNORM: _HalveTexels<uint8_t>(decoded, 4); break;
+        case MHWRender::kR16G16B16A16_FLOAT: _HalveTexels<GfHalf>(decoded, 4); break;
+        case MHWRender::kR32G32B32_FLOAT: _HalveTexels<float>(decoded, 3); break;
+        case MHWRender::kR32G32B32A32_FLOAT: _HalveTexels<float>(decoded, 4); break;
+        default: return;
+        }
+    }
+}
+
+//! Returns the size of a texel of the formats that can be downsampled, or zero.
+size_t _GetDownsampledTexelSize(MHWRender::MRasterFormat format)
+{
+    switch (format) {
+    case MHWRender::kR8G8B8A8_UNORM: return 4 * sizeof(uint8_t);
+    case MHWRender::kR16G16B16A16_FLOAT: return 4 * sizeof(GfHalf);
+    case MHWRender::kR32G32B32_FLOAT: return 3 * sizeof(float);
+    case MHWRender::kR32G32B32A32_FLOAT: return 4 * sizeof(float);
+    default: return 0;
+    }
+}
+
+//! Header of the reduced textures cached on disk. It is followed by the path of the source
+//! image, then by the texels.
+struct _TextureCacheHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t mipLevel;
+    uint32_t isColorSpaceSRGB;
+    uint64_t numBytes;
+    uint64_t sourceSize;
+    int64_t  sourceWriteTime;
+    uint32_t maxResolution;
+    uint32_t sourcePathSize;
+};
+
+constexpr char     kTextureCacheMagic[8] = "MUSDTEX";
+constexpr uint32_t kTextureCacheVersion = 2;
+
+//! Identity of a source image in the texture disk cache.
+struct _TextureCacheSource
+{
+    std::string  path;
+    uint64_t     size { 0 };
+    int64_t      writeTime { 0 };
+    unsigned int maxResolution { 0 };
+};
+
+//! Returns the path of the cached reduced texture, or an empty string if the texture
+//! cannot be cached. The file name hashes the path, size and time stamp of the image file,
+//! so that edited images are decoded again.
+std::string _GetTextureCachePath(
+    const std::string&         path,
+    const _TextureLoadOptions& options,
+    _TextureCacheSource&       source)
+{
+    if (options.cacheDirectory.empty() || options.maxResolution == 0
+        || ArIsPackageRelativePath(path)) {
+        return std::string();
+    }
+
+    std::error_code ec;
+    const auto      fileSize = ghc::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::string();
+    }
+    const auto writeTime = ghc::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return std::string();
+    }
+
+    source.path = path;
+    source.size = static_cast<uint64_t>(fileSize);
+    source.writeTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    source.maxResolution = options.maxResolution;
+
+    uint64_t hash = ArchHash64(source.path.data(), source.path.size());
+    hash = ArchHash64(reinterpret_cast<const char*>(&source.size), sizeof(source.size), hash);
+    hash = ArchHash64(
+        reinterpret_cast<const char*>(&source.writeTime), sizeof(source.writeTime), hash);
+    hash = ArchHash64(
+        reinterpret_cast<const char*>(&source.maxResolution), sizeof(source.maxResolution), hash);
+
+    std::ostringstream fileName;
+    fileName << std::hex << std::setw(16) << std::setfill('0') << hash << ".vp2tex";
+    return (ghc::filesystem::path(options.cacheDirectory) / fileName.str()).string();
+}
+
+//! Reads the texels cached for the source image. The identity of the source image is stored
+//! in the file and compared, so that a hash collision never returns the texels of another image.
+bool _ReadCachedTexels(
+    const std::string&         cachePath,
+    const _TextureCacheSource& source,
+    _DecodedTexture&           decoded)
+{
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    _TextureCacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, kTextureCacheMagic, sizeof(header.magic)) != 0
+        || header.version != kTextureCacheVersion || header.sourceSize != source.size
+        || header.sourceWriteTime != source.writeTime
+        || header.maxResolution != source.maxResolution
+        || header.sourcePathSize != source.path.size()) {
+        return false;
+    }
+
+    std::string sourcePath(header.sourcePathSize, '\0');
+    if (!file.read(&sourcePath[0], sourcePath.size()) || sourcePath != source.path) {
+        return false;
+    }
+
+    // Only downsampled textures are cached. Reject truncated or corrupted files before
+    // allocating anything from the sizes they declare.
+    const size_t texelSize
+        = _GetDownsampledTexelSize(static_cast<MHWRender::MRasterFormat>(header.format));
+    if (texelSize == 0 || header.width == 0 || header.height == 0
+        || header.width > _TextureResidency::kMaxResolution
+        || header.height > _TextureResidency::kMaxResolution
+        || header.numBytes != static_cast<uint64_t>(header.width) * header.height * texelSize) {
+        TF_WARN("Ignoring invalid texture cache file '%s'.", cachePath.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    const auto      fileSize = ghc::filesystem::file_size(cachePath, ec);
+    if (ec || fileSize != sizeof(header) + header.sourcePathSize + header.numBytes) {
+        TF_WARN("Ignoring truncated texture cache file '%s'.", cachePath.c_str());
+        return false;
+    }
+
+    decoded.texels.resize(header.numBytes);
+    if (!file.read(reinterpret_cast<char*>(decoded.texels.data()), header.numBytes)) {
+        decoded.texels.clear();
+        return false;
+    }
+
+    MHWRender::MTextureDescription& desc = decoded.desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = header.width;
+    desc.fHeight = header.height;
+    desc.fFormat = static_cast<MHWRender::MRasterFormat>(header.format);
+    desc.fBytesPerRow = static_cast<unsigned int>(header.numBytes / header.height);
+    desc.fBytesPerSlice = static_cast<unsigned int>(header.numBytes);
+    decoded.mipLevel = header.mipLevel;
+    decoded.isColorSpaceSRGB = header.isColorSpaceSRGB != 0;
+    return true;
+}
+
+void _WriteCachedTexels(
+    const std::string&         cachePath,
+    const _TextureCacheSource& source,
+    const _DecodedTexture&     decoded)
+{
+    std::error_code             ec;
+    const ghc::filesystem::path cacheFile(cachePath);
+    ghc::filesystem::create_directories(cacheFile.parent_path(), ec);
+
+    _TextureCacheHeader header;
+    std::memcpy(header.magic, kTextureCacheMagic, sizeof(header.magic));
+    header.version = kTextureCacheVersion;
+    header.width = decoded.desc.fWidth;
+    header.height = decoded.desc.fHeight;
+    header.format = static_cast<uint32_t>(decoded.desc.fFormat);
+    header.mipLevel = decoded.mipLevel;
+    header.isColorSpaceSRGB = decoded.isColorSpaceSRGB ? 1 : 0;
+    header.numBytes = decoded.texels.size();
+    header.sourceSize = source.size;
+    header.sourceWriteTime = source.writeTime;
+    header.maxResolution = source.maxResolution;
+    header.sourcePathSize = static_cast<uint32_t>(source.path.size());
+
+    // Write to a temporary file first: other threads or Maya sessions may read the cache.
+    std::ostringstream tmpPath;
+    tmpPath << cachePath << "." << std::this_thread::get_id() << ".tmp";
+    {
+        std::ofstream file(tmpPath.str(), std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(source.path.data(), source.path.size());
+        file.write(reinterpret_cast<const char*>(decoded.texels.data()), decoded.texels.size());
+        if (!file) {
+            file.close();
+            ghc::filesystem::remove(tmpPath.str(), ec);
+            return;
+        }
+    }
+    ghc::filesystem::rename(tmpPath.str(), cacheFile, ec);
+    if (ec) {
+        ghc::filesystem::remove(tmpPath.str(), ec);
+    }
+}
+
+//! Number of textures decoded at a reduced resolution, and read from the disk cache.
+std::atomic_size_t gNumReducedTextures { 0 };
+std::atomic_size_t gNumCachedTextureReads { 0 };
+
+//! Decode the image at the specified path, at a resolution fitting in the options, first
+//! looking for it in the disk cache. Does not access Maya, so it can run on a worker thread.
+bool _DecodeTexture(
+    const std::string&         path,
+    const _TextureLoadOptions& options,
+    _DecodedTexture&           decoded)
+{
+    _TextureCacheSource source;
+    const std::string   cachePath = _GetTextureCachePath(path, options, source);
+    if (!cachePath.empty() && _ReadCachedTexels(cachePath, source, decoded)) {
+        ++gNumCachedTextureReads;
+        ++gNumReducedTextures;
+        return true;
+    }
+
+    if (!_ReadTexels(path, decoded)) {
+        return false;
+    }
+
+    _DownsampleTexels(decoded, options.maxResolution);
+    if (decoded.mipLevel > 0) {
+        ++gNumReducedTextures;
+        if (!cachePath.empty()) {
+            _WriteCachedTexels(cachePath, source, decoded);
+        }
+    }
+    return true;
+}
+
+//! Names under which the textures decoded at a reduced resolution were acquired, by path.
+//! Only accessed from the main thread.
+std::unordered_map<std::string, std::string>& _GetReducedTextureNames()
+{
+    static std::unordered_map<std::string, std::string> sNames;
+    return sNames;
+}
+
+//! Find the VP2 texture already loaded for the specified path, at full or reduced resolution.
+//! Must run on the main thread.
+MHWRender::MTexture*
+_FindLoadedTexture(MHWRender::MTextureManager* textureMgr, const std::string& path)
+{
+    MHWRender::MTexture* texture = textureMgr->findTexture(path.c_str());
+    if (texture) {
+        return texture;
+    }
+
+    auto&      reducedNames = _GetReducedTextureNames();
+    const auto it = reducedNames.find(path);
+    if (it == reducedNames.end()) {
+        return nullptr;
+    }
+    texture = textureMgr->findTexture(it->second.c_str());
+    if (!texture) {
+        // The reduced texture has been released since.
+        reducedNames.erase(it);
+    }
+    return texture;
+}
+
+//! Acquire the VP2 texture of the texels decoded from the specified path, or its
+//! fallback texture if the image could not be found. Must run on the main thread.
+MHWRender::MTexture* _AcquireDecodedTexture(
+    const std::string&     path,
+    bool                   hasFallbackColor,
+    const GfVec4f&         fallbackColor,
+    bool                   isDecoded,
+    const _DecodedTexture& decoded,
+    bool&                  isColorSpaceSRGB)
+{
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    MHWRender::MTexture* texture = _FindLoadedTexture(textureMgr, path);
+    if (texture) {
+        return texture;
+    }
 
-        for (int p = 0; p < spec.height * spec.width; p++) {
-            const uint8_t pixel = *storage8++;
-            *texels8++ = pixel;
-            *texels8++ = pixel;
-            *texels8++ = pixel;
-            *texels8++ = *storage8++;
+    if (!isDecoded) {
+        if (!decoded.imageNotFound || !hasFallbackColor) {
+            return nullptr;
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        break;
+        // Create a 1x1 texture of the fallback color, if it was specified:
+        return _GenerateFallbackTexture(textureMgr, path, fallbackColor);
     }
 
-    // 3-Channel
-    case HioFormatFloat32Vec3:
-        desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatFloat16Vec3: {
-        // R16G16B16 is not supported by VP2. Converted to R16G16B16A16.
-        constexpr int bpp_8 = 8;
+    // Reduced textures get their own name, so that they are not mistaken for the full
+    // resolution ones. The name is recorded so that the next loads of the path find them.
+    std::string textureName = path;
+    if (decoded.mipLevel > 0) {
+        textureName += ":mip" + std::to_string(decoded.mipLevel);
+        _GetReducedTextureNames()[path] = textureName;
+    }
 
-        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        desc.fBytesPerRow = spec.width * bpp_8;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+    isColorSpaceSRGB = decoded.isColorSpaceSRGB;
+    return textureMgr->acquireTexture(textureName.c_str(), decoded.desc, decoded.texels.data());
+}
 
-        GfHalf               opaqueAlpha(1.0f);
-        const unsigned short alphaBits = opaqueAlpha.bits();
-        const unsigned char  lowAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[0];
-        const unsigned char  highAlpha = reinterpret_cast<const unsigned char*>(&alphaBits)[1];
+//! Load texture from the specified path
+MHWRender::MTexture* _LoadTexture(
+    const std::string&         path,
+    const _TextureLoadOptions& options,
+    bool                       hasFallbackColor,
+    const GfVec4f&             fallbackColor,
+    bool&                      isColorSpaceSRGB,
+    MFloatArray&               uvScaleOffset)
+{
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L2, "LoadTexture", path.c_str());
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+    // If it is a UDIM texture we need to modify the path before calling OpenForReading
+    if (HdStIsSupportedUdimTexture(path))
+        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
 
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_8 + 0] = storage[t * bpp + 0];
-                texels[t * bpp_8 + 1] = storage[t * bpp + 1];
-                texels[t * bpp_8 + 2] = storage[t * bpp + 2];
-                texels[t * bpp_8 + 3] = storage[t * bpp + 3];
-                texels[t * bpp_8 + 4] = storage[t * bpp + 4];
-                texels[t * bpp_8 + 5] = storage[t * bpp + 5];
-                texels[t * bpp_8 + 6] = lowAlpha;
-                texels[t * bpp_8 + 7] = highAlpha;
-            }
-        }
+    MHWRender::MRenderer* const       renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr
+        = renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
 
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        break;
+    MHWRender::MTexture* texture = _FindLoadedTexture(textureMgr, path);
+    if (texture) {
+        return texture;
     }
-    case HioFormatFloat16Vec4:
-        desc.fFormat = MHWRender::kR16G16B16A16_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatUNorm8Vec3:
-    case HioFormatUNorm8Vec3srgb: {
-        // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
-        constexpr int bpp_4 = 4;
 
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        desc.fBytesPerRow = spec.width * bpp_4;
-        desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+    _DecodedTexture decoded;
+    const bool      isDecoded = _DecodeTexture(path, options, decoded);
+    return _AcquireDecodedTexture(
+        path, hasFallbackColor, fallbackColor, isDecoded, decoded, isColorSpaceSRGB);
+}
 
-        std::vector<unsigned char> texels(desc.fBytesPerSlice);
+unsigned int _NextPowerOfTwo(unsigned int value)
+{
+    unsigned int powerOfTwo = 1;
+    while (powerOfTwo < value) {
+        powerOfTwo *= 2;
+    }
+    return powerOfTwo;
+}
 
-        for (int y = 0; y < spec.height; y++) {
-            for (int x = 0; x < spec.width; x++) {
-                const int t = spec.width * y + x;
-                texels[t * bpp_4] = storage[t * bpp];
-                texels[t * bpp_4 + 1] = storage[t * bpp + 1];
-                texels[t * bpp_4 + 2] = storage[t * bpp + 2];
-                texels[t * bpp_4 + 3] = 255;
-            }
+//! Returns the options to load a new texture with, from the user preferences, the
+//! viewport size and the remaining texture memory budget.
+_TextureLoadOptions _GetTextureLoadOptions(const ProxyRenderDelegate& drawScene)
+{
+    _TextureLoadOptions options;
+
+    options.maxResolution = _GetTextureMaxResolution();
+    if (options.maxResolution > 0) {
+        // A texture covering the whole viewport does not need more texels than pixels.
+        const unsigned int viewportResolution = drawScene.GetViewportMaxDimension();
+        if (viewportResolution > 0) {
+            options.maxResolution
+                = std::min(options.maxResolution, _NextPowerOfTwo(viewportResolution));
         }
-
-        texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        break;
     }
 
-    // 4-Channel
-    case HioFormatFloat32Vec4:
-        desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case HioFormatUNorm8Vec4:
-    case HioFormatUNorm8Vec4srgb:
-        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    default:
-        TF_WARN(
-            "VP2 renderer delegate: unsupported pixel format (%d) in texture file %s.",
-            (int)specFormat,
-            path.c_str());
-        break;
+    const unsigned int budgetResolution
+        = _TextureResidency::GetInstance().GetMaxResolution(_GetTextureMemoryBudget());
+    if (budgetResolution > 0
+        && (options.maxResolution == 0 || budgetResolution < options.maxResolution)) {
+        options.maxResolution = budgetResolution;
     }
 
-    return texture;
+    if (options.maxResolution > 0) {
+        options.cacheDirectory = _GetTextureCacheDirectory();
+    }
+    return options;
 }
 
 TfToken MayaDescriptorToToken(const MVertexBufferDescriptor& descriptor)
@@ -1918,26 +3098,180 @@ struct MStringHash
     }
 };
 
+//! Pool of worker threads decoding texture files in the background. Only the decoding
+//! runs on the workers: the VP2 textures are then acquired on idle, on the main thread.
+//! Decoding requests for prims in the camera frustum are served before all the others.
+class _TextureDecodeQueue
+{
+public:
+    //! A job runs on a worker thread. If it does not get to run before Maya exits, it is
+    //! discarded on the main thread instead, to release what it owns.
+    using Action = std::function<void()>;
+    struct Job
+    {
+        Action run;
+        Action discard;
+    };
+
+    static _TextureDecodeQueue& GetInstance()
+    {
+        static _TextureDecodeQueue sInstance;
+        return sInstance;
+    }
+
+    //! Set the maximum number of textures decoded at the same time.
+    void SetMaxThreads(size_t maxThreads)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _maxThreads = std::max<size_t>(maxThreads, 1);
+        }
+        _condition.notify_all();
+    }
+
+    //! Queue a decoding job, returns false if the job has been rejected.
+    bool Push(Job&& job, bool highPriority)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_isExiting) {
+                return false;
+            }
+            (highPriority ? _highPriorityJobs : _jobs).push_back(std::move(job));
+            ++_numPendingJobs;
+
+            // Threads are started lazily and kept alive until Maya exits.
+            if (_threads.size() < _maxThreads && _numIdleThreads == 0) {
+                _threads.emplace_back(&_TextureDecodeQueue::_Run, this);
+            }
+        }
+        _condition.notify_one();
+        return true;
+    }
+
+    //! Keep a job that ran but could not hand over its result to the main thread, so it
+    //! is discarded on exit.
+    void Discard(Action&& discard)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _discardedJobs.push_back(std::move(discard));
+    }
+
+    //! Number of jobs queued or being decoded.
+    size_t GetNumPendingJobs() const { return _numPendingJobs.load(); }
+
+    //! Number of textures decoded since the queue has been created.
+    size_t GetNumDecodedTextures() const { return _numDecodedTextures.load(); }
+
+    void OnMayaExit()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isExiting = true;
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+
+        // Queued jobs own their texture loading task, which will never be decoded now.
+        // Discard them, and the jobs that could not be handed over, on the main thread.
+        std::deque<Job>     highPriorityJobs;
+        std::deque<Job>     jobs;
+        std::vector<Action> discardedJobs;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _numPendingJobs -= _highPriorityJobs.size() + _jobs.size();
+            highPriorityJobs.swap(_highPriorityJobs);
+            jobs.swap(_jobs);
+            discardedJobs.swap(_discardedJobs);
+        }
+        for (auto& job : highPriorityJobs) {
+            job.discard();
+        }
+        for (auto& job : jobs) {
+            job.discard();
+        }
+        for (auto& discard : discardedJobs) {
+            discard();
+        }
+    }
+
+private:
+    _TextureDecodeQueue() = default;
+    ~_TextureDecodeQueue() { OnMayaExit(); }
+
+    void _Run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            ++_numIdleThreads;
+            _condition.wait(lock, [this]() {
+                return _isExiting
+                    || (_numRunningJobs < _maxThreads
+                        && !(_highPriorityJobs.empty() && _jobs.empty()));
+            });
+            --_numIdleThreads;
+            if (_isExiting) {
+                return;
+            }
+
+            auto& jobs = _highPriorityJobs.empty() ? _jobs : _highPriorityJobs;
+            Job   job = std::move(jobs.front());
+            jobs.pop_front();
+            ++_numRunningJobs;
+
+            lock.unlock();
+            job.run();
+            ++_numDecodedTextures;
+            --_numPendingJobs;
+            lock.lock();
+
+            --_numRunningJobs;
+        }
+    }
+
+    std::mutex               _mutex;
+    std::condition_variable  _condition;
+    std::vector<std::thread> _threads;
+    std::deque<Job>          _highPriorityJobs;
+    std::deque<Job>          _jobs;
+    std::vector<Action>      _discardedJobs;
+    size_t                   _maxThreads { 1 };
+    size_t                   _numRunningJobs { 0 };
+    size_t                   _numIdleThreads { 0 };
+    std::atomic_size_t       _numPendingJobs { 0 };
+    std::atomic_size_t       _numDecodedTextures { 0 };
+    bool                     _isExiting { false };
+};
+
 } // anonymous namespace
 
 class HdVP2Material::TextureLoadingTask
 {
 public:
     TextureLoadingTask(
-        HdVP2Material*     parent,
-        HdSceneDelegate*   sceneDelegate,
-        const std::string& path,
-        bool               hasFallbackColor,
-        const GfVec4f&     fallbackColor)
+        HdVP2Material*             parent,
+        HdSceneDelegate*           sceneDelegate,
+        const std::string&         path,
+        const _TextureLoadOptions& options,
+        bool                       hasFallbackColor,
+        const GfVec4f&             fallbackColor)
         : _parent(parent)
         , _sceneDelegate(sceneDelegate)
         , _path(path)
+        , _options(options)
         , _fallbackColor(fallbackColor)
         , _hasFallbackColor(hasFallbackColor)
     {
+        ++sNumTasks;
     }
 
-    ~TextureLoadingTask() = default;
+    ~TextureLoadingTask() { --sNumTasks; }
+
+    //! Number of tasks not deleted yet, whether they are started or not.
+    static std::atomic_size_t sNumTasks;
 
     const HdVP2TextureInfo& GetFallbackTextureInfo()
     {
@@ -1958,21 +3292,33 @@ public:
         return _fallbackTextureInfo;
     }
 
-    bool EnqueueLoadOnIdle()
+    bool EnqueueLoad(bool highPriority)
     {
         if (_started.exchange(true)) {
             return false;
         }
-        // Push the texture loading on idle
-        auto ret = MGlobal::executeTaskOnIdle(
-            [](void* data) {
-                auto* task = static_cast<HdVP2Material::TextureLoadingTask*>(data);
-                task->_Load();
-                // Once it is done, free the memory.
-                delete task;
-            },
-            this);
-        return ret == MStatus::kSuccess;
+
+        // UDIM tiles are assembled by Maya on the main thread, load them on idle.
+        if (HdStIsSupportedUdimTexture(_path)) {
+            auto ret = MGlobal::executeTaskOnIdle(
+                [](void* data) {
+                    auto* task = static_cast<HdVP2Material::TextureLoadingTask*>(data);
+                    task->_Load();
+                    // Once it is done, free the memory.
+                    delete task;
+                },
+                this);
+            return ret == MStatus::kSuccess;
+        }
+
+        // Decode the image in the background then acquire the texture on idle.
+        if (!_TextureDecodeQueue::GetInstance().Push(
+                { [this]() { _Decode(); }, [this]() { _Discard(); } }, highPriority)) {
+            // Still owned by the material, which will delete it.
+            _started = false;
+            return false;
+        }
+        return true;
     }
 
     bool Terminate()
@@ -1992,24 +3338,98 @@ private:
         }
         bool        isSRGB = false;
         MFloatArray uvScaleOffset;
-        auto*       texture
-            = _LoadTexture(_path, _hasFallbackColor, _fallbackColor, isSRGB, uvScaleOffset);
+        auto*       texture = _LoadTexture(
+            _path, _options, _hasFallbackColor, _fallbackColor, isSRGB, uvScaleOffset);
         if (_terminated) {
             return;
         }
         _parent->_UpdateLoadedTexture(_sceneDelegate, _path, texture, isSRGB, uvScaleOffset);
     }
 
-    HdVP2TextureInfo  _fallbackTextureInfo;
-    HdVP2Material*    _parent;
-    HdSceneDelegate*  _sceneDelegate;
-    const std::string _path;
-    const GfVec4f     _fallbackColor;
-    std::atomic_bool  _started { false };
-    bool              _terminated { false };
-    bool              _hasFallbackColor;
+    //! Runs on a worker thread of the decode queue.
+    void _Decode()
+    {
+        if (!_terminated) {
+            MProfilingScope profilingScope(
+                HdVP2RenderDelegate::sProfilerCategory,
+                MProfiler::kColorD_L2,
+                "DecodeTexture",
+                _path.c_str());
+
+            _isDecoded = _DecodeTexture(_path, _options, _decoded);
+        }
+
+        // Hand over the decoded texels to the main thread.
+        auto ret = MGlobal::executeTaskOnIdle(
+            [](void* data) {
+                auto* task = static_cast<HdVP2Material::TextureLoadingTask*>(data);
+                task->_Acquire();
+                // Once it is done, free the memory.
+                delete task;
+            },
+            this);
+        if (ret != MStatus::kSuccess) {
+            // Maya is exiting: the task is deleted on the main thread once the workers
+            // are stopped, since the material may still reference it.
+            _TextureDecodeQueue::GetInstance().Discard([this]() { _Discard(); });
+        }
+    }
+
+    //! Runs on the main thread, when Maya exits before the texture is acquired.
+    void _Discard()
+    {
+        // Unless the task has been terminated, the material still references it.
+        if (!_terminated) {
+            _parent->_textureLoadingTasks.erase(_path);
+        }
+        delete this;
+    }
+
+    //! Runs on the main thread, once the image has been decoded.
+    void _Acquire()
+    {
+        if (_terminated) {
+            return;
+        }
+
+        const size_t numPendingJobs = _TextureDecodeQueue::GetInstance().GetNumPendingJobs();
+        MProfilingScope profilingScope(
+            HdVP2RenderDelegate::sProfilerCategory,
+            MProfiler::kColorD_L2,
+            "AcquireTexture",
+            (_path + " (" + std::to_string(numPendingJobs) + " pending)").c_str());
+
+        TF_DEBUG(HDVP2_DEBUG_MATERIAL)
+            .Msg(
+                "Decoded texture '%s', %zu textures decoded in the background, %zu pending\n",
+                _path.c_str(),
+                _TextureDecodeQueue::GetInstance().GetNumDecodedTextures(),
+                numPendingJobs);
+
+        bool  isSRGB = false;
+        auto* texture = _AcquireDecodedTexture(
+            _path, _hasFallbackColor, _fallbackColor, _isDecoded, _decoded, isSRGB);
+        // The texels have been copied by VP2, release them right away.
+        _decoded = _DecodedTexture();
+
+        _parent->_UpdateLoadedTexture(_sceneDelegate, _path, texture, isSRGB, MFloatArray());
+    }
+
+    HdVP2TextureInfo          _fallbackTextureInfo;
+    HdVP2Material*            _parent;
+    HdSceneDelegate*          _sceneDelegate;
+    const std::string         _path;
+    const _TextureLoadOptions _options;
+    const GfVec4f             _fallbackColor;
+    _DecodedTexture           _decoded;
+    std::atomic_bool          _started { false };
+    std::atomic_bool          _terminated { false };
+    bool                      _isDecoded { false };
+    bool                      _hasFallbackColor;
 };
 
+std::atomic_size_t HdVP2Material::TextureLoadingTask::sNumTasks { 0 };
+
 std::mutex                            HdVP2Material::_refreshMutex;
 std::chrono::steady_clock::time_point HdVP2Material::_startTime;
 std::atomic_size_t                    HdVP2Material::_runningTasksCounter;
@@ -2146,7 +3566,8 @@ void HdVP2Material::CompiledNetwork::Sync(
             size_t topoHash = _GenerateNetwork2TopoHash(surfaceNetwork);
 
             if (!_surfaceShader || topoHash != _topoHash) {
-                _surfaceShader.reset(_CreateMaterialXShaderInstance(id, surfaceNetwork));
+                _surfaceShader.reset(
+                    _CreateMaterialXShaderInstance(sceneDelegate, id, surfaceNetwork));
                 _frontFaceShader.reset(nullptr);
                 _pointShader.reset(nullptr);
                 _topoHash = topoHash;
@@ -2844,6 +4265,7 @@ void HdVP2Material::CompiledNetwork::_ApplyMtlxVP2Fixes(
 /*! \brief  Detects MaterialX networks and rehydrates them.
  */
 MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShaderInstance(
+    HdSceneDelegate*          sceneDelegate,
     SdfPath const&            materialId,
     HdMaterialNetwork2 const& surfaceNetwork)
 {
@@ -2859,9 +4281,10 @@ MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShad
     HdMaterialNetwork2 fixedNetwork;
     _ApplyMtlxVP2Fixes(fixedNetwork, surfaceNetwork);
 
-    SdfPath       terminalPath = terminalConnIt->second.upstreamNode;
-    const TfToken shaderCacheID(
-        _GenerateXMLString(fixedNetwork) + MaterialXMaya::OgsFragment::getSpecularEnvKey());
+    SdfPath           terminalPath = terminalConnIt->second.upstreamNode;
+    const std::string networkFingerprint = _GenerateNetwork2Fingerprint(fixedNetwork);
+    const TfToken     shaderCacheID(
+        networkFingerprint + MaterialXMaya::OgsFragment::getSpecularEnvKey());
 
     // Acquire a shader instance from the shader cache. If a shader instance has been cached with
     // the same token, a clone of the shader instance will be returned. Multiple clones of a shader
@@ -2883,97 +4306,139 @@ MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShad
         return shaderInstance;
     }
 
-    try {
-        // The HdMtlxCreateMtlxDocumentFromHdNetwork function can throw if any MaterialX error is
-        // raised.
-
-        // Check if the Terminal is a MaterialX Node
-        SdrRegistry&                sdrRegistry = SdrRegistry::GetInstance();
-        const SdrShaderNodeConstPtr mtlxSdrNode = sdrRegistry.GetShaderNodeByIdentifierAndType(
-            surfTerminal->nodeTypeId, HdVP2Tokens->mtlx);
-
-        mx::DocumentPtr           mtlxDoc;
-        const mx::FileSearchPath& crLibrarySearchPath(_GetMaterialXData()._mtlxSearchPath);
-        if (mtlxSdrNode) {
+    // Fragments generated by previous sessions are read from the disk cache, if there is one,
+    // skipping the MaterialX code generation.
+    const std::string fragmentCacheDirectory = _GetMtlxFragmentCacheDirectory();
+    std::string       fragmentCacheEnvironment;
+    std::string       fragmentCacheFingerprint;
+    std::string       fragmentCachePath;
+    if (!fragmentCacheDirectory.empty()) {
+        fragmentCacheEnvironment = _GetMtlxFragmentCacheEnvironment();
+        fragmentCacheFingerprint = networkFingerprint;
+        fragmentCachePath = _GetMtlxFragmentCachePath(
+            fragmentCacheDirectory, fragmentCacheFingerprint, fragmentCacheEnvironment);
+    }
 
-#ifdef HAS_COLOR_MANAGEMENT_SUPPORT_API
-            mx::DocumentPtr completeLibrary = mx::createDocument();
-            completeLibrary->importLibrary(_GetMaterialXData()._mtlxLibrary);
-            completeLibrary->importLibrary(MaterialXMaya::OgsFragment::getOCIOLibrary());
-#else
-            mx::DocumentPtr completeLibrary = _GetMaterialXData()._mtlxLibrary;
-#endif
+    _MtlxFragment fragment;
+    bool          fragmentIsReady = false;
+    if (!fragmentCachePath.empty()
+        && _ReadCachedMtlxFragment(
+            fragmentCachePath, fragmentCacheEnvironment, fragmentCacheFingerprint, fragment)) {
+        ++gNumMtlxFragmentCacheReads;
+        fragmentIsReady = true;
+    }
 
-            // Create the MaterialX Document from the HdMaterialNetwork
-#if PXR_VERSION > 2111
-            mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
-                fixedNetwork,
-                *surfTerminal, // MaterialX HdNode
-                fixedPath,
-                SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
-                completeLibrary);
-#else
-            std::set<SdfPath> hdTextureNodes;
-            mx::StringMap mxHdTextureMap; // Mx-Hd texture name counterparts
-            mtlxDoc = HdMtlxCreateMtlxDocumentFromHdNetwork(
-                fixedNetwork,
-                *surfTerminal, // MaterialX HdNode
-                SdfPath(_mtlxTokens->USD_Mtlx_VP2_Material),
-                completeLibrary,
-                &hdTextureNodes,
-                &mxHdTextureMap);
-#endif
+    // In async mode, the fragment is generated on a worker thread and the material is synced again
+    // once it is ready. The prims are drawn with the fallback shader meanwhile.
+    if (!fragmentIsReady && _IsAsyncMaterialXGeneration()) {
+        _MtlxFragmentGenerator& generator = _MtlxFragmentGenerator::GetInstance();
 
-            if (!mtlxDoc) {
+        double milliseconds = 0.0;
+        if (generator.GetResult(shaderCacheID, _owner, fragment, milliseconds)) {
+            TF_DEBUG(HDVP2_DEBUG_MATERIAL)
+                .Msg(
+                    "Generated the MaterialX fragment of %s in %.1f ms, %zu pending\n",
+                    materialId.GetText(),
+                    milliseconds,
+                    generator.GetNumPendingJobs());
+            if (fragment.name.empty()) {
                 return shaderInstance;
             }
+            fragmentIsReady = true;
+        } else {
+            auto job = [materialId,
+                        fixedNetwork,
+                        fixedPath,
+                        completeLibrary = _GetMtlxCompleteLibrary(),
+                        primaryUVSetName = _GetMaterialXData()._mainUvSetName,
+                        fragmentCachePath,
+                        fragmentCacheEnvironment,
+                        fragmentCacheFingerprint](_MtlxFragment& generated) {
+                MProfilingScope profilingScope(
+                    HdVP2RenderDelegate::sProfilerCategory,
+                    MProfiler::kColorD_L2,
+                    "GenerateMaterialXFragment",
+                    materialId.GetText());
+
+                const auto terminalIt = fixedNetwork.nodes.find(fixedPath);
+                if (terminalIt == fixedNetwork.nodes.end()) {
+                    return false;
+                }
 
-            // Touchups required to fix input stream issues:
-            _AddMissingTangents(mtlxDoc);
+                try {
+                    // The code generation can throw if any MaterialX error is raised.
+                    if (!_GenerateMtlxFragment(
+                            materialId,
+                            fixedNetwork,
+                            fixedPath,
+                            terminalIt->second,
+                            completeLibrary,
+                            primaryUVSetName,
+                            generated)) {
+                        return false;
+                    }
+                } catch (mx::Exception& e) {
+                    TF_RUNTIME_ERROR(
+                        "Caught exception '%s' while processing '%s'",
+                        e.what(),
+                        materialId.GetText());
+                    return false;
+                }
 
-            _surfaceShaderId = terminalPath;
+                if (!fragmentCachePath.empty()) {
+                    _WriteCachedMtlxFragment(
+                        fragmentCachePath,
+                        fragmentCacheEnvironment,
+                        fragmentCacheFingerprint,
+                        generated);
+                }
+                return true;
+            };
 
-            if (TfDebug::IsEnabled(HDVP2_DEBUG_MATERIAL)) {
-                std::cout << "generated shader code for " << materialId.GetText() << ":\n";
-                std::cout << "Generated graph\n==============================\n";
-                mx::writeToXmlStream(mtlxDoc, std::cout);
-                std::cout << "\n==============================\n";
+            if (generator.Push(shaderCacheID, _owner, sceneDelegate, std::move(job))) {
+                ++gNumMtlxFallbackShaders;
+                return shaderInstance;
             }
-        } else {
-            return shaderInstance;
         }
+    }
 
-        mx::NodePtr materialNode;
-        for (const mx::NodePtr& material : mtlxDoc->getMaterialNodes()) {
-            if (material->getName() == _mtlxTokens->USD_Mtlx_VP2_Material.GetText()) {
-                materialNode = material;
+    try {
+        // The code generation can throw if any MaterialX error is raised.
+        if (!fragmentIsReady) {
+            const auto start = std::chrono::steady_clock::now();
+
+            if (!_GenerateMtlxFragment(
+                    materialId,
+                    fixedNetwork,
+                    fixedPath,
+                    *surfTerminal,
+                    _GetMtlxCompleteLibrary(),
+                    _GetMaterialXData()._mainUvSetName,
+                    fragment)) {
+                return shaderInstance;
             }
-        }
 
-        if (!materialNode) {
-            return shaderInstance;
+            const std::chrono::duration<double, std::milli> duration
+                = std::chrono::steady_clock::now() - start;
+            TF_DEBUG(HDVP2_DEBUG_MATERIAL)
+                .Msg(
+                    "Generated the MaterialX fragment of %s in %.1f ms\n",
+                    materialId.GetText(),
+                    duration.count());
+
+            if (!fragmentCachePath.empty()) {
+                _WriteCachedMtlxFragment(
+                    fragmentCachePath,
+                    fragmentCacheEnvironment,
+                    fragmentCacheFingerprint,
+                    fragment);
+            }
         }
 
-        // Enable changing texcoord to geompropvalue
-        const auto prevUVSetName = mx::OgsXmlGenerator::getPrimaryUVSetName();
-        mx::OgsXmlGenerator::setPrimaryUVSetName(_GetMaterialXData()._mainUvSetName);
-
-        MaterialXMaya::OgsFragment ogsFragment(materialNode, crLibrarySearchPath);
-
-        // Restore previous UV set name
-        mx::OgsXmlGenerator::setPrimaryUVSetName(prevUVSetName);
+        _surfaceShaderId = terminalPath;
 
-        // Explore the fragment for primvars:
-        mx::ShaderPtr            shader = ogsFragment.getShader();
-        const mx::VariableBlock& vertexInputs
-            = shader->getStage(mx::Stage::VERTEX).getInputBlock(mx::HW::VERTEX_INPUTS);
-        for (size_t i = 0; i < vertexInputs.size(); ++i) {
-            const mx::ShaderPort* variable = vertexInputs[i];
-            // Position is always assumed.
-            // Tangent will be generated in the vertex shader using a utility fragment
-            if (variable->getName() == mx::HW::T_IN_NORMAL) {
-                _requiredPrimvars.push_back(HdTokens->normals);
-            }
+        if (fragment.requiresNormals) {
+            _requiredPrimvars.push_back(HdTokens->normals);
         }
 
         MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
@@ -2986,12 +4451,11 @@ MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShad
             return shaderInstance;
         }
 
-        MString fragmentName(ogsFragment.getFragmentName().c_str());
+        MString fragmentName(fragment.name.c_str());
 
         if (!fragmentManager->hasFragment(fragmentName)) {
-            std::string   fragSrc = ogsFragment.getFragmentSource();
             const MString registeredFragment
-                = fragmentManager->addShadeFragmentFromBuffer(fragSrc.c_str(), false);
+                = fragmentManager->addShadeFragmentFromBuffer(fragment.source.c_str(), false);
             if (registeredFragment.length() == 0) {
                 TF_WARN("Failed to register shader fragment %s", fragmentName.asChar());
                 return shaderInstance;
@@ -3021,7 +4485,7 @@ MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShad
         }
 
         // Fixup inputs that were renamed because they conflicted with reserved keywords:
-        for (const auto& namePair : ogsFragment.getPathInputMap()) {
+        for (const auto& namePair : fragment.pathInputMap) {
             std::string path = namePair.first;
             std::string input = namePair.second;
             // Renaming adds digits at the end, so only compare the backs.
@@ -3050,7 +4514,7 @@ MHWRender::MShaderInstance* HdVP2Material::CompiledNetwork::_CreateMaterialXShad
     if (TfDebug::IsEnabled(HDVP2_DEBUG_MATERIAL)) {
         std::cout << "BXDF material network for " << materialId << ":\n"
                   << _GenerateXMLString(surfaceNetwork) << "\n"
-                  << "Topology-only network for " << materialId << ":\n"
+                  << "Shader cache id for " << materialId << ":\n"
                   << shaderCacheID << "\n"
                   << "Required primvars:\n";
 
@@ -3482,6 +4946,7 @@ const HdVP2TextureInfo& HdVP2Material::_AcquireTexture(
         HdVP2TextureInfoSharedPtr cacheEntry = it->second.lock();
         if (cacheEntry) {
             _localTextureMap[path] = cacheEntry;
+            _TextureResidency::GetInstance().Touch(path, _GetTextureMemoryBudget());
             return *cacheEntry;
         } else {
             // if cacheEntry is nullptr then there is a stale entry in the _globalTextureMap. Erase
@@ -3499,12 +4964,16 @@ const HdVP2TextureInfo& HdVP2Material::_AcquireTexture(
         hasFallbackColor = true;
     }
 
+    // Choose the texture resolution from the viewport size and the texture memory budget.
+    const _TextureLoadOptions loadOptions = _GetTextureLoadOptions(
+        static_cast<HdVP2RenderParam*>(_renderDelegate->GetRenderParam())->GetDrawScene());
+
     if (_IsDisabledAsyncTextureLoading()) {
         bool        isSRGB = false;
         MFloatArray uvScaleOffset;
 
-        MHWRender::MTexture* texture
-            = _LoadTexture(path, hasFallbackColor, fallbackColor, isSRGB, uvScaleOffset);
+        MHWRender::MTexture* texture = _LoadTexture(
+            path, loadOptions, hasFallbackColor, fallbackColor, isSRGB, uvScaleOffset);
 
         HdVP2TextureInfoSharedPtr info = std::make_shared<HdVP2TextureInfo>();
         // path should never already be in _localTextureMap because if it was
@@ -3522,19 +4991,23 @@ const HdVP2TextureInfo& HdVP2Material::_AcquireTexture(
             info->_stOffset.Set(
                 uvScaleOffset[2], uvScaleOffset[3]); // The next two elements are the offset
         }
+        _TextureResidency::GetInstance().Add(path, info, _GetTextureMemoryBudget());
 
         return *info;
     }
 
-    auto* task = new TextureLoadingTask(this, sceneDelegate, path, hasFallbackColor, fallbackColor);
+    _TextureDecodeQueue::GetInstance().SetMaxThreads(_GetAsyncTextureLoadingThreads());
+
+    auto* task = new TextureLoadingTask(
+        this, sceneDelegate, path, loadOptions, hasFallbackColor, fallbackColor);
     _textureLoadingTasks.emplace(path, task);
     return task->GetFallbackTextureInfo();
 }
 
-void HdVP2Material::EnqueueLoadTextures()
+void HdVP2Material::EnqueueLoadTextures(bool highPriority)
 {
     for (const auto& task : _textureLoadingTasks) {
-        if (task.second->EnqueueLoadOnIdle()) {
+        if (task.second->EnqueueLoad(highPriority)) {
             ++_runningTasksCounter;
         }
     }
@@ -3553,6 +5026,11 @@ void HdVP2Material::ClearPendingTasks()
 
     // Remove the reference of all the tasks
     _textureLoadingTasks.clear();
+
+#ifdef WANT_MATERIALX_BUILD
+    // Fragments being generated for this material don't need to notify it anymore
+    _MtlxFragmentGenerator::GetInstance().Forget(this);
+#endif
     // Reset counter, tasks that have started but not finished yet would be
     // terminated and won't trigger any refresh
     _runningTasksCounter = 0;
@@ -3599,6 +5077,7 @@ void HdVP2Material::_UpdateLoadedTexture(
             info->_stOffset.Set(
                 uvScaleOffset[2], uvScaleOffset[3]); // The next two elements are the offset
         }
+        _TextureResidency::GetInstance().Add(path, info, _GetTextureMemoryBudget());
     }
 
     // Mark sprim dirty
@@ -3698,9 +5177,37 @@ void HdVP2Material::MaterialChanged(HdSceneDelegate* sceneDelegate)
 
 void HdVP2Material::OnMayaExit()
 {
+#ifdef WANT_MATERIALX_BUILD
+    _MtlxFragmentGenerator::GetInstance().OnMayaExit();
+#endif
+    _TextureDecodeQueue::GetInstance().OnMayaExit();
+    _TextureResidency::GetInstance().Clear();
     _TransientTexturePreserver::GetInstance().OnMayaExit();
     _globalTextureMap.clear();
     HdVP2RenderDelegate::OnMayaExit();
 }
 
+void HdVP2Material::GetStatistics(VtDictionary& stats)
+{
+    const _TextureDecodeQueue& decodeQueue = _TextureDecodeQueue::GetInstance();
+    stats["textureLoadingTasks"] = VtValue(TextureLoadingTask::sNumTasks.load());
+    stats["textureDecodePendingJobs"] = VtValue(decodeQueue.GetNumPendingJobs());
+    stats["textureDecodedCount"] = VtValue(decodeQueue.GetNumDecodedTextures());
+
+    const _TextureResidency& residency = _TextureResidency::GetInstance();
+    stats["textureResidentBytes"] = VtValue(residency.GetResidentBytes());
+    stats["textureResidentCount"] = VtValue(residency.GetNumResidentTextures());
+    stats["textureEvictedCount"] = VtValue(residency.GetNumEvictedTextures());
+    stats["textureReducedCount"] = VtValue(gNumReducedTextures.load());
+    stats["textureCacheReadCount"] = VtValue(gNumCachedTextureReads.load());
+
+#ifdef WANT_MATERIALX_BUILD
+    stats["mtlxFragmentGeneratedCount"] = VtValue(gNumGeneratedMtlxFragments.load());
+    stats["mtlxFragmentCacheReadCount"] = VtValue(gNumMtlxFragmentCacheReads.load());
+    stats["mtlxFragmentPendingJobs"]
+        = VtValue(_MtlxFragmentGenerator::GetInstance().GetNumPendingJobs());
+    stats["mtlxFragmentFallbackCount"] = VtValue(gNumMtlxFallbackShaders.load());
+#endif
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
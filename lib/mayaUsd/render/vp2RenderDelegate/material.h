@@ -19,6 +19,7 @@
 #include "shader.h"
 
 #include <pxr/base/gf/vec2f.h>
+#include <pxr/base/vt/dictionary.h>
 #include <pxr/imaging/hd/material.h>
 #include <pxr/pxr.h>
 
@@ -103,7 +104,10 @@ public:
     //! Get primvar tokens required by this material.
     const TfTokenVector& GetRequiredPrimvars(const TfToken& reprToken) const;
 
-    void EnqueueLoadTextures();
+    //! Start loading the textures. The textures of high priority materials, used by
+    //! prims in the camera frustum, are decoded before the others.
+    void EnqueueLoadTextures(bool highPriority);
+    bool HasTexturesToLoad() const { return !_textureLoadingTasks.empty(); }
     void ClearPendingTasks();
 
     //! The specified Rprim starts listening to changes on this material.
@@ -120,6 +124,9 @@ public:
 
     static void OnMayaExit();
 
+    //! Add the counters of the texture loading and of the shader generation to the statistics.
+    static void GetStatistics(VtDictionary& stats);
+
 private:
     class CompiledNetwork
     {
@@ -185,6 +192,7 @@ private:
 
         void _ApplyMtlxVP2Fixes(HdMaterialNetwork2& outNet, const HdMaterialNetwork2& inNet);
         MHWRender::MShaderInstance* _CreateMaterialXShaderInstance(
+            HdSceneDelegate*          sceneDelegate,
             SdfPath const&            materialId,
             HdMaterialNetwork2 const& hdNetworkMap);
 #endif
@@ -114,12 +114,16 @@ MayaUsdRPrim::MayaUsdRPrim(HdVP2RenderDelegate* delegate, const SdfPath& id)
 
 MayaUsdRPrim::~MayaUsdRPrim()
 {
+    auto* const          param = static_cast<HdVP2RenderParam*>(_delegate->GetRenderParam());
+    ProxyRenderDelegate& drawScene = param->GetDrawScene();
     if (!_pathInPrototype.first.IsEmpty()) {
         // Clear my entry from the instancing map
-        auto* const          param = static_cast<HdVP2RenderParam*>(_delegate->GetRenderParam());
-        ProxyRenderDelegate& drawScene = param->GetDrawScene();
         drawScene.UpdateInstancingMapEntry(_pathInPrototype, sVoidInstancePrototypePath, _hydraId);
     }
+    if (!_indexedRenderTag.IsEmpty()) {
+        // Clear my entry from the render tag membership index
+        drawScene.UpdateRenderTagMembership(_indexedRenderTag, TfToken(), _hydraId);
+    }
 }
 
 void MayaUsdRPrim::_CommitMVertexBuffer(MHWRender::MVertexBuffer* const buffer, void* bufferData)
@@ -937,11 +941,22 @@ bool MayaUsdRPrim::_SyncCommon(
         TF_VERIFY(_selectionStatus == drawScene.GetSelectionStatus(id));
     }
 
+    // Keep the render tag membership index of the ProxyRenderDelegate up to date.
+    // UpdateRenderTagMembership is not multithread-safe, so enqueue the call.
+    HdRenderIndex& renderIndex = delegate->GetRenderIndex();
+    const TfToken  renderTag = renderIndex.GetRenderTag(id);
+    if (renderTag != _indexedRenderTag) {
+        _delegate->GetVP2ResourceRegistry().EnqueueCommit([this, id, renderTag]() {
+            auto* const param = static_cast<HdVP2RenderParam*>(_delegate->GetRenderParam());
+            param->GetDrawScene().UpdateRenderTagMembership(_indexedRenderTag, renderTag, id);
+            _indexedRenderTag = renderTag;
+        });
+    }
+
     // We don't update the repr if it is hidden by the render tags (purpose)
     // of the ProxyRenderDelegate. In additional, we need to hide any already
     // existing render items because they should not be drawn.
-    HdRenderIndex& renderIndex = delegate->GetRenderIndex();
-    if (!drawScene.DrawRenderTag(renderIndex.GetRenderTag(id))) {
+    if (!drawScene.DrawRenderTag(renderTag)) {
         _HideAllDrawItems(curRepr);
         *dirtyBits &= ~(HdChangeTracker::DirtyRenderTag);
         return false;
@@ -997,9 +1012,11 @@ SdfPath MayaUsdRPrim::_GetUpdatedMaterialId(HdRprim* rprim, HdSceneDelegate* del
     if (!materialId.IsEmpty()) {
         auto* material = dynamic_cast<HdVP2Material*>(
             renderIndex.GetSprim(HdPrimTypeTokens->material, materialId));
-        if (material) {
-            // Load the textures if any
-            material->EnqueueLoadTextures();
+        if (material && material->HasTexturesToLoad()) {
+            // Load the textures if any, starting with those of the prims in the camera frustum.
+            auto* const param = static_cast<HdVP2RenderParam*>(_delegate->GetRenderParam());
+            const GfBBox3d bounds(delegate->GetExtent(id), delegate->GetTransform(id));
+            material->EnqueueLoadTextures(param->GetDrawScene().IsInViewFrustum(bounds));
         }
     }
 
@@ -409,6 +409,9 @@ protected:
 
     //! For instanced prim, holds the corresponding path in USD prototype
     InstancePrototypePath _pathInPrototype { SdfPath(), kNativeInstancing };
+
+    //! Render tag under which the prim is indexed by the ProxyRenderDelegate
+    TfToken _indexedRenderTag;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -274,6 +274,32 @@ void _FillEdgeIndices(int* indices, const HdMeshTopology& topology)
     }
 }
 
+//! Helper utility function to fill an index buffer shared by the meshes with the same topology
+void _FillSharedIndexBuffer(
+    MHWRender::MIndexBuffer&       indexBuffer,
+    const HdVP2SharedMeshTopology& sharedTopology,
+    bool                           edges)
+{
+    const unsigned int numIndex = edges
+        ? _GetNumOfEdgeIndices(sharedTopology._renderingTopology)
+        : sharedTopology._trianglesFaceVertexIndices.size() * 3;
+    if (numIndex == 0) {
+        return;
+    }
+
+    int* indices = static_cast<int*>(indexBuffer.acquire(numIndex, true));
+    if (!indices) {
+        return;
+    }
+
+    if (edges) {
+        _FillEdgeIndices(indices, sharedTopology._renderingTopology);
+    } else {
+        memcpy(indices, sharedTopology._trianglesFaceVertexIndices.cdata(), numIndex * sizeof(int));
+    }
+    indexBuffer.commit(indices);
+}
+
 PrimvarInfo* _getInfo(const PrimvarInfoMap& infoMap, const TfToken& token)
 {
     auto it = infoMap.find(token);
@@ -437,7 +463,11 @@ void HdVP2Mesh::_PrepareSharedVertexBuffers(
             if (computeCPUNormals) {
                 // note: normals gets dirty when points are marked as dirty,
                 // at change tracker.
-                if (!_meshSharedData->_adjacency) {
+                if (!_meshSharedData->_adjacency && _meshSharedData->_sharedTopology) {
+                    // the adjacency is built once for all the meshes with the same topology.
+                    _meshSharedData->_adjacency
+                        = _meshSharedData->_sharedTopology->GetAdjacency();
+                } else if (!_meshSharedData->_adjacency) {
                     MProfilingScope profilingScope(
                         HdVP2RenderDelegate::sProfilerCategory,
                         MProfiler::kColorC_L2,
@@ -772,6 +802,7 @@ bool HdVP2Mesh::_PrimvarIsRequired(const TfToken& primvar) const
 void HdVP2Mesh::_ResetRenderingTopology()
 {
     _meshSharedData->_renderingTopology = HdMeshTopology();
+    _meshSharedData->_sharedTopology.reset();
 
     RenderItemFunc setIndexBufferDirty = [](HdVP2DrawItem::RenderItemData& renderItemData) {
         renderItemData._indexBufferValid = false;
@@ -948,82 +979,20 @@ void HdVP2Mesh::Sync(
             _rprimId.asChar(),
             "HdVP2Mesh Create Rendering Topology");
 
-        const HdMeshTopology& topology = _meshSharedData->_topology;
-        const VtIntArray&     faceVertexIndices = topology.GetFaceVertexIndices();
-        const size_t          numFaceVertexIndices = faceVertexIndices.size();
-
-        VtIntArray newFaceVertexIndices;
-        newFaceVertexIndices.resize(numFaceVertexIndices);
-
-        if (_meshSharedData->_isVertexLayoutUnshared) {
-            _meshSharedData->_numVertices = numFaceVertexIndices;
-            _meshSharedData->_renderingToSceneFaceVtxIds = faceVertexIndices;
-            _meshSharedData->_sceneToRenderingFaceVtxIds.clear();
-            _meshSharedData->_sceneToRenderingFaceVtxIds.resize(topology.GetNumPoints(), -1);
-
-            for (size_t i = 0; i < numFaceVertexIndices; i++) {
-                const int sceneFaceVtxId = faceVertexIndices[i];
-                _meshSharedData->_sceneToRenderingFaceVtxIds[sceneFaceVtxId]
-                    = i; // could check if the existing value is -1, but it doesn't matter.
-                         // we just need to map to a vertex in the position buffer that has
-                         // the correct value.
-            }
-
-            // Fill with sequentially increasing values, starting from 0. The new
-            // face vertex indices will be used to populate index data for unshared
-            // vertex layout. Note that _FillPrimvarData assumes this sequence to
-            // be used for face-varying primvars and saves lookup and remapping
-            // with _renderingToSceneFaceVtxIds, so in case we change the array we
-            // should update _FillPrimvarData() code to remap indices correctly.
-            std::iota(newFaceVertexIndices.begin(), newFaceVertexIndices.end(), 0);
-        } else {
-            _meshSharedData->_numVertices = topology.GetNumPoints();
-            _meshSharedData->_renderingToSceneFaceVtxIds.clear();
-
-            // Allocate large enough memory with initial value of -1 to indicate
-            // the rendering face vertex index is not determined yet.
-            _meshSharedData->_sceneToRenderingFaceVtxIds.clear();
-            _meshSharedData->_sceneToRenderingFaceVtxIds.resize(numFaceVertexIndices, -1);
-            unsigned int sceneToRenderingFaceVtxIdsCount = 0;
-
-            // Sort vertices to avoid drastically jumping indices. Cache efficiency
-            // is important to fast rendering performance for dense mesh.
-            for (size_t i = 0; i < numFaceVertexIndices; i++) {
-                const int sceneFaceVtxId = faceVertexIndices[i];
-
-                int renderFaceVtxId = _meshSharedData->_sceneToRenderingFaceVtxIds[sceneFaceVtxId];
-                if (renderFaceVtxId < 0) {
-                    renderFaceVtxId = _meshSharedData->_renderingToSceneFaceVtxIds.size();
-                    _meshSharedData->_renderingToSceneFaceVtxIds.push_back(sceneFaceVtxId);
-
-                    _meshSharedData->_sceneToRenderingFaceVtxIds[sceneFaceVtxId] = renderFaceVtxId;
-                    sceneToRenderingFaceVtxIdsCount++;
-                }
-
-                newFaceVertexIndices[i] = renderFaceVtxId;
-            }
-
-            _meshSharedData->_sceneToRenderingFaceVtxIds.resize(
-                sceneToRenderingFaceVtxIdsCount); // drop any extra -1 values.
-        }
-
-        _meshSharedData->_renderingTopology = HdMeshTopology(
-            topology.GetScheme(),
-            topology.GetOrientation(),
-            topology.GetFaceVertexCounts(),
-            newFaceVertexIndices,
-            topology.GetHoleIndices(),
-            topology.GetRefineLevel());
-
-        // All the render items to draw the shaded (Hull) style share the topology
-        // calculation
-        HdMeshUtil meshUtil(&_meshSharedData->_renderingTopology, GetId());
-        _meshSharedData->_trianglesFaceVertexIndices.clear();
-        _meshSharedData->_primitiveParam.clear();
-        meshUtil.ComputeTriangleIndices(
-            &_meshSharedData->_trianglesFaceVertexIndices,
-            &_meshSharedData->_primitiveParam,
-            nullptr);
+        // Meshes with the same topology share the rendering topology and its triangulation.
+        // VtArrays are reference counted, so the copies below don't duplicate the data.
+        _meshSharedData->_sharedTopology = _delegate->GetMeshTopologyRegistry().Acquire(
+            _meshSharedData->_topology, _meshSharedData->_isVertexLayoutUnshared, GetId());
+
+        const HdVP2SharedMeshTopology& sharedTopology = *_meshSharedData->_sharedTopology;
+        _meshSharedData->_renderingTopology = sharedTopology._renderingTopology;
+        _meshSharedData->_renderingToSceneFaceVtxIds = sharedTopology._renderingToSceneFaceVtxIds;
+        _meshSharedData->_trianglesFaceVertexIndices = sharedTopology._trianglesFaceVertexIndices;
+        _meshSharedData->_primitiveParam = sharedTopology._primitiveParam;
+        _meshSharedData->_numVertices = sharedTopology._numVertices;
+#ifdef HDVP2_ENABLE_GPU_COMPUTE
+        _meshSharedData->_sceneToRenderingFaceVtxIds = sharedTopology._sceneToRenderingFaceVtxIds;
+#endif
 
         // Decide if we should use GPU compute, and set up compute objects for later user
 #ifdef HDVP2_ENABLE_GPU_COMPUTE
@@ -1629,10 +1598,17 @@ void HdVP2Mesh::_UpdateDrawItem(
     const bool requiresIndexUpdate = !isBBoxItem && !isPointSnappingItem;
 #endif
 
+    // Items drawing the whole mesh can use the index buffers shared with the meshes having the
+    // same topology. GPU compute may change the rendering topology, so it keeps its own buffers.
+    const bool canShareIndexBuffer = _meshSharedData->_sharedTopology && !_gpuNormalsEnabled;
+    bool       indexBufferChanged = false;
+
     // Prepare index buffer.
     if (requiresIndexUpdate && !renderItemData._indexBufferValid) {
         const HdMeshTopology& topologyToUse = _meshSharedData->_renderingTopology;
 
+        std::shared_ptr<MHWRender::MIndexBuffer> sharedIndexBuffer;
+
         if (desc.geomStyle == HdMeshGeomStyleHull) {
             MProfilingScope profilingScope(
                 HdVP2RenderDelegate::sProfilerCategory,
@@ -1646,8 +1622,9 @@ void HdVP2Mesh::_UpdateDrawItem(
 
             VtVec3iArray     trianglesFaceVertexIndices; // for this item only!
             std::vector<int> faceIds;
-            if (_meshSharedData->_faceIdToGeomSubsetId.size() == 0
-                || reprToken == HdVP2ReprTokens->defaultMaterial) {
+            const bool       allFaces = _meshSharedData->_faceIdToGeomSubsetId.size() == 0
+                || reprToken == HdVP2ReprTokens->defaultMaterial;
+            if (allFaces) {
                 // If there is no mapping from face to render item or if this is the default
                 // material item then all the faces are on this render item. VtArray has
                 // copy-on-write semantics so this is fast
@@ -1712,24 +1689,37 @@ void HdVP2Mesh::_UpdateDrawItem(
 
             const int numIndex = trianglesFaceVertexIndices.size() * 3;
 
-            stateToCommit._indexBufferData = numIndex > 0
-                ? static_cast<int*>(drawItemData._indexBuffer->acquire(numIndex, true))
-                : nullptr;
-            if (stateToCommit._indexBufferData) {
-                memcpy(
-                    stateToCommit._indexBufferData,
-                    trianglesFaceVertexIndices.data(),
-                    numIndex * sizeof(int));
+            if (canShareIndexBuffer && allFaces) {
+                sharedIndexBuffer = _meshSharedData->_sharedTopology->_trianglesIndexBuffer;
+            } else {
+                stateToCommit._indexBufferData = numIndex > 0
+                    ? static_cast<int*>(drawItemData._indexBuffer->acquire(numIndex, true))
+                    : nullptr;
+                if (stateToCommit._indexBufferData) {
+                    memcpy(
+                        stateToCommit._indexBufferData,
+                        trianglesFaceVertexIndices.data(),
+                        numIndex * sizeof(int));
+                }
             }
         } else if (desc.geomStyle == HdMeshGeomStyleHullEdgeOnly) {
-            unsigned int numIndex = _GetNumOfEdgeIndices(topologyToUse);
+            if (canShareIndexBuffer) {
+                sharedIndexBuffer = _meshSharedData->_sharedTopology->_edgesIndexBuffer;
+            } else {
+                unsigned int numIndex = _GetNumOfEdgeIndices(topologyToUse);
 
-            stateToCommit._indexBufferData = numIndex
-                ? static_cast<int*>(drawItemData._indexBuffer->acquire(numIndex, true))
-                : nullptr;
-            _FillEdgeIndices(stateToCommit._indexBufferData, topologyToUse);
+                stateToCommit._indexBufferData = numIndex
+                    ? static_cast<int*>(drawItemData._indexBuffer->acquire(numIndex, true))
+                    : nullptr;
+                _FillEdgeIndices(stateToCommit._indexBufferData, topologyToUse);
+            }
         }
         renderItemData._indexBufferValid = true;
+
+        if (drawItemData._sharedIndexBuffer != sharedIndexBuffer) {
+            drawItemData._sharedIndexBuffer = sharedIndexBuffer;
+            indexBufferChanged = true;
+        }
     }
 
 #ifdef HDVP2_ENABLE_GPU_COMPUTE
@@ -1766,8 +1756,14 @@ void HdVP2Mesh::_UpdateDrawItem(
                     const HdCullStyle           cullStyle = GetCullStyle(sceneDelegate);
                     MHWRender::MShaderInstance* shader = material->GetSurfaceShader(
                         _GetMaterialNetworkToken(reprToken), cullStyle == HdCullStyleBack);
-                    if (shader != nullptr
-                        && (shader != drawItemData._shader || shader != stateToCommit._shader)) {
+                    if (shader == nullptr) {
+                        // The shader of the material may not be created yet, for example while
+                        // its MaterialX fragment is generated in the background.
+                        if (!drawItemData._shaderIsFallback) {
+                            drawItemData._shaderIsFallback = true;
+                            drawItemData._fallbackColorDirty = true;
+                        }
+                    } else if (shader != drawItemData._shader || shader != stateToCommit._shader) {
                         drawItemData._shader = shader;
                         drawItemData._shaderIsFallback = false;
                         stateToCommit._shader = shader;
@@ -2154,10 +2150,10 @@ void HdVP2Mesh::_UpdateDrawItem(
         }
     }
 
-    stateToCommit._geometryDirty
-        = (itemDirtyBits
-           & (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyNormals
-              | HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyTopology));
+    stateToCommit._geometryDirty = indexBufferChanged
+        || (itemDirtyBits
+            & (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyNormals
+               | HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyTopology));
 
     // Some items may require selection mask overrides
     if (!isDedicatedHighlightItem && !isPointSnappingItem
@@ -2197,6 +2193,17 @@ void HdVP2Mesh::_UpdateDrawItem(
         indexBuffer = const_cast<MHWRender::MIndexBuffer*>(sharedBBoxGeom.GetIndexBuffer());
     }
 
+    // The shared index buffer and the topology to fill it are kept alive until the commit.
+    const bool isEdgeItem = (desc.geomStyle == HdMeshGeomStyleHullEdgeOnly);
+
+    std::shared_ptr<MHWRender::MIndexBuffer> sharedIndexBuffer;
+    HdVP2SharedMeshTopologyPtr               sharedTopology;
+    if (!isBBoxItem && drawItemData._sharedIndexBuffer) {
+        sharedIndexBuffer = drawItemData._sharedIndexBuffer;
+        sharedTopology = _meshSharedData->_sharedTopology;
+        indexBuffer = sharedIndexBuffer.get();
+    }
+
     // We can get an empty stateToCommit when viewport draw modes change. In this case every
     // rprim is marked dirty to give any stale render items a chance to update. If there are
     // no stale render items then stateToCommit can be empty!
@@ -2206,6 +2213,9 @@ void HdVP2Mesh::_UpdateDrawItem(
                                                            primvarInfo,
                                                            primvars,
                                                            indexBuffer,
+                                                           sharedIndexBuffer,
+                                                           sharedTopology,
+                                                           isEdgeItem,
                                                            isBBoxItem,
                                                            &sharedBBoxGeom]() {
             // This code executes serially, once per mesh updated. Keep
@@ -2221,6 +2231,10 @@ void HdVP2Mesh::_UpdateDrawItem(
             if (stateToCommit._indexBufferData)
                 indexBuffer->commit(stateToCommit._indexBufferData);
 
+            // The first mesh committing a shared index buffer fills it for the other ones.
+            if (sharedIndexBuffer && sharedTopology && sharedIndexBuffer->size() == 0)
+                _FillSharedIndexBuffer(*sharedIndexBuffer, *sharedTopology, isEdgeItem);
+
             // If available, something changed
             if (stateToCommit._shader != nullptr) {
                 bool success = renderItem->setShader(stateToCommit._shader);
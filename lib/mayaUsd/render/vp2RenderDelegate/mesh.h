@@ -18,6 +18,7 @@
 
 #include "draw_item.h"
 #include "mayaPrimCommon.h"
+#include "meshTopologyRegistry.h"
 #include "meshViewportCompute.h"
 #include "primvarInfo.h"
 
@@ -52,6 +53,10 @@ struct HdVP2MeshSharedData
     //! Adjacency based off of _topology
     Hd_VertexAdjacencySharedPtr _adjacency;
 
+    //! Rendering topology, triangulation and index buffers shared with the meshes having the
+    //! same topology. The members below are copied from it when it is acquired.
+    HdVP2SharedMeshTopologyPtr _sharedTopology;
+
     //! The rendering topology is to create unshared or sorted vertice layout
     //! for efficient GPU rendering.
     HdMeshTopology _renderingTopology;
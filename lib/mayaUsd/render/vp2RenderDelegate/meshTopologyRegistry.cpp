@@ -0,0 +1,254 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "meshTopologyRegistry.h"
+
+#include "debugCodes.h"
+#include "render_delegate.h"
+
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/imaging/hd/meshUtil.h>
+
+#include <maya/MProfiler.h>
+
+#include <iterator>
+#include <numeric>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+//! Salt of the key of the topologies drawn with an unshared vertex layout
+constexpr size_t kUnsharedVertexLayoutSalt = 0x9e3779b97f4a7c15ull;
+
+//! \brief  Returns the topology without the geom subsets and the invisible components, which
+//!         have no effect on the rendering topology.
+HdMeshTopology _GetKeyTopology(const HdMeshTopology& topology)
+{
+    return HdMeshTopology(
+        topology.GetScheme(),
+        topology.GetOrientation(),
+        topology.GetFaceVertexCounts(),
+        topology.GetFaceVertexIndices(),
+        topology.GetHoleIndices(),
+        topology.GetRefineLevel());
+}
+
+} // namespace
+
+const Hd_VertexAdjacencySharedPtr& HdVP2SharedMeshTopology::GetAdjacency() const
+{
+    std::call_once(_adjacencyOnce, [this]() {
+        MProfilingScope profilingScope(
+            HdVP2RenderDelegate::sProfilerCategory,
+            MProfiler::kColorC_L2,
+            "HdVP2MeshTopologyRegistry",
+            "HdVP2SharedMeshTopology::computeAdjacency");
+
+        Hd_VertexAdjacencySharedPtr adjacency(new Hd_VertexAdjacency());
+        adjacency->BuildAdjacencyTable(&_topology);
+        _adjacency = adjacency;
+    });
+
+    return _adjacency;
+}
+
+void HdVP2SharedMeshTopology::_Compute(const SdfPath& id)
+{
+    const VtIntArray& faceVertexIndices = _topology.GetFaceVertexIndices();
+    const size_t      numFaceVertexIndices = faceVertexIndices.size();
+
+    VtIntArray newFaceVertexIndices;
+    newFaceVertexIndices.resize(numFaceVertexIndices);
+
+    if (_isVertexLayoutUnshared) {
+        _numVertices = numFaceVertexIndices;
+        _renderingToSceneFaceVtxIds = faceVertexIndices;
+        _sceneToRenderingFaceVtxIds.resize(_topology.GetNumPoints(), -1);
+
+        for (size_t i = 0; i < numFaceVertexIndices; i++) {
+            const int sceneFaceVtxId = faceVertexIndices[i];
+            _sceneToRenderingFaceVtxIds[sceneFaceVtxId]
+                = i; // could check if the existing value is -1, but it doesn't matter.
+                     // we just need to map to a vertex in the position buffer that has
+                     // the correct value.
+        }
+
+        // Fill with sequentially increasing values, starting from 0. The new
+        // face vertex indices will be used to populate index data for unshared
+        // vertex layout. Note that _FillPrimvarData assumes this sequence to
+        // be used for face-varying primvars and saves lookup and remapping
+        // with _renderingToSceneFaceVtxIds, so in case we change the array we
+        // should update _FillPrimvarData() code to remap indices correctly.
+        std::iota(newFaceVertexIndices.begin(), newFaceVertexIndices.end(), 0);
+    } else {
+        _numVertices = _topology.GetNumPoints();
+
+        // Allocate large enough memory with initial value of -1 to indicate
+        // the rendering face vertex index is not determined yet.
+        _sceneToRenderingFaceVtxIds.resize(numFaceVertexIndices, -1);
+        unsigned int sceneToRenderingFaceVtxIdsCount = 0;
+
+        // Sort vertices to avoid drastically jumping indices. Cache efficiency
+        // is important to fast rendering performance for dense mesh.
+        for (size_t i = 0; i < numFaceVertexIndices; i++) {
+            const int sceneFaceVtxId = faceVertexIndices[i];
+
+            int renderFaceVtxId = _sceneToRenderingFaceVtxIds[sceneFaceVtxId];
+            if (renderFaceVtxId < 0) {
+                renderFaceVtxId = _renderingToSceneFaceVtxIds.size();
+                _renderingToSceneFaceVtxIds.push_back(sceneFaceVtxId);
+
+                _sceneToRenderingFaceVtxIds[sceneFaceVtxId] = renderFaceVtxId;
+                sceneToRenderingFaceVtxIdsCount++;
+            }
+
+            newFaceVertexIndices[i] = renderFaceVtxId;
+        }
+
+        _sceneToRenderingFaceVtxIds.resize(
+            sceneToRenderingFaceVtxIdsCount); // drop any extra -1 values.
+    }
+
+    _renderingTopology = HdMeshTopology(
+        _topology.GetScheme(),
+        _topology.GetOrientation(),
+        _topology.GetFaceVertexCounts(),
+        newFaceVertexIndices,
+        _topology.GetHoleIndices(),
+        _topology.GetRefineLevel());
+
+    // All the render items to draw the shaded (Hull) style share the topology
+    // calculation
+    HdMeshUtil meshUtil(&_renderingTopology, id);
+    meshUtil.ComputeTriangleIndices(&_trianglesFaceVertexIndices, &_primitiveParam, nullptr);
+
+    // The index buffers are filled by the first commit using them.
+    const MHWRender::MIndexBuffer::MIndexType indexType = MHWRender::MGeometry::kUnsignedInt32;
+    _trianglesIndexBuffer = std::make_shared<MHWRender::MIndexBuffer>(indexType);
+    _edgesIndexBuffer = std::make_shared<MHWRender::MIndexBuffer>(indexType);
+}
+
+HdVP2MeshTopologyRegistry::HdVP2MeshTopologyRegistry()
+    : _state(std::make_shared<_State>())
+{
+}
+
+HdVP2MeshTopologyRegistry::~HdVP2MeshTopologyRegistry() = default;
+
+HdVP2SharedMeshTopologyPtr HdVP2MeshTopologyRegistry::Acquire(
+    const HdMeshTopology& topology,
+    bool                  isVertexLayoutUnshared,
+    const SdfPath&        id)
+{
+    const HdMeshTopology keyTopology = _GetKeyTopology(topology);
+
+    size_t key = keyTopology.ComputeHash();
+    if (isVertexLayoutUnshared) {
+        key ^= kUnsharedVertexLayoutSalt;
+    }
+
+    // Entries locked during the lookup are released after the mutex, since releasing the last
+    // reference to an entry removes it from the registry.
+    std::vector<std::shared_ptr<HdVP2SharedMeshTopology>> candidates;
+    std::shared_ptr<HdVP2SharedMeshTopology>              entry;
+    {
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+
+        auto range = _state->_entries.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::shared_ptr<HdVP2SharedMeshTopology> candidate = it->second.lock();
+            if (candidate && candidate->_isVertexLayoutUnshared == isVertexLayoutUnshared
+                && candidate->_topology == keyTopology) {
+                entry = std::move(candidate);
+                break;
+            }
+            candidates.push_back(std::move(candidate));
+        }
+
+        if (entry) {
+            ++_state->_hits;
+        } else {
+            ++_state->_misses;
+
+            // The deleter removes the expired entries of the key, unless the registry is gone.
+            std::weak_ptr<_State> weakState = _state;
+
+            auto deleter = [weakState, key](HdVP2SharedMeshTopology* shared) {
+                if (std::shared_ptr<_State> state = weakState.lock()) {
+                    std::lock_guard<std::mutex> lock(state->_mutex);
+
+                    auto range = state->_entries.equal_range(key);
+                    for (auto it = range.first; it != range.second;) {
+                        it = it->second.expired() ? state->_entries.erase(it) : std::next(it);
+                    }
+                }
+                delete shared;
+            };
+
+            entry.reset(new HdVP2SharedMeshTopology(keyTopology, isVertexLayoutUnshared), deleter);
+            _state->_entries.emplace(key, entry);
+        }
+    }
+
+    // The first mesh acquiring the entry computes it, the other ones wait for the result.
+    std::call_once(entry->_computeOnce, [&entry, &id]() {
+        MProfilingScope profilingScope(
+            HdVP2RenderDelegate::sProfilerCategory,
+            MProfiler::kColorC_L2,
+            "HdVP2MeshTopologyRegistry",
+            "HdVP2MeshTopologyRegistry miss");
+
+        TF_DEBUG(HDVP2_DEBUG_MESH).Msg("Computing the shared topology of %s\n", id.GetText());
+
+        entry->_Compute(id);
+    });
+
+    return entry;
+}
+
+size_t HdVP2MeshTopologyRegistry::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(_state->_mutex);
+    return _state->_entries.size();
+}
+
+void HdVP2MeshTopologyRegistry::ReportStatistics()
+{
+    const size_t hits = _state->_hits;
+    const size_t misses = _state->_misses;
+    if (hits == _reportedHits && misses == _reportedMisses) {
+        return;
+    }
+
+    const std::string statistics = TfStringPrintf(
+        "HdVP2MeshTopologyRegistry: %zu entries, %zu hits, %zu misses",
+        GetEntryCount(),
+        hits - _reportedHits,
+        misses - _reportedMisses);
+
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory,
+        MProfiler::kColorC_L2,
+        "HdVP2MeshTopologyRegistry",
+        statistics.c_str());
+
+    TF_DEBUG(HDVP2_DEBUG_MESH).Msg("%s\n", statistics.c_str());
+
+    _reportedHits = hits;
+    _reportedMisses = misses;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,131 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_MESH_TOPOLOGY_REGISTRY
+#define HD_VP2_MESH_TOPOLOGY_REGISTRY
+
+#include <pxr/base/gf/vec3i.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/imaging/hd/vertexAdjacency.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <maya/MHWGeometry.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  Topology data shared among all the HdVP2Mesh rprims with an identical topology.
+    \class  HdVP2SharedMeshTopology
+
+    The rendering topology, its triangulation and the adjacency only depend on the scene topology
+    and on the vertex layout. The data are computed once by the registry and are read-only
+    afterwards, except for the index buffers which are filled by the first commit using them.
+*/
+struct HdVP2SharedMeshTopology
+{
+    HdVP2SharedMeshTopology(const HdMeshTopology& topology, bool isVertexLayoutUnshared)
+        : _topology(topology)
+        , _isVertexLayoutUnshared(isVertexLayoutUnshared)
+    {
+    }
+
+    //! Returns the adjacency of the scene topology, built on first use. Thread safe.
+    const Hd_VertexAdjacencySharedPtr& GetAdjacency() const;
+
+    //! Scene topology
+    const HdMeshTopology _topology;
+
+    //! Whether the vertex layout used for drawing is unshared
+    const bool _isVertexLayoutUnshared;
+
+    //! Same as the members of HdVP2MeshSharedData
+    HdMeshTopology   _renderingTopology;
+    VtIntArray       _renderingToSceneFaceVtxIds;
+    std::vector<int> _sceneToRenderingFaceVtxIds;
+    VtVec3iArray     _trianglesFaceVertexIndices;
+    VtIntArray       _primitiveParam;
+    size_t           _numVertices { 0 };
+
+    //! Index buffers of all the triangles and of all the edges of the rendering topology, shared
+    //! by the render items drawing the whole mesh
+    std::shared_ptr<MHWRender::MIndexBuffer> _trianglesIndexBuffer;
+    std::shared_ptr<MHWRender::MIndexBuffer> _edgesIndexBuffer;
+
+private:
+    friend class HdVP2MeshTopologyRegistry;
+
+    void _Compute(const SdfPath& id);
+
+    std::once_flag                      _computeOnce;
+    mutable std::once_flag              _adjacencyOnce;
+    mutable Hd_VertexAdjacencySharedPtr _adjacency;
+};
+
+using HdVP2SharedMeshTopologyPtr = std::shared_ptr<const HdVP2SharedMeshTopology>;
+
+/*! \brief  Registry of the topology data shared by the meshes of a render delegate.
+    \class  HdVP2MeshTopologyRegistry
+
+    Meshes with identical topologies, for example copies of the same mesh that are not natively
+    instanced, get the same shared topology. The entries are reference counted by the meshes
+    using them and are removed from the registry when the last mesh releases them.
+*/
+class HdVP2MeshTopologyRegistry
+{
+public:
+    HdVP2MeshTopologyRegistry();
+    ~HdVP2MeshTopologyRegistry();
+
+    //! \brief  Returns the shared data of the given topology and vertex layout, computing them if
+    //!         no other mesh uses them. Thread safe.
+    HdVP2SharedMeshTopologyPtr
+    Acquire(const HdMeshTopology& topology, bool isVertexLayoutUnshared, const SdfPath& id);
+
+    //! \brief  Reports the number of entries, hits and misses to the VP2 profiler category
+    //!         when they changed since the last report.
+    void ReportStatistics();
+
+    size_t GetHitCount() const { return _state->_hits; }
+    size_t GetMissCount() const { return _state->_misses; }
+    size_t GetEntryCount() const;
+
+private:
+    HdVP2MeshTopologyRegistry(const HdVP2MeshTopologyRegistry&) = delete;
+    HdVP2MeshTopologyRegistry& operator=(const HdVP2MeshTopologyRegistry&) = delete;
+
+    //! Entries of the registry, kept alive by the entries removing themselves from it.
+    struct _State
+    {
+        std::mutex _mutex;
+        std::unordered_multimap<size_t, std::weak_ptr<HdVP2SharedMeshTopology>> _entries;
+        std::atomic<size_t> _hits { 0 };
+        std::atomic<size_t> _misses { 0 };
+    };
+
+    std::shared_ptr<_State> _state;
+    size_t                  _reportedHits { 0 };
+    size_t                  _reportedMisses { 0 };
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // HD_VP2_MESH_TOPOLOGY_REGISTRY
@@ -29,6 +29,7 @@
 
 #include <usdUfe/ufe/Utils.h>
 
+#include <pxr/base/gf/vec4d.h>
 #include <pxr/base/tf/diagnostic.h>
 #include <pxr/base/tf/staticTokens.h>
 #include <pxr/base/tf/stringUtils.h>
@@ -39,7 +40,6 @@
 #include <pxr/imaging/hd/material.h>
 #include <pxr/imaging/hd/mesh.h>
 #include <pxr/imaging/hd/points.h>
-#include <pxr/imaging/hd/primGather.h>
 #include <pxr/imaging/hd/repr.h>
 #include <pxr/imaging/hd/rprimCollection.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
@@ -91,6 +91,12 @@
 #include <ufe/sceneNotification.h>
 #include <ufe/selectionNotification.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <vector>
+
 #if defined(BUILD_HDMAYA)
 #include <mayaUsd/render/mayaToHydra/utils.h>
 #endif
@@ -443,103 +449,6 @@ void colorManagementRefreshCB(void* clientData)
     }
 }
 
-// Copied from renderIndex.cpp, the code that does HdRenderIndex::GetDrawItems. But I just want the
-// rprimIds, I don't want to go all the way to draw items.
-#if defined(HD_API_VERSION) && HD_API_VERSION >= 42
-struct _FilterParam
-{
-    const TfTokenVector& renderTags;
-    const HdRenderIndex* renderIndex;
-};
-
-bool _DrawItemFilterPredicate(const SdfPath& rprimID, const void* predicateParam)
-{
-    const _FilterParam* filterParam = static_cast<const _FilterParam*>(predicateParam);
-
-    const TfTokenVector& renderTags = filterParam->renderTags;
-    const HdRenderIndex* renderIndex = filterParam->renderIndex;
-
-    //
-    // Render Tag Filter
-    //
-    if (renderTags.empty()) {
-        // An empty render tag set means everything passes the filter
-        // Primary user is tests, but some single task render delegates
-        // that don't support render tags yet also use it.
-        return true;
-    } else {
-        // As the number of tags is expected to be low (<10)
-        // use a simple linear search.
-        TfToken primRenderTag = renderIndex->GetRenderTag(rprimID);
-        size_t  numRenderTags = renderTags.size();
-        size_t  tagNum = 0;
-        while (tagNum < numRenderTags) {
-            if (renderTags[tagNum] == primRenderTag) {
-                return true;
-            }
-            ++tagNum;
-        }
-    }
-    return false;
-}
-#else
-struct _FilterParam
-{
-    const HdRprimCollection& collection;
-    const TfTokenVector&     renderTags;
-    const HdRenderIndex*     renderIndex;
-};
-
-bool _DrawItemFilterPredicate(const SdfPath& rprimID, const void* predicateParam)
-{
-    const _FilterParam* filterParam = static_cast<const _FilterParam*>(predicateParam);
-
-    const HdRprimCollection& collection = filterParam->collection;
-    const TfTokenVector&     renderTags = filterParam->renderTags;
-    const HdRenderIndex*     renderIndex = filterParam->renderIndex;
-
-    //
-    // Render Tag Filter
-    //
-    bool passedRenderTagFilter = false;
-    if (renderTags.empty()) {
-        // An empty render tag set means everything passes the filter
-        // Primary user is tests, but some single task render delegates
-        // that don't support render tags yet also use it.
-        passedRenderTagFilter = true;
-    } else {
-        // As the number of tags is expected to be low (<10)
-        // use a simple linear search.
-        TfToken primRenderTag = renderIndex->GetRenderTag(rprimID);
-        size_t  numRenderTags = renderTags.size();
-        size_t  tagNum = 0;
-        while (!passedRenderTagFilter && tagNum < numRenderTags) {
-            if (renderTags[tagNum] == primRenderTag) {
-                passedRenderTagFilter = true;
-            }
-            ++tagNum;
-        }
-    }
-
-    //
-    // Material Tag Filter
-    //
-    bool passedMaterialTagFilter = false;
-
-    // Filter out rprims that do not match the collection's materialTag.
-    // E.g. We may want to gather only opaque or translucent prims.
-    // An empty materialTag on collection means: ignore material-tags.
-    // This is important for tasks such as the selection-task which wants
-    // to ignore materialTags and receive all prims in its collection.
-    TfToken const& collectionMatTag = collection.GetMaterialTag();
-    if (collectionMatTag.IsEmpty() || renderIndex->GetMaterialTag(rprimID) == collectionMatTag) {
-        passedMaterialTagFilter = true;
-    }
-
-    return (passedRenderTagFilter && passedMaterialTagFilter);
-}
-#endif
-
 } // namespace
 
 //! \brief  Draw classification used during plugin load to register in VP2
@@ -555,6 +464,12 @@ MHWRender::MPxSubSceneOverride* ProxyRenderDelegate::Creator(const MObject& obj)
     return new ProxyRenderDelegate(obj);
 }
 
+//! \brief  Counters of the caches and of the background jobs of the VP2 render delegates
+VtDictionary ProxyRenderDelegate::GetStatistics() { return HdVP2RenderDelegate::GetStatistics(); }
+
+//! \brief  Removes the shaders cached for the materials of the VP2 render delegates
+void ProxyRenderDelegate::ClearShaderCache() { HdVP2RenderDelegate::ClearShaderCache(); }
+
 //! \brief  Constructor
 ProxyRenderDelegate::ProxyRenderDelegate(const MObject& obj)
     : Autodesk::Maya::OPENMAYA_MPXSUBSCENEOVERRIDE_LATEST_NAMESPACE::MHWRender::MPxSubSceneOverride(
@@ -632,6 +547,8 @@ void ProxyRenderDelegate::_ClearRenderDelegate()
     _changeVersions.reset();
     _taskRenderTagsValid = false;
     _isPopulated = false;
+    _rprimsByRenderTag.clear();
+    _hiddenRenderTagDirtyBits.clear();
 }
 
 //! \brief  Clear data which is now stale because proxy shape attributes have changed
@@ -929,6 +846,67 @@ void ProxyRenderDelegate::UpdateInstancingMapEntry(
     }
 }
 
+void ProxyRenderDelegate::UpdateRenderTagMembership(
+    const TfToken& oldRenderTag,
+    const TfToken& newRenderTag,
+    const SdfPath& rprimId)
+{
+    if (oldRenderTag == newRenderTag) {
+        return;
+    }
+
+    if (!oldRenderTag.IsEmpty()) {
+        auto it = _rprimsByRenderTag.find(oldRenderTag);
+        if (it != _rprimsByRenderTag.end()) {
+            it->second.erase(rprimId);
+        }
+    }
+
+    if (!newRenderTag.IsEmpty()) {
+        _rprimsByRenderTag[newRenderTag].insert(rprimId);
+    }
+}
+
+//! \brief  Mark the rprims whose render tag is drawn dirty, and defer the dirty bits of the
+//!         others until their render tag gets drawn.
+void ProxyRenderDelegate::_MarkDrawnRprimsDirty(HdDirtyBits dirtyBits)
+{
+    MProfilingScope profilingScope(
+        HdVP2RenderDelegate::sProfilerCategory, MProfiler::kColorD_L1, "MarkDrawnRprimsDirty");
+
+    HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+    for (const auto& renderTagRprims : _rprimsByRenderTag) {
+        if (DrawRenderTag(renderTagRprims.first)) {
+            for (const SdfPath& id : renderTagRprims.second) {
+                changeTracker.MarkRprimDirty(id, dirtyBits);
+            }
+        } else if (!renderTagRprims.second.empty()) {
+            _hiddenRenderTagDirtyBits[renderTagRprims.first] |= dirtyBits;
+        }
+    }
+}
+
+//! \brief  Mark the rprims of the render tag dirty, along with the dirty bits deferred while
+//!         the render tag was hidden.
+void ProxyRenderDelegate::_MarkRenderTagRprimsDirty(const TfToken& renderTag, HdDirtyBits dirtyBits)
+{
+    auto deferredIt = _hiddenRenderTagDirtyBits.find(renderTag);
+    if (deferredIt != _hiddenRenderTagDirtyBits.end()) {
+        dirtyBits |= deferredIt->second;
+        _hiddenRenderTagDirtyBits.erase(deferredIt);
+    }
+
+    auto it = _rprimsByRenderTag.find(renderTag);
+    if (it == _rprimsByRenderTag.end()) {
+        return;
+    }
+
+    HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+    for (const SdfPath& id : it->second) {
+        changeTracker.MarkRprimDirty(id, dirtyBits);
+    }
+}
+
 #ifdef MAYA_HAS_DISPLAY_LAYER_API
 void ProxyRenderDelegate::_DirtyUsdSubtree(const UsdPrim& prim)
 {
@@ -1189,13 +1167,10 @@ void ProxyRenderDelegate::_Execute(const MHWRender::MFrameContext& frameContext)
         }
 
         if (dirtyBits != HdChangeTracker::Clean) {
-            // Mark everything "dirty" so that sync is called on everything
+            // Mark every drawn rprim "dirty" so that sync is called on them.
             // If there are multiple views up with different viewport modes then
             // this is slow.
-            auto& rprims = _renderIndex->GetRprimIds();
-            for (auto path : rprims) {
-                changeTracker.MarkRprimDirty(path, dirtyBits);
-            }
+            _MarkDrawnRprimsDirty(dirtyBits);
         }
 
         _engine.Execute(_renderIndex.get(), &_dummyTasks);
@@ -1247,12 +1222,26 @@ void ProxyRenderDelegate::update(MSubSceneContainer& container, const MFrameCont
     param->BeginUpdate(container, _sceneDelegate->GetTime());
     _currentFrameContext = &frameContext;
 
+    MStatus       viewProjectionStatus;
+    const MMatrix viewProjection
+        = frameContext.getMatrix(MHWRender::MFrameContext::kViewProjMtx, &viewProjectionStatus);
+    _hasViewProjectionMatrix = (viewProjectionStatus == MStatus::kSuccess);
+    if (_hasViewProjectionMatrix) {
+        _viewProjectionMatrix = GfMatrix4d(viewProjection.matrix);
+    }
+
+    int originX = 0, originY = 0, width = 0, height = 0;
+    if (frameContext.getViewportDimensions(originX, originY, width, height)) {
+        _viewportMaxDimension = static_cast<unsigned int>(std::max(std::max(width, height), 0));
+    }
+
     if (_Populate()) {
         _UpdateSceneDelegate();
         _Execute(frameContext);
     }
 
     _currentFrameContext = nullptr;
+    _hasViewProjectionMatrix = false;
     param->EndUpdate();
 }
 
@@ -1758,17 +1747,17 @@ void ProxyRenderDelegate::_UpdateSelectionStates()
     const MHWRender::DisplayStatus previousStatus = _displayStatus;
     _displayStatus = MHWRender::MGeometryUtilities::displayStatus(_proxyShapeData->ProxyDagPath());
 
-    SdfPathVector        rootPaths;
-    const SdfPathVector* dirtyPaths = nullptr;
+    SdfPathVector rootPaths;
+    bool          dirtyAllPaths = false;
 
     if (_displayStatus == MHWRender::kLead || _displayStatus == MHWRender::kActive) {
         if (_displayStatus != previousStatus) {
             rootPaths.push_back(SdfPath::AbsoluteRootPath());
-            dirtyPaths = &_renderIndex->GetRprimIds();
+            dirtyAllPaths = true;
         }
     } else if (previousStatus == MHWRender::kLead || previousStatus == MHWRender::kActive) {
         rootPaths.push_back(SdfPath::AbsoluteRootPath());
-        dirtyPaths = &_renderIndex->GetRprimIds();
+        dirtyAllPaths = true;
         _PopulateSelection();
     } else {
         // Append pre-update lead and active selection.
@@ -1781,8 +1770,6 @@ void ProxyRenderDelegate::_UpdateSelectionStates()
         // Append post-update lead and active selection.
         AppendSelectedPrimPaths(_leadSelection, rootPaths);
         AppendSelectedPrimPaths(_activeSelection, rootPaths);
-
-        dirtyPaths = &rootPaths;
     }
 
     if (!rootPaths.empty()) {
@@ -1796,10 +1783,14 @@ void ProxyRenderDelegate::_UpdateSelectionStates()
         if (_selectionModeChanged)
             dirtySelectionBits |= MayaUsdRPrim::DirtySelectionMode;
 #endif
-        HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
-        for (auto path : *dirtyPaths) {
-            if (_renderIndex->HasRprim(path))
-                changeTracker.MarkRprimDirty(path, dirtySelectionBits);
+        if (dirtyAllPaths) {
+            _MarkDrawnRprimsDirty(dirtySelectionBits);
+        } else {
+            HdChangeTracker& changeTracker = _renderIndex->GetChangeTracker();
+            for (auto path : rootPaths) {
+                if (_renderIndex->HasRprim(path))
+                    changeTracker.MarkRprimDirty(path, dirtySelectionBits);
+            }
         }
 
         // now that the appropriate prims have been marked dirty trigger
@@ -1849,11 +1840,38 @@ void ProxyRenderDelegate::_UpdateRenderTags()
     // to an individual rprim or not.
     bool rprimRenderTagChanged = !_changeVersions.renderTagValid(changeTracker);
     if (rprimRenderTagChanged) {
-        for (auto path : _renderIndex->GetRprimIds()) {
-            if (changeTracker.GetRprimDirtyBits(path) & HdChangeTracker::DirtyRenderTag) {
+        MProfilingScope subProfilingScope(
+            HdVP2RenderDelegate::sProfilerCategory,
+            MProfiler::kColorD_L1,
+            "Find Dirty Render Tags");
+
+        // Reading the dirty bits is thread safe, only marking the rprims dirty is not.
+        const SdfPathVector&                                 rprimIds = _renderIndex->GetRprimIds();
+        tbb::enumerable_thread_specific<std::vector<size_t>> dirtyIndices;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, rprimIds.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                auto& localIndices = dirtyIndices.local();
+                for (size_t i = range.begin(); i != range.end(); ++i) {
+                    if (changeTracker.GetRprimDirtyBits(rprimIds[i])
+                        & HdChangeTracker::DirtyRenderTag) {
+                        localIndices.push_back(i);
+                    }
+                }
+            });
+
+        // The rprim may move from a hidden render tag, so also set the deferred dirty bits.
+        HdDirtyBits deferredDirtyBits = HdChangeTracker::Clean;
+        for (const auto& renderTagDirtyBits : _hiddenRenderTagDirtyBits) {
+            deferredDirtyBits |= renderTagDirtyBits.second;
+        }
+
+        for (const auto& localIndices : dirtyIndices) {
+            for (size_t i : localIndices) {
                 // Since USD 23.02, DirtyRenderTag is not enough to provoke a sync,
                 // so we add an extra dirty flag - DirtyVisibility
-                changeTracker.MarkRprimDirty(path, HdChangeTracker::DirtyVisibility);
+                changeTracker.MarkRprimDirty(
+                    rprimIds[i], HdChangeTracker::DirtyVisibility | deferredDirtyBits);
             }
         }
     }
@@ -1882,17 +1900,15 @@ void ProxyRenderDelegate::_UpdateRenderTags()
             changedRenderTags.push_back(HdRenderTagTokens->guide);
         }
 
-        // Mark all the rprims which have a render tag which changed dirty
-        SdfPathVector rprimsToDirty = _GetFilteredRprims(*_defaultCollection, changedRenderTags);
-
-        for (auto& id : rprimsToDirty) {
-            // this call to MarkRprimDirty will increment the change tracker render
-            // tag version. We don't want this to cause rprimRenderTagChanged to be
-            // true when a tag hasn't actually changed.
-            // Since USD 23.02, DirtyRenderTag is not enough to provoke a sync,
-            // so we add an extra dirty flag - DirtyVisibility
-            changeTracker.MarkRprimDirty(
-                id, HdChangeTracker::DirtyRenderTag | HdChangeTracker::DirtyVisibility);
+        // Mark all the rprims which have a render tag which changed dirty.
+        // This call to MarkRprimDirty will increment the change tracker render
+        // tag version. We don't want this to cause rprimRenderTagChanged to be
+        // true when a tag hasn't actually changed.
+        // Since USD 23.02, DirtyRenderTag is not enough to provoke a sync,
+        // so we add an extra dirty flag - DirtyVisibility
+        for (const auto& renderTag : changedRenderTags) {
+            _MarkRenderTagRprimsDirty(
+                renderTag, HdChangeTracker::DirtyRenderTag | HdChangeTracker::DirtyVisibility);
         }
     }
 
@@ -1927,27 +1943,6 @@ void ProxyRenderDelegate::_UpdateRenderTags()
     // the future.
 }
 
-//! \brief  List the rprims in collection that match renderTags
-SdfPathVector ProxyRenderDelegate::_GetFilteredRprims(
-    HdRprimCollection const& collection,
-    TfTokenVector const&     renderTags)
-{
-    SdfPathVector        rprimIds;
-    const SdfPathVector& paths = _renderIndex->GetRprimIds();
-    const SdfPathVector& includePaths = collection.GetRootPaths();
-    const SdfPathVector& excludePaths = collection.GetExcludePaths();
-#if defined(HD_API_VERSION) && HD_API_VERSION >= 42
-    _FilterParam filterParam = { renderTags, _renderIndex.get() };
-#else
-    _FilterParam filterParam = { collection, renderTags, _renderIndex.get() };
-#endif
-    HdPrimGather gather;
-    gather.PredicatedFilter(
-        paths, includePaths, excludePaths, _DrawItemFilterPredicate, &filterParam, &rprimIds);
-
-    return rprimIds;
-}
-
 //! \brief  Query the selection state of a given prim from the lead selection.
 const HdSelection::PrimSelectionState*
 ProxyRenderDelegate::GetLeadSelectionState(const SdfPath& path) const
@@ -2203,6 +2198,35 @@ MColor ProxyRenderDelegate::GetSelectionHighlightColor(const TfToken& className)
     return colorCache->first;
 }
 
+bool ProxyRenderDelegate::IsInViewFrustum(const GfBBox3d& bounds) const
+{
+    // Outside of the update, or without bounds, consider everything to be visible.
+    const GfRange3d& range = bounds.GetRange();
+    if (!_hasViewProjectionMatrix || range.IsEmpty()) {
+        return true;
+    }
+
+    const GfMatrix4d worldViewProjection = bounds.GetMatrix() * _viewProjectionMatrix;
+
+    // The box is outside of the frustum when all its corners are on the outer side of
+    // the same clipping plane.
+    int outsideCounts[6] = { 0, 0, 0, 0, 0, 0 };
+    for (size_t i = 0; i < 8; ++i) {
+        const GfVec3d corner = range.GetCorner(i);
+        const GfVec4d clip = GfVec4d(corner[0], corner[1], corner[2], 1.0) * worldViewProjection;
+        for (int axis = 0; axis < 3; ++axis) {
+            outsideCounts[2 * axis] += (clip[axis] < -clip[3]) ? 1 : 0;
+            outsideCounts[2 * axis + 1] += (clip[axis] > clip[3]) ? 1 : 0;
+        }
+    }
+    for (int outsideCount : outsideCounts) {
+        if (outsideCount == 8) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ProxyRenderDelegate::DrawRenderTag(const TfToken& renderTag) const
 {
     if (renderTag == HdRenderTagTokens->geometry) {
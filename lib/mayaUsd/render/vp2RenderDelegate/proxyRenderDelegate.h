@@ -19,6 +19,9 @@
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/utils/util.h>
 
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/vt/dictionary.h>
 #include <pxr/imaging/hd/engine.h>
 #include <pxr/imaging/hd/selection.h>
 #include <pxr/imaging/hd/task.h>
@@ -40,6 +43,8 @@
 #include <ufe/path.h>
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 // Use the latest MPxSubSceneOverride API
 #ifndef OPENMAYA_MPXSUBSCENEOVERRIDE_LATEST_NAMESPACE
@@ -119,6 +124,15 @@ public:
     MAYAUSD_CORE_PUBLIC
     static MHWRender::MPxSubSceneOverride* Creator(const MObject& obj);
 
+    //! Returns the counters of the caches and of the background jobs of the VP2 render
+    //! delegates, for diagnostics and tests.
+    MAYAUSD_CORE_PUBLIC
+    static VtDictionary GetStatistics();
+
+    //! Removes the shaders cached for the materials of the VP2 render delegates, for tests.
+    MAYAUSD_CORE_PUBLIC
+    static void ClearShaderCache();
+
     MAYAUSD_CORE_PUBLIC
     MHWRender::DrawAPI supportedDrawAPIs() const override;
 
@@ -232,6 +246,15 @@ public:
     MAYAUSD_CORE_PUBLIC
     bool DrawRenderTag(const TfToken& renderTag) const;
 
+    //! Returns false if the world space bounds are known to be outside of the camera
+    //! frustum of the viewport being updated. Thread safe during the Hydra sync.
+    MAYAUSD_CORE_PUBLIC
+    bool IsInViewFrustum(const GfBBox3d& bounds) const;
+
+    //! Returns the largest dimension of the last updated viewport, in pixels.
+    MAYAUSD_CORE_PUBLIC
+    unsigned int GetViewportMaxDimension() const { return _viewportMaxDimension; }
+
     MAYAUSD_CORE_PUBLIC
     UsdImagingDelegate* GetUsdImagingDelegate() const;
 
@@ -248,6 +271,14 @@ public:
         const InstancePrototypePath& newPathInPrototype,
         const SdfPath&               rprimId);
 
+    //! Moves the rprim from the membership index of its previous render tag to the one of
+    //! its new render tag. An empty render tag removes it from the index. Not thread safe.
+    MAYAUSD_CORE_PUBLIC
+    void UpdateRenderTagMembership(
+        const TfToken& oldRenderTag,
+        const TfToken& newRenderTag,
+        const SdfPath& rprimId);
+
 #ifdef MAYA_NEW_POINT_SNAPPING_SUPPORT
     MAYAUSD_CORE_PUBLIC
     bool SnapToSelectedObjects() const;
@@ -286,8 +317,8 @@ private:
     void _DirtyUsdSubtree(const UsdPrim& prim);
 #endif
     void _RequestRefresh();
-    SdfPathVector
-    _GetFilteredRprims(HdRprimCollection const& collection, TfTokenVector const& renderTags);
+    void _MarkDrawnRprimsDirty(HdDirtyBits dirtyBits);
+    void _MarkRenderTagRprimsDirty(const TfToken& renderTag, HdDirtyBits dirtyBits);
 
     void ComputeCombinedDisplayStyles(const unsigned int newDisplayStyle);
 
@@ -352,10 +383,21 @@ private:
     const MHWRender::MFrameContext*     _currentFrameContext = nullptr;
     std::map<TfToken, uint64_t>         _combinedDisplayStyles;
     bool                                _needTexturedMaterials = false;
+    GfMatrix4d                          _viewProjectionMatrix;
+    bool                                _hasViewProjectionMatrix = false;
+    unsigned int                        _viewportMaxDimension = 0;
 
     // maps from a path in USD prototype to the corresponding rprim paths
     std::multimap<InstancePrototypePath, SdfPath> _instancingMap;
 
+    // Rprims indexed by the render tag they were last synced with, so that changes of
+    // display style or purpose only dirty the affected rprims.
+    using RprimIdSet = std::unordered_set<SdfPath, SdfPath::Hash>;
+    std::unordered_map<TfToken, RprimIdSet, TfToken::HashFunctor> _rprimsByRenderTag;
+    // Dirty bits to set on the rprims of a render tag once it gets drawn again. Rprims
+    // hidden by their render tag are not synced, so they are dirtied lazily.
+    std::unordered_map<TfToken, HdDirtyBits, TfToken::HashFunctor> _hiddenRenderTagDirtyBits;
+
     bool _isPopulated {
         false
     }; //!< If false, scene delegate wasn't populated yet within render index
@@ -468,6 +468,18 @@ public:
     }
 #endif
 
+    /*! \brief  Removes the user generated shaders. The materials keep the clones they got.
+     */
+    void ClearUserShaders()
+    {
+        tbb::spin_rw_mutex::scoped_lock lock(_userCache._mutex, true /*write*/);
+
+        _userCache._map.clear();
+#ifdef WANT_MATERIALX_BUILD
+        _userCache._primvars.clear();
+#endif
+    }
+
     void OnMayaExit()
     {
         if (_isInitialized) {
@@ -568,9 +580,10 @@ const HdVP2BBoxGeom* sSharedBBoxGeom
 const int HdVP2RenderDelegate::sProfilerCategory
     = MProfiler::addCategory("HdVP2RenderDelegate", "HdVP2RenderDelegate");
 
-std::mutex                  HdVP2RenderDelegate::_renderDelegateMutex;
-std::atomic_int             HdVP2RenderDelegate::_renderDelegateCounter;
-HdResourceRegistrySharedPtr HdVP2RenderDelegate::_resourceRegistry;
+std::mutex                               HdVP2RenderDelegate::_renderDelegateMutex;
+std::atomic_int                          HdVP2RenderDelegate::_renderDelegateCounter;
+HdResourceRegistrySharedPtr              HdVP2RenderDelegate::_resourceRegistry;
+std::unordered_set<HdVP2RenderDelegate*> HdVP2RenderDelegate::_renderDelegates;
 
 /*! \brief  Constructor.
  */
@@ -590,6 +603,7 @@ HdVP2RenderDelegate::HdVP2RenderDelegate(ProxyRenderDelegate& drawScene)
             sSharedBBoxGeom = new HdVP2BBoxGeom();
         }
     }
+    _renderDelegates.insert(this);
 
     _renderParam.reset(new HdVP2RenderParam(drawScene));
 
@@ -611,6 +625,7 @@ HdVP2RenderDelegate::~HdVP2RenderDelegate()
     _materialSprims.clear();
 
     std::lock_guard<std::mutex> guard(_renderDelegateMutex);
+    _renderDelegates.erase(this);
     if (_renderDelegateCounter.fetch_sub(1) == 1) {
         _resourceRegistry.reset();
 
@@ -651,6 +666,8 @@ void HdVP2RenderDelegate::CommitResources(HdChangeTracker* tracker)
     //     3) Update any scene-level acceleration structures.
 
     _resourceRegistryVP2.Commit();
+
+    _meshTopologyRegistry.ReportStatistics();
 }
 
 /*! \brief  Return a list of which Rprim types can be created by this class's.
@@ -688,6 +705,13 @@ HdVP2ResourceRegistry& HdVP2RenderDelegate::GetVP2ResourceRegistry()
     return _resourceRegistryVP2;
 }
 
+/*! \brief  Return the registry of the topology data shared by the meshes.
+ */
+HdVP2MeshTopologyRegistry& HdVP2RenderDelegate::GetMeshTopologyRegistry()
+{
+    return _meshTopologyRegistry;
+}
+
 /*! \brief  Create a renderpass for rendering a given collection.
  */
 HdRenderPassSharedPtr
@@ -1148,4 +1172,29 @@ void HdVP2RenderDelegate::CleanupMaterials()
 
 void HdVP2RenderDelegate::OnMayaExit() { sShaderCache.OnMayaExit(); }
 
+void HdVP2RenderDelegate::ClearShaderCache() { sShaderCache.ClearUserShaders(); }
+
+VtDictionary HdVP2RenderDelegate::GetStatistics()
+{
+    VtDictionary stats;
+    HdVP2Material::GetStatistics(stats);
+
+    size_t meshTopologyHits = 0;
+    size_t meshTopologyMisses = 0;
+    size_t meshTopologyEntries = 0;
+    {
+        std::lock_guard<std::mutex> guard(_renderDelegateMutex);
+        for (const HdVP2RenderDelegate* renderDelegate : _renderDelegates) {
+            const HdVP2MeshTopologyRegistry& registry = renderDelegate->_meshTopologyRegistry;
+            meshTopologyHits += registry.GetHitCount();
+            meshTopologyMisses += registry.GetMissCount();
+            meshTopologyEntries += registry.GetEntryCount();
+        }
+    }
+    stats["meshTopologyHits"] = VtValue(meshTopologyHits);
+    stats["meshTopologyMisses"] = VtValue(meshTopologyMisses);
+    stats["meshTopologyEntries"] = VtValue(meshTopologyEntries);
+    return stats;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -16,10 +16,12 @@
 #ifndef HD_VP2_RENDER_DELEGATE
 #define HD_VP2_RENDER_DELEGATE
 
+#include "meshTopologyRegistry.h"
 #include "render_param.h"
 #include "resource_registry.h"
 #include "shader.h"
 
+#include <pxr/base/vt/dictionary.h>
 #include <pxr/imaging/hd/renderDelegate.h>
 #include <pxr/imaging/hd/resourceRegistry.h>
 #include <pxr/pxr.h>
@@ -87,6 +89,8 @@ public:
 
     HdVP2ResourceRegistry& GetVP2ResourceRegistry();
 
+    HdVP2MeshTopologyRegistry& GetMeshTopologyRegistry();
+
     HdRenderPassSharedPtr
     CreateRenderPass(HdRenderIndex* index, HdRprimCollection const& collection) override;
 
@@ -165,6 +169,13 @@ public:
 
     static void OnMayaExit();
 
+    //! Counters of the caches and of the background jobs, summed over the render delegates.
+    static VtDictionary GetStatistics();
+
+    //! Removes the shaders cached for the materials, so that they are generated again by the next
+    //! syncs. Must not be called during a sync.
+    static void ClearShaderCache();
+
 private:
     HdVP2RenderDelegate(const HdVP2RenderDelegate&) = delete;
     HdVP2RenderDelegate& operator=(const HdVP2RenderDelegate&) = delete;
@@ -176,6 +187,8 @@ private:
         _renderDelegateMutex; //!< Mutex protecting construction/destruction of render delegate
     static HdResourceRegistrySharedPtr
         _resourceRegistry; //!< Shared and unused by VP2 resource registry
+    static std::unordered_set<HdVP2RenderDelegate*>
+        _renderDelegates; //!< Live render delegates, protected by _renderDelegateMutex
 
     std::unordered_set<HdSprim*> _materialSprims;
 
@@ -184,6 +197,8 @@ private:
     SdfPath _id;          //!< Render delegate ID
     HdVP2ResourceRegistry
         _resourceRegistryVP2; //!< VP2 resource registry used for enqueue and execution of commits
+    HdVP2MeshTopologyRegistry
+        _meshTopologyRegistry; //!< Topology data shared by the meshes with identical topologies
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -70,10 +70,13 @@ MayaStagesSubject::MayaStagesSubject()
     auto me = PXR_NS::TfCreateWeakPtr(this);
     TfNotice::Register(me, &MayaStagesSubject::onStageSet);
     TfNotice::Register(me, &MayaStagesSubject::onStageInvalidate);
+
+    g_StageMap.addCallbacks();
 }
 
 MayaStagesSubject::~MayaStagesSubject()
 {
+    g_StageMap.removeCallbacks();
     MMessage::removeCallbacks(fCbIds);
     fCbIds.clear();
 }
@@ -122,7 +125,12 @@ void MayaStagesSubject::afterNewCallback(void* clientData)
 /*static*/
 void MayaStagesSubject::afterOpenCallback(void* clientData) { afterNewCallback(clientData); }
 
-void MayaStagesSubject::beforeOpen() { clearListeners(); }
+void MayaStagesSubject::beforeOpen()
+{
+    // The proxy shapes of the new scene will be tracked from scratch.
+    g_StageMap.clear();
+    clearListeners();
+}
 
 void MayaStagesSubject::clearListeners()
 {
@@ -144,12 +152,8 @@ void MayaStagesSubject::clearListeners()
         });
     fStageListeners.clear();
 
-    // Set up our stage to proxy shape UFE path (and reverse)
-    // mapping.  We do this with the following steps:
-    // - get all proxyShape nodes in the scene.
-    // - get their Dag paths.
-    // - convert the Dag paths to UFE paths.
-    // - get their stage.
+    // Refresh our stage to proxy shape UFE path (and reverse) mapping from
+    // the tracked proxy shapes the next time it is accessed.
     g_StageMap.setDirty();
 }
 
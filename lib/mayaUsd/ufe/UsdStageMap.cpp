@@ -21,7 +21,11 @@
 #include <mayaUsd/ufe/Utils.h>
 #include <mayaUsd/utils/util.h>
 
+#include <usdUfe/ufe/Utils.h>
+
+#include <maya/MDGMessage.h>
 #include <maya/MFnDagNode.h>
+#include <maya/MNodeMessage.h>
 #include <ufe/pathString.h>
 
 #include <cassert>
@@ -51,13 +55,14 @@ Ufe::Path firstPath(const MObject& object)
     return MayaUsd::ufe::dagPathToUfe(dagPath);
 }
 
-// Assuming proxy shape nodes cannot be instanced, simply return the first path.
-Ufe::Path firstPath(const MObjectHandle& handle)
+MayaUsdProxyShapeBase* objToProxyShape(const MObject& obj)
 {
-    if (!handle.isValid()) {
-        return Ufe::Path();
+    if (obj.isNull()) {
+        return nullptr;
     }
-    return firstPath(handle.object());
+
+    MFnDependencyNode fn(obj);
+    return dynamic_cast<MayaUsdProxyShapeBase*>(fn.userNode());
 }
 
 UsdStageWeakPtr objToStage(MObject& obj)
@@ -67,11 +72,10 @@ UsdStageWeakPtr objToStage(MObject& obj)
     }
 
     // Get the stage from the proxy shape.
-    MFnDependencyNode fn(obj);
-    auto              ps = dynamic_cast<MayaUsdProxyShapeBase*>(fn.userNode());
+    auto ps = objToProxyShape(obj);
     TF_VERIFY(ps);
 
-    return ps->getUsdStage();
+    return ps ? ps->getUsdStage() : nullptr;
 }
 
 inline Ufe::Path toPath(const std::string& mayaPathString)
@@ -95,34 +99,75 @@ UsdStageMap g_StageMap;
 // UsdStageMap
 //------------------------------------------------------------------------------
 
-void UsdStageMap::addItem(const Ufe::Path& path)
+void UsdStageMap::trackProxyShape(const MObject& object)
 {
-    // We expect a path to the proxy shape node, therefore a single segment.
-    auto nbSegments = path.nbSegments();
-    if (nbSegments != 1) {
-        TF_CODING_ERROR(
-            "A proxy shape node path can have only one segment, path '%s' has %lu",
-            path.string().c_str(),
-            nbSegments);
+    MObjectHandle handle(object);
+    if (!handle.isValid()) {
         return;
     }
 
-    // Convert the UFE path to an MObjectHandle.
-    auto proxyShape = nameLookup(path);
-    if (!proxyShape.isValid()) {
+    // The path and stage of the proxy shape are only known once it is part of
+    // the DAG and computed: fill them in on the next access.
+    fObjectToInfo[handle] = ProxyShapeInfo();
+    fPathsDirty = true;
+    fStagesDirty = true;
+}
+
+void UsdStageMap::untrackProxyShape(const MObject& object)
+{
+    MObjectHandle handle(object);
+    auto          found = fObjectToInfo.find(handle);
+    if (found == fObjectToInfo.end()) {
         return;
     }
 
+    const ProxyShapeInfo& info = found->second;
+    auto                  pathIter = fPathToObject.find(info.path);
+    if (pathIter != fPathToObject.end() && pathIter->second == handle) {
+        fPathToObject.erase(pathIter);
+    }
+    auto stageIter = fStageToObject.find(info.stage);
+    if (stageIter != fStageToObject.end() && stageIter->second == handle) {
+        fStageToObject.erase(stageIter);
+    }
+    fObjectToInfo.erase(found);
+}
+
+MObject UsdStageMap::lookupProxyShape(const Ufe::Path& path)
+{
+    // The paths of the tracked proxy shapes are refreshed when a DAG node is
+    // renamed or reparented, but an observer may query the new path before
+    // the stage map is notified.  Look up the node directly, which is much
+    // cheaper than searching the scene for all the proxy shapes.
+    MObject object = UsdMayaUtil::nameToDagPath(path.popHead().string()).node();
+    if (!objToProxyShape(object)) {
+        return MObject();
+    }
+
+    MObjectHandle handle(object);
+    auto          found = fObjectToInfo.find(handle);
+    if (found == fObjectToInfo.end()) {
+        found = fObjectToInfo.emplace(handle, ProxyShapeInfo()).first;
+        found->second.stage = objToStage(object);
+        if (found->second.stage) {
+            fStageToObject[found->second.stage] = handle;
+        }
+    }
+
     // If a proxy shape doesn't yet have a stage, don't add it.
     // We will add it later, when the stage is initialized
-    auto obj = proxyShape.object();
-    auto stage = objToStage(obj);
-    if (!stage) {
-        return;
+    ProxyShapeInfo& info = found->second;
+    if (!info.stage) {
+        return MObject();
     }
 
-    fPathToObject[path] = proxyShape;
-    fStageToObject[stage] = proxyShape;
+    auto stalePath = fPathToObject.find(info.path);
+    if (stalePath != fPathToObject.end() && stalePath->second == handle) {
+        fPathToObject.erase(stalePath);
+    }
+    info.path = path;
+    fPathToObject[path] = handle;
+    return object;
 }
 
 UsdStageWeakPtr UsdStageMap::stage(const Ufe::Path& path)
@@ -136,105 +181,28 @@ MObject UsdStageMap::proxyShape(const Ufe::Path& path)
 {
     rebuildIfDirty();
 
-    // In additional to the explicit dirty system it is possible that
-    // the cache is in an invalid state and needs to be refreshed. See
-    // the class comment in UsdStageMap.h for details.
-    // There are two scenarios which signal a cache refresh is required:
-    // 1. A path is searched for which cannot be found. This indicates that
-    //    the stage has been reparented and the new path has been used to search
-    //    for the stage and the stage is not present in the cache.
-    // 2. The DAG path of a cached MObject doesn't match the key path used to
-    //    find that MObject. This indicates that the stage has been reparented
-    //    and the old path has been used to search for the stage. In this case
-    //    there is a cache hit when there should not be.
-
     const auto& singleSegmentPath
         = path.nbSegments() == 1 ? path : Ufe::Path(path.getSegments()[0]);
 
     auto iter = fPathToObject.find(singleSegmentPath);
-
     if (iter == std::end(fPathToObject)) {
-        // When we don't find an entry in the cache then we are in scenario 1.
-        // MObjects stay valid even when re-parented or re-named, so we can
-        // scan through all the entries in the cache and validate that the current
-        // DAG path to the MObject matches the key Ufe::Path for the MObject in
-        // the cache. When the don't match, update fPathToObject so that the key and
-        // the MObject are in sync again.
-        auto pathToObject = fPathToObject;
-        for (const auto& entry : pathToObject) {
-            const auto& cachedPath = entry.first;
-            const auto& cachedObject = entry.second;
-            // If the cached object itself is invalid then remove it from the map.
-            if (!cachedObject.isValid()) {
-                fPathToObject.erase(cachedPath);
-                continue;
-            }
-            // Get the UFE path from the map value.
-            auto newPath = firstPath(cachedObject);
-            if (newPath != cachedPath) {
-                // Key is stale.  Remove it from our cache, and add the new entry.
-                auto count = fPathToObject.erase(cachedPath);
-                TF_VERIFY(count);
-                if (!newPath.empty())
-                    fPathToObject[newPath] = cachedObject;
-            }
-        }
-
-        // Now that the cache is in a better state, attempt to find the searched for
-        // proxyShape again.
-        iter = fPathToObject.find(singleSegmentPath);
-
-        if (iter == std::end(fPathToObject)) {
-            // Still not found, must have re-appeared through undo of delete.
-            // Add it back to the cache.
-            for (const auto& psn : ProxyShapeHandler::getAllNames()) {
-                auto psPath = toPath(psn);
-                if (fPathToObject.find(psPath) == std::end(fPathToObject)) {
-                    addItem(psPath);
-                }
-            }
+        return lookupProxyShape(singleSegmentPath);
+    }
 
-            iter = fPathToObject.find(singleSegmentPath);
-            if (iter == std::end(fPathToObject)) {
-                // Since our cache is fresh, path not found means it's not a
-                // proxy shape.
-                return MObject();
-            }
-        }
-    } else {
-        auto object = iter->second;
-        // If the cached object itself is invalid then remove it from the map.
-        if (!object.isValid()) {
-            fPathToObject.erase(singleSegmentPath);
-            return MObject();
-        }
-        auto objectPath = firstPath(object);
-        if (objectPath != iter->first) {
-            // When we hit the cache and the key path doesn't match the current object path
-            // we are in scenario 2. Update the entry in fPathToObject so that the key path
-            // is the current object path.
-            fPathToObject.erase(singleSegmentPath);
-            if (!objectPath.empty())
-                fPathToObject[objectPath] = object;
-            TF_VERIFY(std::end(fPathToObject) == fPathToObject.find(singleSegmentPath));
-            return MObject();
-        }
+    // If the cached object itself is invalid then remove it from the map.
+    auto object = iter->second;
+    if (!object.isValid()) {
+        fPathToObject.erase(iter);
+        fObjectToInfo.erase(object);
+        return MObject();
     }
 
-    // At this point the cache is rebuilt, so lookup failure means the object
-    // doesn't exist.
-    return iter == std::end(fPathToObject) ? MObject() : iter->second.object();
+    return object.object();
 }
 
 MayaUsdProxyShapeBase* UsdStageMap::proxyShapeNode(const Ufe::Path& path)
 {
-    auto obj = proxyShape(path);
-    if (obj.isNull()) {
-        return nullptr;
-    }
-
-    MFnDependencyNode fn(obj);
-    return dynamic_cast<MayaUsdProxyShapeBase*>(fn.userNode());
+    return objToProxyShape(proxyShape(path));
 }
 
 Ufe::Path UsdStageMap::path(UsdStageWeakPtr stage)
@@ -244,7 +212,7 @@ Ufe::Path UsdStageMap::path(UsdStageWeakPtr stage)
     // A stage is bound to a single Dag proxy shape.
     auto iter = fStageToObject.find(stage);
     if (iter != std::end(fStageToObject))
-        return firstPath(iter->second);
+        return trackedPath(iter->second);
     return Ufe::Path();
 }
 
@@ -253,40 +221,149 @@ UsdStageMap::StageSet UsdStageMap::allStages()
     rebuildIfDirty();
 
     StageSet stages;
-    for (auto it = fPathToObject.begin(); it != fPathToObject.end();
-         /* no ++it here, we manually move it in the loop */) {
-        const auto&      pair = *it;
-        const Ufe::Path& path = pair.first;
-        // Calling UsdStageMap::stage may erase the entry in fPathToObject at path.
-        // Advance the iterator so that the iterator stays valid if erasure occurs.
-        it++;
-        // Now handle path.
-        PXR_NS::UsdStageWeakPtr matchingStage = stage(path);
-        // After this point pair and path cannot be safely used, they may have been erased.
-        // If the object cached in fPathToObject was invalid we'll get back a nullptr.
-        // Don't add nullptr to the returned StageSet.
-        if (matchingStage)
-            stages.insert(matchingStage);
+    for (const auto& entry : fStageToObject) {
+        // Don't add stages of deleted proxy shapes to the returned StageSet.
+        if (entry.first && entry.second.isValid())
+            stages.insert(entry.first);
     }
     return stages;
 }
 
-void UsdStageMap::setDirty()
+void UsdStageMap::setDirty() { fStagesDirty = true; }
+
+void UsdStageMap::clear()
 {
     fPathToObject.clear();
     fStageToObject.clear();
+    fObjectToInfo.clear();
     fDirty = true;
 }
 
+Ufe::Path UsdStageMap::trackedPath(const MObjectHandle& handle) const
+{
+    auto found = fObjectToInfo.find(handle);
+    return (found != fObjectToInfo.end() && handle.isValid()) ? found->second.path : Ufe::Path();
+}
+
 void UsdStageMap::rebuildIfDirty()
 {
-    if (!fDirty)
+    if (fDirty) {
+        // Full rebuild from all the proxy shapes of the scene.  Afterwards,
+        // the callbacks keep the tracked proxy shapes up to date.
+        fObjectToInfo.clear();
+        for (const auto& psn : ProxyShapeHandler::getAllNames()) {
+            auto proxyShape = nameLookup(toPath(psn));
+            if (proxyShape.isValid()) {
+                fObjectToInfo[proxyShape] = ProxyShapeInfo();
+            }
+        }
+        fPathsDirty = true;
+        fStagesDirty = true;
+        fDirty = false;
+        ++fRebuildCount;
+    }
+
+    if (!fPathsDirty && !fStagesDirty)
         return;
 
-    for (const auto& psn : ProxyShapeHandler::getAllNames()) {
-        addItem(toPath(psn));
+    for (auto it = fObjectToInfo.begin(); it != fObjectToInfo.end();) {
+        if (!it->first.isValid()) {
+            it = fObjectToInfo.erase(it);
+            continue;
+        }
+
+        MObject object = it->first.object();
+        if (fStagesDirty)
+            it->second.stage = objToStage(object);
+        if (fPathsDirty)
+            it->second.path = firstPath(object);
+        ++it;
+    }
+
+    fPathToObject.clear();
+    fStageToObject.clear();
+    for (const auto& entry : fObjectToInfo) {
+        // If a proxy shape doesn't yet have a stage, don't add it.
+        // We will add it later, when the stage is initialized
+        const ProxyShapeInfo& info = entry.second;
+        if (!info.stage || info.path.empty())
+            continue;
+
+        fPathToObject[info.path] = entry.first;
+        fStageToObject[info.stage] = entry.first;
     }
-    fDirty = false;
+
+    fPathsDirty = false;
+    fStagesDirty = false;
+
+    // Drop the path conversions of the stages that were renamed, reparented or removed.
+    UsdUfe::clearPathConversionCaches();
+}
+
+void UsdStageMap::addCallbacks()
+{
+    if (fCbIds.length() > 0)
+        return;
+
+    const MString proxyShapeType(ProxyShapeHandler::gatewayNodeType().c_str());
+
+    MStatus res;
+    fCbIds.append(
+        MDGMessage::addNodeAddedCallback(proxyShapeAddedCallback, proxyShapeType, this, &res));
+    CHECK_MSTATUS(res);
+    fCbIds.append(
+        MDGMessage::addNodeRemovedCallback(proxyShapeRemovedCallback, proxyShapeType, this, &res));
+    CHECK_MSTATUS(res);
+
+    // Renaming or reparenting any DAG node can change the path of proxy shapes.
+    MObject allNodes;
+    fCbIds.append(
+        MNodeMessage::addNameChangedCallback(allNodes, nameChangedCallback, this, &res));
+    CHECK_MSTATUS(res);
+    fCbIds.append(MDagMessage::addAllDagChangesCallback(dagChangedCallback, this, &res));
+    CHECK_MSTATUS(res);
+}
+
+void UsdStageMap::removeCallbacks()
+{
+    MMessage::removeCallbacks(fCbIds);
+    fCbIds.clear();
+}
+
+/*static*/
+void UsdStageMap::proxyShapeAddedCallback(MObject& node, void* clientData)
+{
+    static_cast<UsdStageMap*>(clientData)->trackProxyShape(node);
+}
+
+/*static*/
+void UsdStageMap::proxyShapeRemovedCallback(MObject& node, void* clientData)
+{
+    static_cast<UsdStageMap*>(clientData)->untrackProxyShape(node);
+}
+
+/*static*/
+void UsdStageMap::nameChangedCallback(MObject& node, const MString&, void* clientData)
+{
+    // Only the names of DAG nodes are part of the path of proxy shapes.
+    if (!node.hasFn(MFn::kDagNode))
+        return;
+
+    auto stageMap = static_cast<UsdStageMap*>(clientData);
+    if (!stageMap->fObjectToInfo.empty())
+        stageMap->fPathsDirty = true;
+}
+
+/*static*/
+void UsdStageMap::dagChangedCallback(
+    MDagMessage::DagMessage,
+    MDagPath&,
+    MDagPath&,
+    void* clientData)
+{
+    auto stageMap = static_cast<UsdStageMap*>(clientData);
+    if (!stageMap->fObjectToInfo.empty())
+        stageMap->fPathsDirty = true;
 }
 
 } // namespace ufe
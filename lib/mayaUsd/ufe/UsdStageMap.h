@@ -22,6 +22,8 @@
 #include <pxr/base/tf/hashset.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
 #include <maya/MObjectHandle.h>
 #include <ufe/path.h>
 
@@ -44,14 +46,18 @@ namespace ufe {
     nothing in the data model prevents it).  To generalized access to the
     underlying node, we store an MObjectHandle in the maps.
 
-    The cache is refreshed on access to a stage given a path which cannot be
-    found.  In this way, the cache does not need to observe the Maya data
-    model, and we avoid order of notification problems where one observer would
-    need to access the cache before it is refreshed, since there is no
-    guarantee on the order of notification of Ufe observers.  An earlier
-    implementation with rename observation had the Maya Outliner (which
-    observes rename) access the UsdStageMap on rename before the UsdStageMap
-    had been updated.
+    The proxy shapes are tracked incrementally through Maya node added and
+    removed callbacks, so that the scene never needs to be searched for proxy
+    shapes, except once after a new scene or file open.  Renaming or
+    reparenting any DAG node only marks the UFE paths of the tracked proxy
+    shapes dirty, and a change of stage only marks their stages dirty: they
+    are refreshed on the next access, which also avoids order of notification
+    problems where one observer would need to access the cache before it is
+    refreshed, since there is no guarantee on the order of notification of
+    Ufe observers.  An earlier implementation with rename observation had the
+    Maya Outliner (which observes rename) access the UsdStageMap on rename
+    before the UsdStageMap had been updated.  For the same reason, a path
+    which cannot be found is looked up directly in the Maya scene.
 */
 class MAYAUSD_CORE_PUBLIC UsdStageMap
 {
@@ -84,24 +90,68 @@ public:
     //! Return all the USD stages.
     StageSet allStages();
 
-    //! Set the stage map as dirty. It will be cleared immediately, but
-    //! only repopulated when stage info is requested.
+    //! Set the stages of the stage map as dirty. They will be refreshed from
+    //! the tracked proxy shapes when stage info is requested.
     void setDirty();
 
+    //! Forget all the tracked proxy shapes. The stage map will be rebuilt from
+    //! all the proxy shapes of the scene when stage info is requested.
+    void clear();
+
     //! Returns true if the stage map is dirty (meaning it needs to be filled in).
-    bool isDirty() const { return fDirty; }
+    bool isDirty() const { return fDirty || fStagesDirty || fPathsDirty; }
+
+    //! Returns the number of times the stage map was rebuilt from all the
+    //! proxy shapes of the scene.  Meant for profiling.
+    size_t rebuildCount() const { return fRebuildCount; }
+
+    //! Add the Maya callbacks tracking the proxy shapes.
+    void addCallbacks();
+
+    //! Remove the Maya callbacks tracking the proxy shapes.
+    void removeCallbacks();
 
 private:
-    void addItem(const Ufe::Path& path);
-    void rebuildIfDirty();
+    void      trackProxyShape(const MObject& object);
+    void      untrackProxyShape(const MObject& object);
+    MObject   lookupProxyShape(const Ufe::Path& path);
+    void      rebuildIfDirty();
+    Ufe::Path trackedPath(const MObjectHandle& handle) const;
+
+    static void proxyShapeAddedCallback(MObject& node, void* clientData);
+    static void proxyShapeRemovedCallback(MObject& node, void* clientData);
+    static void nameChangedCallback(MObject& node, const MString& prevName, void* clientData);
+    static void dagChangedCallback(
+        MDagMessage::DagMessage msgType,
+        MDagPath&               child,
+        MDagPath&               parent,
+        void*                   clientData);
 
 private:
-    // We keep two maps for fast lookup when there are many proxy shapes.
+    struct ObjectHandleHash
+    {
+        size_t operator()(const MObjectHandle& handle) const { return handle.hashCode(); }
+    };
+
+    struct ProxyShapeInfo
+    {
+        Ufe::Path               path;
+        PXR_NS::UsdStageWeakPtr stage;
+    };
+
+    // We keep two maps for fast lookup when there are many proxy shapes, and
+    // the reverse information of every tracked proxy shape to update them.
     using PathToObject = std::unordered_map<Ufe::Path, MObjectHandle>;
     using StageToObject = PXR_NS::TfHashMap<PXR_NS::UsdStageWeakPtr, MObjectHandle, PXR_NS::TfHash>;
-    PathToObject  fPathToObject;
-    StageToObject fStageToObject;
-    bool          fDirty { true };
+    using ObjectToInfo = std::unordered_map<MObjectHandle, ProxyShapeInfo, ObjectHandleHash>;
+    PathToObject     fPathToObject;
+    StageToObject    fStageToObject;
+    ObjectToInfo     fObjectToInfo;
+    bool             fDirty { true };
+    bool             fStagesDirty { false };
+    bool             fPathsDirty { false };
+    size_t           fRebuildCount { 0 };
+    MCallbackIdArray fCbIds;
 
 }; // UsdStageMap
 
@@ -161,10 +161,8 @@ bool UsdUndoCreateStageWithNewLayerCommand::executeWithinUndoRecorder()
 
     // Refresh the cache of the stage map.
     // When creating the proxy shape, the stage map gets dirtied and cleaned. Afterwards, the
-    // proxy shape is renamed. The stage map does not observe the Maya data model, so renaming
-    // does not dirty the stage map again. Thus, the cache is in an invalid state, where it
-    // contains the path of the proxy shape before it was renamed. Calling getProxyShape()
-    // refreshes the cache. See comments within UsdStageMap::proxyShape() for more details.
+    // proxy shape is renamed, which only marks the paths of the stage map dirty. Calling
+    // getProxyShape() refreshes the cache right away, before observers access it.
     getProxyShape(proxyShapeUfePath);
 
     return true;
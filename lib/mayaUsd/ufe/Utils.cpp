@@ -102,14 +102,14 @@ Ufe::Path stagePath(UsdStageWeakPtr stage) { return g_StageMap.path(stage); }
 
 TfHashSet<UsdStageWeakPtr, TfHash> getAllStages() { return g_StageMap.allStages(); }
 
+size_t getStageMapRebuildCount() { return g_StageMap.rebuildCount(); }
+
 UsdPrim ufePathToPrim(const Ufe::Path& path)
 {
     // When called we do not make any assumption on whether or not the
     // input path is valid.
 
-    const Ufe::Path ufePrimPath = UsdUfe::stripInstanceIndexFromUfePath(path);
-
-    const Ufe::Path::Segments& segments = ufePrimPath.getSegments();
+    const Ufe::Path::Segments& segments = path.getSegments();
     if (!TF_VERIFY(!segments.empty(), kIllegalUFEPath, path.string().c_str())) {
         return UsdPrim();
     }
@@ -127,7 +127,7 @@ UsdPrim ufePathToPrim(const Ufe::Path& path)
     // The second path segment is the USD path.
     return (segments.size() == 1u)
         ? stage->GetPseudoRoot()
-        : stage->GetPrimAtPath(SdfPath(segments[1].string()).GetPrimPath());
+        : stage->GetPrimAtPath(UsdUfe::ufePathToSdfPrimPath(path));
 }
 
 UsdSceneItem::Ptr
@@ -65,6 +65,11 @@ Ufe::Path stagePath(PXR_NS::UsdStageWeakPtr stage);
 MAYAUSD_CORE_PUBLIC
 PXR_NS::TfHashSet<PXR_NS::UsdStageWeakPtr, PXR_NS::TfHash> getAllStages();
 
+//! Return the number of times the stage map was rebuilt from all the proxy
+//! shapes of the scene.  Meant for profiling.
+MAYAUSD_CORE_PUBLIC
+size_t getStageMapRebuildCount();
+
 //! Return the USD prim corresponding to the argument UFE path.
 MAYAUSD_CORE_PUBLIC
 PXR_NS::UsdPrim ufePathToPrim(const Ufe::Path& path);
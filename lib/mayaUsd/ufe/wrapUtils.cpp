@@ -128,4 +128,5 @@ void wrapUtils()
     // the USD path separator is '/'.  PPT, 8-Dec-2019.
     def("getAllStages", _getAllStages, return_value_policy<PXR_NS::TfPySequenceToList>());
     def("getProxyShapePurposes", _getProxyShapePurposes);
+    def("getStageMapRebuildCount", ufe::getStageMapRebuildCount);
 }
@@ -118,17 +118,6 @@ bool shouldAddToSet(const MDagPath& toAdd, const UsdMayaUtil::MDagPathSet& dagPa
     return true;
 }
 
-bool GetMayaExtent(const UsdPrim& prim, GfRange3d& range)
-{
-    if (prim.IsA<UsdGeomCamera>()) {
-        // UsdGeomCamera, not being a UsdGeomBoundable, doesn't provide any extent information.
-        // So let's add Maya camera dimensions here
-        range = GfRange3d(GfVec3d(-0.4f, -0.3f, -2.0f), GfVec3d(0.4f, 1.0f, 2.0f));
-        return true;
-    }
-
-    return false;
-}
 } // namespace
 
 double UsdMayaUtil::ConvertMDistanceUnitToUsdGeomLinearUnit(const MDistance::Unit mdistanceUnit)
@@ -2515,6 +2504,18 @@ MString UsdMayaUtil::GetCurrentSceneFilePath()
     return currentSceneFilePath;
 }
 
+bool UsdMayaUtil::GetMayaExtent(const UsdPrim& prim, GfRange3d& range)
+{
+    if (prim.IsA<UsdGeomCamera>()) {
+        // UsdGeomCamera, not being a UsdGeomBoundable, doesn't provide any extent information.
+        // So let's add Maya camera dimensions here
+        range = GfRange3d(GfVec3d(-0.4f, -0.3f, -2.0f), GfVec3d(0.4f, 1.0f, 2.0f));
+        return true;
+    }
+
+    return false;
+}
+
 void UsdMayaUtil::AddMayaExtents(GfBBox3d& bbox, const UsdPrim& root, const UsdTimeCode time)
 {
     GfRange3d localExtents;
@@ -678,6 +678,10 @@ MString GetCurrentMayaWorkspacePath();
 MAYAUSD_CORE_PUBLIC
 MString GetCurrentSceneFilePath();
 
+/// Retrieves the Maya-specific local extent of the supplied prim, if it has one.
+MAYAUSD_CORE_PUBLIC
+bool GetMayaExtent(const PXR_NS::UsdPrim& prim, PXR_NS::GfRange3d& range);
+
 /// Takes the supplied bounding box and adds to it Maya-specific extents
 /// that come from the nodes originating from the supplied root node
 MAYAUSD_CORE_PUBLIC
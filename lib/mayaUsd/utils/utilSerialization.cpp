@@ -236,6 +236,16 @@ USDUnsavedEditsOption serializeUsdEditsLocationOption()
     }
 } // namespace MAYAUSD_NS_DEF
 
+bool serializeUsdEditsCompressedOption()
+{
+    static const MString kSerializedUsdEditsCompressed(
+        MayaUsdOptionVars->SerializedUsdEditsCompressed.GetText());
+
+    // Default is to export the edits as text, which older versions can read.
+    return MGlobal::optionVarExists(kSerializedUsdEditsCompressed)
+        && MGlobal::optionVarIntValue(kSerializedUsdEditsCompressed) != 0;
+}
+
 void setNewProxyPath(
     const MString&        proxyNodeName,
     const MString&        newRootLayerPath,
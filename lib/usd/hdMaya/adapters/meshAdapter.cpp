@@ -30,12 +30,13 @@
 #include <maya/MFloatArray.h>
 #include <maya/MFnMesh.h>
 #include <maya/MIntArray.h>
-#include <maya/MItMeshPolygon.h>
 #include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPolyMessage.h>
 
+#include <algorithm>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 namespace {
@@ -59,6 +60,16 @@ const std::pair<MObject&, HdDirtyBits> _dirtyBits[] {
     { MayaAttrs::mesh::smoothLevel, HdChangeTracker::DirtyDisplayStyle }
 };
 
+// Copies a Maya array to a VtArray, reusing the storage of the VtArray when it is not shared.
+void _CopyToVtArray(const MIntArray& src, VtIntArray& dst)
+{
+    dst.clear();
+    dst.resize(src.length());
+    if (src.length() > 0) {
+        src.get(dst.data());
+    }
+}
+
 } // namespace
 
 class HdMayaMeshAdapter : public HdMayaShapeAdapter
@@ -138,6 +149,18 @@ public:
         return GetDelegate()->GetRenderIndex().IsRprimTypeSupported(HdPrimTypeTokens->mesh);
     }
 
+    void MarkDirty(HdDirtyBits dirtyBits) override
+    {
+        HdMayaShapeAdapter::MarkDirty(dirtyBits);
+        if (dirtyBits & HdChangeTracker::DirtyTopology) {
+            _topologyDirty = true;
+            _uvsDirty = true;
+        }
+        if (dirtyBits & HdChangeTracker::DirtyPrimvar) {
+            _uvsDirty = true;
+        }
+    }
+
     VtValue GetUVs()
     {
         MStatus status;
@@ -145,18 +168,47 @@ public:
         if (ARCH_UNLIKELY(!status)) {
             return {};
         }
-        VtArray<GfVec2f> uvs;
-        uvs.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vertexCount = pit.polygonVertexCount();
-            for (auto i = decltype(vertexCount) { 0 }; i < vertexCount; ++i) {
-                float2 uv = { 0.0f, 0.0f };
-                pit.getUV(i, uv);
-                uvs.push_back(GfVec2f(uv[0], uv[1]));
+        UpdateTopology(mesh);
+        if (!_uvsDirty) {
+            return VtValue(_uvs);
+        }
+
+        // Faces without uvs have no assigned uvs, their face-vertices get a zero uv.
+        MIntArray   uvCounts;
+        MIntArray   uvIds;
+        MFloatArray us;
+        MFloatArray vs;
+        mesh.getAssignedUVs(uvCounts, uvIds);
+        mesh.getUVs(us, vs);
+
+        // Reading the shared topology through the const accessors avoids copying it.
+        const int* faceVertexCounts = _faceVertexCounts.cdata();
+        const auto numFaces = std::min(
+            static_cast<unsigned int>(_faceVertexCounts.size()), uvCounts.length());
+
+        _uvs.clear();
+        _uvs.resize(_faceVertexIndices.size());
+        GfVec2f* uvs = _uvs.data();
+        size_t   faceVertex = 0;
+        size_t   uvIndex = 0;
+        for (auto face = decltype(numFaces) { 0 }; face < numFaces; ++face) {
+            const int vertexCount = faceVertexCounts[face];
+            const int uvCount = uvCounts[face];
+            if (uvCount == vertexCount) {
+                for (int i = 0; i < vertexCount; ++i) {
+                    const int uvId = uvIds[static_cast<unsigned int>(uvIndex++)];
+                    uvs[faceVertex++] = GfVec2f(us[uvId], vs[uvId]);
+                }
+            } else {
+                uvIndex += static_cast<size_t>(uvCount);
+                for (int i = 0; i < vertexCount; ++i) {
+                    uvs[faceVertex++] = GfVec2f(0.0f, 0.0f);
+                }
             }
         }
+        _uvsDirty = false;
 
-        return VtValue(uvs);
+        return VtValue(_uvs);
     }
 
     VtValue GetPoints(const MFnMesh& mesh)
@@ -166,9 +218,9 @@ public:
         if (ARCH_UNLIKELY(!status)) {
             return {};
         }
-        VtVec3fArray ret;
-        ret.assign(rawPoints, rawPoints + mesh.numVertices());
-        return VtValue(ret);
+        // Reuses the storage of the previous points once Hydra released them.
+        _points.assign(rawPoints, rawPoints + mesh.numVertices());
+        return VtValue(_points);
     }
 
     VtValue Get(const TfToken& key) override
@@ -217,19 +269,12 @@ public:
 
     HdMeshTopology GetMeshTopology() override
     {
-        MFnMesh    mesh(GetDagPath());
-        const auto numPolygons = mesh.numPolygons();
-        VtIntArray faceVertexCounts;
-        faceVertexCounts.reserve(static_cast<size_t>(numPolygons));
-        VtIntArray faceVertexIndices;
-        faceVertexIndices.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vc = pit.polygonVertexCount();
-            faceVertexCounts.push_back(vc);
-            for (auto i = decltype(vc) { 0 }; i < vc; ++i) {
-                faceVertexIndices.push_back(pit.vertexIndex(i));
-            }
+        MStatus status;
+        MFnMesh mesh(GetDagPath(), &status);
+        if (ARCH_UNLIKELY(!status)) {
+            return {};
         }
+        UpdateTopology(mesh);
 
         // TODO: Maybe we could use the flat shading of the display style?
         return HdMeshTopology(
@@ -237,8 +282,8 @@ public:
                 ? PxOsdOpenSubdivTokens->catmullClark
                 : PxOsdOpenSubdivTokens->none,
             UsdGeomTokens->rightHanded,
-            faceVertexCounts,
-            faceVertexIndices);
+            _faceVertexCounts,
+            _faceVertexIndices);
     }
 
     HdDisplayStyle GetDisplayStyle() override
@@ -360,6 +405,20 @@ public:
     bool HasType(const TfToken& typeId) const override { return typeId == HdPrimTypeTokens->mesh; }
 
 private:
+    // Reads the topology of the mesh in bulk, and keeps it until it changes.
+    void UpdateTopology(const MFnMesh& mesh)
+    {
+        if (!_topologyDirty) {
+            return;
+        }
+        MIntArray vertexCounts;
+        MIntArray vertexIndices;
+        mesh.getVertices(vertexCounts, vertexIndices);
+        _CopyToVtArray(vertexCounts, _faceVertexCounts);
+        _CopyToVtArray(vertexIndices, _faceVertexIndices);
+        _topologyDirty = false;
+    }
+
     static void NodeDirtiedCallback(MObject& node, MPlug& plug, void* clientData)
     {
         auto* adapter = reinterpret_cast<HdMayaMeshAdapter*>(clientData);
@@ -440,6 +499,16 @@ private:
     // To work around this, we register these callbacks specially, and only
     // remove them if the underlying node is currently valid.
     MCallbackIdArray _buggyCallbacks;
+
+    // Cached until the topology or the uvs change, see MarkDirty.
+    VtIntArray   _faceVertexCounts;
+    VtIntArray   _faceVertexIndices;
+    VtVec2fArray _uvs;
+    bool         _topologyDirty = true;
+    bool         _uvsDirty = true;
+
+    // Kept to reuse its storage.
+    VtVec3fArray _points;
 };
 
 TF_REGISTRY_FUNCTION(TfType)
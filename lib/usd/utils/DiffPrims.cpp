@@ -15,7 +15,12 @@
 //
 #include "DiffPrims.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
 #include <map>
+#include <vector>
 
 namespace MayaUsdUtils {
 
@@ -25,6 +30,61 @@ using SdfPath = PXR_NS::SdfPath;
 using UsdAttribute = PXR_NS::UsdAttribute;
 using UsdRelationship = PXR_NS::UsdRelationship;
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Runs the comparison of each item in parallel, since the items of a prim are independent.
+///
+/// When quickDiff is not null, the items after a differing one are skipped, and quickDiff receives
+/// the result of the lowest differing item, like a serial comparison would. Only the results of
+/// the items before that one are returned: they were all compared and found to be the same.
+template <class COMPARE>
+std::vector<DiffResult> compareEachItem(size_t count, DiffResult* quickDiff, const COMPARE& compare)
+{
+    // Small enough that prims with few children or attributes are compared on the calling thread.
+    static const size_t grainSize = 8;
+
+    std::vector<DiffResult> results(count, DiffResult::Same);
+    std::vector<DiffResult> quickResults(quickDiff ? count : 0, DiffResult::Same);
+
+    // Lowest index of the differing items found so far. It only decreases, so every item
+    // below its final value is compared.
+    std::atomic<size_t> firstDiffer(count);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, count, grainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                if (!quickDiff) {
+                    results[i] = compare(i, nullptr);
+                    continue;
+                }
+
+                if (i > firstDiffer.load(std::memory_order_relaxed))
+                    return;
+
+                results[i] = compare(i, &quickResults[i]);
+                if (quickResults[i] == DiffResult::Same)
+                    continue;
+
+                size_t current = firstDiffer.load(std::memory_order_relaxed);
+                while (i < current
+                       && !firstDiffer.compare_exchange_weak(
+                           current, i, std::memory_order_relaxed)) { }
+            }
+        });
+
+    if (quickDiff) {
+        const size_t differ = firstDiffer.load();
+        *quickDiff = differ < count ? quickResults[differ] : DiffResult::Same;
+        results.resize(differ);
+    }
+
+    return results;
+}
+
+} // namespace
+
 #define USD_MAYA_RETURN_QUICK_RESULT(result, results)  \
     do {                                               \
         if (quickDiff && result != DiffResult::Same) { \
@@ -51,21 +111,25 @@ comparePrimsAttributes(const UsdPrim& modified, const UsdPrim& baseline, DiffRes
     }
 
     // Compare the attributes from the modified prim.
-    // Baseline attributes map won't change from now on, so cache the end.
+    // Baseline attributes map won't change from now on, so it can be read from all threads.
     {
-        const auto baselineEnd = baselineAttrs.end();
-        for (const UsdAttribute& attr : modified.GetAuthoredAttributes()) {
-            const TfToken& name = attr.GetName();
-            const auto     iter = baselineAttrs.find(name);
-            if (iter == baselineEnd) {
-                USD_MAYA_RETURN_QUICK_RESULT(DiffResult::Created, results);
-                results[name] = DiffResult::Created;
-            } else {
-                const DiffResult result = compareAttributes(attr, iter->second, quickDiff);
-                USD_MAYA_RETURN_QUICK_RESULT(result, results);
-                results[name] = result;
-            }
-        }
+        const std::vector<UsdAttribute> modifiedAttrs = modified.GetAuthoredAttributes();
+        const auto                      baselineEnd = baselineAttrs.end();
+        const std::vector<DiffResult>   attrResults = compareEachItem(
+            modifiedAttrs.size(), quickDiff, [&](size_t i, DiffResult* itemQuickDiff) {
+                const auto iter = baselineAttrs.find(modifiedAttrs[i].GetName());
+                if (iter == baselineEnd) {
+                    if (itemQuickDiff)
+                        *itemQuickDiff = DiffResult::Created;
+                    return DiffResult::Created;
+                }
+                return compareAttributes(modifiedAttrs[i], iter->second, itemQuickDiff);
+            });
+
+        for (size_t i = 0; i < attrResults.size(); ++i)
+            results[modifiedAttrs[i].GetName()] = attrResults[i];
+
+        USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, results);
     }
 
     // Identify attributes that are absent in the modified prim.
@@ -144,20 +208,26 @@ comparePrimsChildren(const UsdPrim& modified, const UsdPrim& baseline, DiffResul
     }
 
     // Compare the children from the modified prim.
-    // Baseline children map won't change from now on, so cache the end.
+    // Baseline children map won't change from now on, so it can be read from all threads.
     {
-        const auto baselineEnd = baselineChildren.end();
-        for (const UsdPrim& child : modified.GetAllChildren()) {
-            const SdfPath& path = child.GetPath();
-            const auto     iter = baselineChildren.find(path);
-            if (iter == baselineEnd) {
-                USD_MAYA_RETURN_QUICK_RESULT(DiffResult::Created, results);
-                results[path] = DiffResult::Created;
-            } else {
-                results[path] = comparePrims(child, iter->second, quickDiff);
-                USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, results);
-            }
-        }
+        const auto                    allChildren = modified.GetAllChildren();
+        const std::vector<UsdPrim>    modifiedChildren(allChildren.begin(), allChildren.end());
+        const auto                    baselineEnd = baselineChildren.end();
+        const std::vector<DiffResult> childResults = compareEachItem(
+            modifiedChildren.size(), quickDiff, [&](size_t i, DiffResult* itemQuickDiff) {
+                const auto iter = baselineChildren.find(modifiedChildren[i].GetPath());
+                if (iter == baselineEnd) {
+                    if (itemQuickDiff)
+                        *itemQuickDiff = DiffResult::Created;
+                    return DiffResult::Created;
+                }
+                return comparePrims(modifiedChildren[i], iter->second, itemQuickDiff);
+            });
+
+        for (size_t i = 0; i < childResults.size(); ++i)
+            results[modifiedChildren[i].GetPath()] = childResults[i];
+
+        USD_MAYA_RETURN_QUICK_RESULT(*quickDiff, results);
     }
 
     // Identify children that are absent in the modified prim.
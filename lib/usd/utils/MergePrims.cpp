@@ -18,7 +18,16 @@
 #include "DiffPrims.h"
 
 #include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/copyUtils.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/payload.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/propertySpec.h>
+#include <pxr/usd/sdf/reference.h>
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/sdf/variantSetSpec.h>
+#include <pxr/usd/sdf/variantSpec.h>
 #include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usd/variantSets.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
@@ -994,6 +1003,282 @@ std::pair<SdfPath, UsdEditTarget> augmentPathWithVariants(
     return std::make_pair(pathWithVariants, target);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Scratch layer used to ignore the opinions of the upper layers.
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Copies the fields of a spec, except the ones listing its children.
+void copyFieldsWithoutChildren(
+    const SdfLayerHandle& srcLayer,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        path)
+{
+    const SdfSchemaBase& schema = srcLayer->GetSchema();
+    for (const TfToken& field : srcLayer->ListFields(path)) {
+        if (!schema.HoldsChildren(field))
+            dstLayer->SetField(path, field, srcLayer->GetField(path, field));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Adds the prims targeted by the composition arcs of a prim spec that refer to the same layer.
+void addInternalArcTargets(const SdfLayerHandle& layer, const SdfPath& path, SdfPathVector& targets)
+{
+    const SdfPath primPath = path.GetPrimPath();
+    const auto    addTarget = [&](const SdfPath& target) {
+        if (!target.IsEmpty())
+            targets.push_back(target.MakeAbsolutePath(primPath).StripAllVariantSelections());
+    };
+
+    const auto addItems = [](const auto& listOp, const auto& addItem) {
+        for (const auto& item : listOp.GetExplicitItems())
+            addItem(item);
+        for (const auto& item : listOp.GetAddedItems())
+            addItem(item);
+        for (const auto& item : listOp.GetPrependedItems())
+            addItem(item);
+        for (const auto& item : listOp.GetAppendedItems())
+            addItem(item);
+        for (const auto& item : listOp.GetOrderedItems())
+            addItem(item);
+    };
+
+    // Internal references and payloads without a prim path target the default prim.
+    const auto addInternalArc = [&](const auto& arc) {
+        if (!arc.GetAssetPath().empty())
+            return;
+        if (!arc.GetPrimPath().IsEmpty())
+            addTarget(arc.GetPrimPath());
+        else if (!layer->GetDefaultPrim().IsEmpty())
+            addTarget(SdfPath::AbsoluteRootPath().AppendChild(layer->GetDefaultPrim()));
+    };
+
+    SdfPathListOp pathListOp;
+    if (layer->HasField(path, SdfFieldKeys->InheritPaths, &pathListOp))
+        addItems(pathListOp, addTarget);
+    if (layer->HasField(path, SdfFieldKeys->Specializes, &pathListOp))
+        addItems(pathListOp, addTarget);
+
+    SdfReferenceListOp references;
+    if (layer->HasField(path, SdfFieldKeys->References, &references))
+        addItems(references, addInternalArc);
+
+    SdfPayloadListOp payloads;
+    if (layer->HasField(path, SdfFieldKeys->Payload, &payloads))
+        addItems(payloads, addInternalArc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Copies the spec at a path with all its descendants into a scratch layer, along with what is
+/// needed to compose it: the layer metadata, the fields of its ancestors and the prims targeted
+/// by the internal composition arcs of all of them. The rest of the layer is not copied.
+void copyScope(const SdfLayerHandle& srcLayer, const SdfLayerHandle& dstLayer, const SdfPath& path)
+{
+    SdfChangeBlock changeBlock;
+
+    copyFieldsWithoutChildren(srcLayer, dstLayer, SdfPath::AbsoluteRootPath());
+
+    SdfPathVector toCopy { path };
+    SdfPathVector copied;
+    while (!toCopy.empty()) {
+        const SdfPath scopePath = toCopy.back();
+        toCopy.pop_back();
+
+        const bool alreadyCopied
+            = std::any_of(copied.begin(), copied.end(), [&scopePath](const SdfPath& copiedPath) {
+                  return scopePath.HasPrefix(copiedPath);
+              });
+        if (alreadyCopied || !srcLayer->HasSpec(scopePath))
+            continue;
+        copied.push_back(scopePath);
+
+        SdfPathVector ancestors;
+        scopePath.GetPrefixes(&ancestors);
+        ancestors.pop_back();
+        for (const SdfPath& ancestor : ancestors) {
+            if (!srcLayer->HasSpec(ancestor))
+                continue;
+            if (!dstLayer->HasSpec(ancestor))
+                SdfJustCreatePrimInLayer(dstLayer, ancestor);
+            copyFieldsWithoutChildren(srcLayer, dstLayer, ancestor);
+            addInternalArcTargets(srcLayer, ancestor, toCopy);
+        }
+
+        SdfCopySpec(srcLayer, scopePath, dstLayer, scopePath);
+
+        srcLayer->Traverse(scopePath, [&](const SdfPath& specPath) {
+            if (specPath.IsPrimOrPrimVariantSelectionPath())
+                addInternalArcTargets(srcLayer, specPath, toCopy);
+        });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Verifies if the children listed in a children field of a spec are synchronized individually.
+bool isSyncedChildrenField(const TfToken& childrenField)
+{
+    return childrenField == SdfChildrenKeys->PrimChildren
+        || childrenField == SdfChildrenKeys->PropertyChildren
+        || childrenField == SdfChildrenKeys->VariantSetChildren
+        || childrenField == SdfChildrenKeys->VariantChildren;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Returns the path of a child listed in one of the children fields that are synchronized
+/// individually.
+SdfPath getChildPath(const SdfPath& path, const TfToken& childrenField, const TfToken& name)
+{
+    if (childrenField == SdfChildrenKeys->PrimChildren)
+        return path.AppendChild(name);
+    if (childrenField == SdfChildrenKeys->PropertyChildren)
+        return path.AppendProperty(name);
+    if (childrenField == SdfChildrenKeys->VariantSetChildren)
+        return path.AppendVariantSelection(name.GetString(), "");
+    if (childrenField == SdfChildrenKeys->VariantChildren)
+        return path.GetParentPath().AppendVariantSelection(
+            path.GetVariantSelection().first, name.GetString());
+    return SdfPath();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Removes a prim, property, variant set or variant spec with all its descendants.
+void removeSpec(const SdfLayerHandle& layer, const SdfPath& path)
+{
+    switch (layer->GetSpecType(path)) {
+    case SdfSpecTypePrim: {
+        const SdfPath     parentPath = path.GetParentPath();
+        SdfPrimSpecHandle parent = parentPath.IsAbsoluteRootPath()
+            ? layer->GetPseudoRoot()
+            : layer->GetPrimAtPath(parentPath);
+        if (parent)
+            parent->RemoveNameChild(layer->GetPrimAtPath(path));
+    } break;
+    case SdfSpecTypeAttribute:
+    case SdfSpecTypeRelationship: {
+        SdfPrimSpecHandle prim = layer->GetPrimAtPath(path.GetPrimOrPrimVariantSelectionPath());
+        if (prim)
+            prim->RemoveProperty(layer->GetPropertyAtPath(path));
+    } break;
+    case SdfSpecTypeVariantSet: {
+        SdfPrimSpecHandle prim = layer->GetPrimAtPath(path.GetParentPath());
+        if (prim)
+            prim->RemoveVariantSet(path.GetVariantSelection().first);
+    } break;
+    case SdfSpecTypeVariant: {
+        const std::string&      setName = path.GetVariantSelection().first;
+        SdfVariantSetSpecHandle variantSet = TfDynamic_cast<SdfVariantSetSpecHandle>(
+            layer->GetObjectAtPath(path.GetParentPath().AppendVariantSelection(setName, "")));
+        if (variantSet)
+            variantSet->RemoveVariant(
+                TfDynamic_cast<SdfVariantSpecHandle>(layer->GetObjectAtPath(path)));
+    } break;
+    default: break;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Replaces a spec with all its descendants by the one of another layer.
+void replaceSpec(
+    const SdfLayerHandle& srcLayer,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        path)
+{
+    if (dstLayer->HasSpec(path))
+        removeSpec(dstLayer, path);
+    SdfCopySpec(srcLayer, path, dstLayer, path);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Verifies if a spec has the same fields with the same values in two layers.
+bool hasSameFields(
+    const SdfLayerHandle& srcLayer,
+    const SdfLayerHandle& dstLayer,
+    const SdfPath&        path)
+{
+    std::vector<TfToken> srcFields = srcLayer->ListFields(path);
+    std::vector<TfToken> dstFields = dstLayer->ListFields(path);
+    std::sort(srcFields.begin(), srcFields.end());
+    std::sort(dstFields.begin(), dstFields.end());
+    if (srcFields != dstFields)
+        return false;
+
+    for (const TfToken& field : srcFields) {
+        if (srcLayer->GetField(path, field) != dstLayer->GetField(path, field))
+            return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Makes a spec and its descendants identical to the ones of another layer, only modifying the
+/// specs and fields that differ.
+void syncSpec(const SdfLayerHandle& srcLayer, const SdfLayerHandle& dstLayer, const SdfPath& path)
+{
+    const SdfSpecType specType = srcLayer->GetSpecType(path);
+    if (specType != dstLayer->GetSpecType(path)) {
+        replaceSpec(srcLayer, dstLayer, path);
+        return;
+    }
+
+    // Properties are small: they are replaced as a whole when they differ.
+    if (specType == SdfSpecTypeAttribute || specType == SdfSpecTypeRelationship) {
+        if (!hasSameFields(srcLayer, dstLayer, path))
+            replaceSpec(srcLayer, dstLayer, path);
+        return;
+    }
+
+    const SdfSchemaBase& schema = srcLayer->GetSchema();
+
+    std::vector<TfToken> childrenFields;
+    for (const TfToken& field : dstLayer->ListFields(path)) {
+        if (schema.HoldsChildren(field))
+            childrenFields.push_back(field);
+        else if (!srcLayer->HasField(path, field))
+            dstLayer->EraseField(path, field);
+    }
+
+    for (const TfToken& field : srcLayer->ListFields(path)) {
+        if (schema.HoldsChildren(field)) {
+            if (std::find(childrenFields.begin(), childrenFields.end(), field)
+                == childrenFields.end())
+                childrenFields.push_back(field);
+            continue;
+        }
+
+        const VtValue value = srcLayer->GetField(path, field);
+        if (dstLayer->GetField(path, field) != value)
+            dstLayer->SetField(path, field, value);
+    }
+
+    for (const TfToken& field : childrenFields) {
+        if (!isSyncedChildrenField(field)) {
+            replaceSpec(srcLayer, dstLayer, path);
+            return;
+        }
+
+        const auto srcNames = srcLayer->GetFieldAs<std::vector<TfToken>>(path, field);
+        const auto dstNames = dstLayer->GetFieldAs<std::vector<TfToken>>(path, field);
+
+        for (const TfToken& name : dstNames) {
+            if (std::find(srcNames.begin(), srcNames.end(), name) == srcNames.end())
+                removeSpec(dstLayer, getChildPath(path, field, name));
+        }
+
+        for (const TfToken& name : srcNames) {
+            const SdfPath childPath = getChildPath(path, field, name);
+            if (dstLayer->HasSpec(childPath))
+                syncSpec(srcLayer, dstLayer, childPath);
+            else
+                SdfCopySpec(srcLayer, childPath, dstLayer, childPath);
+        }
+
+        // The children may have been reordered.
+        if (dstLayer->GetFieldAs<std::vector<TfToken>>(path, field) != srcNames)
+            dstLayer->SetField(path, field, VtValue(srcNames));
+    }
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1029,16 +1314,20 @@ bool mergePrims(
     SdfJustCreatePrimInLayer(dstLayer, augmentedDstPath);
 
     if (options.ignoreUpperLayerOpinions) {
-        auto           tempStage = UsdStage::CreateInMemory();
-        SdfLayerHandle tempLayer = tempStage->GetSessionLayer();
-
-        tempLayer->TransferContent(dstLayer);
+        // Merge in a scratch stage holding only the part of the destination layer needed to
+        // compose the destination prim, then only write back the specs that changed, so that the
+        // cost does not depend on the size of the destination layer.
+        SdfLayerRefPtr tempLayer = SdfLayer::CreateAnonymous();
+        copyScope(dstLayer, tempLayer, augmentedDstPath);
+        auto tempStage = UsdStage::Open(tempLayer);
 
         const bool success = mergeDiffPrims(
             options, srcStage, srcLayer, srcPath, tempStage, tempLayer, augmentedDstPath);
 
-        if (success)
-            dstLayer->TransferContent(tempLayer);
+        if (success) {
+            SdfChangeBlock changeBlock;
+            syncSpec(tempLayer, dstLayer, augmentedDstPath);
+        }
 
         return success;
     } else {
@@ -14,6 +14,7 @@
 // limitations under the License.
 //
 
+#include <usdUfe/ufe/StagesSubject.h>
 #include <usdUfe/ufe/UsdSceneItem.h>
 #include <usdUfe/ufe/Utils.h>
 
@@ -75,6 +76,23 @@ PXR_NS::UsdPrim _ufePathToPrim(const std::string& ufePathString)
     return UsdUfe::ufePathToPrim(Ufe::PathString::path(ufePathString));
 }
 
+PXR_NS::SdfPath _ufePathToSdfPrimPath(const std::string& ufePathString)
+{
+    return UsdUfe::ufePathToSdfPrimPath(Ufe::PathString::path(ufePathString));
+}
+
+boost::python::dict _getPathConversionStatistics()
+{
+    const UsdUfe::PathConversionStatistics stats = UsdUfe::getPathConversionStatistics();
+
+    boost::python::dict result;
+    result["usdToUfeEntries"] = stats.numUsdToUfeEntries;
+    result["ufeToUsdEntries"] = stats.numUfeToUsdEntries;
+    result["hits"] = stats.numHits;
+    result["misses"] = stats.numMisses;
+    return result;
+}
+
 int _ufePathToInstanceIndex(const std::string& ufePathString)
 {
     return UsdUfe::ufePathToInstanceIndex(Ufe::PathString::path(ufePathString));
@@ -96,6 +114,11 @@ bool _isAttributeEditAllowed(const PXR_NS::UsdAttribute& attr)
     return UsdUfe::isAttributeEditAllowed(attr);
 }
 
+UsdUfe::SceneChangedNotificationGuard* _SceneChangedNotificationGuardInit()
+{
+    return new UsdUfe::SceneChangedNotificationGuard();
+}
+
 void wrapUtils()
 {
     // Because mayaUsd and UFE have incompatible Python bindings that do not
@@ -113,8 +136,16 @@ void wrapUtils()
     def("uniqueChildName", UsdUfe::uniqueChildName);
     def("stripInstanceIndexFromUfePath", _stripInstanceIndexFromUfePath, (arg("ufePathString")));
     def("ufePathToPrim", _ufePathToPrim);
+    def("ufePathToSdfPrimPath", _ufePathToSdfPrimPath);
+    def("clearPathConversionCaches", UsdUfe::clearPathConversionCaches);
+    def("getPathConversionStatistics", _getPathConversionStatistics);
     def("ufePathToInstanceIndex", _ufePathToInstanceIndex);
     def("isEditTargetLayerModifiable", _isEditTargetLayerModifiable);
     def("getTime", _getTime);
     def("isAttributeEditAllowed", _isAttributeEditAllowed);
+
+    // The notifications are sent when the guard object is deleted.
+    using GuardThis = UsdUfe::SceneChangedNotificationGuard;
+    class_<GuardThis, boost::noncopyable>("SceneChangedNotificationGuard", no_init)
+        .def("__init__", make_constructor(_SceneChangedNotificationGuardInit));
 }
@@ -15,6 +15,7 @@
 //
 #include "SetVariantSelectionCommand.h"
 
+#include <usdUfe/ufe/StagesSubject.h>
 #include <usdUfe/ufe/Utils.h>
 
 #include <pxr/usd/usd/variantSets.h>
@@ -64,6 +65,9 @@ void SetVariantSelectionCommand::redo()
     _savedSn.replaceWith(*globalSn);
     // Filter the global selection, removing items below our prim.
     globalSn->replaceWith(UsdUfe::removeDescendants(_savedSn, _path));
+
+    // Switching a variant can resync a large number of prims.
+    SceneChangedNotificationGuard guard;
     _varSet.SetVariantSelection(_newSelection);
 }
 
@@ -78,7 +82,10 @@ void SetVariantSelectionCommand::undo()
         throw std::runtime_error(errMsg.c_str());
     }
 
-    _varSet.SetVariantSelection(_oldSelection);
+    {
+        SceneChangedNotificationGuard guard;
+        _varSet.SetVariantSelection(_oldSelection);
+    }
     // Restore the saved selection to the global selection.  If a saved
     // selection item started with the prim's path, re-create it.
     auto globalSn = Ufe::GlobalSelection::get();
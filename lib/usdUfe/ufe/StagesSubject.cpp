@@ -38,6 +38,8 @@
 #include <ufe/transform3d.h>
 
 #include <regex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace {
@@ -59,6 +61,15 @@ void notifyWithoutExceptions(const NOTIFICATION& notif)
     }
 }
 
+void notifySceneWithoutExceptions(const Ufe::Notification& notif)
+{
+    try {
+        Ufe::Scene::instance().notify(notif);
+    } catch (const std::exception& ex) {
+        TF_WARN("Caught error during notification: %s", ex.what());
+    }
+}
+
 // The attribute change notification guard is not meant to be nested, but
 // use a counter nonetheless to provide consistent behavior in such cases.
 std::atomic_int attributeChangedNotificationGuardCount { 0 };
@@ -298,6 +309,123 @@ std::vector<std::string> getMetadataKeys(const std::string& strMetadata)
 }
 #endif
 
+// Scene changed notifications can be nested, for example when a bulk edit
+// contains commands that also batch their notifications.
+std::atomic_int sceneChangedNotificationGuardCount { 0 };
+
+enum class SceneChangeType
+{
+    kAdded,
+    kPostDeleted,
+    kSubtreeInvalidated,
+    kRemoved, // Destroyed, unless a scene item can still be created for the path.
+    kDestroyed
+};
+
+struct SceneNotification
+{
+    Ufe::Path       path;
+    SceneChangeType type;
+};
+
+// Scene changed notifications delayed until the end of the outermost guard.
+std::vector<SceneNotification> pendingSceneChangedNotifications;
+
+bool inSceneChangedNotificationGuard() { return sceneChangedNotificationGuardCount.load() > 0; }
+
+bool hasAncestor(const Ufe::Path& path, const std::unordered_set<Ufe::Path>& paths)
+{
+    for (Ufe::Path ancestor = path.pop(); !ancestor.empty(); ancestor = ancestor.pop()) {
+        if (paths.count(ancestor) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void sendSceneChanged(const SceneNotification& notification)
+{
+    if (notification.type == SceneChangeType::kDestroyed) {
+        notifySceneWithoutExceptions(Ufe::ObjectDestroyed(notification.path));
+        return;
+    }
+
+    // AL LayerCommands.addSubLayer test will cause crash
+    // if we don't filter invalid sceneItems. This patch is provided
+    // to prevent crashes, but more investigation will have to be
+    // done to understand why ufePath in case of sub layer
+    // creation causes Ufe::Hierarchy::createItem to fail.
+    auto sceneItem = Ufe::Hierarchy::createItem(notification.path);
+    switch (notification.type) {
+    case SceneChangeType::kAdded:
+        if (sceneItem)
+            notifySceneWithoutExceptions(Ufe::ObjectAdd(sceneItem));
+        break;
+    case SceneChangeType::kPostDeleted:
+        if (sceneItem)
+            notifySceneWithoutExceptions(Ufe::ObjectPostDelete(sceneItem));
+        break;
+    case SceneChangeType::kSubtreeInvalidated:
+        if (sceneItem)
+            notifySceneWithoutExceptions(Ufe::SubtreeInvalidate(sceneItem));
+        break;
+    case SceneChangeType::kRemoved:
+        if (sceneItem) {
+            notifySceneWithoutExceptions(Ufe::SubtreeInvalidate(sceneItem));
+        } else {
+            notifySceneWithoutExceptions(Ufe::ObjectDestroyed(notification.path));
+        }
+        break;
+    case SceneChangeType::kDestroyed: break;
+    }
+}
+
+// Send the scene changed notifications, collapsed so that large edits, like
+// loading a payload or switching a variant, do not flood the observers:
+// - only the last notification of a path is sent, as it reflects the final
+//   state of the prim,
+// - notifications of descendants of an added or removed path are dropped, as
+//   observers refresh or discard the whole subtree of that ancestor. Under an
+//   ancestor that is only invalidated, the descendants are still notified, so
+//   that the observers tracking a destroyed descendant hear about it.
+// Scene items are only created for the paths left, and only when the scene
+// has observers.
+void sendSceneChangedNotifications(std::vector<SceneNotification>& notifications)
+{
+    if (notifications.empty()) {
+        return;
+    }
+
+    if (Ufe::Scene::instance().nbObservers() == 0) {
+        notifications.clear();
+        return;
+    }
+
+    std::unordered_map<Ufe::Path, size_t> lastNotification;
+    for (size_t i = 0; i < notifications.size(); ++i) {
+        lastNotification[notifications[i].path] = i;
+    }
+
+    std::unordered_set<Ufe::Path> collapsingPaths;
+    for (const auto& pathAndIndex : lastNotification) {
+        if (notifications[pathAndIndex.second].type != SceneChangeType::kSubtreeInvalidated) {
+            collapsingPaths.insert(pathAndIndex.first);
+        }
+    }
+
+    // Move the notifications out, as observers may trigger other notifications.
+    std::vector<SceneNotification> toSend;
+    toSend.swap(notifications);
+    for (size_t i = 0; i < toSend.size(); ++i) {
+        const SceneNotification& notification = toSend[i];
+        if (lastNotification[notification.path] != i
+            || hasAncestor(notification.path, collapsingPaths)) {
+            continue;
+        }
+        sendSceneChanged(notification);
+    }
+}
+
 void processAttributeChanges(
     const Ufe::Path&                                ufePath,
     const SdfPath&                                  changedPath,
@@ -387,10 +515,19 @@ void StagesSubject::stageChanged(
     UsdStageWeakPtr const&           sender)
 {
     // If the stage path has not been initialized yet, do nothing
-    if (stagePath(sender).empty())
+    const Ufe::Path stageUfePath = stagePath(sender);
+    if (stageUfePath.empty())
         return;
 
     auto stage = notice.GetStage();
+
+    // Scene changed notifications are collapsed and sent once all the resynced
+    // paths are known, or at the end of the outermost notification guard.
+    std::vector<SceneNotification>  noticeSceneNotifications;
+    std::vector<SceneNotification>& sceneNotifications = inSceneChangedNotificationGuard()
+        ? pendingSceneChangedNotifications
+        : noticeSceneNotifications;
+
     auto resyncPaths = notice.GetResyncedPaths();
     for (auto it = resyncPaths.begin(), end = resyncPaths.end(); it != end; ++it) {
         const auto& changedPath = *it;
@@ -401,7 +538,7 @@ void StagesSubject::stageChanged(
             const TfToken nameToken = changedPath.GetNameToken();
             auto          usdPrimPathStr = changedPath.GetPrimPath().GetString();
             auto          ufePath
-                = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, getUsdRunTimeId(), '/');
+                = stageUfePath + Ufe::PathSegment(usdPrimPathStr, getUsdRunTimeId(), '/');
             if (isTransformChange(nameToken)) {
                 if (!UsdUfe::InTransform3dChange::inTransform3dChange()) {
                     notifyWithoutExceptions<Ufe::Transform3d>(ufePath);
@@ -426,35 +563,23 @@ void StagesSubject::stageChanged(
         Ufe::Path ufePath;
         UsdPrim   prim;
         if (changedPath == SdfPath::AbsoluteRootPath()) {
-            ufePath = stagePath(sender);
+            ufePath = stageUfePath;
             prim = stage->GetPseudoRoot();
         } else {
             const std::string& usdPrimPathStr = changedPath.GetPrimPath().GetString();
-            ufePath = stagePath(sender)
-                + Ufe::PathSegment(usdPrimPathStr, UsdUfe::getUsdRunTimeId(), '/');
+            ufePath
+                = stageUfePath + Ufe::PathSegment(usdPrimPathStr, UsdUfe::getUsdRunTimeId(), '/');
             prim = stage->GetPrimAtPath(changedPath);
         }
 
         if (prim.IsValid() && !InPathChange::inPathChange()) {
-            auto sceneItem = Ufe::Hierarchy::createItem(ufePath);
-
-            // AL LayerCommands.addSubLayer test will cause crash
-            // if we don't filter invalid sceneItems. This patch is provided
-            // to prevent crashes, but more investigation will have to be
-            // done to understand why ufePath in case of sub layer
-            // creation causes Ufe::Hierarchy::createItem to fail.
-            if (!sceneItem)
-                continue;
-
 #ifndef MAYA_ENABLE_NEW_PRIM_DELETE
             // Special case when we know the operation came from either
             // the add or delete of our UFE/USD implementation.
             if (InAddOrDeleteOperation::inAddOrDeleteOperation()) {
-                if (prim.IsActive()) {
-                    sendObjectAdd(sceneItem);
-                } else {
-                    sendObjectPostDelete(sceneItem);
-                }
+                sceneNotifications.push_back(
+                    { ufePath,
+                      prim.IsActive() ? SceneChangeType::kAdded : SceneChangeType::kPostDeleted });
             } else {
 #endif
                 // Use the entry flags in the USD notice to know what operation was performed and
@@ -463,7 +588,7 @@ void StagesSubject::stageChanged(
                 bool                                            sentNotif { false };
                 for (const auto& entry : entries) {
                     if (entry->flags.didAddInertPrim || entry->flags.didAddNonInertPrim) {
-                        sendObjectAdd(sceneItem);
+                        sceneNotifications.push_back({ ufePath, SceneChangeType::kAdded });
                         sentNotif = true;
                         break;
                     }
@@ -481,11 +606,10 @@ void StagesSubject::stageChanged(
 
                     // Special case for "active" metadata.
                     if (entry->HasInfoChange(SdfFieldKeys->Active)) {
-                        if (prim.IsActive()) {
-                            sendObjectAdd(sceneItem);
-                        } else {
-                            sendObjectPostDelete(sceneItem);
-                        }
+                        sceneNotifications.push_back(
+                            { ufePath,
+                              prim.IsActive() ? SceneChangeType::kAdded
+                                              : SceneChangeType::kPostDeleted });
                         sentNotif = true;
                         break;
                     }
@@ -495,28 +619,30 @@ void StagesSubject::stageChanged(
                     // According to USD docs for GetResyncedPaths():
                     // - Resyncs imply entire subtree invalidation of all descendant prims and
                     // properties. So we send the UFE subtree invalidate notif.
-                    sendSubtreeInvalidate(sceneItem);
+                    sceneNotifications.push_back({ ufePath, SceneChangeType::kSubtreeInvalidated });
                 }
 #ifndef MAYA_ENABLE_NEW_PRIM_DELETE
             }
 #endif
         } else if (!prim.IsValid() && !InPathChange::inPathChange()) {
-            Ufe::SceneItem::Ptr sceneItem = Ufe::Hierarchy::createItem(ufePath);
-            if (!sceneItem || InAddOrDeleteOperation::inAddOrDeleteOperation()) {
-                sendObjectDestroyed(ufePath);
-            } else {
-                sendSubtreeInvalidate(sceneItem);
-            }
+            sceneNotifications.push_back(
+                { ufePath,
+                  InAddOrDeleteOperation::inAddOrDeleteOperation() ? SceneChangeType::kDestroyed
+                                                                   : SceneChangeType::kRemoved });
         }
     }
 
+    if (!inSceneChangedNotificationGuard()) {
+        sendSceneChangedNotifications(noticeSceneNotifications);
+    }
+
     auto changedInfoOnlyPaths = notice.GetChangedInfoOnlyPaths();
     for (auto it = changedInfoOnlyPaths.begin(), end = changedInfoOnlyPaths.end(); it != end;
          ++it) {
         const auto& changedPath = *it;
         auto        usdPrimPathStr = changedPath.GetPrimPath().GetString();
         auto        ufePath
-            = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, UsdUfe::getUsdRunTimeId(), '/');
+            = stageUfePath + Ufe::PathSegment(usdPrimPathStr, UsdUfe::getUsdRunTimeId(), '/');
 
         bool sendValueChangedFallback = true;
 
@@ -572,7 +698,7 @@ void StagesSubject::stageChanged(
                         : std::numeric_limits<int>::max();
 
                     for (int instanceIndex = 0; instanceIndex < numIndices; ++instanceIndex) {
-                        const Ufe::Path instanceUfePath = stagePath(sender)
+                        const Ufe::Path instanceUfePath = stageUfePath
                             + usdPathToUfePathSegment(changedPath.GetPrimPath(), instanceIndex);
                         notifyWithoutExceptions<Ufe::Transform3d>(instanceUfePath);
                     }
@@ -600,8 +726,7 @@ void StagesSubject::stageChanged(
 
     // Special case when we are notified, but no paths given.
     if (notice.GetResyncedPaths().empty() && notice.GetChangedInfoOnlyPaths().empty()) {
-        auto                       ufePath = stagePath(sender);
-        Ufe::AttributeValueChanged vc(ufePath, "/");
+        Ufe::AttributeValueChanged vc(stageUfePath, "/");
         notifyWithoutExceptions<Ufe::Attributes>(vc);
     }
 }
@@ -616,39 +741,43 @@ void StagesSubject::stageEditTargetChanged(
 
 void StagesSubject::sendObjectAdd(const Ufe::SceneItem::Ptr& sceneItem) const
 {
-    try {
-        Ufe::Scene::instance().notify(Ufe::ObjectAdd(sceneItem));
-    } catch (const std::exception& ex) {
-        TF_WARN("Caught error during notification: %s", ex.what());
-    }
+    notifySceneWithoutExceptions(Ufe::ObjectAdd(sceneItem));
 }
 
 void StagesSubject::sendObjectPostDelete(const Ufe::SceneItem::Ptr& sceneItem) const
 {
-    try {
-        Ufe::Scene::instance().notify(Ufe::ObjectPostDelete(sceneItem));
-    } catch (const std::exception& ex) {
-        TF_WARN("Caught error during notification: %s", ex.what());
-    }
+    notifySceneWithoutExceptions(Ufe::ObjectPostDelete(sceneItem));
 }
 
 void StagesSubject::sendObjectDestroyed(const Ufe::Path& ufePath) const
 {
-    try {
-        Ufe::Scene::instance().notify(Ufe::ObjectDestroyed(ufePath));
-    } catch (const std::exception& ex) {
-        TF_WARN("Caught error during notification: %s", ex.what());
-    }
+    notifySceneWithoutExceptions(Ufe::ObjectDestroyed(ufePath));
 }
 
 void StagesSubject::sendSubtreeInvalidate(const Ufe::SceneItem::Ptr& sceneItem) const
 {
-    try {
-        Ufe::Scene::instance().notify(Ufe::SubtreeInvalidate(sceneItem));
-    } catch (const std::exception& ex) {
-        TF_WARN("Caught error during notification: %s", ex.what());
+    notifySceneWithoutExceptions(Ufe::SubtreeInvalidate(sceneItem));
+}
+
+SceneChangedNotificationGuard::SceneChangedNotificationGuard()
+{
+    ++sceneChangedNotificationGuardCount;
+}
+
+SceneChangedNotificationGuard::~SceneChangedNotificationGuard()
+{
+    if (--sceneChangedNotificationGuardCount < 0) {
+        TF_CODING_ERROR("Corrupt scene changed notification guard.");
+        sceneChangedNotificationGuardCount = 0;
     }
+
+    if (sceneChangedNotificationGuardCount.load() > 0) {
+        return;
+    }
+
+    sendSceneChangedNotifications(pendingSceneChangedNotifications);
 }
+
 AttributeChangedNotificationGuard::AttributeChangedNotificationGuard()
 {
     if (inAttributeChangedNotificationGuard()) {
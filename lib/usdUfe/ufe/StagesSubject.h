@@ -87,6 +87,35 @@ protected:
 
 }; // StagesSubject
 
+//! \brief Guard to batch scene changed notifications.
+/*!
+        Instantiating an object of this class delays the scene changed
+        notifications (object added, deleted, destroyed and subtree
+        invalidated) until the outermost guard expires.
+
+        The pending notifications are then collapsed: only the last
+        notification of a given UFE path is sent, and notifications for
+        descendants of an added or removed path are dropped since observers
+        refresh or discard the whole subtree of that ancestor.  Descendants
+        of a path that is only invalidated are still notified.  This is
+        desirable around edits that resync large parts of a stage, such as
+        loading payloads, switching variants or activating many prims.
+
+        Guards can be nested.
+ */
+class USDUFE_PUBLIC SceneChangedNotificationGuard
+{
+public:
+    SceneChangedNotificationGuard();
+    ~SceneChangedNotificationGuard();
+
+    //@{
+    //! Cannot be copied or assigned.
+    SceneChangedNotificationGuard(const SceneChangedNotificationGuard&) = delete;
+    const SceneChangedNotificationGuard& operator&(const SceneChangedNotificationGuard&) = delete;
+    //@}
+};
+
 //! \brief Guard to delay attribute changed notifications.
 /*!
         Instantiating an object of this class allows the attribute changed
@@ -19,6 +19,7 @@
 
 #include <usdUfe/ufe/Global.h>
 #include <usdUfe/ufe/SetVariantSelectionCommand.h>
+#include <usdUfe/ufe/StagesSubject.h>
 #include <usdUfe/ufe/UsdObject3dHandler.h>
 #include <usdUfe/ufe/UsdSceneItem.h>
 #include <usdUfe/ufe/UsdUndoAddNewPrimCommand.h>
@@ -237,6 +238,34 @@ getConcretePrimTypes(bool sorted, const UsdContextOps::SchemaNameMap& schemaPlug
     return groups;
 }
 
+// Composite command for the bulk edits, batching the scene changed notifications of all its
+// commands into a single collapsed set of notifications.
+class BatchedCompositeUndoableCommand : public Ufe::CompositeUndoableCommand
+{
+public:
+    typedef Ufe::CompositeUndoableCommand Parent;
+
+    using Parent::Parent;
+
+    void execute() override
+    {
+        UsdUfe::SceneChangedNotificationGuard guard;
+        Parent::execute();
+    }
+
+    void undo() override
+    {
+        UsdUfe::SceneChangedNotificationGuard guard;
+        Parent::undo();
+    }
+
+    void redo() override
+    {
+        UsdUfe::SceneChangedNotificationGuard guard;
+        Parent::redo();
+    }
+};
+
 } // namespace
 
 namespace USDUFE_NS_DEF {
@@ -626,7 +655,7 @@ Ufe::UndoableCommand::Ptr UsdContextOps::doBulkOpCmd(const ItemPath& itemPath)
 
     auto compositeCmdReturn = [&cmdList](const Ufe::Selection& bulkItems) {
         DEBUG_OUTPUT(bulkItems);
-        return !cmdList.empty() ? std::make_shared<Ufe::CompositeUndoableCommand>(cmdList)
+        return !cmdList.empty() ? std::make_shared<BatchedCompositeUndoableCommand>(cmdList)
                                 : nullptr;
     };
 
@@ -15,6 +15,7 @@
 //
 #include "UsdUndoPayloadCommand.h"
 
+#include <usdUfe/ufe/StagesSubject.h>
 #include <usdUfe/ufe/Utils.h>
 
 namespace USDUFE_NS_DEF {
@@ -50,6 +51,8 @@ void UsdUndoLoadUnloadBaseCommand::doLoad() const
     if (!_stage)
         return;
 
+    // Loading a payload can resync a large number of prims.
+    SceneChangedNotificationGuard guard;
     _stage->Load(_primPath, _policy);
     saveModifiedLoadRules();
 }
@@ -59,6 +62,7 @@ void UsdUndoLoadUnloadBaseCommand::doUnload() const
     if (!_stage)
         return;
 
+    SceneChangedNotificationGuard guard;
     _stage->Unload(_primPath);
     saveModifiedLoadRules();
 }
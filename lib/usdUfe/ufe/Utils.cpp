@@ -31,7 +31,9 @@
 #include <ufe/selection.h>
 
 #include <cctype>
+#include <mutex>
 #include <regex>
+#include <unordered_map>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -100,6 +102,27 @@ UsdUfe::UniqueChildNameFn    gUniqueChildNameFn = nullptr;
 UsdUfe::WaitCursorFn         gStartWaitCursorFn = nullptr;
 UsdUfe::WaitCursorFn         gStopWaitCursorFn = nullptr;
 
+// Selection, notifications and attribute queries convert the same paths between UFE and USD
+// over and over, and each conversion otherwise builds and parses path strings. Both directions
+// are cached, until the caches grow too large or the DCC clears them.
+constexpr size_t kMaxCachedPathConversions = 100000;
+
+struct PathConversionCaches
+{
+    std::mutex                                                   mutex;
+    Ufe::Rtid                                                    rtid { 0 };
+    std::unordered_map<SdfPath, Ufe::PathSegment, SdfPath::Hash> usdToUfe;
+    std::unordered_map<Ufe::Path, SdfPath>                       ufeToUsd;
+    size_t                                                       numHits { 0 };
+    size_t                                                       numMisses { 0 };
+};
+
+PathConversionCaches& pathConversionCaches()
+{
+    static PathConversionCaches caches;
+    return caches;
+}
+
 } // anonymous namespace
 
 namespace USDUFE_NS_DEF {
@@ -150,18 +173,40 @@ Ufe::PathSegment usdPathToUfePathSegment(const SdfPath& usdPath, int instanceInd
         return Ufe::PathSegment(Ufe::PathSegment::Components(), usdRuntimeId, separator);
     }
 
-    std::string pathString = usdPath.GetString();
+    // Point instance paths are not cached, there can be too many of them.
+    if (instanceIndex < 0) {
+        PathConversionCaches&       caches = pathConversionCaches();
+        std::lock_guard<std::mutex> lock(caches.mutex);
+        if (caches.rtid != usdRuntimeId) {
+            caches.usdToUfe.clear();
+            caches.ufeToUsd.clear();
+            caches.rtid = usdRuntimeId;
+        }
+
+        auto found = caches.usdToUfe.find(usdPath);
+        if (found != caches.usdToUfe.end()) {
+            ++caches.numHits;
+            return found->second;
+        }
 
-    if (instanceIndex >= 0) {
-        // Note here that we're taking advantage of the fact that identifiers
-        // in SdfPaths must be C/Python identifiers; that is, they must *not*
-        // begin with a digit. This means that when we see a path component at
-        // the end of a USD path segment that does begin with a digit, we can
-        // be sure that it represents an instance index and not a prim or other
-        // USD entity.
-        pathString += TfStringPrintf("%c%d", separator, instanceIndex);
+        ++caches.numMisses;
+        if (caches.usdToUfe.size() >= kMaxCachedPathConversions) {
+            caches.usdToUfe.clear();
+        }
+        return caches.usdToUfe
+            .emplace(usdPath, Ufe::PathSegment(usdPath.GetString(), usdRuntimeId, separator))
+            .first->second;
     }
 
+    // Note here that we're taking advantage of the fact that identifiers
+    // in SdfPaths must be C/Python identifiers; that is, they must *not*
+    // begin with a digit. This means that when we see a path component at
+    // the end of a USD path segment that does begin with a digit, we can
+    // be sure that it represents an instance index and not a prim or other
+    // USD entity.
+    const std::string pathString
+        = usdPath.GetString() + TfStringPrintf("%c%d", separator, instanceIndex);
+
     return Ufe::PathSegment(pathString, usdRuntimeId, separator);
 }
 
@@ -200,6 +245,52 @@ UsdPrim ufePathToPrim(const Ufe::Path& path)
     return gUfePathToPrimFn(path);
 }
 
+SdfPath ufePathToSdfPrimPath(const Ufe::Path& path)
+{
+    const Ufe::Path::Segments& segments = path.getSegments();
+    if (segments.size() < 2u) {
+        return SdfPath();
+    }
+
+    PathConversionCaches&       caches = pathConversionCaches();
+    std::lock_guard<std::mutex> lock(caches.mutex);
+
+    auto found = caches.ufeToUsd.find(path);
+    if (found != caches.ufeToUsd.end()) {
+        ++caches.numHits;
+        return found->second;
+    }
+
+    ++caches.numMisses;
+    if (caches.ufeToUsd.size() >= kMaxCachedPathConversions) {
+        caches.ufeToUsd.clear();
+    }
+    const Ufe::Path primPath = stripInstanceIndexFromUfePath(path);
+    return caches.ufeToUsd.emplace(path, SdfPath(primPath.getSegments()[1].string()).GetPrimPath())
+        .first->second;
+}
+
+void clearPathConversionCaches()
+{
+    PathConversionCaches&       caches = pathConversionCaches();
+    std::lock_guard<std::mutex> lock(caches.mutex);
+    caches.usdToUfe.clear();
+    caches.ufeToUsd.clear();
+}
+
+PathConversionStatistics getPathConversionStatistics()
+{
+    PathConversionCaches&       caches = pathConversionCaches();
+    std::lock_guard<std::mutex> lock(caches.mutex);
+
+    PathConversionStatistics stats;
+    stats.numUsdToUfeEntries = caches.usdToUfe.size();
+    stats.numUfeToUsdEntries = caches.ufeToUsd.size();
+    stats.numHits = caches.numHits;
+    stats.numMisses = caches.numMisses;
+    return stats;
+}
+
 void setTimeAccessorFn(TimeAccessorFn fn)
 {
     if (nullptr == fn) {
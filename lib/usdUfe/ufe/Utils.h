@@ -102,6 +102,31 @@ void setUfePathToPrimFn(UfePathToPrimFn fn);
 USDUFE_PUBLIC
 PXR_NS::UsdPrim ufePathToPrim(const Ufe::Path& path);
 
+//! Return the USD path of the prim corresponding to the argument UFE path,
+//! ignoring any instance index and property at its tail.  The conversions are
+//! cached.  Returns an empty path if the UFE path has no USD segment.
+USDUFE_PUBLIC
+PXR_NS::SdfPath ufePathToSdfPrimPath(const Ufe::Path& path);
+
+//! Clear the caches of the conversions between UFE and USD paths.  Called by
+//! the DCC when the paths of its stages change.
+USDUFE_PUBLIC
+void clearPathConversionCaches();
+
+//! Sizes of the caches of the conversions between UFE and USD paths, and the
+//! number of conversions found in them or added to them since the start.
+struct PathConversionStatistics
+{
+    size_t numUsdToUfeEntries = 0;
+    size_t numUfeToUsdEntries = 0;
+    size_t numHits = 0;
+    size_t numMisses = 0;
+};
+
+//! Return the statistics of the caches of the conversions between UFE and USD paths.
+USDUFE_PUBLIC
+PathConversionStatistics getPathConversionStatistics();
+
 //! Set the DCC specific time accessor function.
 //! It cannot be empty.
 //! \excpection std::invalid_argument if fn is empty.
@@ -0,0 +1,138 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "UsdUndoJournal.h"
+
+#include <usdUfe/undo/UsdUndoStateDelegate.h>
+
+#include <pxr/base/tf/type.h>
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/sdf/valueTypeName.h>
+
+#include <functional>
+#include <string>
+
+namespace USDUFE_NS_DEF {
+
+namespace {
+
+void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+bool UsdUndoJournal::Key::operator==(const Key& other) const
+{
+    return type == other.type && delegate == other.delegate && path == other.path
+        && fieldName == other.fieldName && token == other.token && time == other.time;
+}
+
+size_t UsdUndoJournal::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = key.path.GetHash();
+    hashCombine(hash, key.fieldName.Hash());
+    hashCombine(hash, key.token.Hash());
+    hashCombine(hash, std::hash<double>()(key.time));
+    hashCombine(hash, std::hash<const void*>()(key.delegate));
+    hashCombine(hash, static_cast<size_t>(key.type));
+    return hash;
+}
+
+void UsdUndoJournal::add(Edit&& edit)
+{
+    switch (edit.type) {
+    case EditType::SetField:
+    case EditType::SetFieldDictValueByKey:
+    case EditType::SetTimeSample: {
+        // inverting the first edit restores the value anyway, the following ones would only
+        // restore intermediate values.
+        Key key { edit.type, edit.delegate, edit.path, edit.fieldName, edit.token, edit.time };
+        if (!_coalescingKeys.insert(std::move(key)).second) {
+            ++_coalescedCount;
+            return;
+        }
+        break;
+    }
+    default:
+        // the spec at a path may be moved or replaced by structural edits, in which case the
+        // following edits at that path do not target the same spec anymore.
+        _coalescingKeys.clear();
+        break;
+    }
+
+    _memory += sizeof(Edit) + edit.memory + estimateMemory(edit.value);
+    _edits.push_back(std::move(edit));
+}
+
+void UsdUndoJournal::invert() const
+{
+    // invert the edits in reverse order
+    for (auto it = _edits.rbegin(); it != _edits.rend(); ++it) {
+        it->delegate->invertEdit(*it);
+    }
+}
+
+void UsdUndoJournal::close() { std::unordered_set<Key, KeyHash>().swap(_coalescingKeys); }
+
+void UsdUndoJournal::trim()
+{
+    std::deque<Edit>().swap(_edits);
+    close();
+    _memory = 0;
+    _trimmed = true;
+}
+
+size_t UsdUndoJournal::estimateMemory(const VtValue& value)
+{
+    if (value.IsEmpty()) {
+        return 0;
+    }
+
+    if (value.IsArrayValued()) {
+        const SdfValueTypeName typeName = SdfSchema::GetInstance().FindType(value);
+        const size_t           elementSize
+            = typeName ? typeName.GetScalarType().GetType().GetSizeof() : sizeof(VtValue);
+        return value.GetArraySize() * elementSize;
+    }
+
+    if (value.IsHolding<SdfTimeSampleMap>()) {
+        size_t memory = 0;
+        for (const auto& sample : value.UncheckedGet<SdfTimeSampleMap>()) {
+            memory += sizeof(sample) + estimateMemory(sample.second);
+        }
+        return memory;
+    }
+
+    if (value.IsHolding<VtDictionary>()) {
+        size_t memory = 0;
+        for (const auto& entry : value.UncheckedGet<VtDictionary>()) {
+            memory += sizeof(entry) + entry.first.capacity() + estimateMemory(entry.second);
+        }
+        return memory;
+    }
+
+    if (value.IsHolding<std::string>()) {
+        return value.UncheckedGet<std::string>().capacity();
+    }
+
+    // other values are either stored in place or shared, like tokens and paths.
+    return 0;
+}
+
+} // namespace USDUFE_NS_DEF
@@ -0,0 +1,134 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef USDUFE_UNDO_UNDOJOURNAL_H
+#define USDUFE_UNDO_UNDOJOURNAL_H
+
+#include <usdUfe/base/api.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/usd/sdf/data.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/types.h>
+
+#include <cstddef>
+#include <deque>
+#include <unordered_set>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace USDUFE_NS_DEF {
+
+class UsdUndoStateDelegate;
+
+//! \brief UsdUndoJournal
+/*!
+    This class stores the inverse of the edits made to layers inside an UsdUndoBlock.
+
+    Edits are stored as plain records rather than closures. Repeated edits to the same
+    field, dictionary key or time sample of a spec within a block are coalesced: only the
+    first one is kept since it holds the value to restore.
+*/
+class USDUFE_PUBLIC UsdUndoJournal
+{
+public:
+    enum class EditType
+    {
+        SetField,
+        SetFieldDictValueByKey,
+        SetTimeSample,
+        CreateSpec,
+        DeleteSpec,
+        MoveSpec,
+        PushTokenChild,
+        PushPathChild,
+        PopTokenChild,
+        PopPathChild
+    };
+
+    //! \brief The inverse of a single edit.
+    struct Edit
+    {
+        EditType              type { EditType::SetField };
+        UsdUndoStateDelegate* delegate { nullptr };
+        SdfPath               path;
+        SdfPath               otherPath; // new path of moves, path children
+        TfToken               fieldName;
+        TfToken               token; // dictionary key path, token children
+        double                time { 0.0 };
+        bool                  inert { false };
+        SdfSpecType           specType { SdfSpecTypeUnknown };
+        VtValue               value;
+        SdfDataRefPtr         deletedData;
+        size_t                memory { 0 }; // memory held outside of the value
+    };
+
+    UsdUndoJournal() = default;
+    ~UsdUndoJournal() = default;
+
+    UsdUndoJournal(const UsdUndoJournal&) = delete;
+    UsdUndoJournal& operator=(const UsdUndoJournal&) = delete;
+
+    // adds an edit, unless a previous edit already restores the same value.
+    void add(Edit&& edit);
+
+    // applies the edits in reverse order.
+    void invert() const;
+
+    // stops coalescing edits and releases the memory used to do so.
+    void close();
+
+    // releases all the edits, which will not be inverted anymore.
+    void trim();
+
+    bool   empty() const { return _edits.empty(); }
+    size_t size() const { return _edits.size(); }
+    size_t coalescedCount() const { return _coalescedCount; }
+    size_t memoryUsage() const { return _memory; }
+    bool   isTrimmed() const { return _trimmed; }
+
+    // returns an estimate of the memory held by the given value.
+    static size_t estimateMemory(const VtValue& value);
+
+private:
+    struct Key
+    {
+        bool operator==(const Key& other) const;
+
+        EditType                    type;
+        const UsdUndoStateDelegate* delegate;
+        SdfPath                     path;
+        TfToken                     fieldName;
+        TfToken                     token;
+        double                      time;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    std::deque<Edit>                 _edits;
+    std::unordered_set<Key, KeyHash> _coalescingKeys;
+    size_t                           _coalescedCount { 0 };
+    size_t                           _memory { 0 };
+    bool                             _trimmed { false };
+};
+
+} // namespace USDUFE_NS_DEF
+
+#endif // USDUFE_UNDO_UNDOJOURNAL_H
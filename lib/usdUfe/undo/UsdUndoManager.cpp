@@ -16,13 +16,32 @@
 
 #include "UsdUndoManager.h"
 
+#include <usdUfe/base/debugCodes.h>
 #include <usdUfe/undo/UsdUndoBlock.h>
 #include <usdUfe/undo/UsdUndoStateDelegate.h>
 
-PXR_NAMESPACE_USING_DIRECTIVE
+#include <pxr/base/tf/envSetting.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(
+    USDUFE_UNDO_MEMORY_BUDGET,
+    0,
+    "Memory that the undo information of USD edits can use, in megabytes. When it is exceeded, "
+    "the undo information of the oldest operations is discarded. Set to 0 for no limit.");
+
+PXR_NAMESPACE_CLOSE_SCOPE
 
 namespace USDUFE_NS_DEF {
 
+UsdUndoManager::UsdUndoManager()
+    : _memoryBudget(static_cast<size_t>(std::max(TfGetEnvSetting(USDUFE_UNDO_MEMORY_BUDGET), 0))
+                    * 1024 * 1024)
+{
+}
+
 UsdUndoManager& UsdUndoManager::instance()
 {
     static UsdUndoManager undoManager;
@@ -40,20 +59,91 @@ void UsdUndoManager::trackLayerStates(const SdfLayerHandle& layer)
     }
 }
 
-void UsdUndoManager::addInverse(UsdUndoableItem::InvertFunc func)
+void UsdUndoManager::setMemoryBudget(size_t budget)
+{
+    _memoryBudget = budget;
+    trimToBudget();
+}
+
+size_t UsdUndoManager::memoryUsage()
+{
+    size_t memory = 0;
+    for (const auto& journal : _transferredJournals) {
+        if (auto alive = journal.lock()) {
+            memory += alive->memoryUsage();
+        }
+    }
+    return memory;
+}
+
+void UsdUndoManager::addEdit(UsdUndoJournal::Edit&& edit)
 {
     if (UsdUndoBlock::depth() == 0) {
         TF_CODING_ERROR("Collecting invert functions outside of undoblock is not allowed!");
         return;
     }
 
-    _invertFuncs.emplace_back(func);
+    if (!_journal) {
+        _journal = std::make_shared<UsdUndoJournal>();
+    }
+    _journal->add(std::move(edit));
 }
 
 void UsdUndoManager::transferEdits(UsdUndoableItem& undoableItem)
 {
     // transfer the edits
-    undoableItem._invertFuncs = std::move(_invertFuncs);
+    undoableItem._journal = std::move(_journal);
+    _journal.reset();
+
+    if (!undoableItem._journal) {
+        return;
+    }
+
+    undoableItem._journal->close();
+
+    TF_DEBUG_MSG(
+        USDUFE_UNDOSTACK,
+        "Transferring %zu edits (%zu coalesced) using %zu bytes.\n",
+        undoableItem._journal->size(),
+        undoableItem._journal->coalescedCount(),
+        undoableItem._journal->memoryUsage());
+
+    if (_memoryBudget > 0) {
+        _transferredJournals.push_back(undoableItem._journal);
+        trimToBudget();
+    }
+}
+
+void UsdUndoManager::trimToBudget()
+{
+    // forget the journals of the items that were destroyed
+    _transferredJournals.erase(
+        std::remove_if(
+            _transferredJournals.begin(),
+            _transferredJournals.end(),
+            [](const std::weak_ptr<UsdUndoJournal>& journal) { return journal.expired(); }),
+        _transferredJournals.end());
+
+    if (_memoryBudget == 0) {
+        _transferredJournals.clear();
+        return;
+    }
+
+    // the newest journal is always kept, so that the last operation can be undone
+    size_t memory = memoryUsage();
+    while (memory > _memoryBudget && _transferredJournals.size() > 1) {
+        if (auto oldest = _transferredJournals.front().lock()) {
+            TF_DEBUG_MSG(
+                USDUFE_UNDOSTACK,
+                "Discarding %zu edits using %zu bytes to respect the undo memory budget.\n",
+                oldest->size(),
+                oldest->memoryUsage());
+
+            memory -= oldest->memoryUsage();
+            oldest->trim();
+        }
+        _transferredJournals.pop_front();
+    }
 }
 
 } // namespace USDUFE_NS_DEF
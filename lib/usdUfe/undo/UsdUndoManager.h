@@ -18,12 +18,15 @@
 #define USDUFE_UNDO_UNDOMANAGER_H
 
 #include <usdUfe/base/api.h>
+#include <usdUfe/undo/UsdUndoJournal.h>
 #include <usdUfe/undo/UsdUndoableItem.h>
 
 #include <pxr/usd/sdf/layer.h>
 
-#include <functional>
-#include <vector>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <utility>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -33,8 +36,9 @@ namespace USDUFE_NS_DEF {
 /*!
     The UndoManager is responsible for :
     1- tracking layer state changes from UsdUndoStateDelegate
-    2- collecting InvertFunc() in every state change
+    2- collecting the inverse of every state change in an UsdUndoJournal
     3- transferring collected edits into an UsdUndoableItem
+    4- trimming the oldest UsdUndoableItem when their edits exceed the memory budget
 */
 class USDUFE_PUBLIC UsdUndoManager
 {
@@ -51,21 +55,36 @@ public:
     // tracks layer states by spawning a new UsdUndoStateDelegate
     void trackLayerStates(const SdfLayerHandle& layer);
 
+    // sets the memory that the edits of the UsdUndoableItem can use, in bytes. When it is
+    // exceeded, the edits of the oldest items are discarded. Zero means no limit.
+    // Defaults to the USDUFE_UNDO_MEMORY_BUDGET environment variable, in megabytes.
+    void   setMemoryBudget(size_t budget);
+    size_t memoryBudget() const { return _memoryBudget; }
+
+    // returns the memory used by the edits of the UsdUndoableItem that are still alive,
+    // in bytes. Only tracked when there is a memory budget.
+    size_t memoryUsage();
+
 private:
     friend class UsdUndoManagerAccessor;
 
-    UsdUndoManager() = default;
+    UsdUndoManager();
     ~UsdUndoManager() = default;
 
-    void addInverse(UsdUndoableItem::InvertFunc func);
+    void addEdit(UsdUndoJournal::Edit&& edit);
     void transferEdits(UsdUndoableItem& undoableItem);
+    void trimToBudget();
 
 private:
-    UsdUndoableItem::InvertFuncs _invertFuncs;
+    std::shared_ptr<UsdUndoJournal> _journal;
+
+    // the journals transferred to UsdUndoableItem, oldest first.
+    std::deque<std::weak_ptr<UsdUndoJournal>> _transferredJournals;
+    size_t                                    _memoryBudget;
 };
 
 //! \brief Helper struct which exists only to provide controlled,
-//!        deliberate access to UsdUndoManager addInverse/transferEdits
+//!        deliberate access to UsdUndoManager addEdit/transferEdits
 //!        private methods.
 class USDUFE_PUBLIC UsdUndoManagerAccessor
 {
@@ -78,10 +97,10 @@ public:
     UsdUndoManagerAccessor(UsdUndoManagerAccessor&&) = delete;
     UsdUndoManagerAccessor& operator=(UsdUndoManagerAccessor&&) = delete;
 
-    static void addInverse(UsdUndoableItem::InvertFunc func)
+    static void addEdit(UsdUndoJournal::Edit&& edit)
     {
         auto& undoManager = UsdUfe::UsdUndoManager::instance();
-        undoManager.addInverse(func);
+        undoManager.addEdit(std::move(edit));
     }
     static void transferEdits(UsdUndoableItem& undoableItem)
     {
@@ -23,7 +23,11 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace {
 
-void copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfPath& path)
+using Edit = UsdUfe::UsdUndoJournal::Edit;
+using EditType = UsdUfe::UsdUndoJournal::EditType;
+
+// returns an estimate of the memory used by the copy.
+size_t copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfPath& path)
 {
     // create a new spec at a path with the given specType
     dst->CreateSpec(path, src.GetSpecType(path));
@@ -32,9 +36,13 @@ void copySpecAtPath(const SdfAbstractData& src, SdfAbstractData* dst, const SdfP
     const std::vector<TfToken>& tokens = src.List(path);
 
     // set the value of dst at the given path and a fieldName
+    size_t memory = 0;
     for (const auto& token : tokens) {
-        dst->Set(path, token, src.Get(path, token));
+        const VtValue value = src.Get(path, token);
+        memory += sizeof(VtValue) + UsdUfe::UsdUndoJournal::estimateMemory(value);
+        dst->Set(path, token, value);
     }
+    return memory;
 }
 
 // This class is used to copy specs from source SdfAbstractData container
@@ -96,6 +104,32 @@ void UsdUndoStateDelegate::_OnSetLayer(const SdfLayerHandle& layer)
     }
 }
 
+void UsdUndoStateDelegate::invertEdit(const UsdUndoJournal::Edit& edit)
+{
+    switch (edit.type) {
+    case EditType::SetField: invertSetField(edit.path, edit.fieldName, edit.value); break;
+    case EditType::SetFieldDictValueByKey:
+        invertSetFieldDictValueByKey(edit.path, edit.fieldName, edit.token, edit.value);
+        break;
+    case EditType::SetTimeSample: invertSetTimeSample(edit.path, edit.time, edit.value); break;
+    case EditType::CreateSpec: invertCreateSpec(edit.path, edit.inert); break;
+    case EditType::DeleteSpec:
+        invertDeleteSpec(edit.path, edit.inert, edit.specType, edit.deletedData);
+        break;
+    case EditType::MoveSpec: invertMoveSpec(edit.path, edit.otherPath); break;
+    case EditType::PushTokenChild:
+        invertPushTokenChild(edit.path, edit.fieldName, edit.token);
+        break;
+    case EditType::PushPathChild:
+        invertPushPathChild(edit.path, edit.fieldName, edit.otherPath);
+        break;
+    case EditType::PopTokenChild: invertPopTokenChild(edit.path, edit.fieldName, edit.token); break;
+    case EditType::PopPathChild:
+        invertPopPathChild(edit.path, edit.fieldName, edit.otherPath);
+        break;
+    }
+}
+
 void UsdUndoStateDelegate::invertSetField(
     const SdfPath& path,
     const TfToken& fieldName,
@@ -271,10 +305,13 @@ void UsdUndoStateDelegate::_OnSetField(
         return;
     }
 
-    const VtValue inverseValue = _layer->GetField(path, fieldName);
-
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+    Edit edit;
+    edit.type = EditType::SetField;
+    edit.delegate = this;
+    edit.path = path;
+    edit.fieldName = fieldName;
+    edit.value = _layer->GetField(path, fieldName);
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnSetField(
@@ -298,11 +335,14 @@ void UsdUndoStateDelegate::_OnSetField(
         return;
     }
 
-    const VtValue inverseValue = _layer->GetField(path, fieldName);
-
     // add invert
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertSetField, this, path, fieldName, inverseValue));
+    Edit edit;
+    edit.type = EditType::SetField;
+    edit.delegate = this;
+    edit.path = path;
+    edit.fieldName = fieldName;
+    edit.value = _layer->GetField(path, fieldName);
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnSetFieldDictValueByKey(
@@ -353,8 +393,12 @@ void UsdUndoStateDelegate::_OnCreateSpec(const SdfPath& path, SdfSpecType specTy
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertCreateSpec, this, path, inert));
+    Edit edit;
+    edit.type = EditType::CreateSpec;
+    edit.delegate = this;
+    edit.path = path;
+    edit.inert = inert;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnDeleteSpec(const SdfPath& path, bool inert)
@@ -374,19 +418,24 @@ void UsdUndoStateDelegate::_OnDeleteSpec(const SdfPath& path, bool inert)
         return;
     }
 
-    SdfDataRefPtr deletedData = TfCreateRefPtr(new SdfData());
+    Edit edit;
+    edit.type = EditType::DeleteSpec;
+    edit.delegate = this;
+    edit.path = path;
+    edit.inert = inert;
+    edit.deletedData = TfCreateRefPtr(new SdfData());
 
     // traverse the hierarchy and call copySpecAtPath on each spec
     auto layerDataPtr = std::cref(*get_pointer(_GetLayerData()));
-    auto deleteDataPtr = get_pointer(deletedData);
+    auto deleteDataPtr = get_pointer(edit.deletedData);
 
-    _GetLayer()->Traverse(
-        path, [&](const SdfPath& path) { copySpecAtPath(layerDataPtr, deleteDataPtr, path); });
+    _GetLayer()->Traverse(path, [&](const SdfPath& path) {
+        edit.memory += copySpecAtPath(layerDataPtr, deleteDataPtr, path);
+    });
 
-    const SdfSpecType deletedSpecType = _GetLayer()->GetSpecType(path);
+    edit.specType = _GetLayer()->GetSpecType(path);
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(std::bind(
-        &UsdUndoStateDelegate::invertDeleteSpec, this, path, inert, deletedSpecType, deletedData));
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnMoveSpec(const SdfPath& oldPath, const SdfPath& newPath)
@@ -407,8 +456,12 @@ void UsdUndoStateDelegate::_OnMoveSpec(const SdfPath& oldPath, const SdfPath& ne
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertMoveSpec, this, oldPath, newPath));
+    Edit edit;
+    edit.type = EditType::MoveSpec;
+    edit.delegate = this;
+    edit.path = oldPath;
+    edit.otherPath = newPath;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnPushChild(
@@ -432,8 +485,13 @@ void UsdUndoStateDelegate::_OnPushChild(
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertPushTokenChild, this, parentPath, fieldName, value));
+    Edit edit;
+    edit.type = EditType::PushTokenChild;
+    edit.delegate = this;
+    edit.path = parentPath;
+    edit.fieldName = fieldName;
+    edit.token = value;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnPushChild(
@@ -457,8 +515,13 @@ void UsdUndoStateDelegate::_OnPushChild(
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(
-        std::bind(&UsdUndoStateDelegate::invertPushPathChild, this, parentPath, fieldName, value));
+    Edit edit;
+    edit.type = EditType::PushPathChild;
+    edit.delegate = this;
+    edit.path = parentPath;
+    edit.fieldName = fieldName;
+    edit.otherPath = value;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnPopChild(
@@ -482,8 +545,13 @@ void UsdUndoStateDelegate::_OnPopChild(
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(std::bind(
-        &UsdUndoStateDelegate::invertPopTokenChild, this, parentPath, fieldName, oldValue));
+    Edit edit;
+    edit.type = EditType::PopTokenChild;
+    edit.delegate = this;
+    edit.path = parentPath;
+    edit.fieldName = fieldName;
+    edit.token = oldValue;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnPopChild(
@@ -507,8 +575,13 @@ void UsdUndoStateDelegate::_OnPopChild(
         return;
     }
 
-    UsdUfe::UsdUndoManagerAccessor::addInverse(std::bind(
-        &UsdUndoStateDelegate::invertPopPathChild, this, parentPath, fieldName, oldValue));
+    Edit edit;
+    edit.type = EditType::PopPathChild;
+    edit.delegate = this;
+    edit.path = parentPath;
+    edit.fieldName = fieldName;
+    edit.otherPath = oldValue;
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnSetFieldDictValueByKeyImpl(
@@ -536,15 +609,14 @@ void UsdUndoStateDelegate::_OnSetFieldDictValueByKeyImpl(
         return;
     }
 
-    const VtValue inverseValue = _layer->GetFieldDictValueByKey(path, fieldName, keyPath);
-
-    UsdUfe::UsdUndoManagerAccessor::addInverse(std::bind(
-        &UsdUndoStateDelegate::invertSetFieldDictValueByKey,
-        this,
-        path,
-        fieldName,
-        keyPath,
-        inverseValue));
+    Edit edit;
+    edit.type = EditType::SetFieldDictValueByKey;
+    edit.delegate = this;
+    edit.path = path;
+    edit.fieldName = fieldName;
+    edit.token = keyPath;
+    edit.value = _layer->GetFieldDictValueByKey(path, fieldName, keyPath);
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time)
@@ -559,22 +631,18 @@ void UsdUndoStateDelegate::_OnSetTimeSampleImpl(const SdfPath& path, double time
     TF_DEBUG(USDUFE_UNDOSTATEDELEGATE)
         .Msg("Setting time sample '%f' for spec '%s'\n", time, path.GetText());
 
+    Edit edit;
+    edit.delegate = this;
+    edit.path = path;
     if (!_GetLayer()->HasField(path, SdfFieldKeys->TimeSamples)) {
-        UsdUfe::UsdUndoManagerAccessor::addInverse(std::bind(
-            &UsdUndoStateDelegate::invertSetField,
-            this,
-            path,
-            SdfFieldKeys->TimeSamples,
-            VtValue()));
-
+        edit.type = EditType::SetField;
+        edit.fieldName = SdfFieldKeys->TimeSamples;
     } else {
-        VtValue oldValue;
-
-        _GetLayer()->QueryTimeSample(path, time, &oldValue);
-
-        UsdUfe::UsdUndoManagerAccessor::addInverse(
-            std::bind(&UsdUndoStateDelegate::invertSetTimeSample, this, path, time, oldValue));
+        edit.type = EditType::SetTimeSample;
+        edit.time = time;
+        _GetLayer()->QueryTimeSample(path, time, &edit.value);
     }
+    UsdUfe::UsdUndoManagerAccessor::addEdit(std::move(edit));
 }
 
 // We hit a wall when running testGroupCmd with the new Undo/Redo service.
@@ -18,6 +18,7 @@
 #define USDUFE_UNDO_UNDOSTATE_DELEGATE_H
 
 #include <usdUfe/base/api.h>
+#include <usdUfe/undo/UsdUndoJournal.h>
 
 #include <pxr/usd/sdf/data.h>
 #include <pxr/usd/sdf/layerStateDelegate.h>
@@ -35,8 +36,8 @@ TF_DECLARE_WEAK_AND_REF_PTRS(UsdUndoStateDelegate);
 /*!
     The state delegate is invoked on every authoring operation on a layer.
 
-    There exist exactly one invert function for every authoring operation. These invert functions
-   are collected by UsdUndoManager::addInverse() call which then will be transfered to an
+    There exist exactly one inverse edit for every authoring operation. These inverse edits
+   are collected by UsdUndoManager::addEdit() call which then will be transfered to an
    UsdUndoableItem object when UsdUndoBlock expires.
 */
 class USDUFE_PUBLIC UsdUndoStateDelegate : public SdfLayerStateDelegateBase
@@ -48,6 +49,10 @@ public:
     static UsdUndoStateDelegateRefPtr New();
 
 private:
+    friend class UsdUndoJournal;
+
+    void invertEdit(const UsdUndoJournal::Edit& edit);
+
     void invertSetField(const SdfPath& path, const TfToken& fieldName, const VtValue& inverse);
     void invertCreateSpec(const SdfPath& path, bool inert);
     void invertDeleteSpec(
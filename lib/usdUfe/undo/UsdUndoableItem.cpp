@@ -26,6 +26,8 @@ void UsdUndoableItem::undo() { doInvert(); }
 
 void UsdUndoableItem::redo() { doInvert(); }
 
+size_t UsdUndoableItem::memoryUsage() const { return _journal ? _journal->memoryUsage() : 0; }
+
 void UsdUndoableItem::doInvert()
 {
     if (UsdUndoBlock::depth() != 0) {
@@ -33,14 +35,19 @@ void UsdUndoableItem::doInvert()
                         "stack.");
     }
 
+    // keep the journal alive while the block replaces it with the inverse edits
+    const std::shared_ptr<UsdUndoJournal> journal = _journal;
+    if (journal && journal->isTrimmed()) {
+        TF_WARN("The undo information of this operation was discarded to respect the undo "
+                "memory budget.");
+    }
+
     UsdUndoBlock undoBlock(this);
 
-    // call invert functions in reverse order
-    {
+    // apply the inverse edits in reverse order
+    if (journal) {
         SdfChangeBlock changeBlock;
-        for (auto it = _invertFuncs.rbegin(); it != _invertFuncs.rend(); ++it) {
-            (*it)();
-        }
+        journal->invert();
     }
 }
 
@@ -18,23 +18,21 @@
 #define USDUFE_UNDO_UNDOABLE_ITEM_H
 
 #include <usdUfe/base/api.h>
+#include <usdUfe/undo/UsdUndoJournal.h>
 
-#include <functional>
-#include <vector>
+#include <cstddef>
+#include <memory>
 
 namespace USDUFE_NS_DEF {
 
 //! \brief UsdUndoableItem
 /*!
-    This class stores the list of inverse edit functions that are invoked
+    This class stores the journal of inverse edits that are applied
     on undo() / redo() call. This is the object that must be placed in DCC's undo stack.
 */
 class USDUFE_PUBLIC UsdUndoableItem
 {
 public:
-    using InvertFunc = std::function<void()>;
-    using InvertFuncs = std::vector<InvertFunc>;
-
     // default constructor/destructor
     UsdUndoableItem() = default;
     ~UsdUndoableItem() = default;
@@ -50,12 +48,17 @@ public:
     void undo();
     void redo();
 
+    // returns an estimate of the memory held by the inverse edits, in bytes.
+    size_t memoryUsage() const;
+
 private:
     friend class UsdUndoManager;
 
     void doInvert();
 
-    InvertFuncs _invertFuncs;
+    // shared by the copies of the item: a journal is not modified once transferred,
+    // except when it is trimmed to respect the memory budget.
+    std::shared_ptr<UsdUndoJournal> _journal;
 };
 
 } // namespace USDUFE_NS_DEF
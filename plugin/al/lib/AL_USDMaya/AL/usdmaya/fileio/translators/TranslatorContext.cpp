@@ -22,7 +22,11 @@
 #include <maya/MProfiler.h>
 #include <maya/MSelectionList.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace {
 const int _translatorContextProfilerCategory
@@ -44,6 +48,289 @@ bool isDescendantPath(const SdfPathSet& affectedPaths, const SdfPath& path)
     return false;
 }
 
+// The translator context is serialised in a binary format, encoded in base64 since it is stored in
+// a string attribute. Contexts that do not start with this header were serialised by older
+// versions as "path=translatorId,node[,createdNode...][,uniquekey:key];" entries.
+const std::string kBinaryFormatHeader("ALTrCtx1:");
+
+const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string encodeBase64(const std::string& data)
+{
+    std::string result;
+    result.reserve(((data.size() + 2) / 3) * 4);
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        const uint32_t bits = (uint32_t(uint8_t(data[i])) << 16)
+            | (uint32_t(uint8_t(data[i + 1])) << 8) | uint32_t(uint8_t(data[i + 2]));
+        result.push_back(kBase64Chars[(bits >> 18) & 0x3f]);
+        result.push_back(kBase64Chars[(bits >> 12) & 0x3f]);
+        result.push_back(kBase64Chars[(bits >> 6) & 0x3f]);
+        result.push_back(kBase64Chars[bits & 0x3f]);
+    }
+    if (i < data.size()) {
+        uint32_t bits = uint32_t(uint8_t(data[i])) << 16;
+        if (i + 1 < data.size()) {
+            bits |= uint32_t(uint8_t(data[i + 1])) << 8;
+        }
+        result.push_back(kBase64Chars[(bits >> 18) & 0x3f]);
+        result.push_back(kBase64Chars[(bits >> 12) & 0x3f]);
+        result.push_back(i + 1 < data.size() ? kBase64Chars[(bits >> 6) & 0x3f] : '=');
+        result.push_back('=');
+    }
+    return result;
+}
+
+bool decodeBase64(const char* begin, const char* end, std::string& data)
+{
+    int8_t values[256];
+    std::fill(values, values + 256, int8_t(-1));
+    for (int i = 0; i < 64; ++i) {
+        values[uint8_t(kBase64Chars[i])] = int8_t(i);
+    }
+
+    data.clear();
+    data.reserve(((end - begin) / 4) * 3);
+    uint32_t bits = 0;
+    int      bitCount = 0;
+    for (const char* c = begin; c != end && *c != '='; ++c) {
+        const int8_t value = values[uint8_t(*c)];
+        if (value < 0) {
+            return false;
+        }
+        bits = (bits << 6) | uint32_t(value);
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            data.push_back(char((bits >> bitCount) & 0xff));
+        }
+    }
+    return true;
+}
+
+void writeVarint(std::string& data, uint64_t value)
+{
+    while (value >= 0x80) {
+        data.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    data.push_back(char(value));
+}
+
+void writeString(std::string& data, const char* value, size_t length)
+{
+    writeVarint(data, length);
+    data.append(value, length);
+}
+
+/// reads the values written by writeVarint and writeString, failing on truncated data
+struct BinaryReader
+{
+    const char* current;
+    const char* end;
+    bool        valid;
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64 && current != end; shift += 7) {
+            const uint8_t byte = uint8_t(*current++);
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        valid = false;
+        return 0;
+    }
+
+    std::string readString()
+    {
+        const uint64_t length = readVarint();
+        if (!valid || length > uint64_t(end - current)) {
+            valid = false;
+            return std::string();
+        }
+        std::string value(current, length);
+        current += length;
+        return value;
+    }
+};
+
+/// a prim lookup as read from a serialised context, referencing nodes by their index plus one in
+/// the node names, zero being a null node
+struct SerialisedLookup
+{
+    SdfPath             path;
+    std::string         translatorId;
+    size_t              node = 0;
+    std::vector<size_t> createdNodes;
+    size_t              uniqueKey = 0;
+};
+
+struct NodeHash
+{
+    size_t operator()(const MObjectHandle& handle) const { return handle.hashCode(); }
+};
+
+bool readBinaryFormat(
+    const char*                    begin,
+    const char*                    end,
+    std::vector<std::string>&      nodeNames,
+    std::vector<SerialisedLookup>& lookups)
+{
+    std::string data;
+    if (!decodeBase64(begin, end, data)) {
+        return false;
+    }
+
+    BinaryReader reader { data.data(), data.data() + data.size(), true };
+
+    // every value takes at least one byte, which bounds the counts of valid data
+    auto readCount = [&reader, &data]() {
+        const uint64_t count = reader.readVarint();
+        if (count > data.size()) {
+            reader.valid = false;
+            return uint64_t(0);
+        }
+        return count;
+    };
+
+    std::vector<std::string> translatorIds(readCount());
+    for (auto& translatorId : translatorIds) {
+        translatorId = reader.readString();
+    }
+    nodeNames.resize(readCount());
+    for (auto& nodeName : nodeNames) {
+        nodeName = reader.readString();
+    }
+    lookups.resize(readCount());
+
+    auto readNode = [&reader, &nodeNames]() {
+        const uint64_t node = reader.readVarint();
+        if (node > nodeNames.size()) {
+            reader.valid = false;
+            return size_t(0);
+        }
+        return size_t(node);
+    };
+
+    std::string path;
+    for (auto& lookup : lookups) {
+        const uint64_t sharedLength = reader.readVarint();
+        if (!reader.valid || sharedLength > path.size()) {
+            return false;
+        }
+        path.resize(sharedLength);
+        path += reader.readString();
+        lookup.path = SdfPath(path);
+
+        const uint64_t translatorId = reader.readVarint();
+        if (!reader.valid || translatorId >= translatorIds.size()) {
+            return false;
+        }
+        lookup.translatorId = translatorIds[translatorId];
+        lookup.node = readNode();
+        lookup.createdNodes.resize(readCount());
+        for (auto& node : lookup.createdNodes) {
+            node = readNode();
+        }
+        lookup.uniqueKey = reader.readVarint();
+        if (!reader.valid) {
+            return false;
+        }
+    }
+    return reader.valid;
+}
+
+void readTextFormat(
+    const char*                    begin,
+    const char*                    end,
+    std::vector<std::string>&      nodeNames,
+    std::vector<SerialisedLookup>& lookups)
+{
+    static const std::string uniqueKeyPrefix("uniquekey:");
+
+    std::unordered_map<std::string, size_t> nodeIndices;
+
+    auto nodeIndex = [&](std::string&& name) {
+        if (name.empty()) {
+            return size_t(0);
+        }
+        auto inserted = nodeIndices.emplace(name, nodeNames.size() + 1);
+        if (inserted.second) {
+            nodeNames.push_back(std::move(name));
+        }
+        return inserted.first->second;
+    };
+
+    for (const char* entryBegin = begin; entryBegin < end;) {
+        const char* entryEnd = std::find(entryBegin, end, ';');
+        const char* equals = std::find(entryBegin, entryEnd, '=');
+        if (equals != entryEnd) {
+            SerialisedLookup lookup;
+            lookup.path = SdfPath(std::string(entryBegin, equals));
+
+            // the fields are the translator id, the transform node, then the created nodes and
+            // the unique key
+            size_t field = 0;
+            for (const char* fieldBegin = equals + 1; fieldBegin <= entryEnd; ++field) {
+                const char* fieldEnd = std::find(fieldBegin, entryEnd, ',');
+                std::string value(fieldBegin, fieldEnd);
+                fieldBegin = fieldEnd + 1;
+
+                if (field == 0) {
+                    lookup.translatorId = std::move(value);
+                } else if (field == 1) {
+                    lookup.node = nodeIndex(std::move(value));
+                } else if (value.compare(0, uniqueKeyPrefix.size(), uniqueKeyPrefix) == 0) {
+                    const std::string keyStr = value.substr(uniqueKeyPrefix.size());
+                    if (!keyStr.empty()) {
+                        try {
+                            lookup.uniqueKey = std::stoul(keyStr);
+                        } catch (std::logic_error&) {
+                            TF_DEBUG(ALUSDMAYA_TRANSLATORS)
+                                .Msg(
+                                    "TranslatorContext:deserialise ignored invalid hash value for "
+                                    "prim='%s' [hash='%s']\n",
+                                    lookup.path.GetText(),
+                                    keyStr.c_str());
+                        }
+                    }
+                } else {
+                    // like the previous reader, an empty node name gives a null node
+                    lookup.createdNodes.push_back(nodeIndex(std::move(value)));
+                }
+            }
+            lookups.push_back(std::move(lookup));
+        }
+        entryBegin = entryEnd + 1;
+    }
+}
+
+/// resolves the node names with a single selection list rather than one per name. The returned
+/// nodes are indexed by the name index plus one, names that cannot be resolved giving null nodes.
+std::vector<MObject> resolveNodes(const std::vector<std::string>& nodeNames)
+{
+    std::vector<MObject> nodes(nodeNames.size() + 1);
+    MSelectionList       sl;
+    for (size_t i = 0; i < nodeNames.size(); ++i) {
+        const unsigned int index = sl.length();
+        if (!sl.add(nodeNames[i].c_str())) {
+            continue;
+        }
+        if (sl.length() > index) {
+            sl.getDependNode(index, nodes[i + 1]);
+        } else {
+            // the node is already in the list under another name
+            MSelectionList single;
+            single.add(nodeNames[i].c_str());
+            single.getDependNode(0, nodes[i + 1]);
+        }
+    }
+    return nodes;
+}
+
 } // namespace
 
 namespace AL {
@@ -62,6 +349,22 @@ UsdStageRefPtr TranslatorContext::getUsdStage() const
     return UsdStageRefPtr();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorContext::PrimLookups::iterator TranslatorContext::insertLookup(PrimLookup&& lookup)
+{
+    const SdfPath path = lookup.path();
+    auto          it = m_primMapping.emplace(path, std::move(lookup)).first;
+    m_primIndex[path] = it;
+    return it;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorContext::PrimLookups::iterator TranslatorContext::eraseLookup(PrimLookups::iterator it)
+{
+    m_primIndex.erase(it->first);
+    return m_primMapping.erase(it);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TranslatorContext::validatePrims()
 {
@@ -69,12 +372,13 @@ void TranslatorContext::validatePrims()
         _translatorContextProfilerCategory, MProfiler::kColorE_L3, "Validate prims");
 
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALIDATE PRIMS **\n");
-    for (auto it : m_primMapping) {
-        if (it.objectHandle().isValid() && it.objectHandle().isAlive()) {
+    for (const auto& it : m_primMapping) {
+        const PrimLookup& lookup = it.second;
+        if (lookup.objectHandle().isValid() && lookup.objectHandle().isAlive()) {
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                 .Msg(
                     "TranslatorContext::validatePrims ** VALID HANDLE DETECTED %s **\n",
-                    it.path().GetText());
+                    lookup.path().GetText());
         }
     }
 }
@@ -88,12 +392,12 @@ bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTransform %s\n", path.GetText());
     auto it = find(path);
     if (it != m_primMapping.end()) {
-        if (!it->objectHandle().isValid()) {
+        if (!it->second.objectHandle().isValid()) {
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                 .Msg("TranslatorContext::getTransform - invalid handle\n");
             return false;
         }
-        object = it->object();
+        object = it->second.object();
         return true;
     }
     return false;
@@ -107,20 +411,20 @@ void TranslatorContext::updatePrimTypes(const SdfPathSet& affectedPaths)
 
     auto stage = m_proxyShape->usdStage();
     for (auto it = m_primMapping.begin(); it != m_primMapping.end();) {
-        SdfPath path(it->path());
+        SdfPath path(it->first);
         UsdPrim prim = stage->GetPrimAtPath(path);
         bool    modifiedIt = false;
         if (!prim) {
             // Check if the registered prim path is affected
             if (isDescendantPath(affectedPaths, path)) {
-                it = m_primMapping.erase(it);
+                it = eraseLookup(it);
                 modifiedIt = true;
             }
         } else {
             std::string translatorId
                 = m_proxyShape->translatorManufacture().generateTranslatorId(prim);
-            if (it->translatorId() != translatorId) {
-                it->translatorId() = translatorId;
+            if (it->second.translatorId() != translatorId) {
+                it->second.translatorId() = translatorId;
                 ++it;
                 modifiedIt = true;
             }
@@ -143,7 +447,7 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
     if (it != m_primMapping.end()) {
         const MTypeId zero(0);
         if (zero != typeId) {
-            for (auto temp : it->createdNodes()) {
+            for (auto temp : it->second.createdNodes()) {
                 MFnDependencyNode fn(temp.object());
                 TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                     .Msg("TranslatorContext::getMObject getting %s\n", fn.typeName().asChar());
@@ -159,12 +463,12 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
                 }
             }
         } else {
-            if (!it->createdNodes().empty()) {
+            if (!it->second.createdNodes().empty()) {
                 TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                     .Msg(
                         "TranslatorContext::getMObject getting anything %s\n",
                         path.GetString().c_str());
-                object = it->createdNodes()[0];
+                object = it->second.createdNodes()[0];
 
                 if (!object.isAlive())
                     MGlobal::displayError(
@@ -191,7 +495,7 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
     if (it != m_primMapping.end()) {
         const MTypeId zero(0);
         if (MFn::kInvalid != type) {
-            for (auto temp : it->createdNodes()) {
+            for (auto temp : it->second.createdNodes()) {
                 TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                     .Msg("TranslatorContext::getMObject getting: %s\n", temp.object().apiTypeStr());
                 if (temp.object().apiType() == type) {
@@ -206,12 +510,12 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
                 }
             }
         } else {
-            if (!it->createdNodes().empty()) {
+            if (!it->second.createdNodes().empty()) {
                 TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                     .Msg(
                         "TranslatorContext::getMObject getting anything: %s\n",
                         path.GetString().c_str());
-                object = it->createdNodes()[0];
+                object = it->second.createdNodes()[0];
 
                 if (!object.isAlive())
                     MGlobal::displayError(
@@ -235,7 +539,7 @@ bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& ret
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObjects: %s\n", path.GetText());
     auto it = find(path);
     if (it != m_primMapping.end()) {
-        returned = it->createdNodes();
+        returned = it->second.createdNodes();
         return true;
     }
     return false;
@@ -252,18 +556,17 @@ void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
             "TranslatorContext::registerItem adding entry %s[%s]\n",
             prim.GetPath().GetText(),
             object.object().apiTypeStr());
-    auto iter = findLocation(prim.GetPath());
-    if (iter == m_primMapping.end() || iter->path() != prim.GetPath()) {
+    auto iter = find(prim.GetPath());
+    if (iter == m_primMapping.end()) {
         // We keep around this legacy plugin identification by type only to allow tests which don't
         // create a proxy shape to run..
         std::string translatorId = m_proxyShape
             ? m_proxyShape->translatorManufacture().generateTranslatorId(prim)
             : "schematype:" + prim.GetTypeName().GetString();
 
-        iter
-            = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, object.object()));
+        iter = insertLookup(PrimLookup(prim.GetPath(), translatorId, object.object()));
     } else {
-        iter->setNode(object.object());
+        iter->second.setNode(object.object());
     }
 
     if (object.object() == MObject::kNullObj) {
@@ -271,13 +574,13 @@ void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
             .Msg(
                 "TranslatorContext::registerItem primPath=%s translatorId=%s to null MObject\n",
                 prim.GetPath().GetText(),
-                iter->translatorId().c_str());
+                iter->second.translatorId().c_str());
     } else {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg(
                 "TranslatorContext::registerItem primPath=%s translatorId=%s to MObject type %s\n",
                 prim.GetPath().GetText(),
-                iter->translatorId().c_str(),
+                iter->second.translatorId().c_str(),
                 object.object().apiTypeStr());
     }
 }
@@ -294,35 +597,35 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
             prim.GetPath().GetText(),
             object.object().apiTypeStr());
 
-    auto iter = findLocation(prim.GetPath());
-    if (iter == m_primMapping.end() || iter->path() != prim.GetPath()) {
+    auto iter = find(prim.GetPath());
+    if (iter == m_primMapping.end()) {
         // We keep around this legacy plugin identification by type only to allow tests which don't
         // create a proxy shape to run..
         std::string translatorId = m_proxyShape
             ? m_proxyShape->translatorManufacture().generateTranslatorId(prim)
             : "schematype:" + prim.GetTypeName().GetString();
 
-        iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, MObject()));
+        iter = insertLookup(PrimLookup(prim.GetPath(), translatorId, MObject()));
     }
 
     if (object.object() == MObject::kNullObj) {
         return;
     }
 
-    iter->createdNodes().push_back(object);
+    iter->second.createdNodes().push_back(object);
 
     if (object.object() == MObject::kNullObj) {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg(
                 "TranslatorContext::insertItem primPath=%s translatorId=%s to null MObject\n",
                 prim.GetPath().GetText(),
-                iter->translatorId().c_str());
+                iter->second.translatorId().c_str());
     } else {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg(
                 "TranslatorContext::insertItem primPath=%s translatorId=%s to MObject type %s\n",
                 prim.GetPath().GetText(),
-                iter->translatorId().c_str(),
+                iter->second.translatorId().c_str(),
                 object.object().apiTypeStr());
     }
 }
@@ -336,9 +639,9 @@ void TranslatorContext::removeItems(const SdfPath& path)
     TF_DEBUG(ALUSDMAYA_TRANSLATORS)
         .Msg("TranslatorContext::removeItems remove under primPath=%s\n", path.GetText());
     auto it = find(path);
-    if (it != m_primMapping.end() && it->path() == path) {
+    if (it != m_primMapping.end()) {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
-            .Msg("TranslatorContext::removeItems removing path=%s\n", it->path().GetText());
+            .Msg("TranslatorContext::removeItems removing path=%s\n", it->first.GetText());
         MDGModifier        modifier1;
         MDagModifier       modifier2;
         MObjectHandleArray tempXforms;
@@ -347,7 +650,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
         // Store the DAG nodes to delete in a vector which we will sort via their path length
         std::vector<std::pair<int, MObject>> dagNodesToDelete;
 
-        auto& nodes = it->createdNodes();
+        auto& nodes = it->second.createdNodes();
         for (std::size_t j = 0, n = nodes.size(); j < n; ++j) {
             if (nodes[j].isAlive() && nodes[j].isValid()) {
                 // Need to reparent nodes first to avoid transform getting deleted and triggering
@@ -415,7 +718,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
             }
             AL_MAYA_CHECK_ERROR2(status, "failed to delete dag nodes");
         }
-        m_primMapping.erase(it);
+        eraseLookup(it);
     }
     validatePrims();
 }
@@ -447,21 +750,74 @@ MString TranslatorContext::serialise() const
 
     m_proxyShape->excludedTranslatedGeometryPlug().setString(MString(oss.str().c_str()));
 
-    oss.str("");
-    oss.clear();
+    // the translator ids and the node names are stored once each, and referenced by index. Node
+    // indices are offset by one so that null nodes are stored as zero.
+    std::vector<const std::string*>                       translatorIds;
+    std::unordered_map<std::string, uint64_t>             translatorIdIndices;
+    std::vector<std::string>                              nodeNames;
+    std::unordered_map<MObjectHandle, uint64_t, NodeHash> nodeIndices;
+
+    auto translatorIdIndex = [&](const std::string& translatorId) {
+        auto inserted = translatorIdIndices.emplace(translatorId, translatorIds.size());
+        if (inserted.second) {
+            translatorIds.push_back(&inserted.first->first);
+        }
+        return inserted.first->second;
+    };
 
-    for (auto it : m_primMapping) {
-        oss << it.path() << "=" << it.translatorId() << ",";
-        oss << getNodeName(it.object());
-        for (uint32_t i = 0; i < it.createdNodes().size(); ++i) {
-            oss << "," << getNodeName(it.createdNodes()[i].object());
+    auto nodeIndex = [&](const MObject& obj) -> uint64_t {
+        if (obj.isNull()) {
+            return 0;
+        }
+        auto inserted = nodeIndices.emplace(MObjectHandle(obj), nodeNames.size() + 1);
+        if (inserted.second) {
+            nodeNames.emplace_back(getNodeName(obj).asChar());
+        }
+        return inserted.first->second;
+    };
+
+    std::string        entries;
+    const std::string* previousPath = nullptr;
+    for (const auto& it : m_primMapping) {
+        const PrimLookup& lookup = it.second;
+
+        // the mappings are sorted by path, so only the end of a path that differs from the
+        // previous one is stored
+        const std::string& path = lookup.path().GetString();
+        size_t             sharedLength = 0;
+        if (previousPath) {
+            const size_t maxLength = std::min(path.size(), previousPath->size());
+            while (sharedLength < maxLength
+                   && path[sharedLength] == (*previousPath)[sharedLength]) {
+                ++sharedLength;
+            }
         }
-        if (it.uniqueKey()) {
-            oss << ",uniquekey:" << it.uniqueKey();
+        previousPath = &path;
+
+        writeVarint(entries, sharedLength);
+        writeString(entries, path.data() + sharedLength, path.size() - sharedLength);
+        writeVarint(entries, translatorIdIndex(lookup.translatorId()));
+        writeVarint(entries, nodeIndex(lookup.object()));
+        writeVarint(entries, lookup.createdNodes().size());
+        for (const auto& node : lookup.createdNodes()) {
+            writeVarint(entries, nodeIndex(node.object()));
         }
-        oss << ";";
+        writeVarint(entries, lookup.uniqueKey());
+    }
+
+    std::string data;
+    writeVarint(data, translatorIds.size());
+    for (const std::string* translatorId : translatorIds) {
+        writeString(data, translatorId->data(), translatorId->size());
+    }
+    writeVarint(data, nodeNames.size());
+    for (const std::string& nodeName : nodeNames) {
+        writeString(data, nodeName.data(), nodeName.size());
     }
-    return MString(oss.str().c_str());
+    writeVarint(data, m_primMapping.size());
+    data.append(entries);
+
+    return MString((kBinaryFormatHeader + encodeBase64(data)).c_str());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -471,61 +827,44 @@ void TranslatorContext::deserialise(const MString& string)
         _translatorContextProfilerCategory, MProfiler::kColorE_L3, "Deserialise");
 
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:deserialise\n");
-    MStringArray strings;
-    string.split(';', strings);
-
-    for (uint32_t i = 0; i < strings.length(); ++i) {
-        MStringArray strings2;
-        strings[i].split('=', strings2);
+    const char* begin = string.asChar();
+    const char* end = begin + string.length();
 
-        MStringArray strings3;
-        strings2[1].split(',', strings3);
+    std::vector<std::string>      nodeNames;
+    std::vector<SerialisedLookup> lookups;
 
-        MObject obj;
-        {
-            MSelectionList sl;
-            sl.add(strings3[1].asChar());
-            sl.getDependNode(0, obj);
-        }
-
-        PrimLookup lookup(SdfPath(strings2[0].asChar()), strings3[0].asChar(), obj);
-
-        static const MString uniqueKeyPrefix("uniquekey:");
-
-        for (uint32_t j = 2; j < strings3.length(); ++j) {
-            if (strings3[j].substring(0, 10) == uniqueKeyPrefix) {
-                auto keyStr(strings3[j].substring(10, strings3[j].length()));
-                if (keyStr.length()) {
-                    try {
-                        lookup.setUniqueKey(std::stoul(keyStr.asChar()));
-                    } catch (std::logic_error&) {
-                        TF_DEBUG(ALUSDMAYA_TRANSLATORS)
-                            .Msg(
-                                "TranslatorContext:deserialise ignored invalid hash value for "
-                                "prim='%s' [hash='%s']\n",
-                                lookup.path().GetText(),
-                                keyStr.asChar());
-                    }
-                }
-                continue;
-            }
-
-            MSelectionList sl;
-            sl.add(strings3[j].asChar());
-            MObject obj;
-            sl.getDependNode(0, obj);
-            lookup.createdNodes().push_back(obj);
+    const size_t headerLength = kBinaryFormatHeader.size();
+    if (size_t(end - begin) >= headerLength
+        && kBinaryFormatHeader.compare(0, headerLength, begin, headerLength) == 0) {
+        if (!readBinaryFormat(begin + headerLength, end, nodeNames, lookups)) {
+            MGlobal::displayError(
+                MString("TranslatorContext::deserialise could not read the translator context of ")
+                + m_proxyShape->name());
+            nodeNames.clear();
+            lookups.clear();
         }
+    } else {
+        readTextFormat(begin, end, nodeNames, lookups);
+    }
 
+    const std::vector<MObject> nodes = resolveNodes(nodeNames);
+
+    m_primIndex.reserve(m_primIndex.size() + lookups.size());
+    for (SerialisedLookup& serialised : lookups) {
         // Check for any prim lookup duplicates.
         // This assumes lookups have 1:1 mapping of prim to translator, and that
         // multiple translators can not be registered against the same prim type.
-        auto iter
-            = std::find_if(m_primMapping.begin(), m_primMapping.end(), [&](const PrimLookup& p) {
-                  return p.path() == lookup.path();
-              });
-        if (iter == m_primMapping.end())
-            m_primMapping.push_back(lookup);
+        if (find(serialised.path) != m_primMapping.end()) {
+            continue;
+        }
+
+        PrimLookup lookup(serialised.path, serialised.translatorId, nodes[serialised.node]);
+        lookup.setUniqueKey(serialised.uniqueKey);
+        lookup.createdNodes().reserve(serialised.createdNodes.size());
+        for (size_t node : serialised.createdNodes) {
+            lookup.createdNodes().push_back(nodes[node]);
+        }
+        insertLookup(std::move(lookup));
     }
 
     SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(
@@ -534,7 +873,6 @@ void TranslatorContext::deserialise(const MString& string)
         m_excludedGeometry.emplace(it, it);
     }
 }
-
 //----------------------------------------------------------------------------------------------------------------------
 void TranslatorContext::preRemoveEntry(
     const SdfPath& primPath,
@@ -548,14 +886,13 @@ void TranslatorContext::preRemoveEntry(
         .Msg("TranslatorContext::preRemoveEntry primPath=%s\n", primPath.GetText());
 
     PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator range_begin
-        = std::lower_bound(m_primMapping.begin(), end, primPath, value_compare());
+    PrimLookups::iterator range_begin = m_primMapping.lower_bound(primPath);
     PrimLookups::iterator range_end = range_begin;
     for (; range_end != end; ++range_end) {
         // due to the joys of sorting, any child prims of this prim being destroyed should appear
         // next to each other (one would assume); So if compare does not find a match (the value is
         // something other than zero), we are no longer in the same prim root
-        const SdfPath& childPath = range_end->path();
+        const SdfPath& childPath = range_end->first;
 
         if (!childPath.HasPrefix(primPath)) {
             break;
@@ -568,13 +905,14 @@ void TranslatorContext::preRemoveEntry(
     // (which will guarentee the the itemsToRemove will be ordered such that the child prims will be
     // destroyed before their parents).
     auto iter = range_end;
-    itemsToRemove.reserve(itemsToRemove.size() + (range_end - range_begin));
+    itemsToRemove.reserve(itemsToRemove.size() + std::distance(range_begin, range_end));
+    std::unordered_set<SdfPath, SdfPath::Hash> processedItems(
+        itemsToRemove.begin(), itemsToRemove.end());
     while (iter != range_begin) {
         --iter;
-        PrimLookup& node = *iter;
+        PrimLookup& node = iter->second;
 
-        if (std::find(itemsToRemove.begin(), itemsToRemove.end(), node.path())
-            != itemsToRemove.end()) {
+        if (!processedItems.insert(node.path()).second) {
             // Same exact path has already been processed and added to the list of itemsToRemove.
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                 .Msg(
@@ -608,25 +946,24 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
     auto iter = itemsToRemove.begin();
     while (iter != itemsToRemove.end()) {
         auto path = *iter;
-        auto node
-            = std::lower_bound(m_primMapping.begin(), m_primMapping.end(), path, value_compare());
+        auto node = find(path);
         if (node == m_primMapping.end()) {
             ++iter;
             continue;
         }
         bool isInTransformChain = isPrimInTransformChain(path);
-        auto primMappingSize = m_primMapping.size();
 
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg("TranslatorContext::removeEntries removing: %s\n", iter->GetText());
-        if (node->objectHandle().isValid() && node->objectHandle().isAlive()) {
-            unloadPrim(path, node->object());
+        if (node->second.objectHandle().isValid() && node->second.objectHandle().isAlive()) {
+            unloadPrim(path, node->second.object());
         }
 
         // The item might already have been removed by a translator...
-        if (primMappingSize == m_primMapping.size()) {
+        node = find(path);
+        if (node != m_primMapping.end()) {
             // remove nodes from map
-            m_primMapping.erase(node);
+            eraseLookup(node);
         }
 
         if (isInTransformChain) {
@@ -646,7 +983,8 @@ void TranslatorContext::updateUniqueKeys()
         _translatorContextProfilerCategory, MProfiler::kColorE_L3, "Update unique keys");
 
     auto stage = getUsdStage();
-    for (auto& lookup : m_primMapping) {
+    for (auto& it : m_primMapping) {
+        PrimLookup& lookup = it.second;
         const auto& prim = stage->GetPrimAtPath(lookup.path());
         if (prim) {
             std::string translatorId = getTranslatorIdForPath(lookup.path());
@@ -685,7 +1023,7 @@ void TranslatorContext::updateUniqueKey(const UsdPrim& prim)
     auto translator = m_proxyShape->translatorManufacture().getTranslatorFromId(translatorId);
     if (translator) {
         auto it = find(path);
-        if (it != m_primMapping.end() && it->path() == path) {
+        if (it != m_primMapping.end()) {
             auto key(translator->generateUniqueKey(prim));
             TF_DEBUG(ALUSDMAYA_TRANSLATORS)
                 .Msg(
@@ -693,8 +1031,8 @@ void TranslatorContext::updateUniqueKey(const UsdPrim& prim)
                     "uniqueKey='%lu', previousUniqueKey='%lu'\n",
                     path.GetText(),
                     key,
-                    it->uniqueKey());
-            it->setUniqueKey(key);
+                    it->second.uniqueKey());
+            it->second.setUniqueKey(key);
         }
     }
 }
@@ -32,7 +32,9 @@
 #include <maya/MObjectHandle.h>
 #include <maya/MPxData.h>
 
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -249,7 +251,7 @@ public:
     {
         const auto it = find(path);
         if (it != m_primMapping.end()) {
-            return it->translatorId();
+            return it->second.translatorId();
         }
         TF_DEBUG(ALUSDMAYA_TRANSLATORS)
             .Msg(
@@ -273,12 +275,14 @@ public:
     AL_USDMAYA_PUBLIC
     void registerItem(const UsdPrim& prim, MObjectHandle object);
 
-    /// \brief  serialises the content of the translator context to a text string.
+    /// \brief  serialises the content of the translator context to a string, in a compact binary
+    ///         format encoded as text.
     /// \return the translator context serialised into a string
     AL_USDMAYA_PUBLIC
     MString serialise() const;
 
-    /// \brief  deserialises the string back into the translator context
+    /// \brief  deserialises the string back into the translator context. Strings written in the
+    ///         older text format are read as well.
     /// \param  string the string to deserialised
     AL_USDMAYA_PUBLIC
     void deserialise(const MString& string);
@@ -298,7 +302,7 @@ public:
     {
         auto it = find(path);
         if (it != m_primMapping.end()) {
-            return translatorId == it->translatorId();
+            return translatorId == it->second.translatorId();
         }
         return false;
     }
@@ -328,7 +332,7 @@ public:
     {
         auto it = find(path);
         if (it != m_primMapping.end()) {
-            return it->uniqueKey();
+            return it->second.uniqueKey();
         }
         return 0;
     }
@@ -414,8 +418,12 @@ public:
         MObjectHandleArray m_createdNodes;
     };
 
-    /// a sorted array of prim mappings
-    typedef std::vector<PrimLookup> PrimLookups;
+    /// the prim mappings sorted by path, so that the mappings of the descendants of a prim follow
+    /// its own
+    typedef std::map<SdfPath, PrimLookup> PrimLookups;
+
+    /// an index of the prim mappings by path
+    typedef std::unordered_map<SdfPath, PrimLookups::iterator, SdfPath::Hash> PrimLookupIndex;
 
     /// comparison utility (for sorting array of pointers to node references based on their path)
     struct value_compare
@@ -444,7 +452,16 @@ public:
     };
 
     /// \brief  This is used for testing only. Do not call.
-    void clearPrimMappings() { m_primMapping.clear(); }
+    void clearPrimMappings()
+    {
+        m_primIndex.clear();
+        m_primMapping.clear();
+    }
+
+    /// \brief  reserves room for the given number of new prim mappings, to be called before
+    ///         registering a batch of prims
+    /// \param  count the number of prim mappings about to be added
+    void reservePrimMappings(std::size_t count) { m_primIndex.reserve(m_primIndex.size() + count); }
 
     /// \brief  add geometry to the exclusion list
     /// \param  newPath the path to add as an excluded translator path
@@ -489,35 +506,19 @@ private:
 
     inline PrimLookups::iterator find(const SdfPath& path)
     {
-        PrimLookups::iterator end = m_primMapping.end();
-        PrimLookups::iterator it
-            = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-        if (it != end) {
-            if (it->path() == path)
-                return it;
-        }
-        return end;
+        auto it = m_primIndex.find(path);
+        return it != m_primIndex.end() ? it->second : m_primMapping.end();
     }
 
     inline PrimLookups::const_iterator find(const SdfPath& path) const
     {
-        PrimLookups::const_iterator end = m_primMapping.end();
-        PrimLookups::const_iterator it
-            = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-        if (it != end) {
-            if (it->path() == path)
-                return it;
-        }
-        return end;
+        auto it = m_primIndex.find(path);
+        return it != m_primIndex.end() ? PrimLookups::const_iterator(it->second)
+                                       : m_primMapping.end();
     }
 
-    inline PrimLookups::iterator findLocation(const SdfPath& path)
-    {
-        PrimLookups::iterator end = m_primMapping.end();
-        PrimLookups::iterator it
-            = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-        return it;
-    }
+    PrimLookups::iterator insertLookup(PrimLookup&& lookup);
+    PrimLookups::iterator eraseLookup(PrimLookups::iterator it);
 
     TranslatorContext(nodes::ProxyShape* proxyShape)
         : m_proxyShape(proxyShape)
@@ -529,7 +530,8 @@ private:
 
     // map between a usd prim path and either a dag parent node or
     // a dependency node
-    PrimLookups m_primMapping;
+    PrimLookups     m_primMapping;
+    PrimLookupIndex m_primIndex;
 
     // list of geometry that has been request to be excluded during the translation
     SdfInstanceMap m_excludedGeometry;
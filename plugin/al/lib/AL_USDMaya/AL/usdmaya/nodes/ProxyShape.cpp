@@ -47,6 +47,7 @@
 #include <pxr/usd/usd/stageCacheContext.h>
 #include <pxr/usd/usdGeom/imageable.h>
 #include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformOp.h>
 #include <pxr/usd/usdUtils/stageCache.h>
 #include <pxr/usdImaging/usdImaging/delegate.h>
 
@@ -265,6 +266,10 @@ void ProxyShape::translatePrimsIntoMaya(
     // recreating them.
     context()->removeEntries(filter.removedPrimSet());
 
+    // the new prims are registered as a batch, make room for them once
+    context()->reservePrimMappings(
+        filter.newPrimSet().size() + filter.transformsToCreate().size());
+
     fileio::translators::TranslatorContextSetterCtx ctxSetter(context());
 
     cmds::ProxyShapePostLoadProcess::MObjectToPrim objsToCreate;
@@ -1011,8 +1016,6 @@ void ProxyShape::processChangedObjects(
 
     TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - processing changes\n");
 
-    bool shouldCleanBBoxCache = false;
-
     if (!m_stage) {
         TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - Invalid stage\n");
         return;
@@ -1025,7 +1028,7 @@ void ProxyShape::processChangedObjects(
             if (!newPrim.IsValid()) {
                 TF_DEBUG(ALUSDMAYA_EVENTS)
                     .Msg(
-                        "ProxyShape::processChangedObjects - resyncedPaths (1) contains invalid "
+                        "ProxyShape::processChangedObjects - resyncedPaths contains invalid "
                         "path %s\n",
                         path.GetText());
                 continue;
@@ -1038,40 +1041,26 @@ void ProxyShape::processChangedObjects(
                 continue;
             tmm->setPrim(
                 newPrim, tm); // Might be (invalid/nullptr) but that's OK at least it won't crash
-        } else {
-            UsdPrim newPrim = m_stage->GetPrimAtPath(path);
-            if (!newPrim.IsValid()) {
-                TF_DEBUG(ALUSDMAYA_EVENTS)
-                    .Msg(
-                        "ProxyShape::processChangedObjects - resyncedPaths (2) contains invalid "
-                        "path %s\n",
-                        path.GetText());
-                continue;
-            }
-            if (newPrim && newPrim.IsA<UsdGeomXformable>()) {
-                shouldCleanBBoxCache = true;
-            }
         }
     }
 
-    // check to see if any transform ops have been modified (update the bounds accordingly)
-    if (!shouldCleanBBoxCache) {
-        for (const SdfPath& path : changedOnlyPaths) {
-            UsdPrim changedPrim = m_stage->GetPrimAtPath(path);
-            if (path.IsPrimPropertyPath()) {
-                const std::string tokenString = path.GetElementString();
-                if (std::strncmp(tokenString.c_str(), ".xformOp", 8) == 0
-                    || std::strncmp(tokenString.c_str(), ".visibility", 11) == 0) {
-                    shouldCleanBBoxCache = true;
-                    break;
-                }
+    // check to see if any transform ops or visibilities have been modified (update the bounds
+    // accordingly)
+    SdfPathVector boundsChangedPaths;
+    for (const SdfPath& path : changedOnlyPaths) {
+        if (path.IsPrimPropertyPath()) {
+            const TfToken& name = path.GetNameToken();
+            if (UsdGeomXformOp::IsXformOp(name) || name == UsdGeomTokens->xformOpOrder
+                || name == UsdGeomTokens->visibility) {
+                boundsChangedPaths.push_back(path);
             }
         }
     }
 
-    // do we need to clear the bounding box cache?
-    if (shouldCleanBBoxCache) {
-        clearBoundingBoxCache();
+    // do we need to update the bounding box cache? Only the cached bounds of the changed prims
+    // and of their ancestors are dropped, the bounds of the rest of the stage stay cached.
+    if (!resyncedPaths.empty() || !boundsChangedPaths.empty()) {
+        invalidateBoundingBoxCache(m_stage, resyncedPaths, boundsChangedPaths);
 
         // Ideally we want to have a way to force maya to call ProxyShape::boundingBox() again to
         // update the bbox attributes. This may lead to a delay in the bbox updates (e.g. usually
@@ -28,6 +28,8 @@
 #include <maya/MProfiler.h>
 #include <maya/MViewport2Renderer.h>
 
+#include <algorithm>
+
 #define AL_USDMAYA_XFORM_COMP_EPSILON 1e-7
 
 namespace {
@@ -91,6 +93,86 @@ template <> inline bool isClose(const GfHalf& x, const GfHalf& y)
     return GfIsClose(x, y, AL_USDMAYA_XFORM_COMP_EPSILON);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool evaluateVector(
+    MVector&                  result,
+    const XformOpSamples::Op& samples,
+    double                    time,
+    size_t&                   hint)
+{
+    if (samples.numValues != 3) {
+        return false;
+    }
+    double value[3];
+    samples.evaluate(time, hint, value);
+    result.x = value[0];
+    result.y = value[1];
+    result.z = value[2];
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool evaluateShear(
+    MVector&                  result,
+    const XformOpSamples::Op& samples,
+    double                    time,
+    size_t&                   hint)
+{
+    if (samples.numValues != 16) {
+        return false;
+    }
+    double value[16];
+    samples.evaluate(time, hint, value);
+    result.x = value[4];
+    result.y = value[8];
+    result.z = value[9];
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool evaluateRotation(
+    MEulerRotation&           result,
+    const UsdGeomXformOp&     op,
+    const XformOpSamples::Op& samples,
+    double                    time,
+    size_t&                   hint)
+{
+    // single axis rotations only have samples for their axis
+    size_t                        axis = 0;
+    size_t                        numValues = 3;
+    MEulerRotation::RotationOrder order = MEulerRotation::kXYZ;
+    switch (op.GetOpType()) {
+    case UsdGeomXformOp::TypeRotateX: numValues = 1; break;
+    case UsdGeomXformOp::TypeRotateY:
+        axis = 1;
+        numValues = 1;
+        break;
+    case UsdGeomXformOp::TypeRotateZ:
+        axis = 2;
+        numValues = 1;
+        break;
+    case UsdGeomXformOp::TypeRotateXYZ: break;
+    case UsdGeomXformOp::TypeRotateXZY: order = MEulerRotation::kXZY; break;
+    case UsdGeomXformOp::TypeRotateYXZ: order = MEulerRotation::kYXZ; break;
+    case UsdGeomXformOp::TypeRotateYZX: order = MEulerRotation::kYZX; break;
+    case UsdGeomXformOp::TypeRotateZXY: order = MEulerRotation::kZXY; break;
+    case UsdGeomXformOp::TypeRotateZYX: order = MEulerRotation::kZYX; break;
+    default: return false;
+    }
+    if (samples.numValues != numValues) {
+        return false;
+    }
+
+    const double degToRad = M_PI / 180.0;
+    double       value[3] = { 0.0, 0.0, 0.0 };
+    samples.evaluate(time, hint, value + axis);
+    result.x = value[0] * degToRad;
+    result.y = value[1] * degToRad;
+    result.z = value[2] * degToRad;
+    result.order = order;
+    return true;
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -179,6 +261,7 @@ void TransformationMatrix::setPrim(const UsdPrim& prim, Scope* transformNode)
     // "externally" (ie, from attributes on the controlling transform node), and should NOT be reset
     // when we're re-initializing
     m_flags &= kPreservationMask;
+    m_samples.reset();
     m_scaleTweak = MVector(0, 0, 0);
     m_rotationTweak = MEulerRotation(0, 0, 0);
     m_translationTweak = MVector(0, 0, 0);
@@ -920,6 +1003,7 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Scope* transformN
     bool resetsXformStack = false;
     m_xformops = m_xform.GetOrderedXformOps(&resetsXformStack);
     m_orderedOps.resize(m_xformops.size());
+    m_samples.reset();
 
     if (!resetsXformStack) {
         m_flags |= kInheritsTransform;
@@ -1170,6 +1254,29 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Scope* transformN
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool TransformationMatrix::updateSamples()
+{
+    if (m_samples && m_samples->isValid()) {
+        return m_samplesMatchOps;
+    }
+
+    const UsdStageWeakPtr stage = m_prim.GetStage();
+    if (!stage) {
+        m_samples.reset();
+        return false;
+    }
+    m_samples = XformSampleCache::forStage(stage).samples(m_xform);
+    m_sampleHints.assign(m_xformops.size(), 0);
+
+    // the ops of the prim may have been changed since the transform read them
+    m_samplesMatchOps = m_samples->ops.size() == m_xformops.size();
+    for (size_t i = 0; m_samplesMatchOps && i < m_xformops.size(); ++i) {
+        m_samplesMatchOps = m_samples->ops[i].name == m_xformops[i].GetOpName();
+    }
+    return m_samplesMatchOps;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TransformationMatrix::updateToTime(const UsdTimeCode& time)
 {
@@ -1184,27 +1291,58 @@ void TransformationMatrix::updateToTime(const UsdTimeCode& time)
     }
     if (m_time != time) {
         m_time = time;
+
+        // The animated values are interpolated from the cached time samples when possible, so
+        // that changing the time does not query USD. Transforms without samples have nothing to
+        // update.
+        const UsdTimeCode timeCode = getTimeCode();
+        const bool        useSamples = !timeCode.IsDefault() && updateSamples();
+        if (useSamples && !m_samples->animated) {
+            return;
+        }
+        const double sampleTime = timeCode.GetValue();
+
         {
-            auto opIt = m_orderedOps.begin();
+            auto   opIt = m_orderedOps.begin();
+            size_t opIndex = 0;
             for (std::vector<UsdGeomXformOp>::const_iterator it = m_xformops.begin(),
                                                              e = m_xformops.end();
                  it != e;
-                 ++it, ++opIt) {
-                const UsdGeomXformOp& op = *it;
+                 ++it, ++opIt, ++opIndex) {
+                const UsdGeomXformOp&     op = *it;
+                const XformOpSamples::Op* samples = nullptr;
+                if (useSamples) {
+                    samples = &m_samples->ops[opIndex];
+                    if (samples->times.empty()) {
+                        continue;
+                    }
+                    if (!samples->supported) {
+                        samples = nullptr;
+                    }
+                }
+                size_t* hint = useSamples ? &m_sampleHints[opIndex] : nullptr;
+
                 switch (*opIt) {
                 case kTranslate: {
-                    if (op.GetNumTimeSamples() >= 1) {
+                    if (samples || op.GetNumTimeSamples() >= 1) {
                         m_flags |= kAnimatedTranslation;
-                        internal_readVector(m_translationFromUsd, op);
+                        if (!samples
+                            || !evaluateVector(m_translationFromUsd, *samples, sampleTime, *hint)) {
+                            internal_readVector(m_translationFromUsd, op);
+                        }
                         MPxTransformationMatrix::translationValue
                             = m_translationFromUsd + m_translationTweak;
                     }
                 } break;
 
                 case kRotate: {
-                    if (op.GetNumTimeSamples() >= 1) {
+                    if (samples || op.GetNumTimeSamples() >= 1) {
                         m_flags |= kAnimatedRotation;
-                        internal_readRotation(m_rotationFromUsd, op);
+                        if (!samples
+                            || !evaluateRotation(
+                                m_rotationFromUsd, op, *samples, sampleTime, *hint)) {
+                            internal_readRotation(m_rotationFromUsd, op);
+                        }
                         MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
                         MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
                         MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
@@ -1213,30 +1351,53 @@ void TransformationMatrix::updateToTime(const UsdTimeCode& time)
                 } break;
 
                 case kScale: {
-                    if (op.GetNumTimeSamples() >= 1) {
+                    if (samples || op.GetNumTimeSamples() >= 1) {
                         m_flags |= kAnimatedScale;
-                        internal_readVector(m_scaleFromUsd, op);
+                        if (!samples
+                            || !evaluateVector(m_scaleFromUsd, *samples, sampleTime, *hint)) {
+                            internal_readVector(m_scaleFromUsd, op);
+                        }
                         MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
                     }
                 } break;
 
                 case kShear: {
-                    if (op.GetNumTimeSamples() >= 1) {
+                    if (samples || op.GetNumTimeSamples() >= 1) {
                         m_flags |= kAnimatedShear;
-                        internal_readShear(m_shearFromUsd, op);
+                        if (!samples
+                            || !evaluateShear(m_shearFromUsd, *samples, sampleTime, *hint)) {
+                            internal_readShear(m_shearFromUsd, op);
+                        }
                         MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
                     }
                 } break;
 
                 case kTransform: {
-                    if (op.GetNumTimeSamples() >= 1) {
+                    if (samples || op.GetNumTimeSamples() >= 1) {
                         m_flags |= kAnimatedMatrix;
+                        double     T[3] {};
+                        double     S[3] {};
+                        size_t     sampleIndex = XformOpSamples::npos;
                         GfMatrix4d matrix;
                         matrix.SetIdentity();
-                        op.Get<GfMatrix4d>(&matrix, getTimeCode());
-                        double T[3] {};
-                        double S[3] {};
-                        AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
+                        if (samples && samples->numValues == 16) {
+                            sampleIndex = samples->evaluate(sampleTime, *hint, matrix.GetArray());
+                        } else {
+                            op.Get<GfMatrix4d>(&matrix, getTimeCode());
+                        }
+
+                        // the samples were decomposed in XYZ order when they were cached
+                        if (sampleIndex != XformOpSamples::npos
+                            && m_rotationFromUsd.order == MEulerRotation::kXYZ) {
+                            const double* SRT = samples->decomposed.data() + sampleIndex * 9;
+                            std::copy(SRT, SRT + 3, S);
+                            m_rotationFromUsd.x = SRT[3];
+                            m_rotationFromUsd.y = SRT[4];
+                            m_rotationFromUsd.z = SRT[5];
+                            std::copy(SRT + 6, SRT + 9, T);
+                        } else {
+                            AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
+                        }
                         m_scaleFromUsd.x = S[0];
                         m_scaleFromUsd.y = S[1];
                         m_scaleFromUsd.z = S[2];
@@ -1273,6 +1434,7 @@ void TransformationMatrix::insertTranslateOp()
     m_xformops.insert(m_xformops.begin(), op);
     m_orderedOps.insert(m_orderedOps.begin(), kTranslate);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasTranslation;
 }
 
@@ -1323,6 +1485,7 @@ void TransformationMatrix::insertScaleOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kScale);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasScale;
 }
 
@@ -1368,6 +1531,7 @@ void TransformationMatrix::insertShearOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kShear);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasShear;
 }
 
@@ -1420,6 +1584,7 @@ void TransformationMatrix::insertScalePivotOp()
         m_orderedOps.insert(posInOps, kScalePivotInv);
     }
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasScalePivot;
 }
 
@@ -1462,6 +1627,7 @@ void TransformationMatrix::insertScalePivotTranslationOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kScalePivotTranslate);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasScalePivotTranslate;
 }
 
@@ -1511,6 +1677,7 @@ void TransformationMatrix::insertRotatePivotOp()
         m_orderedOps.insert(posInOps, kRotatePivotInv);
     }
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasRotatePivot;
 }
 
@@ -1553,6 +1720,7 @@ void TransformationMatrix::insertRotatePivotTranslationOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kRotatePivotTranslate);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasRotatePivotTranslate;
 }
 
@@ -1628,6 +1796,7 @@ void TransformationMatrix::insertRotateOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kRotate);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasRotation;
 }
 
@@ -1713,6 +1882,7 @@ void TransformationMatrix::insertRotateAxesOp()
     m_xformops.insert(posInXfm, op);
     m_orderedOps.insert(posInOps, kRotateAxis);
     m_xform.SetXformOpOrder(m_xformops, (m_flags & kInheritsTransform) == 0);
+    m_samples.reset();
     m_flags |= kPrimHasRotateAxes;
 }
 
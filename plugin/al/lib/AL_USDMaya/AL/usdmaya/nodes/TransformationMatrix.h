@@ -18,6 +18,7 @@
 #include "AL/usdmaya/Api.h"
 #include "AL/usdmaya/TransformOperation.h"
 #include "AL/usdmaya/nodes/BasicTransformationMatrix.h"
+#include "AL/usdmaya/nodes/XformSampleCache.h"
 
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 #include <pxr/usd/usdGeom/xformable.h>
@@ -50,6 +51,12 @@ class TransformationMatrix : public BasicTransformationMatrix
     std::vector<UsdGeomXformOp>     m_xformops;
     std::vector<TransformOperation> m_orderedOps;
 
+    // time samples of the ops, shared with the other transforms of the stage. Only used when
+    // m_samplesMatchOps is set, i.e. when they were read from the same ops as m_xformops.
+    std::shared_ptr<const XformOpSamples> m_samples;
+    std::vector<size_t>                   m_sampleHints;
+    bool                                  m_samplesMatchOps = false;
+
     // tweak values. These are applied on top of the USD transform values to produce the final
     // result.
     MVector        m_scaleTweak;
@@ -111,6 +118,9 @@ class TransformationMatrix : public BasicTransformationMatrix
     void insertRotatePivotTranslationOp();
     void insertRotateAxesOp();
 
+    // fetch the time samples of the ops if needed. Returns true if they can be used.
+    bool updateSamples();
+
     enum Flags
     {
         // describe which components are animated
@@ -0,0 +1,340 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/XformSampleCache.h"
+
+#include "AL/usdmaya/utils/AttributeType.h"
+#include "AL/usdmaya/utils/Utils.h"
+
+#include <pxr/base/gf/half.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/gf/vec3h.h>
+#include <pxr/base/gf/vec3i.h>
+#include <pxr/usd/usdGeom/tokens.h>
+
+#include <maya/MEulerRotation.h>
+
+#include <algorithm>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace {
+using AL::usdmaya::utils::UsdDataType;
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T> bool readScalar(const UsdAttribute& attr, double time, double* result)
+{
+    T value;
+    if (!attr.Get<T>(&value, time)) {
+        return false;
+    }
+    result[0] = double(value);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T> bool readVec3(const UsdAttribute& attr, double time, double* result)
+{
+    T value;
+    if (!attr.Get<T>(&value, time)) {
+        return false;
+    }
+    result[0] = double(value[0]);
+    result[1] = double(value[1]);
+    result[2] = double(value[2]);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readMatrix(const UsdAttribute& attr, double time, double* result)
+{
+    GfMatrix4d value;
+    if (!attr.Get<GfMatrix4d>(&value, time)) {
+        return false;
+    }
+    std::copy(value.GetArray(), value.GetArray() + 16, result);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readOpSamples(const UsdGeomXformOp& op, bool heldInterpolation, XformOpSamples::Op& samples)
+{
+    bool (*read)(const UsdAttribute&, double, double*) = nullptr;
+
+    // Values that cannot be interpolated are held by USD.
+    samples.held = heldInterpolation;
+    switch (AL::usdmaya::utils::getAttributeType(op.GetTypeName())) {
+    case UsdDataType::kHalf:
+        read = readScalar<GfHalf>;
+        samples.numValues = 1;
+        break;
+    case UsdDataType::kFloat:
+        read = readScalar<float>;
+        samples.numValues = 1;
+        break;
+    case UsdDataType::kDouble:
+        read = readScalar<double>;
+        samples.numValues = 1;
+        break;
+    case UsdDataType::kInt:
+        read = readScalar<int32_t>;
+        samples.numValues = 1;
+        samples.held = true;
+        break;
+    case UsdDataType::kVec3h:
+        read = readVec3<GfVec3h>;
+        samples.numValues = 3;
+        break;
+    case UsdDataType::kVec3f:
+        read = readVec3<GfVec3f>;
+        samples.numValues = 3;
+        break;
+    case UsdDataType::kVec3d:
+        read = readVec3<GfVec3d>;
+        samples.numValues = 3;
+        break;
+    case UsdDataType::kVec3i:
+        read = readVec3<GfVec3i>;
+        samples.numValues = 3;
+        samples.held = true;
+        break;
+    case UsdDataType::kMatrix4d:
+        read = readMatrix;
+        samples.numValues = 16;
+        break;
+    default: return false;
+    }
+
+    const UsdAttribute attr = op.GetAttr();
+    const size_t       numSamples = samples.times.size();
+    samples.values.resize(numSamples * samples.numValues);
+    for (size_t i = 0; i < numSamples; ++i) {
+        // blocked samples are left to USD
+        if (!read(attr, samples.times[i], samples.values.data() + i * samples.numValues)) {
+            return false;
+        }
+    }
+
+    if (samples.numValues == 16) {
+        samples.decomposed.resize(numSamples * 9);
+        for (size_t i = 0; i < numSamples; ++i) {
+            GfMatrix4d matrix;
+            std::copy(
+                samples.values.data() + i * 16,
+                samples.values.data() + (i + 1) * 16,
+                matrix.GetArray());
+
+            double*        S = samples.decomposed.data() + i * 9;
+            double*        T = S + 6;
+            MEulerRotation R;
+            AL::usdmaya::utils::matrixToSRT(matrix, S, R, T);
+            S[3] = R.x;
+            S[4] = R.y;
+            S[5] = R.z;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<std::unique_ptr<XformSampleCache>>& caches()
+{
+    // Never destroyed, so that the notice listeners are not revoked after the notice registry
+    // is destroyed at exit.
+    static auto* caches = new std::vector<std::unique_ptr<XformSampleCache>>();
+    return *caches;
+}
+
+std::mutex g_cachesMutex;
+
+} // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t XformOpSamples::Op::evaluate(double time, size_t& hint, double* result) const
+{
+    const size_t count = times.size();
+    size_t       index = 0;
+    if (time <= times.front()) {
+        index = 0;
+    } else if (time >= times.back()) {
+        index = count - 1;
+    } else {
+        // find the samples such that times[index] <= time < times[index + 1], checking the ones
+        // of the previous evaluation and the following ones first
+        if (hint + 1 < count && times[hint] <= time && time < times[hint + 1]) {
+            index = hint;
+        } else if (hint + 2 < count && times[hint + 1] <= time && time < times[hint + 2]) {
+            index = hint + 1;
+        } else {
+            index = (std::upper_bound(times.begin(), times.end(), time) - times.begin()) - 1;
+        }
+        hint = index;
+
+        if (!held && time != times[index]) {
+            const double  alpha = (time - times[index]) / (times[index + 1] - times[index]);
+            const double* lower = values.data() + index * numValues;
+            const double* upper = lower + numValues;
+            for (size_t i = 0; i < numValues; ++i) {
+                result[i] = (1.0 - alpha) * lower[i] + alpha * upper[i];
+            }
+            return npos;
+        }
+    }
+
+    const double* value = values.data() + index * numValues;
+    std::copy(value, value + numValues, result);
+    return index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+XformSampleCache& XformSampleCache::forStage(const UsdStageWeakPtr& stage)
+{
+    std::lock_guard<std::mutex> lock(g_cachesMutex);
+
+    auto& stageCaches = caches();
+    for (const auto& cache : stageCaches) {
+        if (cache->stage() == stage) {
+            return *cache;
+        }
+    }
+
+    // the caches of the stages that were closed are not needed anymore
+    stageCaches.erase(
+        std::remove_if(
+            stageCaches.begin(),
+            stageCaches.end(),
+            [](const std::unique_ptr<XformSampleCache>& cache) { return !cache->stage(); }),
+        stageCaches.end());
+
+    stageCaches.push_back(std::make_unique<XformSampleCache>(stage));
+    return *stageCaches.back();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+XformSampleCache::XformSampleCache(const UsdStageWeakPtr& stage)
+    : m_stage(stage)
+{
+    TfWeakPtr<XformSampleCache> me(this);
+    m_objectsChangedNoticeKey
+        = TfNotice::Register(me, &XformSampleCache::onObjectsChanged, m_stage);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+XformSampleCache::~XformSampleCache() { TfNotice::Revoke(m_objectsChangedNoticeKey); }
+
+//----------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<const XformOpSamples> XformSampleCache::samples(const UsdGeomXformable& xform)
+{
+    const SdfPath& path = xform.GetPath();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        it = m_entries.find(path);
+        if (it != m_entries.end()) {
+            return it->second;
+        }
+    }
+
+    // read the samples without holding the lock, so that the transforms evaluated in parallel
+    // do not wait for each other
+    const bool heldInterpolation
+        = m_stage && m_stage->GetInterpolationType() == UsdInterpolationTypeHeld;
+    std::shared_ptr<XformOpSamples> entry = readSamples(xform, heldInterpolation);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        inserted = m_entries.emplace(path, entry);
+    return inserted.first->second;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void XformSampleCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        entry.second->valid.store(false, std::memory_order_release);
+    }
+    m_entries.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void XformSampleCache::onObjectsChanged(
+    const UsdNotice::ObjectsChanged& notice,
+    const UsdStageWeakPtr&           sender)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.empty()) {
+        return;
+    }
+
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        invalidate(path.GetPrimPath(), path.IsAbsoluteRootOrPrimPath());
+    }
+
+    // time samples are edited without resyncing the prim
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (!path.IsPropertyPath()) {
+            continue;
+        }
+        const TfToken& name = path.GetNameToken();
+        if (UsdGeomXformOp::IsXformOp(name) || name == UsdGeomTokens->xformOpOrder) {
+            invalidate(path.GetPrimPath(), false);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void XformSampleCache::invalidate(const SdfPath& primPath, bool invalidateDescendants)
+{
+    auto it = m_entries.lower_bound(primPath);
+    while (it != m_entries.end()
+           && (it->first == primPath || (invalidateDescendants && it->first.HasPrefix(primPath)))) {
+        it->second->valid.store(false, std::memory_order_release);
+        it = m_entries.erase(it);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<XformOpSamples>
+XformSampleCache::readSamples(const UsdGeomXformable& xform, bool heldInterpolation)
+{
+    auto result = std::make_shared<XformOpSamples>();
+
+    bool                              resetsXformStack = false;
+    const std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+    result->ops.resize(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const UsdGeomXformOp& op = ops[i];
+        XformOpSamples::Op&   samples = result->ops[i];
+        samples.name = op.GetOpName();
+        if (!op.GetTimeSamples(&samples.times) || samples.times.empty()) {
+            samples.times.clear();
+            continue;
+        }
+
+        result->animated = true;
+        if (!readOpSamples(op, heldInterpolation, samples)) {
+            samples.supported = false;
+            samples.values.clear();
+            samples.decomposed.clear();
+        }
+    }
+    return result;
+}
+
+} // namespace nodes
+} // namespace usdmaya
+} // namespace AL
@@ -0,0 +1,153 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "AL/usdmaya/Api.h"
+
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The time samples of the xform ops of a prim, read once from USD into contiguous
+///         buffers so that evaluating them at a new time does not query USD.
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+struct XformOpSamples
+{
+    /// \brief  The time samples of a single xform op.
+    struct Op
+    {
+        /// \brief  Evaluates the op at the given time, interpolating between the samples that
+        ///         surround it and clamping to the first and last samples.
+        /// \param  time the time to evaluate
+        /// \param  hint the index of the samples found by the previous evaluation, which are
+        ///         checked first since the time usually moves forward one frame at a time
+        /// \param  result receives numValues values
+        /// \return the index of the sample used when the value was not interpolated, or
+        ///         XformOpSamples::npos otherwise
+        AL_USDMAYA_PUBLIC
+        size_t evaluate(double time, size_t& hint, double* result) const;
+
+        /// the name of the op
+        TfToken name;
+
+        /// the times of the samples, in increasing order
+        std::vector<double> times;
+
+        /// numValues values per sample
+        std::vector<double> values;
+
+        /// for matrix ops, the scale, rotation (in radians, in XYZ order) and translation
+        /// decomposed from each sample
+        std::vector<double> decomposed;
+
+        /// the number of values per sample: 1 for single axis rotations, 3 for vectors, 16 for
+        /// matrices
+        size_t numValues = 0;
+
+        /// true when the values are held between samples rather than linearly interpolated
+        bool held = false;
+
+        /// false when the op has samples that could not be cached and must be read from USD
+        bool supported = true;
+    };
+
+    /// \brief  returned by Op::evaluate when the value is interpolated
+    static constexpr size_t npos = ~size_t(0);
+
+    /// \brief  Returns true until the samples are changed in USD.
+    inline bool isValid() const { return valid.load(std::memory_order_acquire); }
+
+    /// one entry per op, in the order returned by UsdGeomXformable::GetOrderedXformOps
+    std::vector<Op> ops;
+
+    /// true if any of the ops has time samples
+    bool animated = false;
+
+    /// cleared when the samples are changed in USD
+    std::atomic<bool> valid { true };
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Caches the xform op samples of the prims of a stage, for the transforms that animate
+///         them. The samples of each prim are read the first time they are requested, and
+///         dropped when the xform ops of the prim change in the stage.
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+class XformSampleCache : public TfWeakBase
+{
+public:
+    /// \brief  Returns the cache of the given stage, creating it if needed.
+    /// \param  stage the stage
+    AL_USDMAYA_PUBLIC
+    static XformSampleCache& forStage(const UsdStageWeakPtr& stage);
+
+    /// \brief  ctor
+    /// \param  stage the stage whose changes invalidate the samples
+    XformSampleCache(const UsdStageWeakPtr& stage);
+
+    /// \brief  dtor
+    ~XformSampleCache();
+
+    /// \brief  Returns the samples of the xform ops of the given prim. Safe to call from
+    ///         multiple threads.
+    /// \param  xform the prim
+    AL_USDMAYA_PUBLIC
+    std::shared_ptr<const XformOpSamples> samples(const UsdGeomXformable& xform);
+
+    /// \brief  Drops all the samples.
+    AL_USDMAYA_PUBLIC
+    void clear();
+
+    /// \brief  Returns the stage of the cache.
+    inline const UsdStageWeakPtr& stage() const { return m_stage; }
+
+private:
+    void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender);
+    void invalidate(const SdfPath& primPath, bool invalidateDescendants);
+
+    static std::shared_ptr<XformOpSamples>
+    readSamples(const UsdGeomXformable& xform, bool heldInterpolation);
+
+    UsdStageWeakPtr m_stage;
+    TfNotice::Key   m_objectsChangedNoticeKey;
+    std::mutex      m_mutex;
+
+    // sorted by path, so that the entries of a subtree are contiguous
+    std::map<SdfPath, std::shared_ptr<XformOpSamples>> m_entries;
+};
+
+} // namespace nodes
+} // namespace usdmaya
+} // namespace AL
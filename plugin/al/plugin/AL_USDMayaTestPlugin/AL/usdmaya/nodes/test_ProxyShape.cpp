@@ -25,9 +25,12 @@
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/usdaFileFormat.h>
+#include <pxr/usd/usdGeom/cube.h>
+#include <pxr/usd/usdGeom/imageable.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
+#include <maya/MBoundingBox.h>
 #include <maya/MCommonSystemUtils.h>
 #include <maya/MDagModifier.h>
 #include <maya/MFileIO.h>
@@ -1313,7 +1316,63 @@ TEST(ManualTranslate, roundtripMergedMeshPrim)
 TEST(ProxyShape, destroyTransformReferences) { AL_USDMAYA_UNTESTED; }
 
 // MBoundingBox boundingBox() const override;
-TEST(ProxyShape, boundingBox) { AL_USDMAYA_UNTESTED; }
+TEST(ProxyShape, boundingBox)
+{
+    MFileIO::newFile(true);
+
+    const std::string temp_path = buildTempPath("AL_USDMayaTests_boundingBox.usda");
+    {
+        UsdStageRefPtr stage = UsdStage::CreateInMemory();
+        UsdGeomXform::Define(stage, SdfPath("/root"));
+        UsdGeomXform::Define(stage, SdfPath("/root/a"));
+        UsdGeomXform::Define(stage, SdfPath("/root/b"));
+        UsdGeomCube::Define(stage, SdfPath("/root/a/cube"));
+        UsdGeomCube::Define(stage, SdfPath("/root/b/cube"));
+        UsdGeomXformCommonAPI(stage->GetPrimAtPath(SdfPath("/root/b")))
+            .SetTranslate(GfVec3d(10.0, 0.0, 0.0));
+        stage->Export(temp_path, false);
+    }
+
+    MFnDagNode fn;
+    MObject    xform = fn.create("transform");
+    MObject    shape = fn.create("AL_usdmaya_ProxyShape", xform);
+
+    AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+    proxy->filePathPlug().setString(temp_path.c_str());
+
+    auto stage = proxy->getUsdStage();
+    ASSERT_TRUE(stage);
+
+    MBoundingBox box = proxy->boundingBox();
+    EXPECT_NEAR(-1.0, box.min().x, 1e-5);
+    EXPECT_NEAR(11.0, box.max().x, 1e-5);
+    EXPECT_NEAR(1.0, box.max().y, 1e-5);
+
+    // moving one of the prims updates the bounds
+    UsdGeomXformCommonAPI(stage->GetPrimAtPath(SdfPath("/root/a")))
+        .SetTranslate(GfVec3d(0.0, 5.0, 0.0));
+    box = proxy->boundingBox();
+    EXPECT_NEAR(-1.0, box.min().x, 1e-5);
+    EXPECT_NEAR(11.0, box.max().x, 1e-5);
+    EXPECT_NEAR(6.0, box.max().y, 1e-5);
+
+    // so does hiding it
+    UsdGeomImageable(stage->GetPrimAtPath(SdfPath("/root/b"))).MakeInvisible();
+    box = proxy->boundingBox();
+    EXPECT_NEAR(-1.0, box.min().x, 1e-5);
+    EXPECT_NEAR(1.0, box.max().x, 1e-5);
+    EXPECT_NEAR(6.0, box.max().y, 1e-5);
+
+    // and removing one
+    UsdGeomImageable(stage->GetPrimAtPath(SdfPath("/root/b"))).MakeVisible();
+    stage->RemovePrim(SdfPath("/root/a"));
+    box = proxy->boundingBox();
+    EXPECT_NEAR(9.0, box.min().x, 1e-5);
+    EXPECT_NEAR(11.0, box.max().x, 1e-5);
+    EXPECT_NEAR(1.0, box.max().y, 1e-5);
+
+    MFileIO::newFile(true);
+}
 
 // std::vector<UsdPrim> huntForNativeNodesUnderPrim(const MDagPath& proxyTransformPath, SdfPath
 // startPath);
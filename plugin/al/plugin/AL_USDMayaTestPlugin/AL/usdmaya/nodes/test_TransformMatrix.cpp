@@ -1573,3 +1573,49 @@ TEST(Transform, checkTwistedRotation)
         }
     }
 }
+
+TEST(Transform, animationValuesAreInterpolatedBetweenSamples)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform   xform = UsdGeomXform::Define(stage, SdfPath("/tm"));
+    UsdGeomXformOp translate = xform.AddTranslateOp(UsdGeomXformOp::PrecisionDouble);
+    UsdGeomXformOp rotate = xform.AddRotateXOp(UsdGeomXformOp::PrecisionFloat);
+    translate.Set(GfVec3d(0.0, 0.0, 0.0), UsdTimeCode(0.0));
+    translate.Set(GfVec3d(10.0, 20.0, 30.0), UsdTimeCode(10.0));
+    rotate.Set(0.0f, UsdTimeCode(0.0));
+    rotate.Set(90.0f, UsdTimeCode(10.0));
+
+    AL::usdmaya::nodes::TransformationMatrix tm;
+    tm.enableReadAnimatedValues(true);
+    tm.setPrim(xform.GetPrim(), nullptr);
+
+    auto expectValuesAt = [&](double time) {
+        tm.updateToTime(UsdTimeCode(time));
+
+        GfVec3d usdTranslation;
+        float   usdRotation = 0.0f;
+        ASSERT_TRUE(translate.Get(&usdTranslation, UsdTimeCode(time)));
+        ASSERT_TRUE(rotate.Get(&usdRotation, UsdTimeCode(time)));
+
+        const MVector T = tm.translation(MSpace::kTransform);
+        EXPECT_NEAR(usdTranslation[0], T.x, 1e-5f);
+        EXPECT_NEAR(usdTranslation[1], T.y, 1e-5f);
+        EXPECT_NEAR(usdTranslation[2], T.z, 1e-5f);
+
+        const MEulerRotation R = tm.eulerRotation(MSpace::kTransform);
+        EXPECT_NEAR(usdRotation * M_PI / 180.0, R.x, 1e-5f);
+    };
+
+    // before, on, between and after the samples, forwards and backwards
+    for (double time : { -1.0, 0.0, 2.5, 5.0, 10.0, 12.0, 7.5, 0.5 }) {
+        expectValuesAt(time);
+    }
+
+    // edited samples are read again
+    translate.Set(GfVec3d(-10.0, -20.0, -30.0), UsdTimeCode(20.0));
+    expectValuesAt(15.0);
+
+    // as well as the interpolation of the stage
+    stage->SetInterpolationType(UsdInterpolationTypeHeld);
+    expectValuesAt(5.0);
+}
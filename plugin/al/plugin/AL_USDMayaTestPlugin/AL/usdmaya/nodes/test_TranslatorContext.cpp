@@ -264,6 +264,60 @@ TEST(TranslatorContext, TranslatorContext)
             MObjectHandle handle;
             EXPECT_FALSE(context->getTransform(SdfPath("/root/rig"), handle));
         }
+
+        {
+            obj = fnd.create("polyCube");
+            auto checkMapping = [&]() {
+                AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+                context->getMObjects(SdfPath("/root/rig"), handles);
+                ASSERT_EQ(handles.size(), 1u);
+                EXPECT_TRUE(handles[0].object() == obj);
+                MObjectHandle handle;
+                context->getTransform(SdfPath("/root/rig"), handle);
+                EXPECT_TRUE(handle.object() == rigObj);
+                EXPECT_EQ(
+                    "schematype:ALMayaReference",
+                    context->getTranslatorIdForPath(SdfPath("/root/rig")));
+                EXPECT_EQ(42u, context->getUniqueKeyForPath(SdfPath("/root/rig")));
+            };
+
+            // contexts saved by older versions are stored as text
+            MString legacyText = MString("/root/rig=schematype:ALMayaReference,")
+                + MFnDagNode(rigObj).fullPathName() + "," + MFnDependencyNode(obj).name()
+                + ",uniquekey:42;";
+            context->clearPrimMappings();
+            context->deserialise(legacyText);
+            checkMapping();
+
+            // and saved back in the binary format
+            MString text = context->serialise();
+            EXPECT_EQ(0u, std::string(text.asChar()).find("ALTrCtx1:"));
+            context->clearPrimMappings();
+            context->deserialise(text);
+            checkMapping();
+
+            // empty created node names are kept as null nodes
+            auto checkNullNode = [&]() {
+                AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+                context->getMObjects(SdfPath("/root/rig"), handles);
+                ASSERT_EQ(handles.size(), 2u);
+                EXPECT_TRUE(handles[0].object().isNull());
+                EXPECT_TRUE(handles[1].object() == obj);
+            };
+            MString nullNodeText = MString("/root/rig=schematype:ALMayaReference,")
+                + MFnDagNode(rigObj).fullPathName() + ",," + MFnDependencyNode(obj).name()
+                + ",uniquekey:42;";
+            context->clearPrimMappings();
+            context->deserialise(nullNodeText);
+            checkNullNode();
+
+            text = context->serialise();
+            context->clearPrimMappings();
+            context->deserialise(text);
+            checkNullNode();
+
+            context->removeItems(SdfPath("/root/rig"));
+        }
     }
 }
 
@@ -173,6 +173,85 @@ class testLayerManagerSerialization(unittest.TestCase):
 
         shutil.rmtree(self._currentTestDir)
 
+    def testSaveAllToMayaCompressed(self):
+        '''
+        Verify that all USD edits are saved compressed into the Maya file.
+        '''
+        stage = self.copyTestFilesAndMakeEdits()
+
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsLocation', 2))
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsCompressed', 1))
+
+        try:
+            # Saving twice stores the layers exported by the first save again.
+            cmds.file(save=True, force=True)
+            cmds.file(save=True, force=True)
+        finally:
+            cmds.optionVar(remove='mayaUsd_SerializedUsdEditsCompressed')
+
+        with open(self._tempMayaFile) as mayaFile:
+            mayaFileContent = mayaFile.read()
+        self.assertIn('#mayaUsdCompressed', mayaFileContent)
+        self.assertNotIn('ChangeInLayer_1_1', mayaFileContent)
+
+        cmds.file(new=True, force=True)
+        cmds.file(self._tempMayaFile, open=True)
+
+        stage = mayaUsd.ufe.getStage(
+            "|SerializationTest|SerializationTestShape")
+        stack = stage.GetLayerStack()
+        self.assertEqual(6, len(stack))
+
+        newPrimPath = "/ChangeInRoot"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        newPrimPath = "/ChangeInLayer_1_1"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        newPrimPath = "/ChangeInSessionLayer"
+        self.assertTrue(stage.GetPrimAtPath(newPrimPath))
+
+        self.confirmEditsSavedStatus(False, False)
+
+        shutil.rmtree(self._currentTestDir)
+
+    def testCompressedRelativeSubLayers(self):
+        '''
+        Verify that the layers of a compressed save are restored when the Maya
+        file is opened, even when they are reached through relative sub-layer
+        paths, which composition resolves without the layer manager.
+        '''
+        self.copyTestFilesAndMakeEdits()
+
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsLocation', 2))
+        cmds.optionVar(intValue=('mayaUsd_SerializedUsdEditsCompressed', 1))
+        try:
+            cmds.file(save=True, force=True)
+        finally:
+            cmds.optionVar(remove='mayaUsd_SerializedUsdEditsCompressed')
+
+        cmds.file(new=True, force=True)
+        cmds.file(self._tempMayaFile, open=True)
+
+        # The root layer refers to the edited layer as './SerializationTest_1.usda',
+        # which refers to './SerializationTest_1_1.usda'.
+        rootLayer = Sdf.Layer.Find(self._rootUsdFile)
+        self.assertTrue(rootLayer)
+        self.assertIn('./SerializationTest_1.usda', rootLayer.subLayerPaths)
+
+        # The layer opened by composition holds the edits stored in the Maya file.
+        layer_1_1 = Sdf.Layer.Find(self._test1_1File)
+        self.assertTrue(layer_1_1)
+        self.assertTrue(layer_1_1.GetPrimAtPath('/ChangeInLayer_1_1'))
+        self.assertTrue(layer_1_1.dirty)
+
+        # A new stage on the root layer composes the edits as well.
+        stage = Usd.Stage.Open(rootLayer)
+        self.assertTrue(stage.GetPrimAtPath('/ChangeInRoot'))
+        self.assertTrue(stage.GetPrimAtPath('/ChangeInLayer_1_1'))
+
+        shutil.rmtree(self._currentTestDir)
+
     def testSaveAllToUsd(self):
         '''
         Verify that all USD edits are saved back to the original .usd files
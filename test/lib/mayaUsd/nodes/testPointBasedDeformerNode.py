@@ -110,6 +110,48 @@ class testPointBasedDeformerNode(unittest.TestCase):
         self._ValidateControlPoint(testCube, 2, Gf.Vec3d(-1.0, 0.0, 1.0))
         self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.0, 1.0, 1.0))
 
+    def testCubeWithEnvelopeAndWeights(self):
+        """
+        Tests that the envelope and the painted weights of a point based
+        deformer node blend the Maya and USD points, and that changing the prim
+        path is taken into account.
+        """
+        testCube = cmds.polyCube(depth=1.0, height=1.0, width=1.0)[0]
+
+        stageNode = cmds.createNode('pxrUsdStageNode')
+        cmds.setAttr('%s.filePath' % stageNode, self._deformingCubeUsdFilePath,
+            type='string')
+
+        cmds.select(testCube, replace=True)
+        deformerNode = cmds.deformer(type='pxrUsdPointBasedDeformerNode')[0]
+        cmds.setAttr('%s.primPath' % deformerNode, self._deformingCubePrimPath,
+            type='string')
+        cmds.connectAttr('%s.outUsdStage' % stageNode,
+            '%s.inUsdStage' % deformerNode)
+        cmds.currentTime(self.START_TIMECODE)
+
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-1.0, -1.0, 1.0))
+
+        # Half way between the Maya cube and the USD cube.
+        cmds.setAttr('%s.envelope' % deformerNode, 0.5)
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.75, -0.75, 0.75))
+        self._ValidateControlPoint(testCube, 1, Gf.Vec3d(0.75, -0.75, 0.75))
+
+        # A point with a zero weight is not deformed.
+        cmds.setAttr('%s.envelope' % deformerNode, 1.0)
+        cmds.percent(deformerNode, '%s.vtx[1]' % testCube, value=0.0)
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-1.0, -1.0, 1.0))
+        self._ValidateControlPoint(testCube, 1, Gf.Vec3d(0.5, -0.5, 0.5))
+
+        # An invalid prim path fails the deformation, leaving the Maya points
+        # as they are, and a valid one restores it.
+        cmds.setAttr('%s.primPath' % deformerNode, '/DoesNotExist', type='string')
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.5, -0.5, 0.5))
+        self._ValidateControlPoint(testCube, 1, Gf.Vec3d(0.5, -0.5, 0.5))
+        cmds.setAttr('%s.primPath' % deformerNode, self._deformingCubePrimPath,
+            type='string')
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-1.0, -1.0, 1.0))
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -64,6 +64,35 @@ class testProxyShapeBase(unittest.TestCase):
         bboxSize = cmds.getAttr('Cube_usd.boundingBoxSize')[0]
         self.assertEqual(bboxSize, (1.0, 1.0, 1.0))
 
+    def testBoundingBoxAnimatedAndEdited(self):
+        '''
+        Verify that the bounding box follows animated transforms and edits of the stage.
+        '''
+        cmds.file(new=True, force=True)
+
+        proxyShape, stage = mayaUtils.createProxyAndStage()
+        UsdGeom.Cube.Define(stage, '/Static').CreateSizeAttr(2.0)
+        animated = UsdGeom.Xform.Define(stage, '/Animated')
+        UsdGeom.Cube.Define(stage, '/Animated/Cube').CreateSizeAttr(2.0)
+        translateOp = animated.AddTranslateOp()
+        translateOp.Set((0.0, 0.0, 0.0), 1.0)
+        translateOp.Set((10.0, 0.0, 0.0), 10.0)
+
+        bboxSizeAttr = proxyShape + '.boundingBoxSize'
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr(bboxSizeAttr)[0], (2.0, 2.0, 2.0))
+        cmds.currentTime(10)
+        self.assertEqual(cmds.getAttr(bboxSizeAttr)[0], (12.0, 2.0, 2.0))
+
+        # Editing the static geometry must update the cached bounds.
+        stage.GetPrimAtPath('/Static').GetAttribute('size').Set(4.0)
+        self.assertEqual(cmds.getAttr(bboxSizeAttr)[0], (13.0, 4.0, 4.0))
+
+        # Hiding the animated branch leaves only the static geometry.
+        UsdGeom.Imageable(animated).MakeInvisible()
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr(bboxSizeAttr)[0], (4.0, 4.0, 4.0))
+
     def testDuplicateProxyStageAnonymous(self):
         '''
         Verify stage with new anonymous layer is duplicated properly.
@@ -0,0 +1,161 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import imageUtils
+import mayaUtils
+
+from maya import cmds
+
+from pxr import Sdf
+from pxr import UsdGeom
+
+import os
+import time
+import unittest
+
+
+class testVP2RenderDelegateDirtyPropagation(imageUtils.ImageDiffingTestCase):
+    """
+    Tests that rprims whose render tag is not drawn still pick up the changes
+    made while they were hidden: the guide meshes of the proxy shape must draw
+    in the current display mode and selection state once the guide purpose is
+    turned back on.
+
+    Set MAYAUSD_RUN_BENCHMARKS=1 to also time the viewport refreshes dirtying
+    many rprims on a large synthetic stage.
+    """
+
+    NUM_MESHES = 8
+    NUM_BENCHMARK_MESHES = 20000
+    NUM_ITERATIONS = 5
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__, initializeStandalone=False, loadPlugin=False)
+
+        cls._testDir = os.path.abspath('.')
+
+    def setUp(self):
+        self._panel = mayaUtils.activeModelPanel()
+
+    def tearDown(self):
+        cmds.modelEditor(self._panel, edit=True, displayAppearance='smoothShaded')
+        cmds.select(clear=True)
+
+    def _CreateStage(self, numMeshes, drawGuidePurpose=False):
+        cmds.file(force=True, new=True)
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+        self._proxyShape, stage = mayaUtils.createProxyAndStage()
+        cmds.setAttr('%s.drawGuidePurpose' % self._proxyShape, drawGuidePurpose)
+
+        # One quad per mesh, a quarter of them with the guide purpose.
+        with Sdf.ChangeBlock():
+            for i in range(numMeshes):
+                mesh = UsdGeom.Mesh.Define(stage, '/Root/Mesh%d' % i)
+                x = (i % 200) * 1.5
+                z = (i // 200) * 1.5
+                mesh.CreatePointsAttr([
+                    (x, 0, z), (x + 1, 0, z), (x + 1, 0, z + 1), (x, 0, z + 1)])
+                mesh.CreateFaceVertexCountsAttr([4])
+                mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3])
+                if i % 4 == 0:
+                    mesh.CreatePurposeAttr(UsdGeom.Tokens.guide)
+
+        cmds.viewFit(all=True)
+        cmds.refresh(force=True)
+
+    def _ShowGuidesAndSnapshot(self, imageName):
+        cmds.setAttr('%s.drawGuidePurpose' % self._proxyShape, True)
+        cmds.viewFit(all=True)
+        cmds.refresh(force=True)
+
+        imagePath = os.path.join(self._testDir, imageName)
+        imageUtils.snapshot(imagePath, width=960, height=540)
+        return imagePath
+
+    def testDisplayModeChangedWhileGuidesHidden(self):
+        # Switch to wireframe while the guide meshes are not drawn.
+        self._CreateStage(self.NUM_MESHES)
+        cmds.modelEditor(self._panel, edit=True, displayAppearance='wireframe')
+        cmds.refresh(force=True)
+        deferredImage = self._ShowGuidesAndSnapshot('displayModeDeferred.png')
+
+        # Reference: the guide meshes are drawn when switching to wireframe.
+        cmds.modelEditor(self._panel, edit=True, displayAppearance='smoothShaded')
+        self._CreateStage(self.NUM_MESHES, drawGuidePurpose=True)
+        cmds.modelEditor(self._panel, edit=True, displayAppearance='wireframe')
+        cmds.refresh(force=True)
+        referenceImage = self._ShowGuidesAndSnapshot('displayModeReference.png')
+
+        self.assertImagesClose(referenceImage, deferredImage)
+
+    def testSelectionChangedWhileGuidesHidden(self):
+        # Select the proxy shape while the guide meshes are not drawn.
+        self._CreateStage(self.NUM_MESHES)
+        cmds.select(self._proxyShape, replace=True)
+        cmds.refresh(force=True)
+        deferredImage = self._ShowGuidesAndSnapshot('selectionDeferred.png')
+
+        # Reference: the guide meshes are drawn when selecting the proxy shape.
+        cmds.select(clear=True)
+        self._CreateStage(self.NUM_MESHES, drawGuidePurpose=True)
+        cmds.select(self._proxyShape, replace=True)
+        cmds.refresh(force=True)
+        referenceImage = self._ShowGuidesAndSnapshot('selectionReference.png')
+
+        self.assertImagesClose(referenceImage, deferredImage)
+
+    def _TimeRefreshes(self, label, changeFunc):
+        start = time.time()
+        for i in range(self.NUM_ITERATIONS):
+            changeFunc(i)
+            cmds.refresh(force=True)
+        elapsed = (time.time() - start) / self.NUM_ITERATIONS
+        print('%s: %.1f ms per refresh with %d meshes'
+              % (label, elapsed * 1000.0, self.NUM_BENCHMARK_MESHES))
+
+    @unittest.skipUnless(os.environ.get('MAYAUSD_RUN_BENCHMARKS'),
+                         'Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark')
+    def testToggleGuidePurposeBenchmark(self):
+        self._CreateStage(self.NUM_BENCHMARK_MESHES)
+        attrName = '%s.drawGuidePurpose' % self._proxyShape
+        self._TimeRefreshes(
+            'Toggle guide purpose', lambda i: cmds.setAttr(attrName, i % 2 == 0))
+
+    @unittest.skipUnless(os.environ.get('MAYAUSD_RUN_BENCHMARKS'),
+                         'Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark')
+    def testToggleDisplayModeBenchmark(self):
+        self._CreateStage(self.NUM_BENCHMARK_MESHES)
+        self._TimeRefreshes(
+            'Toggle display mode',
+            lambda i: cmds.modelEditor(
+                self._panel, edit=True,
+                displayAppearance='wireframe' if i % 2 == 0 else 'smoothShaded'))
+
+    @unittest.skipUnless(os.environ.get('MAYAUSD_RUN_BENCHMARKS'),
+                         'Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark')
+    def testToggleProxyShapeSelectionBenchmark(self):
+        self._CreateStage(self.NUM_BENCHMARK_MESHES)
+        self._TimeRefreshes(
+            'Toggle proxy shape selection',
+            lambda i: cmds.select(self._proxyShape, replace=True) if i % 2 == 0
+                else cmds.select(clear=True))
+
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
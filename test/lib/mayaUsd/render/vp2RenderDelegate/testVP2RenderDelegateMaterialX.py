@@ -31,6 +31,8 @@ from pxr import Usd
 import ufe
 
 import os
+import shutil
+import time
 import unittest
 
 
@@ -160,7 +162,7 @@ class testVP2RenderDelegateMaterialX(imageUtils.ImageDiffingTestCase):
         cmds.rotate(-90, 0, 0, 'persp')
         self.assertSnapshotClose('transparencyScene.png', 960, 960)
 
-    def testDemoQuads(self):
+    def _SetUpDemoQuads(self):
         cmds.file(force=True, new=True)
 
         cmds.move(0, 8, 0, 'persp')
@@ -174,8 +176,89 @@ class testVP2RenderDelegateMaterialX(imageUtils.ImageDiffingTestCase):
         panel = mayaUtils.activeModelPanel()
         cmds.modelEditor(panel, edit=True, lights=True, displayLights="all", displayTextures=True)
 
+    def testDemoQuads(self):
+        self._SetUpDemoQuads()
         self._StartTest('DemoQuads')
 
+    def testAsyncFragmentGeneration(self):
+        """Fragments generated on worker threads replace the fallback shader once ready."""
+        optVarName = 'mayaUsd_AsyncMaterialXGeneration'
+        cmds.optionVar(iv=(optVarName, 1))
+
+        try:
+            self._SetUpDemoQuads()
+            mayaUtils.loadPlugin("mayaUsdPlugin")
+
+            # The shaders cached in memory by the previous tests are cleared, so that the
+            # fragments are generated.
+            mayaUsdLib.ClearVP2RenderDelegateShaderCache()
+            stats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+
+            self._testName = 'DemoQuads'
+            testFile = testUtils.getTestScene("MaterialX", self._testName + ".usda")
+            mayaUtils.createProxyFromFile(testFile)
+            ufe.GlobalSelection.get().clear()
+            cmds.refresh(force=True)
+
+            # The prims are drawn with the fallback shader until their fragments are generated.
+            asyncStats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            self.assertGreater(
+                asyncStats['mtlxFragmentFallbackCount'], stats['mtlxFragmentFallbackCount'])
+
+            # The materials are synced again on idle, once their fragments are generated.
+            deadline = time.time() + 60.0
+            while mayaUsdLib.GetVP2RenderDelegateStatistics()['mtlxFragmentPendingJobs'] > 0:
+                if time.time() > deadline:
+                    self.fail('The MaterialX fragments were not generated in time')
+                cmds.flushIdleQueue()
+            cmds.flushIdleQueue()
+            cmds.refresh(force=True)
+
+            self.assertSnapshotClose('%s_render.png' % self._testName)
+        finally:
+            cmds.optionVar(remove=optVarName)
+
+    def testFragmentDiskCache(self):
+        """Fragments generated for MaterialX materials are stored on disk and reused."""
+        optVarName = 'mayaUsd_MaterialXCacheDirectory'
+        cacheDir = os.path.join(self._testDir, 'MaterialXCache')
+        shutil.rmtree(cacheDir, ignore_errors=True)
+        cmds.optionVar(sv=(optVarName, cacheDir))
+
+        def cachedFragments():
+            return sorted(f for f in os.listdir(cacheDir) if f.endswith('.vp2frag'))
+
+        try:
+            # The first render generates the fragments and stores them. The shaders cached in
+            # memory by the previous tests are cleared, so that the fragments are generated.
+            mayaUsdLib.ClearVP2RenderDelegateShaderCache()
+            stats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            self.testDemoQuads()
+            fragments = cachedFragments()
+            self.assertTrue(fragments)
+            generatedStats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            self.assertGreaterEqual(
+                generatedStats['mtlxFragmentGeneratedCount'] - stats['mtlxFragmentGeneratedCount'],
+                len(fragments))
+            self.assertEqual(
+                generatedStats['mtlxFragmentCacheReadCount'], stats['mtlxFragmentCacheReadCount'])
+
+            # Rendering again without the shaders cached in memory reads the stored fragments
+            # instead of generating them.
+            mayaUsdLib.ClearVP2RenderDelegateShaderCache()
+            self.testDemoQuads()
+            self.assertEqual(cachedFragments(), fragments)
+            readStats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            self.assertEqual(
+                readStats['mtlxFragmentGeneratedCount'],
+                generatedStats['mtlxFragmentGeneratedCount'])
+            self.assertGreaterEqual(
+                readStats['mtlxFragmentCacheReadCount']
+                - generatedStats['mtlxFragmentCacheReadCount'],
+                len(fragments))
+        finally:
+            cmds.optionVar(remove=optVarName)
+
     def testWithEnabledMaterialX(self):
         """Make sure the absence of MAYAUSD_VP2_USE_ONLY_PREVIEWSURFACE env var has an effect."""
         cmds.file(force=True, new=True)
@@ -0,0 +1,148 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import imageUtils
+import mayaUtils
+
+from mayaUsd import lib as mayaUsdLib
+
+from maya import cmds
+
+from pxr import Gf, Sdf, UsdGeom, UsdShade, Vt
+
+import os
+
+
+class testVP2RenderDelegateMeshTopologySharing(imageUtils.ImageDiffingTestCase):
+    """
+    Tests that copies of a mesh share their topology data in the Viewport 2.0 render
+    delegate, and that editing the topology of one copy does not affect the other ones.
+    """
+
+    # Grid of COLUMNS x ROWS quads, the first half of the faces are in a geom subset.
+    COLUMNS = 4
+    ROWS = 2
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__, initializeStandalone=False, loadPlugin=False)
+
+        cls._testDir = os.path.abspath('.')
+
+        mayaUtils.loadPlugin("mayaUsdPlugin")
+
+    def _snapshot(self, imageName):
+        snapshotImage = os.path.join(self._testDir, imageName)
+        imageUtils.snapshot(snapshotImage, width=960, height=540)
+        return snapshotImage
+
+    def _gridTopology(self, numFaces):
+        counts = []
+        indices = []
+        for face in range(numFaces):
+            row, column = divmod(face, self.COLUMNS)
+            first = row * (self.COLUMNS + 1) + column
+            counts.append(4)
+            indices += [first, first + 1, first + self.COLUMNS + 2, first + self.COLUMNS + 1]
+        return Vt.IntArray(counts), Vt.IntArray(indices)
+
+    def _createMaterial(self, stage, name, color):
+        material = UsdShade.Material.Define(stage, '/Materials/' + name)
+        shader = UsdShade.Shader.Define(stage, '/Materials/%s/Surface' % name)
+        shader.CreateIdAttr('UsdPreviewSurface')
+        shader.CreateInput('diffuseColor', Sdf.ValueTypeNames.Color3f).Set(color)
+        material.CreateSurfaceOutput().ConnectToSource(
+            shader.ConnectableAPI(), UsdShade.Tokens.surface)
+        return material
+
+    def _createGrid(self, stage, path, offset, numFaces, material, subsetMaterial=None):
+        mesh = UsdGeom.Mesh.Define(stage, path)
+        points = [Gf.Vec3f(x + offset[0], y + offset[1], 0.0)
+                  for y in range(self.ROWS + 1) for x in range(self.COLUMNS + 1)]
+        mesh.CreatePointsAttr(points)
+        counts, indices = self._gridTopology(numFaces)
+        mesh.CreateFaceVertexCountsAttr(counts)
+        mesh.CreateFaceVertexIndicesAttr(indices)
+        mesh.CreateSubdivisionSchemeAttr(UsdGeom.Tokens.none)
+
+        bindingAPI = UsdShade.MaterialBindingAPI.Apply(mesh.GetPrim())
+        bindingAPI.Bind(material)
+        if subsetMaterial:
+            subsetFaces = list(range(self.COLUMNS * self.ROWS // 2))
+            subset = bindingAPI.CreateMaterialBindSubset('half', Vt.IntArray(subsetFaces))
+            UsdShade.MaterialBindingAPI.Apply(subset.GetPrim()).Bind(subsetMaterial)
+        return mesh
+
+    def _createScene(self, numEditedFaces):
+        '''Create two copies of a grid with a geom subset and two copies without. The first copy
+        of each pair has numEditedFaces faces.'''
+        cmds.file(force=True, new=True)
+        cmds.xform('persp', translation=(5, 2.5, 16), rotation=(0, 0, 0), worldSpace=True)
+
+        _, stage = mayaUtils.createProxyAndStage()
+        blue = self._createMaterial(stage, 'Blue', Gf.Vec3f(0.1, 0.1, 0.8))
+        red = self._createMaterial(stage, 'Red', Gf.Vec3f(0.8, 0.1, 0.1))
+
+        numFaces = self.COLUMNS * self.ROWS
+        self._createGrid(stage, '/SubsetMesh1', (0, 0), numEditedFaces, blue, red)
+        self._createGrid(stage, '/SubsetMesh2', (0, 3), numFaces, blue, red)
+        self._createGrid(stage, '/WholeMesh1', (6, 0), numEditedFaces, blue)
+        self._createGrid(stage, '/WholeMesh2', (6, 3), numFaces, blue)
+
+        cmds.select(clear=True)
+        cmds.refresh(force=True)
+        return stage
+
+    def testEditSharedTopology(self):
+        numFaces = self.COLUMNS * self.ROWS
+        numEditedFaces = numFaces - 2
+
+        # Reference image, each mesh being authored with its final topology.
+        self._createScene(numEditedFaces)
+        referenceImage = self._snapshot('meshTopologySharing_reference.png')
+
+        # The four copies have the same topology, geom subsets aside.
+        stage = self._createScene(numFaces)
+        stats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+        self.assertEqual(stats['meshTopologyMisses'], 1)
+        self.assertEqual(stats['meshTopologyHits'], 3)
+        self.assertEqual(stats['meshTopologyEntries'], 1)
+
+        # Remove the last faces of the first copy of each pair. The edited copies share a new
+        # entry, the other copies keep the initial one.
+        counts, indices = self._gridTopology(numEditedFaces)
+        for path in ('/SubsetMesh1', '/WholeMesh1'):
+            mesh = UsdGeom.Mesh(stage.GetPrimAtPath(path))
+            with Sdf.ChangeBlock():
+                mesh.GetFaceVertexCountsAttr().Set(counts)
+                mesh.GetFaceVertexIndicesAttr().Set(indices)
+        cmds.refresh(force=True)
+
+        stats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+        self.assertEqual(stats['meshTopologyMisses'], 2)
+        self.assertEqual(stats['meshTopologyHits'], 4)
+        self.assertEqual(stats['meshTopologyEntries'], 2)
+
+        # Both the geom subset items and the whole mesh items draw the edited topology of the
+        # edited copies, and the initial topology of the other ones.
+        editedImage = self._snapshot('meshTopologySharing_edited.png')
+        self.assertImagesClose(referenceImage, editedImage)
+
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -21,9 +21,13 @@ import imageUtils
 import mayaUtils
 import testUtils
 
+from mayaUsd import lib as mayaUsdLib
+
 from maya import cmds
 
 import os
+import shutil
+import time
 
 class testVP2RenderDelegateTextureLoading(imageUtils.ImageDiffingTestCase):
     """
@@ -66,6 +70,20 @@ class testVP2RenderDelegateTextureLoading(imageUtils.ImageDiffingTestCase):
         imageUtils.snapshot(snapshot_image, width=768, height=768)
         return self.assertImagesClose(baseline_image, snapshot_image)
 
+    def _waitForTextureLoading(self, timeout=60.0):
+        """Wait until all the textures are decoded and acquired on idle."""
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            # Decoding starts on draw, the decoded textures are acquired on idle.
+            cmds.refresh(force=True)
+            cmds.flushIdleQueue()
+            stats = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            if stats['textureLoadingTasks'] == 0 and stats['textureDecodePendingJobs'] == 0:
+                return stats
+            time.sleep(0.01)
+        self.fail('Textures still loading after %d seconds: %s'
+                  % (timeout, mayaUsdLib.GetVP2RenderDelegateStatistics()))
+
     def testTextureLoadingSync(self):
         cmds.file(force=True, new=True)
 
@@ -111,18 +129,174 @@ class testVP2RenderDelegateTextureLoading(imageUtils.ImageDiffingTestCase):
         shapeNode, _ = mayaUtils.createProxyFromFile(testFile)
         cmds.select(cl=True)
 
-        # Force all idle tasks to finish
-        cmds.flushIdleQueue()
+        # Wait for the background decoding and the idle tasks to finish
+        self._waitForTextureLoading()
         self.assertSnapshotClose("TextureLoading_Proxy_Async.png")
 
         # Switch purpose to "render"
         cmds.setAttr("{}.drawProxyPurpose".format(shapeNode), 0)
         cmds.setAttr("{}.drawRenderPurpose".format(shapeNode), 1)
 
-        # Force all idle tasks to finish
-        cmds.flushIdleQueue()
+        # Wait for the background decoding and the idle tasks to finish
+        self._waitForTextureLoading()
         self.assertSnapshotClose("TextureLoading_Render_Async.png")
 
+    def testTextureLoadingBackgroundDecode(self):
+        """Textures decoded on the worker threads are acquired and their tasks released."""
+        cmds.file(force=True, new=True)
+        cmds.optionVar(iv=(self._optVarName, 0))
+
+        threadsOptVarName = "mayaUsd_AsyncTextureLoadingThreads"
+        cmds.optionVar(iv=(threadsOptVarName, 2))
+
+        try:
+            cmds.xform("persp", t=(2, 2, 5.8))
+            cmds.xform("persp", ro=[0, 0, 0], ws=True)
+
+            panel = mayaUtils.activeModelPanel()
+            cmds.modelEditor(panel, edit=True, lights=False, displayLights="default",
+                             displayTextures=True)
+
+            decodedCount = mayaUsdLib.GetVP2RenderDelegateStatistics()['textureDecodedCount']
+
+            testFile = testUtils.getTestScene("multipleMaterialsAssignment",
+                                              "MultipleMaterialsAssignment.usda")
+            mayaUtils.createProxyFromFile(testFile)
+            cmds.select(cl=True)
+
+            # The textures went through the decode queue, and no task is left behind.
+            stats = self._waitForTextureLoading()
+            self.assertGreater(stats['textureDecodedCount'], decodedCount)
+            self.assertEqual(stats['textureLoadingTasks'], 0)
+            self.assertSnapshotClose("TextureLoading_Proxy_Async.png")
+
+            # The tasks of the textures still decoding when the stage goes away are released.
+            cmds.file(force=True, new=True)
+            mayaUtils.createProxyFromFile(testFile)
+            cmds.refresh(force=True)
+            cmds.file(force=True, new=True)
+            stats = self._waitForTextureLoading()
+            self.assertEqual(stats['textureLoadingTasks'], 0)
+        finally:
+            cmds.optionVar(remove=threadsOptVarName)
+
+    def _loadTexturedScene(self):
+        cmds.file(force=True, new=True)
+        cmds.optionVar(iv=(self._optVarName, 0))
+
+        panel = mayaUtils.activeModelPanel()
+        cmds.modelEditor(panel, edit=True, displayTextures=True)
+
+        testFile = testUtils.getTestScene("multipleMaterialsAssignment",
+                                          "MultipleMaterialsAssignment.usda")
+        mayaUtils.createProxyFromFile(testFile)
+        cmds.select(cl=True)
+        return self._waitForTextureLoading()
+
+    def _unloadScene(self):
+        cmds.file(force=True, new=True)
+        # Textures of deleted materials are released on idle.
+        cmds.flushIdleQueue()
+        return mayaUsdLib.GetVP2RenderDelegateStatistics()
+
+    def testTextureMemoryBudget(self):
+        """Unused textures stay loaded under a budget, until the budget is removed."""
+        budgetOptVarName = "mayaUsd_TextureMemoryBudget"
+        cmds.optionVar(iv=(budgetOptVarName, 1))
+
+        try:
+            loaded = self._loadTexturedScene()
+            self.assertGreater(loaded['textureResidentCount'], 0)
+            self.assertLessEqual(loaded['textureResidentBytes'], 1 << 20)
+
+            # Without any material using them, the textures are kept within the budget...
+            unloaded = self._unloadScene()
+            self.assertEqual(unloaded['textureResidentCount'], loaded['textureResidentCount'])
+            self.assertEqual(unloaded['textureEvictedCount'], loaded['textureEvictedCount'])
+
+            # ...and reused without being decoded again.
+            reloaded = self._loadTexturedScene()
+            self.assertEqual(reloaded['textureDecodedCount'], loaded['textureDecodedCount'])
+
+            # Once the budget is removed, the unused textures are evicted.
+            self._unloadScene()
+            cmds.optionVar(remove=budgetOptVarName)
+            withoutBudget = self._loadTexturedScene()
+            self.assertGreater(withoutBudget['textureEvictedCount'],
+                               reloaded['textureEvictedCount'])
+            self.assertGreater(withoutBudget['textureDecodedCount'],
+                               reloaded['textureDecodedCount'])
+        finally:
+            cmds.optionVar(remove=budgetOptVarName)
+            self._unloadScene()
+
+    def testReducedResolutionCache(self):
+        """Textures are reduced to the maximum resolution and cached on disk."""
+        resolutionOptVarName = "mayaUsd_TextureMaxResolution"
+        cacheOptVarName = "mayaUsd_TextureCacheDirectory"
+        cacheDir = os.path.join(self._test_dir, "TextureCache")
+        shutil.rmtree(cacheDir, ignore_errors=True)
+
+        # The test textures are 8x8.
+        cmds.optionVar(iv=(resolutionOptVarName, 4))
+        cmds.optionVar(sv=(cacheOptVarName, cacheDir))
+
+        def cachedTextures():
+            if not os.path.isdir(cacheDir):
+                return []
+            return sorted(os.path.join(cacheDir, f)
+                          for f in os.listdir(cacheDir) if f.endswith(".vp2tex"))
+
+        try:
+            before = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            reduced = self._loadTexturedScene()
+            self.assertGreater(reduced['textureReducedCount'], before['textureReducedCount'])
+            self.assertEqual(reduced['textureCacheReadCount'], before['textureCacheReadCount'])
+            files = cachedTextures()
+            self.assertTrue(files)
+
+            # Loading the textures again reads the reduced texels from the cache.
+            self._unloadScene()
+            cached = self._loadTexturedScene()
+            self.assertEqual(cached['textureCacheReadCount'] - reduced['textureCacheReadCount'],
+                             len(files))
+
+            # Truncated cache files are ignored and the textures are decoded again.
+            for f in files:
+                with open(f, "r+b") as cacheFile:
+                    cacheFile.truncate(os.path.getsize(f) // 2)
+            self._unloadScene()
+            decoded = self._loadTexturedScene()
+            self.assertEqual(decoded['textureCacheReadCount'], cached['textureCacheReadCount'])
+            self.assertGreater(decoded['textureReducedCount'], cached['textureReducedCount'])
+        finally:
+            cmds.optionVar(remove=resolutionOptVarName)
+            cmds.optionVar(remove=cacheOptVarName)
+            self._unloadScene()
+
+    def testReducedTextureReuse(self):
+        """Textures loaded at a reduced resolution are found again instead of being decoded."""
+        budgetOptVarName = "mayaUsd_TextureMemoryBudget"
+        resolutionOptVarName = "mayaUsd_TextureMaxResolution"
+        cmds.optionVar(iv=(budgetOptVarName, 1))
+        # The test textures are 8x8.
+        cmds.optionVar(iv=(resolutionOptVarName, 4))
+
+        try:
+            before = mayaUsdLib.GetVP2RenderDelegateStatistics()
+            reduced = self._loadTexturedScene()
+            self.assertGreater(reduced['textureReducedCount'], before['textureReducedCount'])
+
+            # The reduced textures are kept within the budget and reused.
+            self._unloadScene()
+            reloaded = self._loadTexturedScene()
+            self.assertEqual(reloaded['textureDecodedCount'], reduced['textureDecodedCount'])
+            self.assertEqual(reloaded['textureReducedCount'], reduced['textureReducedCount'])
+        finally:
+            cmds.optionVar(remove=budgetOptVarName)
+            cmds.optionVar(remove=resolutionOptVarName)
+            self._unloadScene()
+
 
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
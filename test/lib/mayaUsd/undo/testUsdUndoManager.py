@@ -19,7 +19,7 @@ import unittest
 
 import maya.cmds as cmds
 
-from pxr import Tf, Usd, UsdGeom, Gf
+from pxr import Tf, Usd, UsdGeom, Gf, Sdf
 
 import mayaUsd.lib as mayaUsdLib
 import mayaUtils
@@ -141,3 +141,67 @@ class TestUsdUndoManager(unittest.TestCase):
         self.assertTrue(stage.GetPrimAtPath('/TreeBase'))
         self.assertTrue(stage.GetPrimAtPath('/TreeBase/leavesXform/leaves'))
         self.assertTrue(stage.GetPrimAtPath('/TreeBase/trunk'))
+
+    def testCoalescedEdits(self):
+        '''
+            Repeated edits to the same attribute within a block are undone
+            and redone to the right values.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        with mayaUsdLib.UsdUndoBlock():
+            prim = self.stage.DefinePrim('/World')
+            attr = prim.CreateAttribute('value', Sdf.ValueTypeNames.Double)
+            attr.Set(-1.0)
+            attr.Set(-2.0, 1.0)
+
+        with mayaUsdLib.UsdUndoBlock():
+            for i in range(1000):
+                attr.Set(float(i))
+                attr.Set(float(i), 1.0)
+            self.stage.DefinePrim('/World/Child')
+            for i in range(1000):
+                attr.Set(float(i) + 0.5)
+
+        self.assertEqual(attr.Get(), 999.5)
+        self.assertEqual(attr.Get(1.0), 999.0)
+
+        cmds.undo()
+        self.assertEqual(attr.Get(), -1.0)
+        self.assertEqual(attr.Get(1.0), -2.0)
+        self.assertFalse(self.stage.GetPrimAtPath('/World/Child'))
+
+        cmds.redo()
+        self.assertEqual(attr.Get(), 999.5)
+        self.assertEqual(attr.Get(1.0), 999.0)
+        self.assertTrue(self.stage.GetPrimAtPath('/World/Child'))
+
+    def testMemoryBudget(self):
+        '''
+            The edits of the oldest operations are discarded when the
+            memory budget is exceeded.
+        '''
+        # start with a new file
+        cmds.file(force=True, new=True)
+
+        budget = mayaUsdLib.UsdUndoManager.getMemoryBudget()
+        try:
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(64 * 1024)
+
+            with mayaUsdLib.UsdUndoBlock():
+                prim = self.stage.DefinePrim('/World')
+                attr = prim.CreateAttribute('points', Sdf.ValueTypeNames.Point3fArray)
+                attr.Set([(0, 0, 0)] * 10000)
+
+            for i in range(1, 4):
+                with mayaUsdLib.UsdUndoBlock():
+                    attr.Set([(i, i, i)] * 10000)
+
+            self.assertLessEqual(mayaUsdLib.UsdUndoManager.getMemoryUsage(), 256 * 1024)
+
+            # the last operation can still be undone
+            cmds.undo()
+            self.assertEqual(attr.Get()[0], Gf.Vec3f(2, 2, 2))
+        finally:
+            mayaUsdLib.UsdUndoManager.setMemoryBudget(budget)
@@ -0,0 +1,282 @@
+#include <mayaUsd/fileio/flexibleSparseValueWriter.h>
+
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <utility>
+
+#include <gtest/gtest.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+UsdAttribute createAttribute(const SdfValueTypeName& typeName)
+{
+    static UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    static int            count = 0;
+
+    UsdPrim prim = stage->DefinePrim(SdfPath(TfStringPrintf("/Prim%d", ++count)));
+    return prim.CreateAttribute(TfToken("value"), typeName);
+}
+
+VtVec3fArray makePoints(float offset)
+{
+    VtVec3fArray points(4);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = GfVec3f(static_cast<float>(i) + offset, 1.0f, 2.0f);
+    }
+    return points;
+}
+
+} // namespace
+
+TEST(FlexibleSparseValueWriter, skipsIdenticalSamples)
+{
+    UsdAttribute              attr = createAttribute(SdfValueTypeNames->Point3fArray);
+    FlexibleSparseValueWriter writer;
+
+    for (int frame = 1; frame <= 5; ++frame) {
+        VtVec3fArray points = makePoints(0.0f);
+        EXPECT_TRUE(writer.SetAttribute(attr, points, UsdTimeCode(frame)));
+        // The typed overloads swap the value out.
+        EXPECT_TRUE(points.empty());
+    }
+    VtVec3fArray points = makePoints(1.0f);
+    EXPECT_TRUE(writer.SetAttribute(attr, points, UsdTimeCode(6.0)));
+
+    // The last identical sample is written to hold the value until the change.
+    std::vector<double> times;
+    attr.GetTimeSamples(&times);
+    EXPECT_EQ(times, std::vector<double>({ 1.0, 5.0, 6.0 }));
+    EXPECT_EQ(writer.GetNumWrittenSamples(), 3u);
+    EXPECT_EQ(writer.GetNumSkippedSamples(), 4u);
+
+    VtVec3fArray value;
+    EXPECT_TRUE(attr.Get(&value, UsdTimeCode(6.0)));
+    EXPECT_EQ(value, makePoints(1.0f));
+}
+
+TEST(FlexibleSparseValueWriter, firstSampleComparedToDefault)
+{
+    UsdAttribute attr = createAttribute(SdfValueTypeNames->FloatArray);
+    attr.Set(VtFloatArray(3, 1.0f));
+
+    FlexibleSparseValueWriter writer(false);
+    for (int frame = 1; frame <= 3; ++frame) {
+        VtFloatArray values(3, 1.0f);
+        EXPECT_TRUE(writer.SetAttribute(attr, values, UsdTimeCode(frame)));
+    }
+
+    EXPECT_EQ(attr.GetNumTimeSamples(), 0u);
+    EXPECT_EQ(writer.GetNumSkippedSamples(), 3u);
+}
+
+TEST(FlexibleSparseValueWriter, skipsNearEqualSamplesByDefault)
+{
+    UsdAttribute              attr = createAttribute(SdfValueTypeNames->Point3fArray);
+    FlexibleSparseValueWriter writer;
+    EXPECT_EQ(writer.GetTolerance(), 1e-6);
+
+    // Floating-point noise well under the tolerance does not produce time samples.
+    const float noise[] = { 0.0f, 1e-8f, -1e-8f, 2e-8f, 0.5f };
+    for (int frame = 0; frame < 5; ++frame) {
+        VtVec3fArray points = makePoints(noise[frame]);
+        EXPECT_TRUE(writer.SetAttribute(attr, points, UsdTimeCode(frame)));
+    }
+
+    std::vector<double> times;
+    attr.GetTimeSamples(&times);
+    EXPECT_EQ(times, std::vector<double>({ 0.0, 3.0, 4.0 }));
+    EXPECT_EQ(writer.GetNumSkippedSamples(), 3u);
+}
+
+TEST(FlexibleSparseValueWriter, typedPathMatchesValuePath)
+{
+    // The VtValue overloads go through UsdUtilsSparseValueWriter: the typed overloads
+    // must skip the same near-equal samples.
+    const float noise[] = { 0.0f, 1e-8f, 1e-8f, 1e-3f, 1e-3f + 1e-8f, 2e-3f, 2e-3f, 1.0f };
+    const int   numFrames = sizeof(noise) / sizeof(noise[0]);
+
+    UsdAttribute              typedPoints = createAttribute(SdfValueTypeNames->Point3fArray);
+    UsdAttribute              valuePoints = createAttribute(SdfValueTypeNames->Point3fArray);
+    UsdAttribute              typedFloats = createAttribute(SdfValueTypeNames->FloatArray);
+    UsdAttribute              valueFloats = createAttribute(SdfValueTypeNames->FloatArray);
+    UsdAttribute              typedMatrix = createAttribute(SdfValueTypeNames->Matrix4d);
+    UsdAttribute              valueMatrix = createAttribute(SdfValueTypeNames->Matrix4d);
+    FlexibleSparseValueWriter writer;
+
+    for (int frame = 0; frame < numFrames; ++frame) {
+        const UsdTimeCode time(frame);
+
+        VtVec3fArray points = makePoints(noise[frame]);
+        VtValue      pointsValue(points);
+        writer.SetAttribute(typedPoints, points, time);
+        writer.SetAttribute(valuePoints, &pointsValue, time);
+
+        VtFloatArray floats(3, noise[frame]);
+        VtValue      floatsValue(floats);
+        writer.SetAttribute(typedFloats, floats, time);
+        writer.SetAttribute(valueFloats, &floatsValue, time);
+
+        GfMatrix4d matrix(1.0);
+        matrix.SetTranslate(GfVec3d(noise[frame], 0.0, 0.0));
+        VtValue matrixValue(matrix);
+        writer.SetAttribute(typedMatrix, matrix, time);
+        writer.SetAttribute(valueMatrix, &matrixValue, time);
+    }
+    writer.Clear();
+
+    const std::pair<UsdAttribute, UsdAttribute> pairs[]
+        = { { typedPoints, valuePoints },
+            { typedFloats, valueFloats },
+            { typedMatrix, valueMatrix } };
+    for (const auto& pair : pairs) {
+        std::vector<double> typedTimes;
+        std::vector<double> valueTimes;
+        pair.first.GetTimeSamples(&typedTimes);
+        pair.second.GetTimeSamples(&valueTimes);
+        EXPECT_EQ(typedTimes, valueTimes) << pair.first.GetPath().GetText();
+        EXPECT_LT(typedTimes.size(), static_cast<size_t>(numFrames));
+        for (double t : typedTimes) {
+            VtValue typedValue;
+            VtValue valueValue;
+            pair.first.Get(&typedValue, t);
+            pair.second.Get(&valueValue, t);
+            EXPECT_EQ(typedValue, valueValue) << pair.first.GetPath().GetText();
+        }
+    }
+}
+
+TEST(FlexibleSparseValueWriter, exactComparisonWithZeroTolerance)
+{
+    UsdAttribute              attr = createAttribute(SdfValueTypeNames->Point3fArray);
+    FlexibleSparseValueWriter writer;
+    writer.SetTolerance(0.0);
+
+    // A drift much smaller than the default tolerance is exported.
+    const int numFrames = 100;
+    for (int frame = 0; frame < numFrames; ++frame) {
+        VtVec3fArray points = makePoints(1e-5f * frame);
+        EXPECT_TRUE(writer.SetAttribute(attr, points, UsdTimeCode(frame)));
+    }
+
+    EXPECT_EQ(attr.GetNumTimeSamples(), static_cast<size_t>(numFrames));
+    EXPECT_EQ(writer.GetNumSkippedSamples(), 0u);
+}
+
+TEST(FlexibleSparseValueWriter, intArrays)
+{
+    UsdAttribute              attr = createAttribute(SdfValueTypeNames->IntArray);
+    FlexibleSparseValueWriter writer;
+    writer.SetTolerance(1.0);
+
+    const int values[] = { 1, 1, 2, 2 };
+    for (int frame = 0; frame < 4; ++frame) {
+        VtIntArray array(3, values[frame]);
+        EXPECT_TRUE(writer.SetAttribute(attr, array, UsdTimeCode(frame)));
+    }
+
+    // Integers are always compared exactly.
+    std::vector<double> times;
+    attr.GetTimeSamples(&times);
+    EXPECT_EQ(times, std::vector<double>({ 0.0, 1.0, 2.0 }));
+}
+
+TEST(FlexibleSparseValueWriter, matrices)
+{
+    UsdAttribute              attr = createAttribute(SdfValueTypeNames->Matrix4d);
+    FlexibleSparseValueWriter writer;
+
+    GfMatrix4d identity(1.0);
+    GfMatrix4d translated(1.0);
+    translated.SetTranslate(GfVec3d(1e-3, 0.0, 0.0));
+
+    const GfMatrix4d samples[] = { identity, identity, translated, translated };
+    for (int frame = 0; frame < 4; ++frame) {
+        GfMatrix4d matrix = samples[frame];
+        EXPECT_TRUE(writer.SetAttribute(attr, matrix, UsdTimeCode(frame)));
+    }
+
+    // The first sample is written since the attribute has no default value.
+    std::vector<double> times;
+    attr.GetTimeSamples(&times);
+    EXPECT_EQ(times, std::vector<double>({ 0.0, 1.0, 2.0 }));
+
+    GfMatrix4d value;
+    EXPECT_TRUE(attr.Get(&value, UsdTimeCode(3.0)));
+    EXPECT_EQ(value, translated);
+}
+
+TEST(FlexibleSparseValueWriter, stagedSamplesMatchTypedPath)
+{
+    UsdAttribute typedAttr = createAttribute(SdfValueTypeNames->FloatArray);
+    UsdAttribute stagedAttr = createAttribute(SdfValueTypeNames->FloatArray);
+
+    FlexibleSparseValueWriter typedWriter;
+    FlexibleSparseValueWriter stagedWriter;
+    stagedWriter.SetStaging(true);
+
+    const float ramp[] = { 0.0f, 0.0f, 1e-7f, 1e-7f, 1e-7f, 2.0f, 2.0f };
+    for (int frame = 0; frame < 7; ++frame) {
+        VtFloatArray typedValue(1, ramp[frame]);
+        typedWriter.SetAttribute(typedAttr, typedValue, UsdTimeCode(frame));
+
+        VtFloatArray stagedValue(1, ramp[frame]);
+        stagedWriter.SetAttribute(stagedAttr, stagedValue, UsdTimeCode(frame));
+        stagedWriter.TakeStagedSamples();
+        stagedWriter.ProcessTakenSamples();
+        stagedWriter.AuthorProcessedSamples();
+    }
+
+    std::vector<double> typedTimes;
+    std::vector<double> stagedTimes;
+    typedAttr.GetTimeSamples(&typedTimes);
+    stagedAttr.GetTimeSamples(&stagedTimes);
+    EXPECT_EQ(typedTimes, stagedTimes);
+    EXPECT_EQ(typedTimes, std::vector<double>({ 0.0, 4.0, 5.0 }));
+}
+
+TEST(FlexibleSparseValueWriter, stagedSamplesMatchValuePath)
+{
+    // Every floating-point type is staged as a VtValue: the staged samples must be
+    // compared like UsdUtilsSparseValueWriter compares the samples of the serial export.
+    const double noise[] = { 0.0, 1e-9, -1e-9, 1e-3, 1e-3 + 1e-9, 1.0 };
+    const int    numFrames = sizeof(noise) / sizeof(noise[0]);
+
+    const SdfValueTypeName typeNames[]
+        = { SdfValueTypeNames->Double, SdfValueTypeNames->Double3, SdfValueTypeNames->Float2Array };
+    for (const SdfValueTypeName& typeName : typeNames) {
+        UsdAttribute serialAttr = createAttribute(typeName);
+        UsdAttribute stagedAttr = createAttribute(typeName);
+
+        FlexibleSparseValueWriter serialWriter;
+        FlexibleSparseValueWriter stagedWriter;
+        stagedWriter.SetStaging(true);
+
+        for (int frame = 0; frame < numFrames; ++frame) {
+            VtValue value;
+            if (typeName == SdfValueTypeNames->Double) {
+                value = VtValue(1.0 + noise[frame]);
+            } else if (typeName == SdfValueTypeNames->Double3) {
+                value = VtValue(GfVec3d(noise[frame], 2.0, 3.0));
+            } else {
+                value = VtValue(VtVec2fArray(2, GfVec2f(static_cast<float>(noise[frame]))));
+            }
+            VtValue stagedValue(value);
+            serialWriter.SetAttribute(serialAttr, &value, UsdTimeCode(frame));
+            stagedWriter.SetAttribute(stagedAttr, &stagedValue, UsdTimeCode(frame));
+            stagedWriter.TakeStagedSamples();
+            stagedWriter.ProcessTakenSamples();
+            stagedWriter.AuthorProcessedSamples();
+        }
+
+        std::vector<double> serialTimes;
+        std::vector<double> stagedTimes;
+        serialAttr.GetTimeSamples(&serialTimes);
+        stagedAttr.GetTimeSamples(&stagedTimes);
+        EXPECT_EQ(serialTimes, stagedTimes) << typeName.GetAsToken().GetText();
+        EXPECT_EQ(stagedTimes, std::vector<double>({ 0.0, 2.0, 3.0, 4.0, 5.0 }))
+            << typeName.GetAsToken().GetText();
+    }
+}
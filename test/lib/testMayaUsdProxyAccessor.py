@@ -872,6 +872,42 @@ class MayaUsdProxyAccessorTestCase(unittest.TestCase):
         v0 = cmds.getAttr('{}.{}'.format(nodeDagPath,worldMatrixPlug))
         self.assertVectorAlmostEqual(v0, [0.0, 0.0, -1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -5.0, 5.0, 0.0, 1.0])
     
+    def validateOutputValueResolution(self, cachingScope):
+        """
+        Validate that outputs follow the changes to the value resolution of their attribute, i.e.
+        opinions authored in a stronger layer and time samples authored over a default value.
+        """
+        nodeDagPath,stage = createProxyAndStage()
+        prim = stage.DefinePrim('/Prim')
+        attr = prim.CreateAttribute('value', Sdf.ValueTypeNames.Double)
+        attr.Set(1.0)
+
+        ufeItem = createUfeSceneItem(nodeDagPath,'/Prim')
+        valuePlug = pa.getOrCreateAccessPlug(ufeItem, usdAttrName='value')
+
+        cachingScope.waitForCache()
+
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr('{}.{}'.format(nodeDagPath,valuePlug)), 1.0)
+
+        # Author a stronger opinion in the session layer
+        with Usd.EditContext(stage, stage.GetSessionLayer()):
+            attr.Set(2.0)
+        cachingScope.waitForCache()
+
+        self.assertEqual(cmds.getAttr('{}.{}'.format(nodeDagPath,valuePlug)), 2.0)
+
+        # Time samples override the default value of the same layer
+        with Usd.EditContext(stage, stage.GetSessionLayer()):
+            attr.Set(3.0, 1)
+            attr.Set(4.0, 100)
+        cachingScope.waitForCache()
+
+        cmds.currentTime(1)
+        self.assertEqual(cmds.getAttr('{}.{}'.format(nodeDagPath,valuePlug)), 3.0)
+        cmds.currentTime(100)
+        self.assertEqual(cmds.getAttr('{}.{}'.format(nodeDagPath,valuePlug)), 4.0)
+
     ###################################################################################
     def testOutput_NoCaching(self):
         """
@@ -1138,3 +1174,23 @@ class MayaUsdProxyAccessorTestCase(unittest.TestCase):
         with CachingScope(self) as thisScope:
             thisScope.verifyScopeSetup()
             self.validateRecursiveCompute(thisScope)
+
+    def testOutputValueResolution_NoCaching(self):
+        """
+        Validate that outputs follow the changes to the value resolution of their attribute.
+        Cached playback is disabled in this test.
+        """
+        cmds.file(new=True, force=True)
+        with NonCachingScope(self) as thisScope:
+            thisScope.verifyScopeSetup()
+            self.validateOutputValueResolution(thisScope)
+
+    def testOutputValueResolution_Caching(self):
+        """
+        Validate that outputs follow the changes to the value resolution of their attribute.
+        Cached playback is ENABLED in this test.
+        """
+        cmds.file(new=True, force=True)
+        with CachingScope(self) as thisScope:
+            thisScope.verifyScopeSetup()
+            self.validateOutputValueResolution(thisScope)
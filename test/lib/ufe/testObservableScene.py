@@ -21,11 +21,13 @@ import fixturesUtils
 from maya import standalone
 from maya import cmds
 import mayaUtils
+import mayaUsd_createStageWithNewLayer
 
-from pxr import Usd
+from pxr import Sdf, Usd
 import ufe
 
 from mayaUsd import lib as mayaUsdLib
+import usdUfe
 
 import os
 import sys
@@ -163,7 +165,59 @@ class UFEObservableSceneTest(unittest.TestCase):
         # state was cleared from the session layer.
         sessionLayer.Clear()
         self.checkNotifications(snObs, [1,1,0,0,0,0])
-        
+
+        ufe.Scene.removeObserver(snObs)
+
+    def testDestroyedDescendantOfInvalidatedPrim(self):
+        cmds.file(new=True, force=True)
+
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsdLib.GetPrim(proxyShape).GetStage()
+        stage.DefinePrim('/Root', 'Xform')
+        stage.DefinePrim('/Root/Child', 'Xform')
+
+        snObs = TestObserver()
+        ufe.Scene.addObserver(snObs)
+
+        # Deleting a prim and editing its parent within a single notification
+        # guard must still notify the deletion of the child: its parent is only
+        # invalidated, and observers tracking the child must hear that it is gone.
+        guard = usdUfe.SceneChangedNotificationGuard()
+        stage.RemovePrim('/Root/Child')
+        stage.GetPrimAtPath('/Root').SetTypeName('Scope')
+        self.checkNotifications(snObs, [0,0,0,0,0,0])
+        del guard
+        self.checkNotifications(snObs, [0,1,0,1,0,0])
+
+        ufe.Scene.removeObserver(snObs)
+
+    def testCollapsedDescendantNotifications(self):
+        cmds.file(new=True, force=True)
+
+        proxyShape = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        stage = mayaUsdLib.GetPrim(proxyShape).GetStage()
+
+        snObs = TestObserver()
+        ufe.Scene.addObserver(snObs)
+
+        # Adding a prim and its descendants in a single change block only
+        # notifies the addition of the top-most prim.
+        with Sdf.ChangeBlock():
+            stage.DefinePrim('/Root', 'Xform')
+            for i in range(100):
+                stage.DefinePrim('/Root/Child%d' % i, 'Xform')
+                stage.DefinePrim('/Root/Child%d/GrandChild' % i, 'Xform')
+        self.checkNotifications(snObs, [1,0,0,0,0,0])
+
+        # Deactivating a prim and some of its descendants only notifies the
+        # deletion of the top-most prim.
+        with Sdf.ChangeBlock():
+            stage.GetPrimAtPath('/Root/Child0/GrandChild').SetActive(False)
+            stage.GetPrimAtPath('/Root').SetActive(False)
+        self.checkNotifications(snObs, [1,1,0,0,0,0])
+
+        ufe.Scene.removeObserver(snObs)
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -0,0 +1,162 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import fixturesUtils
+import mayaUtils
+import usdUtils
+
+from pxr import Sdf
+
+from maya import cmds
+from maya import standalone
+
+import usdUfe
+
+import ufe
+
+import unittest
+
+
+class PathConversionTestCase(unittest.TestCase):
+    '''Verify the cached conversions between UFE and USD paths.'''
+
+    pluginsLoaded = False
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.readOnlySetUpClass(__file__, loadPlugin=False)
+
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        cmds.file(new=True, force=True)
+
+        standalone.uninitialize()
+
+    def setUp(self):
+        self.assertTrue(self.pluginsLoaded)
+
+        cmds.file(new=True, force=True)
+        self.proxyShape, self.stage = mayaUtils.createProxyAndStage()
+
+    def _createPrims(self, count):
+        usdPaths = []
+        for i in range(count):
+            usdPath = '/Group%d/Xform%d' % (i // 100, i)
+            self.stage.DefinePrim(usdPath, 'Xform')
+            usdPaths.append(usdPath)
+        return usdPaths
+
+    def _ufePath(self, usdPath):
+        return self.proxyShape + ',' + usdPath
+
+    def testRoundTrip(self):
+        '''Converting the same paths again gives the same results.'''
+        usdPaths = self._createPrims(10)
+
+        for attempt in range(2):
+            for usdPath in usdPaths:
+                self.assertEqual(
+                    usdUfe.usdPathToUfePathSegment(Sdf.Path(usdPath)), usdPath)
+                self.assertEqual(
+                    usdUfe.ufePathToSdfPrimPath(self._ufePath(usdPath)), Sdf.Path(usdPath))
+                prim = usdUfe.ufePathToPrim(self._ufePath(usdPath))
+                self.assertTrue(prim)
+                self.assertEqual(prim.GetPath(), Sdf.Path(usdPath))
+
+        # Instance indices and properties are not part of the prim path.
+        self.assertEqual(
+            usdUfe.usdPathToUfePathSegment(Sdf.Path(usdPaths[0]), 3), usdPaths[0] + '/3')
+        self.assertEqual(
+            usdUfe.ufePathToSdfPrimPath(self._ufePath(usdPaths[0] + '/3')),
+            Sdf.Path(usdPaths[0]))
+        self.assertEqual(
+            usdUfe.ufePathToSdfPrimPath(self._ufePath(usdPaths[0] + '.visibility')),
+            Sdf.Path(usdPaths[0]))
+
+        # The proxy shape alone has no USD path.
+        self.assertEqual(usdUfe.ufePathToSdfPrimPath(self.proxyShape), Sdf.Path())
+
+    def testRenameProxyShape(self):
+        '''The prims are found under the new name of a renamed proxy shape.'''
+        usdPaths = self._createPrims(10)
+        for usdPath in usdPaths:
+            self.assertTrue(usdUfe.ufePathToPrim(self._ufePath(usdPath)))
+
+        proxyTransform = cmds.listRelatives(self.proxyShape, parent=True, fullPath=True)[0]
+        cmds.rename(proxyTransform, 'renamedStage')
+        renamedShape = cmds.listRelatives('renamedStage', shapes=True, fullPath=True)[0]
+
+        for usdPath in usdPaths:
+            self.assertFalse(usdUfe.ufePathToPrim(self._ufePath(usdPath)))
+            prim = usdUfe.ufePathToPrim(renamedShape + ',' + usdPath)
+            self.assertTrue(prim)
+            self.assertEqual(prim.GetPath(), Sdf.Path(usdPath))
+
+    def testSelectionLoop(self):
+        '''Selecting the same prims again converts their paths from the caches.'''
+        usdPaths = self._createPrims(1000)
+        shapeSegment = mayaUtils.createUfePathSegment(self.proxyShape)
+        ufePaths = [ufe.Path([shapeSegment, usdUtils.createUfePathSegment(p)])
+                    for p in usdPaths]
+
+        def selectAll():
+            selection = ufe.Selection()
+            for ufePath in ufePaths:
+                selection.append(ufe.Hierarchy.createItem(ufePath))
+            ufe.GlobalSelection.get().replaceWith(selection)
+            self.assertEqual(len(ufe.GlobalSelection.get()), len(ufePaths))
+
+        usdUfe.clearPathConversionCaches()
+        stats = usdUfe.getPathConversionStatistics()
+        self.assertEqual(stats['usdToUfeEntries'], 0)
+        self.assertEqual(stats['ufeToUsdEntries'], 0)
+
+        # The first selection parses the path of every selected prim.
+        selectAll()
+        firstStats = usdUfe.getPathConversionStatistics()
+        self.assertGreaterEqual(firstStats['ufeToUsdEntries'], len(ufePaths))
+        self.assertGreaterEqual(firstStats['misses'] - stats['misses'], len(ufePaths))
+
+        # Selecting them again only finds cached conversions.
+        for i in range(3):
+            selectAll()
+        cachedStats = usdUfe.getPathConversionStatistics()
+        self.assertEqual(cachedStats['misses'], firstStats['misses'])
+        self.assertGreaterEqual(cachedStats['hits'] - firstStats['hits'], 3 * len(ufePaths))
+        self.assertEqual(cachedStats['ufeToUsdEntries'], firstStats['ufeToUsdEntries'])
+        self.assertEqual(cachedStats['usdToUfeEntries'], firstStats['usdToUfeEntries'])
+
+        ufe.GlobalSelection.get().clear()
+
+        # Clearing the caches converts the paths again.
+        usdUfe.clearPathConversionCaches()
+        stats = usdUfe.getPathConversionStatistics()
+        self.assertEqual(stats['usdToUfeEntries'], 0)
+        self.assertEqual(stats['ufeToUsdEntries'], 0)
+        selectAll()
+        stats = usdUfe.getPathConversionStatistics()
+        self.assertGreaterEqual(stats['misses'] - cachedStats['misses'], len(ufePaths))
+
+        ufe.GlobalSelection.get().clear()
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
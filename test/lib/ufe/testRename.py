@@ -147,8 +147,21 @@ class RenameTestCase(unittest.TestCase):
         ball35PathStr = ','.join(
             [str(segment) for segment in ball35Path.segments])
 
+        rebuildCount = mayaUsd.ufe.getStageMapRebuildCount()
         assertStageAndPrimAccess(mayaSegment, ball35PathStr, usdSegment)
 
+        # Reparent the transform of the proxy shape.  The stage map should
+        # follow the tracked proxy shape without searching the whole scene.
+        cmds.group('|transform1', name='potatoGroup', world=True)
+        mayaSegment = mayaUtils.createUfePathSegment(
+            "|potatoGroup|transform1|potato")
+        ball35Path = ufe.Path([mayaSegment, usdSegment])
+        ball35PathStr = ','.join(
+            [str(segment) for segment in ball35Path.segments])
+
+        assertStageAndPrimAccess(mayaSegment, ball35PathStr, usdSegment)
+        self.assertEqual(mayaUsd.ufe.getStageMapRebuildCount(), rebuildCount)
+
     def testRename(self):
         '''
         Testing renaming a USD node.
@@ -0,0 +1,147 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import time
+import unittest
+
+import fixturesUtils
+from maya import cmds
+from maya import standalone
+from pxr import Sdf, Usd
+
+
+class testUsdExportParallelFrameWrite(unittest.TestCase):
+    """Check that the parallelFrameWrite export of a generated crowd-like scene
+    authors exactly the same layer as the serial animated export.
+
+    Set MAYAUSD_RUN_BENCHMARKS=1 to also compare the frames-per-second of both
+    exports on a larger scene. The benchmark is skipped otherwise.
+    """
+
+    START_FRAME = 1
+    END_FRAME = 48
+    NUM_CHARACTERS = 40
+    NUM_BENCHMARK_CHARACTERS = 400
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+        cls.temp_dir = os.path.abspath('.')
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _createScene(self, numCharacters=NUM_CHARACTERS):
+        '''Create deforming and moving meshes, plus a few static ones and a few
+        whose animation is only floating-point noise.'''
+        cmds.file(new=True, force=True)
+        root = cmds.group(empty=True, name='crowd')
+        for i in range(numCharacters):
+            sphere, history = cmds.polySphere(
+                name='character%d' % i, subdivisionsX=40, subdivisionsY=40)
+            cmds.parent(sphere, root)
+            if i % 4 == 0:
+                # Keep some static characters to exercise the sparse writer.
+                continue
+            if i % 4 == 1:
+                # Noise under the sparse writer tolerance must be skipped by both modes.
+                cmds.setKeyframe(history, attribute='radius', value=1.0, time=self.START_FRAME)
+                cmds.setKeyframe(history, attribute='radius', value=1.0 + 1e-9, time=self.END_FRAME)
+                cmds.setKeyframe(sphere, attribute='translateX', value=0.0, time=self.START_FRAME)
+                cmds.setKeyframe(sphere, attribute='translateX', value=1e-9, time=self.END_FRAME)
+                continue
+            cmds.setKeyframe(history, attribute='radius', value=1.0, time=self.START_FRAME)
+            cmds.setKeyframe(history, attribute='radius', value=2.0 + i, time=self.END_FRAME)
+            cmds.setKeyframe(sphere, attribute='translateX', value=0.0, time=self.START_FRAME)
+            cmds.setKeyframe(sphere, attribute='translateX', value=i, time=self.END_FRAME)
+
+    def _export(self, fileName, parallel):
+        path = os.path.join(self.temp_dir, fileName)
+        cmds.mayaUSDExport(
+            file=path,
+            frameRange=(self.START_FRAME, self.END_FRAME),
+            parallelFrameWrite=parallel)
+        return path
+
+    def _assertSameSamples(self, serialPath, parallelPath):
+        serialStage = Usd.Stage.Open(serialPath)
+        parallelStage = Usd.Stage.Open(parallelPath)
+        for serialPrim in serialStage.Traverse():
+            parallelPrim = parallelStage.GetPrimAtPath(serialPrim.GetPath())
+            self.assertTrue(parallelPrim, serialPrim.GetPath())
+            for serialAttr in serialPrim.GetAttributes():
+                parallelAttr = parallelPrim.GetAttribute(serialAttr.GetName())
+                self.assertTrue(parallelAttr, serialAttr.GetPath())
+                serialTimes = serialAttr.GetTimeSamples()
+                self.assertEqual(serialTimes, parallelAttr.GetTimeSamples(), serialAttr.GetPath())
+                for t in serialTimes:
+                    self.assertEqual(serialAttr.Get(t), parallelAttr.Get(t), serialAttr.GetPath())
+                self.assertEqual(serialAttr.Get(), parallelAttr.Get(), serialAttr.GetPath())
+
+    def testParallelFrameWriteMatchesSerialExport(self):
+        self._createScene()
+
+        serialPath = self._export('serialFrameWrite.usda', False)
+        parallelPath = self._export('parallelFrameWrite.usda', True)
+
+        self._assertSameSamples(serialPath, parallelPath)
+
+        # Both modes must author the very same layer, down to the skipped samples.
+        self.assertEqual(
+            Sdf.Layer.FindOrOpen(serialPath).ExportToString(),
+            Sdf.Layer.FindOrOpen(parallelPath).ExportToString())
+
+        numFrames = self.END_FRAME - self.START_FRAME + 1
+
+        # Static characters must not receive redundant time samples.
+        stage = Usd.Stage.Open(parallelPath)
+        staticPoints = stage.GetPrimAtPath('/crowd/character0').GetAttribute('points')
+        self.assertEqual(staticPoints.GetNumTimeSamples(), 0)
+        animatedPoints = stage.GetPrimAtPath('/crowd/character2').GetAttribute('points')
+        self.assertEqual(animatedPoints.GetNumTimeSamples(), numFrames)
+
+        # Neither do the characters only animated by floating-point noise.
+        noisyPrim = stage.GetPrimAtPath('/crowd/character1')
+        self.assertLessEqual(noisyPrim.GetAttribute('points').GetNumTimeSamples(), 1)
+        noisyTranslate = noisyPrim.GetAttribute('xformOp:translate')
+        if noisyTranslate:
+            self.assertLessEqual(noisyTranslate.GetNumTimeSamples(), 1)
+
+    @unittest.skipUnless(os.environ.get('MAYAUSD_RUN_BENCHMARKS'),
+                         'Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark')
+    def testParallelFrameWriteBenchmark(self):
+        self._createScene(self.NUM_BENCHMARK_CHARACTERS)
+        numFrames = self.END_FRAME - self.START_FRAME + 1
+
+        start = time.time()
+        serialPath = self._export('serialFrameWriteBenchmark.usdc', False)
+        serialTime = time.time() - start
+
+        start = time.time()
+        parallelPath = self._export('parallelFrameWriteBenchmark.usdc', True)
+        parallelTime = time.time() - start
+
+        print('Serial export:   %.2f frames per second' % (numFrames / max(serialTime, 1e-6)))
+        print('Parallel export: %.2f frames per second' % (numFrames / max(parallelTime, 1e-6)))
+
+        self._assertSameSamples(serialPath, parallelPath)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
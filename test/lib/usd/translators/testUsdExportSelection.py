@@ -79,5 +79,49 @@ class testUsdExportSelection(unittest.TestCase):
             self.assertFalse(prim.IsValid())
 
 
+    def testExportWithLargeSelection(self):
+        """Export a large selection spread across a large scene. Validating the
+        selection and traversing the DAG must scale linearly with its size."""
+        cmds.file(new=True, force=True)
+
+        numGroups = 50
+        numChildren = 100
+        selection = []
+        for i in range(numGroups):
+            group = cmds.group(empty=True, name='Group%d' % i)
+            for j in range(numChildren):
+                child = cmds.group(empty=True, name='Group%d_Child%d' % (i, j), parent=group)
+                cmds.group(empty=True, name='Group%d_Leaf%d' % (i, j), parent=child)
+                if i % 2 == 0 and j % 2 == 0:
+                    selection.append(child)
+        cmds.select(selection)
+
+        usdFilePath = os.path.abspath('UsdExportLargeSelectionTest_EXPORTED.usda')
+        cmds.usdExport(selection=True, file=usdFilePath, shadingMode='none')
+
+        stage = Usd.Stage.Open(usdFilePath)
+        self.assertTrue(stage)
+
+        self.assertTrue(stage.GetPrimAtPath('/Group0/Group0_Child0/Group0_Leaf0').IsValid())
+        self.assertTrue(stage.GetPrimAtPath('/Group48/Group48_Child98').IsValid())
+        self.assertFalse(stage.GetPrimAtPath('/Group0/Group0_Child1').IsValid())
+        self.assertFalse(stage.GetPrimAtPath('/Group1').IsValid())
+
+        numExported = len([p for p in stage.Traverse()])
+        expectedNumExported = (numGroups // 2) * (1 + numChildren)
+        self.assertEqual(numExported, expectedNumExported)
+
+    def testExportWithOverlappingSelection(self):
+        cmds.file(new=True, force=True)
+
+        group = cmds.group(empty=True, name='Parent')
+        child = cmds.group(empty=True, name='Child', parent=group)
+        cmds.select([group, child])
+
+        usdFilePath = os.path.abspath('UsdExportOverlappingSelectionTest_EXPORTED.usda')
+        with self.assertRaises(RuntimeError):
+            cmds.usdExport(selection=True, file=usdFilePath, shadingMode='none')
+
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -0,0 +1,159 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import unittest
+
+import fixturesUtils
+from maya import cmds
+from maya import standalone
+from pxr import Sdf, Usd
+
+
+class testUsdExportTimeSampleChunkSize(unittest.TestCase):
+    """Compare a regular animated export with an export flushing its time
+    samples to value clips every few frames."""
+
+    START_FRAME = 1
+    END_FRAME = 10
+    CHUNK_SIZE = 4
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+        cls.temp_dir = os.path.abspath('.')
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _createScene(self):
+        cmds.file(new=True, force=True)
+        sphere, history = cmds.polySphere(name='deforming')
+        cmds.setKeyframe(history, attribute='radius', value=1.0, time=self.START_FRAME)
+        cmds.setKeyframe(history, attribute='radius', value=3.0, time=self.END_FRAME)
+
+        cube = cmds.polyCube(name='moving')[0]
+        # Only animated in the last frame window.
+        cmds.setKeyframe(cube, attribute='translateY', value=0.0, time=self.END_FRAME - 1)
+        cmds.setKeyframe(cube, attribute='translateY', value=5.0, time=self.END_FRAME)
+
+        # Only animated in the first frame window, back to its first value.
+        cone = cmds.polyCone(name='stopping')[0]
+        cmds.setKeyframe(cone, attribute='translateX', value=0.0, time=self.START_FRAME)
+        cmds.setKeyframe(cone, attribute='translateX', value=2.0, time=self.START_FRAME + 1)
+        cmds.setKeyframe(cone, attribute='translateX', value=0.0, time=self.START_FRAME + 2)
+
+        # Animated, but its points never change: they get a single time sample.
+        constant, constantHistory = cmds.polySphere(name='constant')
+        cmds.setKeyframe(constantHistory, attribute='radius', value=2.0, time=self.START_FRAME)
+        cmds.setKeyframe(constantHistory, attribute='radius', value=2.0, time=self.END_FRAME)
+
+    def _export(self, fileName, chunkSize, staticSingleSample=False):
+        path = os.path.join(self.temp_dir, fileName)
+        cmds.mayaUSDExport(
+            file=path,
+            frameRange=(self.START_FRAME, self.END_FRAME),
+            timeSampleChunkSize=chunkSize,
+            staticSingleSample=staticSingleSample)
+        return path
+
+    def _assertSameValues(self, regularPath, chunkedPath):
+        regularStage = Usd.Stage.Open(regularPath)
+        chunkedStage = Usd.Stage.Open(chunkedPath)
+        for regularPrim in regularStage.Traverse():
+            chunkedPrim = chunkedStage.GetPrimAtPath(regularPrim.GetPath())
+            self.assertTrue(chunkedPrim, regularPrim.GetPath())
+            for regularAttr in regularPrim.GetAttributes():
+                chunkedAttr = chunkedPrim.GetAttribute(regularAttr.GetName())
+                self.assertTrue(chunkedAttr, regularAttr.GetPath())
+                for frame in range(self.START_FRAME, self.END_FRAME + 1):
+                    self.assertEqual(
+                        regularAttr.Get(frame), chunkedAttr.Get(frame),
+                        '%s at frame %d' % (regularAttr.GetPath(), frame))
+
+    def testChunkedExportMatchesRegularExport(self):
+        self._createScene()
+
+        regularPath = self._export('regularTimeSamples.usda', 0)
+        chunkedPath = self._export('chunkedTimeSamples.usda', self.CHUNK_SIZE)
+
+        # Frames 1-4, 5-8 and 9-10 are each flushed to their own clip.
+        for i in range(1, 4):
+            self.assertTrue(os.path.exists(
+                os.path.join(self.temp_dir, 'chunkedTimeSamples.clip%04d.usdc' % i)))
+        self.assertFalse(os.path.exists(
+            os.path.join(self.temp_dir, 'chunkedTimeSamples.clip0004.usdc')))
+        self.assertTrue(os.path.exists(
+            os.path.join(self.temp_dir, 'chunkedTimeSamples.manifest.usda')))
+
+        # The exported layer itself holds no time samples.
+        chunkedLayer = Sdf.Layer.FindOrOpen(chunkedPath)
+        self.assertTrue(chunkedLayer)
+        pointsSpec = chunkedLayer.GetAttributeAtPath('/deforming.points')
+        self.assertTrue(pointsSpec)
+        self.assertFalse(pointsSpec.HasInfo('timeSamples'))
+
+        # An attribute that does not change after the first window is not carried
+        # into the next clips when its held value is the manifest default.
+        translatePath = '/stopping.xformOp:translate'
+        firstClip = Sdf.Layer.FindOrOpen(
+            os.path.join(self.temp_dir, 'chunkedTimeSamples.clip0001.usdc'))
+        self.assertTrue(firstClip.GetAttributeAtPath(translatePath))
+        for i in range(2, 4):
+            clip = Sdf.Layer.FindOrOpen(
+                os.path.join(self.temp_dir, 'chunkedTimeSamples.clip%04d.usdc' % i))
+            self.assertFalse(clip.GetAttributeAtPath(translatePath))
+
+        self._assertSameValues(regularPath, chunkedPath)
+
+    def testChunkedExportWithStaticSingleSample(self):
+        self._createScene()
+
+        # The points of the constant sphere only get a single time sample...
+        regularPath = self._export('singleSamples.usda', 0)
+        regularPoints = Usd.Stage.Open(regularPath).GetPrimAtPath(
+            '/constant').GetAttribute('points')
+        self.assertEqual(regularPoints.GetNumTimeSamples(), 1)
+
+        # ...which staticSingleSample turns into a default value, with or without clips.
+        staticPath = self._export('staticSingleSamples.usda', 0, True)
+        chunkedPath = self._export('chunkedStaticSingleSamples.usda', self.CHUNK_SIZE, True)
+
+        chunkedLayer = Sdf.Layer.FindOrOpen(chunkedPath)
+        pointsSpec = chunkedLayer.GetAttributeAtPath('/constant.points')
+        self.assertTrue(pointsSpec)
+        self.assertTrue(pointsSpec.HasInfo('default'))
+        self.assertFalse(pointsSpec.HasInfo('timeSamples'))
+
+        manifest = Sdf.Layer.FindOrOpen(
+            os.path.join(self.temp_dir, 'chunkedStaticSingleSamples.manifest.usda'))
+        self.assertFalse(manifest.GetAttributeAtPath('/constant.points'))
+        self.assertTrue(manifest.GetAttributeAtPath('/deforming.points'))
+
+        staticStage = Usd.Stage.Open(staticPath)
+        chunkedStage = Usd.Stage.Open(chunkedPath)
+        for stage in (staticStage, chunkedStage):
+            points = stage.GetPrimAtPath('/constant').GetAttribute('points')
+            self.assertEqual(points.GetNumTimeSamples(), 0)
+            self.assertFalse(points.ValueMightBeTimeVarying())
+
+        self._assertSameValues(staticPath, chunkedPath)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
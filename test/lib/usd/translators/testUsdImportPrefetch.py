@@ -0,0 +1,154 @@
+#!/usr/bin/env mayapy
+#
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import time
+import unittest
+
+import fixturesUtils
+from maya import cmds
+from maya import standalone
+from pxr import Sdf, Usd, UsdGeom
+
+
+class testUsdImportPrefetch(unittest.TestCase):
+    """Import meshes whose data is read ahead of the prim readers.
+
+    This test is run twice: with the prim data read ahead of the prim readers
+    on worker threads, in batches much smaller than the asset, and with
+    MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE=0 to read it from the prim readers.
+    Both imports must give the same meshes.
+
+    Set MAYAUSD_RUN_BENCHMARKS=1 to also time the import of a 100k-prim asset.
+    Run the module with mayapy once with the default prefetch batch size and
+    once with MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE=0, and compare the printed
+    wall times. The benchmark is skipped otherwise.
+    """
+
+    # One transform and one mesh per item, spanning several prefetch batches.
+    NUM_ITEMS = 1000
+    NUM_DEFORMING = 10
+    NUM_BENCHMARK_ITEMS = 50000
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+        cls.usdFile = os.path.abspath('UsdImportPrefetch.usdc')
+        cls._createAsset(cls.usdFile)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    @classmethod
+    def _points(cls, i, height=0.0):
+        # Each mesh gets its own points, so data staged for the wrong prim is detected.
+        size = 1.0 + i * 0.001
+        return [(0, height, 0), (size, height, 0), (size, height, size), (0, height, size)]
+
+    @classmethod
+    def _createAsset(cls, usdFile, numItems=NUM_ITEMS):
+        stage = Usd.Stage.CreateNew(usdFile)
+        stage.SetStartTimeCode(1)
+        stage.SetEndTimeCode(2)
+
+        with Sdf.ChangeBlock():
+            for i in range(numItems):
+                x = (i % 50) * 2.0
+                z = (i // 50) * 2.0
+                xform = UsdGeom.Xform.Define(stage, '/Root/Item%d' % i)
+                xform.AddTranslateOp().Set((x, 0, z))
+
+                mesh = UsdGeom.Mesh.Define(stage, '/Root/Item%d/Quad' % i)
+                mesh.CreatePointsAttr(cls._points(i))
+                mesh.CreateFaceVertexCountsAttr([4])
+                mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3])
+                mesh.CreateSubdivisionSchemeAttr(UsdGeom.Tokens.none)
+                if i % 2 == 1:
+                    mesh.CreateOrientationAttr(UsdGeom.Tokens.leftHanded)
+
+        # A few deforming meshes, imported as blend shapes.
+        for i in cls._deformingItems(numItems):
+            points = UsdGeom.Mesh.Get(stage, '/Root/Item%d/Quad' % i).GetPointsAttr()
+            points.Set(cls._points(i), 1)
+            points.Set(cls._points(i, 1.0), 2)
+
+        stage.GetRootLayer().Save()
+
+    @classmethod
+    def _deformingItems(cls, numItems=NUM_ITEMS):
+        return range(0, numItems, numItems // cls.NUM_DEFORMING)
+
+    def _faceNormalY(self, mesh):
+        info = cmds.polyInfo(mesh, faceNormals=True)[0]
+        return float(info.split()[-2])
+
+    def _assertPoints(self, mesh, expected):
+        points = cmds.xform(mesh + '.vtx[*]', query=True, objectSpace=True, translation=True)
+        actual = [tuple(points[j:j + 3]) for j in range(0, len(points), 3)]
+        self.assertEqual(len(actual), len(expected), mesh)
+        for actualPoint, expectedPoint in zip(actual, expected):
+            for a, e in zip(actualPoint, expectedPoint):
+                self.assertAlmostEqual(a, e, places=5, msg=mesh)
+
+    def testImport(self):
+        cmds.file(new=True, force=True)
+        cmds.usdImport(file=self.usdFile, shadingMode=[['none', 'default'], ],
+                       frameRange=(1, 2))
+
+        meshes = cmds.ls(type='mesh', noIntermediate=True)
+        self.assertEqual(len(meshes), self.NUM_ITEMS)
+
+        deforming = set(self._deformingItems())
+        cmds.currentTime(1)
+        for i in range(self.NUM_ITEMS):
+            mesh = '|Root|Item%d|Quad|QuadShape' % i
+            self.assertEqual(cmds.polyEvaluate(mesh, vertex=True), 4)
+            self.assertEqual(cmds.polyEvaluate(mesh, face=True), 1)
+            self._assertPoints(mesh, self._points(i))
+
+            # The faces of the left-handed meshes are flipped to be right-handed.
+            expectedNormalY = 1.0 if i % 2 == 1 else -1.0
+            self.assertAlmostEqual(self._faceNormalY(mesh), expectedNormalY, places=5)
+
+        # The deforming meshes read their time samples.
+        self.assertEqual(len(cmds.ls(type='blendShape')), len(deforming))
+        cmds.currentTime(2)
+        for i in deforming:
+            self._assertPoints('|Root|Item%d|Quad|QuadShape' % i, self._points(i, 1.0))
+
+    @unittest.skipUnless(os.environ.get('MAYAUSD_RUN_BENCHMARKS'),
+                         'Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark')
+    def testImportBenchmark(self):
+        usdFile = os.path.abspath('UsdImportPrefetchBenchmark.usdc')
+        self._createAsset(usdFile, self.NUM_BENCHMARK_ITEMS)
+
+        cmds.file(new=True, force=True)
+        start = time.time()
+        cmds.usdImport(file=usdFile, shadingMode=[['none', 'default'], ],
+                       frameRange=(1, 2))
+        elapsed = time.time() - start
+        print('Imported %d prims in %.2f s (MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE=%s)' % (
+            2 * self.NUM_BENCHMARK_ITEMS, elapsed,
+            os.environ.get('MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE', 'default')))
+
+        meshes = cmds.ls(type='mesh', noIntermediate=True)
+        self.assertEqual(len(meshes), self.NUM_BENCHMARK_ITEMS)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
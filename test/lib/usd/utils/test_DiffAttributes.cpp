@@ -1,6 +1,8 @@
 #include <mayaUsdUtils/DiffPrims.h>
 
+#include <pxr/base/gf/vec3f.h>
 #include <pxr/base/tf/type.h>
+#include <pxr/base/vt/types.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 
 #include <gtest/gtest.h>
@@ -414,3 +416,44 @@ TEST(DiffAttributes, compareAttributesCreatedSampledDouble)
     compareAttributes(modifiedAttr, baselineAttr, &quickDiff);
     EXPECT_NE(quickDiff, DiffResult::Same);
 }
+
+TEST(DiffAttributes, compareAttributesRepeatedLargeArraySamples)
+{
+    // Test that repeated samples of large arrays are compared correctly.
+
+    SdfPath primPath("/A");
+    auto    pointsType = SdfValueTypeNames->Point3fArray;
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = baselineStage->DefinePrim(SdfPath(primPath));
+    auto baselineAttr = baselinePrim.CreateAttribute(TfToken("test_attr"), pointsType, true);
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = modifiedStage->DefinePrim(SdfPath(primPath));
+    auto modifiedAttr = modifiedPrim.CreateAttribute(TfToken("test_attr"), pointsType, true);
+
+    VtVec3fArray pose1(10000, GfVec3f(1.0f, 2.0f, 3.0f));
+    VtVec3fArray pose2(10000, GfVec3f(4.0f, 5.0f, 6.0f));
+
+    // Held poses, alternating every few samples.
+    for (int time = 0; time < 20; ++time) {
+        const VtVec3fArray& pose = (time / 5) % 2 ? pose2 : pose1;
+        baselineAttr.Set(pose, UsdTimeCode(time));
+        modifiedAttr.Set(pose, UsdTimeCode(time));
+    }
+
+    EXPECT_EQ(compareAttributes(modifiedAttr, baselineAttr), DiffResult::Same);
+
+    DiffResult quickDiff = DiffResult::Differ;
+    compareAttributes(modifiedAttr, baselineAttr, &quickDiff);
+    EXPECT_EQ(quickDiff, DiffResult::Same);
+
+    // Swap the poses in a single sample of the modified attribute.
+    modifiedAttr.Set(pose2, UsdTimeCode(12));
+
+    EXPECT_EQ(compareAttributes(modifiedAttr, baselineAttr), DiffResult::Differ);
+
+    quickDiff = DiffResult::Same;
+    compareAttributes(modifiedAttr, baselineAttr, &quickDiff);
+    EXPECT_EQ(quickDiff, DiffResult::Differ);
+}
@@ -1,5 +1,6 @@
 #include <mayaUsdUtils/DiffPrims.h>
 
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/base/tf/type.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 
@@ -137,3 +138,40 @@ TEST(DiffPrimsAttributes, comparePrimsAttributesCreatedDouble)
     comparePrimsAttributes(modifiedPrim, baselinePrim, &quickDiff);
     EXPECT_NE(quickDiff, DiffResult::Same);
 }
+
+TEST(DiffPrimsAttributes, comparePrimsAttributesQuickManyDiffer)
+{
+    // Test that the quick result of a prim with many differing attributes is the result of the
+    // first differing attribute, and that only the attributes before it are reported.
+
+    SdfPath   primPath("/A");
+    auto      doubleType = SdfValueTypeNames->Double;
+    const int numAttrs = 100;
+    const int createdAttr = 30;
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = baselineStage->DefinePrim(SdfPath(primPath));
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = modifiedStage->DefinePrim(SdfPath(primPath));
+
+    for (int i = 0; i < numAttrs; ++i) {
+        const TfToken name(TfStringPrintf("attr%03d", i));
+        modifiedPrim.CreateAttribute(name, doubleType, true).Set(1.0);
+        if (i == createdAttr)
+            continue;
+        // Every attribute after the created one differs.
+        baselinePrim.CreateAttribute(name, doubleType, true).Set(i > createdAttr ? 2.0 : 1.0);
+    }
+
+    for (int run = 0; run < 20; ++run) {
+        DiffResult         quickDiff = DiffResult::Same;
+        DiffResultPerToken results
+            = comparePrimsAttributes(modifiedPrim, baselinePrim, &quickDiff);
+
+        EXPECT_EQ(quickDiff, DiffResult::Created);
+        EXPECT_EQ(results.size(), std::size_t(createdAttr));
+        for (const auto& nameAndResult : results)
+            EXPECT_EQ(nameAndResult.second, DiffResult::Same) << nameAndResult.first.GetText();
+    }
+}
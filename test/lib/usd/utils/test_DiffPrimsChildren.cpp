@@ -1,5 +1,6 @@
 #include <mayaUsdUtils/DiffPrims.h>
 
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/base/tf/type.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 
@@ -160,3 +161,35 @@ TEST(DiffPrimsChildren, comparePrimsChildrenCreated)
     comparePrimsChildren(modifiedPrim, baselinePrim, &quickDiff);
     EXPECT_NE(quickDiff, DiffResult::Same);
 }
+
+TEST(DiffPrimsChildren, comparePrimsChildrenMany)
+{
+    // Test that prims with enough children to be compared in parallel report each child.
+
+    const int numChildren = 1000;
+    const int diffChild = 777;
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselinePrim = createPrim(baselineStage, primPath);
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, primPath);
+
+    for (int i = 0; i < numChildren; ++i) {
+        const SdfPath childPath = primPath.AppendChild(TfToken(TfStringPrintf("C%d", i)));
+        createChild(baselineStage, childPath, 1.0);
+        createChild(modifiedStage, childPath, i == diffChild ? 2.0 : 1.0);
+    }
+
+    DiffResultPerPath results = comparePrimsChildren(modifiedPrim, baselinePrim);
+
+    EXPECT_EQ(results.size(), std::size_t(numChildren));
+    for (int i = 0; i < numChildren; ++i) {
+        const SdfPath childPath = primPath.AppendChild(TfToken(TfStringPrintf("C%d", i)));
+        EXPECT_EQ(results[childPath], i == diffChild ? DiffResult::Differ : DiffResult::Same);
+    }
+
+    DiffResult quickDiff = DiffResult::Same;
+    comparePrimsChildren(modifiedPrim, baselinePrim, &quickDiff);
+    EXPECT_EQ(quickDiff, DiffResult::Differ);
+}
@@ -1,16 +1,24 @@
 #include <mayaUsdUtils/MergePrims.h>
 
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/primSpec.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 #include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/editContext.h>
+#include <pxr/usd/usd/inherits.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/relationship.h>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdlib>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 using namespace MayaUsdUtils;
@@ -719,3 +727,130 @@ TEST(MergePrims, mergePrimsChildRelationshipAddTarget)
     EXPECT_EQ(targets[0], targetPath1);
     EXPECT_EQ(targets[1], targetPath3);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Ignoring upper layer opinions.
+
+TEST(MergePrims, mergePrimsIgnoreUpperLayerOpinions)
+{
+    // Test that the opinions of the upper layers are ignored, while the opinions composed from
+    // other prims of the destination layer are not.
+
+    const SdfPath classPath("/_class_A");
+    const SdfPath siblingPath("/Sibling");
+
+    auto baselineStage = UsdStage::CreateInMemory();
+    auto baselineClass = baselineStage->CreateClassPrim(classPath);
+    createAttr(baselineClass, 1.0);
+    auto baselinePrim = createPrim(baselineStage, primPath);
+    baselinePrim.GetInherits().AddInherit(classPath);
+    auto baselineSibling = createChild(baselineStage, siblingPath, 1.0);
+
+    // Upper layer opinion.
+    {
+        UsdEditContext editContext(baselineStage, baselineStage->GetSessionLayer());
+        baselinePrim.GetAttribute(testAttrName).Set(5.0);
+    }
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, primPath);
+    createAttr(modifiedPrim, testAttrName, 1.0);
+    createAttr(modifiedPrim, otherAttrName, 2.0);
+
+    MergePrimsOptions options;
+    options.ignoreUpperLayerOpinions = true;
+    options.propertiesHandling = MergeMissing::Create;
+    options.verbosity = MergeVerbosity::Failure;
+
+    const SdfLayerHandle baselineLayer = baselineStage->GetRootLayer();
+
+    const bool result = mergePrims(
+        modifiedStage,
+        modifiedStage->GetRootLayer(),
+        modifiedPrim.GetPath(),
+        baselineStage,
+        baselineLayer,
+        baselinePrim.GetPath(),
+        options);
+
+    EXPECT_TRUE(result);
+
+    // The inherited value is identical, so it is not authored.
+    EXPECT_FALSE(baselineLayer->GetAttributeAtPath(primPath.AppendProperty(testAttrName)));
+
+    double value = 0.;
+    EXPECT_TRUE(baselineLayer->HasField(
+        primPath.AppendProperty(otherAttrName), SdfFieldKeys->Default, &value));
+    EXPECT_EQ(value, 2.);
+
+    // The rest of the layer is untouched.
+    EXPECT_TRUE(baselineLayer->GetPrimAtPath(classPath));
+    EXPECT_TRUE(baselineSibling.GetAttribute(testAttrName).Get(&value));
+    EXPECT_EQ(value, 1.);
+    EXPECT_EQ(rangeSize(baselineStage->GetPseudoRoot().GetChildren()), size_t(2));
+}
+
+namespace {
+
+// Merge a single prim in a layer of itemCount prims. Only the merged prim should be copied and
+// written back, so the time should not depend on the number of prims in the layer.
+void mergeOnePrimInLayer(size_t itemCount)
+{
+    const SdfPath setPath("/Set");
+    const SdfPath itemPath = setPath.AppendChild(TfToken("Item42"));
+
+    auto           baselineStage = UsdStage::CreateInMemory();
+    SdfLayerHandle baselineLayer = baselineStage->GetRootLayer();
+    {
+        SdfChangeBlock    changeBlock;
+        SdfPrimSpecHandle set = SdfCreatePrimInLayer(baselineLayer, setPath);
+        set->SetSpecifier(SdfSpecifierDef);
+        for (size_t i = 0; i < itemCount; ++i) {
+            SdfPrimSpecHandle      item
+                = SdfPrimSpec::New(set, TfStringPrintf("Item%zu", i), SdfSpecifierDef, "xform");
+            SdfAttributeSpecHandle attr = SdfAttributeSpec::New(item, testAttrName, doubleType);
+            attr->SetDefaultValue(VtValue(1.0));
+        }
+    }
+
+    auto modifiedStage = UsdStage::CreateInMemory();
+    auto modifiedPrim = createPrim(modifiedStage, SdfPath("/Item42"));
+    createAttr(modifiedPrim, 3.0);
+
+    MergePrimsOptions options;
+    options.ignoreUpperLayerOpinions = true;
+    options.mergeChildren = true;
+    options.verbosity = MergeVerbosity::Failure;
+
+    const bool result = mergePrims(
+        modifiedStage,
+        modifiedStage->GetRootLayer(),
+        modifiedPrim.GetPath(),
+        baselineStage,
+        baselineLayer,
+        itemPath,
+        options);
+
+    EXPECT_TRUE(result);
+
+    double value = 0.;
+    EXPECT_TRUE(
+        baselineStage->GetAttributeAtPath(itemPath.AppendProperty(testAttrName)).Get(&value));
+    EXPECT_EQ(value, 3.);
+
+    EXPECT_TRUE(baselineStage->GetAttributeAtPath(SdfPath("/Set/Item41.test_attr")).Get(&value));
+    EXPECT_EQ(value, 1.);
+    EXPECT_EQ(baselineLayer->GetPrimAtPath(setPath)->GetNameChildren().size(), itemCount);
+}
+
+} // namespace
+
+TEST(MergePrims, mergePrimsIgnoreUpperLayerOpinionsInLayer) { mergeOnePrimInLayer(100); }
+
+TEST(MergePrims, mergePrimsIgnoreUpperLayerOpinionsLargeLayer)
+{
+    if (!std::getenv("MAYAUSD_RUN_BENCHMARKS"))
+        GTEST_SKIP() << "Set MAYAUSD_RUN_BENCHMARKS=1 to run the benchmark";
+
+    mergeOnePrimInLayer(100000);
+}